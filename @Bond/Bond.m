@@ -139,6 +139,7 @@ classdef Bond < Instrument
         key_rate_mon_dur = [];
         key_rate_eff_convex = [];
         key_rate_mon_convex = [];
+        key_rate_dv01 = [];
     end
    
    methods
@@ -212,6 +213,7 @@ classdef Bond < Instrument
             fprintf('Key rate Monetary Duration: %s\n',any2str(b.key_rate_mon_dur));
             fprintf('Key rate Effective Convexity: %s\n',any2str(b.key_rate_eff_convex));
             fprintf('Key rate Monetary Convexity: %s\n',any2str(b.key_rate_mon_convex));
+            fprintf('Key rate DV01: %s\n',any2str(b.key_rate_dv01));
          end
          if ( regexpi(b.sub_type,'CMS'))
             fprintf('vola_surface: %s\n',b.vola_surface); 
@@ -541,8 +543,11 @@ Calculate the net present value of cash flows of Bonds (including pricing of emb
 @item obj.rollout(@var{scenario},@var{valuation_date}, @var{hazard_curve}, @var{reference_asset},@var{reference_curve}): used for CDS\n\
 Cash flow rollout for Bonds\n\
 \n\
-@item obj.calc_sensitivities(@var{valuation_date},@var{discount_curve}, @var{reference_curve})\n\
+@item obj.calc_sensitivities(@var{valuation_date},@var{discount_curve}, @var{reference_curve}, @var{greeks_mode}, @var{call_schedule}, @var{put_schedule})\n\
 Calculate analytical and numerical sensitivities for the given Bond instrument.\n\
+With @var{greeks_mode} 'analytic' (default) effective duration, convexity, DV01 and PV01 of fixed cash flow bonds\n\
+are derived from discount factor derivatives and the Hull-White tree sensitivities of embedded options.\n\
+'bump' revalues with shocked curves (validation). Floating rate notes keep the revaluation for effective measures.\n\
 \n\
 @item obj.calc_key_rates(@var{valuation_date},@var{discount_curve})\n\
 Calculate key rate sensitivities for the given Bond instrument.\n\
@@ -37,6 +37,7 @@ function obj = calc_key_rates(bond,valuation_date,discount_curve)
 		key_rate_mon_dur = zeros(1,length(key_terms));
 		key_rate_eff_convex = zeros(1,length(key_terms));
 		key_rate_mon_convex = zeros(1,length(key_terms));
+		key_rate_dv01 = zeros(1,length(key_terms));
     else
 		if ( columns(cf_values) == 0 || rows(cf_values) == 0 )
 			error('No cash flow values set. CF rollout done?');    
@@ -48,71 +49,40 @@ function obj = calc_key_rates(bond,valuation_date,discount_curve)
 		key_rate_shock = obj.key_rate_shock;
 		key_rate_width = obj.key_rate_width;    
 		
-		% new discount curve
-		curve_keyrate_up = zeros(1,length(cf_dates));
-		curve_keyrate_down = zeros(1,length(cf_dates));
-		% vectors for key rate durations and convexities
-		key_rate_eff_dur = zeros(1,length(key_terms));
-		key_rate_mon_dur = zeros(1,length(key_terms));
-		key_rate_eff_convex = zeros(1,length(key_terms));
-		key_rate_mon_convex = zeros(1,length(key_terms));
+		% get curve and spread rates at all cash flow dates (set up once)
+		[rates_cf weights_cf] = get_curve_weights(disc_nodes,disc_rates, ...
+											cf_dates,interp_discount);
+		rates_cf = rates_cf * weights_cf;
+		spread_cf = convert_curve_rates(valuation_date,cf_dates, ...
+							bond.soy,'continuous','annual',3, ...
+							curve_comp_type,curve_comp_freq,curve_basis);
+		spread_cf = spread_cf .* ones(1,length(cf_dates));
+		tf_curve = timefactor(valuation_date,valuation_date + cf_dates,curve_basis);
+		tf_shock = timefactor(valuation_date,valuation_date + cf_dates,3);
 		
-		% loop through all key rates and set up a new curve for each key rate.
-		% calculate up and down values for each key rate with the new curve.
-		% the new curve consists of the discount curve and key rate specific shocks.
-		for ii = 1:1:length(key_terms)
-			key_term = key_terms(ii);
-			% generate key rate shock curve
-			krs_terms = [key_term - key_rate_width,key_term,key_term + key_rate_width];
-			if ( ii == 1)
-				krs_rates = [key_rate_shock,key_rate_shock,0];
-			elseif ( ii == length(key_terms))
-				krs_rates = [0,key_rate_shock,key_rate_shock];
-			else
-				krs_rates = [0,key_rate_shock,0];
-			end
-			for jj = 1:1:length(cf_dates)
-				cf_date = cf_dates(jj);
-				% generate new curve (sum of discount curve and key rate shock curve)
-				disc_rate = interpolate_curve(disc_nodes,disc_rates, ...
-												cf_date,interp_discount);
-				krs_rate = interpolate_curve(krs_terms,krs_rates, ...
-												cf_date,'linear');
-				% convert krs_rate convention (cont, act/365) to curve conv
-				key_rate_shock_conv = convert_curve_rates(valuation_date,cf_date, ...
-							krs_rate,'continuous','annual',3, ...
-							curve_comp_type,curve_comp_freq,curve_basis);   
-				% store rate in new curve
-				curve_keyrate_up(jj) = disc_rate + key_rate_shock_conv;
-				curve_keyrate_down(jj) = disc_rate - key_rate_shock_conv;
-			end
-			curve_keyrates = [curve_keyrate_down ; curve_keyrate_up];
-			% calc bond values under key rate up and down shocks
-			value_krs = pricing_npv(valuation_date, cf_dates, ...
-									cf_values, bond.soy, ...
-									cf_dates, curve_keyrates, basis, ...
-									comp_type, comp_freq, interp_discount, ...
-									curve_comp_type, curve_basis, ...
-									curve_comp_freq,false);
-			value_krs_down  = value_krs(1);
-			value_krs_up    = value_krs(2);
-			% calc key rate duration and convexity
-			key_rate_dur    = (value_krs_down - value_krs_up) ...
-									./ (2 * key_rate_shock * base_value);
-			key_rate_convex = (value_krs_down + value_krs_up - 2*base_value) ...
-									./ (key_rate_shock^2 * base_value);
-			% store in vectors
-			key_rate_eff_dur(ii) = key_rate_dur;
-			key_rate_mon_dur(ii) = key_rate_dur * base_value;
-			key_rate_eff_convex(ii) = key_rate_convex;
-			key_rate_mon_convex(ii) = key_rate_convex * base_value;
-		end
+		% calculate values under key rate up and down shocks and analytical 
+		% key rate DV01 of all key rates in one pass over all cash flows.
+		% the shocked curves consist of the discount curve and key rate 
+		% specific triangular shocks.
+		[value_krs_down value_krs_up key_rate_dv01] = key_rates_cpp( ...
+							[0;length(cf_dates)],cf_dates,cf_values, ...
+							rates_cf,spread_cf,tf_curve,tf_shock, ...
+							curve_comp_type,curve_comp_freq,key_terms, ...
+							key_rate_shock,key_rate_width);
+		% calc key rate duration and convexity
+		key_rate_eff_dur    = (value_krs_down - value_krs_up) ...
+								./ (2 * key_rate_shock * base_value);
+		key_rate_eff_convex = (value_krs_down + value_krs_up - 2*base_value) ...
+								./ (key_rate_shock^2 * base_value);
+		key_rate_mon_dur    = key_rate_eff_dur .* base_value;
+		key_rate_mon_convex = key_rate_eff_convex .* base_value;
     end
     % store key rates
     obj = obj.set('key_rate_eff_dur',key_rate_eff_dur);   
     obj = obj.set('key_rate_mon_dur',key_rate_mon_dur);
     obj = obj.set('key_rate_eff_convex',key_rate_eff_convex);
     obj = obj.set('key_rate_mon_convex',key_rate_mon_convex);
+    obj = obj.set('key_rate_dv01',key_rate_dv01);
     
 end
 
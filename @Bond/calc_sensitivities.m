@@ -1,12 +1,29 @@
-function obj = calc_sensitivities (bond, valuation_date, discount_curve, reference_curve)
+function obj = calc_sensitivities (bond, valuation_date, discount_curve, reference_curve, greeks_mode, call_schedule, put_schedule)
 obj = bond;
 
-%TODO: implement correct sensi calculation for CMS_Floating, CDS_FLOATING, Callable Bonds
+%TODO: implement correct sensi calculation for CMS_Floating, CDS_FLOATING
 %       right now only there is no new cash flow rollout (no sensi to reference curve)
 
 if ischar(valuation_date)
     valuation_date = datenum(valuation_date,1);
 end
+if ( nargin < 4 )
+    reference_curve = [];
+end
+% greeks_mode: 'analytic' (default, derivatives of discount factors and
+% Hull-White tree) or 'bump' (revaluation with shocked curves, validation)
+if ( nargin < 5 || isempty(greeks_mode) )
+    greeks_mode = 'analytic';
+end
+if ~( strcmpi(greeks_mode,'analytic') || strcmpi(greeks_mode,'bump') )
+    error('Bond.calc_sensitivities: unknown greeks_mode >>%s<<. Allowed values: analytic, bump',greeks_mode);
+end
+if ( nargin < 6 || ~isobject(call_schedule) )
+    call_schedule = [];
+end
+if ( nargin < 7 || ~isobject(put_schedule) )
+    put_schedule = [];
+end
 
 % A) get bond related attributes
 % Get base cf values and dates
@@ -32,12 +49,13 @@ end
 % B) Calculate analytic sensitivities where no new CF rollout is required    
     % TODO: incorporate embedded bond option calculation 
     sensi_flag = true;
-    [theo_value MacDur Convex MonDur] = pricing_npv(valuation_date, cashflow_dates, ...
+    [theo_value MacDur Convex MonDur Convex_alt dnpv d2npv] = pricing_npv(valuation_date, cashflow_dates, ...
                                 cashflow_values, bond.soy, ...
                                 nodes_discount, rates_discount, basis_bond, ...
                                 comp_type_bond, comp_freq_bond, interp_discount, ...
                                 comp_type_discount, basis_discount, ...
                                 comp_freq_discount, sensi_flag);
+    npv_base = theo_value(1);
     obj.mac_duration = MacDur(1);
     obj.dollar_duration = MonDur(1);
     % calculating modified (adjusted) duration depending on compounding freq
@@ -55,7 +73,7 @@ end
     
 % C.1) Effective Dur/Convex: CF rollout required special case FRN or SWAP_FLOAT
 if ( strcmp(bond.sub_type,'FRN') || strcmp(bond.sub_type,'SWAP_FLOAT'))
-    if ( nargin < 4 )
+    if ( ~isobject(reference_curve) )
         error ('rollout for sub_type FRN or SWAP_FLOAT: expecting reference curve object');
     end
        
@@ -127,37 +145,64 @@ if ( strcmp(bond.sub_type,'FRN') || strcmp(bond.sub_type,'SWAP_FLOAT'))
         obj.pv01 = theo_value_1bpup - theo_value;         
     
     % calculate spread duration (without CF rollout): shock discount curve only
-    rates_eff_sensis = [rates_discount; ...
-                    rates_discount - bond.ir_shock; ...
-                    rates_discount + bond.ir_shock];
-    value_vec = pricing_npv(valuation_date, cashflow_dates, ...
-                                cashflow_values, bond.soy, ...
-                                nodes_discount, rates_eff_sensis, basis_bond, ...
-                                comp_type_bond, comp_freq_bond, interp_discount, ...
-                                comp_type_discount, basis_discount, ...
-                                comp_freq_discount);
+    if ( strcmpi(greeks_mode,'analytic') )
+        obj.spread_duration = - dnpv(1) / npv_base;
+    else
+        rates_eff_sensis = [rates_discount; ...
+                        rates_discount - bond.ir_shock; ...
+                        rates_discount + bond.ir_shock];
+        value_vec = pricing_npv(valuation_date, cashflow_dates, ...
+                                    cashflow_values, bond.soy, ...
+                                    nodes_discount, rates_eff_sensis, basis_bond, ...
+                                    comp_type_bond, comp_freq_bond, interp_discount, ...
+                                    comp_type_discount, basis_discount, ...
+                                    comp_freq_discount);
                                 
-    theo_value              = value_vec(1);
-    theo_value_100bpdown    = value_vec(2);
-    theo_value_100bpup      = value_vec(3);
+        theo_value              = value_vec(1);
+        theo_value_100bpdown    = value_vec(2);
+        theo_value_100bpup      = value_vec(3);
     
-    % calc spread duration
-    obj.spread_duration = ( theo_value_100bpdown - theo_value_100bpup ) ...
-                    / ( 2 * theo_value * bond.ir_shock );
+        % calc spread duration
+        obj.spread_duration = ( theo_value_100bpdown - theo_value_100bpup ) ...
+                        / ( 2 * theo_value * bond.ir_shock );
+    end
     
 else  % all bonds with fixed cashflows (FRB, SWAP_FIXED, CF Instruments)
   % C.2) calculate effective sensitivities for all fixed CF bonds
+  % embedded options are priced in the Hull-White tree if a call or put
+  % schedule is given
+  embedded_option = ( bond.embedded_option_flag == true && ...
+            (isobject(call_schedule) || isobject(put_schedule)) );
+  if ( strcmpi(greeks_mode,'analytic') )
+    % first and second derivative of the value to a parallel shift of the
+    % discount curve (discount factors and tree sensitivities)
+    dvalue  = dnpv(1);
+    d2value = d2npv(1);
+    if ( embedded_option )
+        [OptionValue tmp_put tmp_call dOption d2Option] = option_bond_hw('base', ...
+                                bond,discount_curve,call_schedule,put_schedule);
+        theo_value = theo_value + OptionValue(1);
+        dvalue     = dvalue + dOption(1);
+        d2value    = d2value + d2Option(1);
+    end
+    theo_value = theo_value(1);
+    
+    obj.eff_duration = - dvalue / theo_value;
+    % spread duration for FRB equals effective duration:
+    obj.spread_duration = obj.eff_duration;
+    obj.eff_convexity = d2value / theo_value;
+    % DV01 and PV01 (up shock incl. second order term) for 1bp shift
+    obj.dv01 = 0.0001 * abs(dvalue);
+    obj.pv01 = 0.0001 * dvalue + 0.5 * 0.0001^2 * d2value;
+  else
     % adjust rates_discount for shocks
     %   1. row: base value
     %   2. row: -bond.ir_shock
     %   3. row: +bond.ir_shock
     %   4. row: -0.0001 (DV01)
     %   5. row: +0.0001 (DV01)
-    rates_eff_sensis = [rates_discount; ...
-                    rates_discount - bond.ir_shock; ...
-                    rates_discount + bond.ir_shock; ...
-                    rates_discount - 0.0001; ...
-                    rates_discount + 0.0001];
+    shock_vec = [0; -bond.ir_shock; bond.ir_shock; -0.0001; 0.0001];
+    rates_eff_sensis = rates_discount + shock_vec;
                     
     % calculate values under shock
     value_vec = pricing_npv(valuation_date, cashflow_dates, ...
@@ -166,6 +211,13 @@ else  % all bonds with fixed cashflows (FRB, SWAP_FIXED, CF Instruments)
                                 comp_type_bond, comp_freq_bond, interp_discount, ...
                                 comp_type_discount, basis_discount, ...
                                 comp_freq_discount);
+    if ( embedded_option )
+        for kk = 1 : 1 : length(shock_vec)
+            tmp_curve = discount_curve.set('rates_base',rates_discount + shock_vec(kk));
+            value_vec(kk) = value_vec(kk) + option_bond_hw('base',bond, ...
+                                    tmp_curve,call_schedule,put_schedule);
+        end
+    end
     theo_value              = value_vec(1);
     theo_value_100bpdown    = value_vec(2);
     theo_value_100bpup      = value_vec(3);
@@ -185,6 +237,7 @@ else  % all bonds with fixed cashflows (FRB, SWAP_FIXED, CF Instruments)
     obj.dv01 = 0.5 * abs(theo_value_1bpdown - theo_value_1bpup);
     % calculating pv01 using upshock only
     obj.pv01 = theo_value_1bpup - theo_value;                           
+  end
 end
    
 end
@@ -1,9 +1,5 @@
 function s = calc_spread_over_yield (bond,valuation_date,discount_curve,call_schedule,put_schedule)
    s = bond;
-   % Start parameter
-   x0 = 0.01;
-   lb = -1;
-   ub = 1;
 
    if ( nargin < 3)
         error('Error: No  discount curve set. Aborting.');
@@ -80,13 +76,11 @@ function s = calc_spread_over_yield (bond,valuation_date,discount_curve,call_sch
             tmp_rates, basis, comp_type, comp_freq, tmp_interp_discount, ...
             tmp_curve_comp_type, tmp_curve_basis, tmp_curve_comp_freq, false);
     
-    % set up objective function
-    objfunc = @ (x) phi_soy(x,valuation_date,cf_dates, ...
-            cf_values,value_dirty,tmp_curve_comp_type, tmp_curve_basis, ...
-            tmp_curve_comp_freq, rate_vec);
-    
-    % calculate spread over yield (with fixed embedded option value)    
-    [spread_over_yield retcode] = calibrate_generic(objfunc,x0,lb,ub);
+    % calculate spread over yield (with fixed embedded option value) by
+    % Newton solver with analytic derivative
+    [spread_over_yield retcode] = calibrate_bond_yields('soy',valuation_date, ...
+            cf_dates,cf_values,value_dirty,rate_vec,tmp_curve_comp_type, ...
+            tmp_curve_basis, tmp_curve_comp_freq);
             
      if ( retcode > 0 ) %failed calibration
         fprintf('Calibration failed for %s. Setting value_base to theo_value.\n',s.id); 
@@ -107,27 +101,3 @@ function s = calc_spread_over_yield (bond,valuation_date,discount_curve,call_sch
   end
 end
 
-
-%-------------------------------------------------------------------------------
-%------------------- Begin Subfunctions ----------------------------------------
- 
-% Definition Objective Function for spread over yield:  
-function obj = phi_soy (x,valuation_date,cf_dates,cf_values,act_value, ...
-                comp_type_curve, basis_curve, comp_freq_curve,rate_vec)
-        % convert constant spread 
-        x = convert_curve_rates(valuation_date,cf_dates', ...
-                        x,'continuous','annual',3, ...
-                        comp_type_curve,comp_freq_curve,basis_curve)';
-        % add spread to interpolated rates
-        rate_vec = rate_vec + x;
-        % get discount factor
-        tmp_df  = discount_factor (valuation_date, valuation_date + cf_dates', ...
-                                               rate_vec', comp_type_curve, ...
-                                               basis_curve, comp_freq_curve); 
-        % Calculate actual NPV of cash flows    
-        tmp_npv = cf_values * tmp_df;
-        obj = (act_value - tmp_npv).^2;
-end    
-
-%------------------------------------------------------------------
-
@@ -1,11 +1,6 @@
 function s = calc_yield_to_mat (bond, valuation_date)
   s = bond;
   
-  % set start parameter and bounds
-  x0 = 0.01;
-  lb = -1;
-  ub = 1;
-  
   if ( nargin < 2)
         valuation_date = today;
   end
@@ -32,25 +27,14 @@ function s = calc_yield_to_mat (bond, valuation_date)
 	else
 		value_dirty = s.value_base;
 	end
-	objfunc = @ (x) phi_ytm(x, valuation_date, s.cf_dates, cf_values, value_dirty);
-	s.ytm = calibrate_generic(objfunc,x0,lb,ub);
+	% Newton solver with analytic derivative (disc annual act/365 yield)
+	[ytm retcode] = calibrate_bond_yields('ytm',valuation_date, ...
+	                                        s.cf_dates,cf_values,value_dirty);
+	if ( retcode > 0 )
+		fprintf('--- calc_yield_to_mat: WARNING: Calibration of YtM failed for %s. Setting YtM = -99 ---\n',s.id);
+		ytm = -99;
+	end
+	s.ytm = ytm;
   end
    
 end
-
-%-------------------------------------------------------------------------------
-%--------------------------- Begin Subfunction ---------------------------------
-
-% Definition Objective Function for yield to maturity:         
-function obj = phi_ytm (x,valuation_date,cashflow_dates, ...
-                        cashflow_values,act_value)
-            tmp_yield = [x];
-            % get discount factors for all cash flow dates and ytm rate
-            tmp_df  = discount_factor (valuation_date, valuation_date + cashflow_dates', ...
-                                                   tmp_yield,'disc',3,'annual'); 
-            % Calculate actual NPV of cash flows    
-            tmp_npv = cashflow_values * tmp_df;
-        
-            obj = (act_value - tmp_npv).^2;
-end
-%-------------------------------------------------------------------------------
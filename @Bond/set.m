@@ -150,6 +150,7 @@ function obj = set(obj, varargin)
                 'key_rate_mon_dur', 'numeric', ...
                 'key_rate_eff_convex', 'numeric', ...
                 'key_rate_mon_convex', 'numeric', ...
+                'key_rate_dv01', 'numeric', ...
                 'embedded_option_value', 'numeric'...
                );
   % B) store values in object
@@ -287,8 +287,10 @@ Calculate the net present value of cash flows of Caps and Floors.\n\
 @item obj.rollout(@var{valuation_date},@var{scenario}, @var{inflation_exp_rates}, @var{historical_inflation}, @var{consumer_price_index}): used for Inflation Caps and Floors\n\
 Cash flow rollout for (Inflation) Caps and Floors.\n\
 \n\
-@item obj.calc_sensitivity(@var{valuation_date},@var{scenario},  @var{reference_curve}, @var{vola_surface}, @var{discount_curve})\n\
-Calculate numerical sensitivities (durations, vega, theta) for the given CapFloor instrument.\n\
+@item obj.calc_sensitivities(@var{valuation_date},@var{scenario},  @var{reference_curve}, @var{vola_surface}, @var{discount_curve}, @var{greeks_mode})\n\
+Calculate numerical sensitivities (effective duration and convexity, vega, theta) for the given CapFloor instrument.\n\
+Sensitivities to the discount curve with fixed cash flows (spread duration, DV01, PV01) are calculated\n\
+from discount factor derivatives (@var{greeks_mode} 'analytic', default) or by revaluation ('bump').\n\
 \n\
 @item obj.calc_vola_spread(@var{valuation_date},@var{scenario}, @var{discount_curve}, @var{volatility_surface})\n\
 Calibrate volatility spread in order to match the CapFloor price with the market price. The volatility spread will be used for further pricing.\n\
@@ -1,8 +1,16 @@
-function obj = calc_sensitivities(capfloor,valuation_date,value_type, reference_curve, vola_surface, discount_curve)
+function obj = calc_sensitivities(capfloor,valuation_date,value_type, reference_curve, vola_surface, discount_curve, greeks_mode)
 obj = capfloor;
 if ( nargin < 6)
     error('Error: No reference curve, discount curve, vola surface or vola risk factor set. Aborting.');
 end
+% greeks_mode: 'analytic' (default, discount curve sensitivities from
+% discount factor derivatives) or 'bump' (revaluation, validation)
+if ( nargin < 7 || isempty(greeks_mode) )
+    greeks_mode = 'analytic';
+end
+if ~( strcmpi(greeks_mode,'analytic') || strcmpi(greeks_mode,'bump') )
+    error('CapFloor.calc_sensitivities: unknown greeks_mode >>%s<<. Allowed values: analytic, bump',greeks_mode);
+end
 
 if ischar(valuation_date)
       valuation_date = datenum(valuation_date,1);
@@ -12,6 +20,8 @@ end
     obj = obj.rollout(valuation_date,'base',reference_curve,vola_surface);
     obj = obj.calc_value(valuation_date,'base',reference_curve);
     theo_value      = obj.getValue('base');
+    cashflow_dates  = obj.get('cf_dates');
+    cashflow_values = obj.getCF('base');
     basis_obj       = obj.get('basis');
     comp_type_obj   = obj.get('compounding_type');
     comp_freq_obj   = obj.get('compounding_freq');
@@ -122,6 +132,37 @@ end
                         
     % effective theta
         obj.theta = theo_value_time_up - theo_value;
+    
+% e) discount curve sensitivities (cash flows of base rollout held fixed)
+    if ( strcmpi(greeks_mode,'analytic') )
+        [npv_cf tmp_mac tmp_conv tmp_mon tmp_conv_alt dnpv d2npv] = ...
+                        pricing_npv(valuation_date, cashflow_dates, ...
+                                    cashflow_values, obj.soy, ...
+                                    nodes_discount, rates_discount, basis_obj, ...
+                                    comp_type_obj, comp_freq_obj, interp_discount, ...
+                                    comp_type_discount, basis_discount, ...
+                                    comp_freq_discount);
+        obj.spread_duration = - dnpv(1) / npv_cf(1);
+        obj.dv01 = 0.0001 * abs(dnpv(1));
+        obj.pv01 = 0.0001 * dnpv(1) + 0.5 * 0.0001^2 * d2npv(1);
+    else
+        %   1. row: base value
+        %   2. row: -obj.ir_shock
+        %   3. row: +obj.ir_shock
+        %   4. row: -0.0001 (DV01)
+        %   5. row: +0.0001 (DV01)
+        shock_vec = [0; -obj.ir_shock; obj.ir_shock; -0.0001; 0.0001];
+        value_vec = pricing_npv(valuation_date, cashflow_dates, ...
+                                    cashflow_values, obj.soy, ...
+                                    nodes_discount, rates_discount + shock_vec, ...
+                                    basis_obj, comp_type_obj, comp_freq_obj, ...
+                                    interp_discount, comp_type_discount, ...
+                                    basis_discount, comp_freq_discount);
+        obj.spread_duration = ( value_vec(2) - value_vec(3) ) ...
+                        / ( 2 * value_vec(1) * obj.ir_shock );
+        obj.dv01 = 0.5 * abs(value_vec(4) - value_vec(5));
+        obj.pv01 = value_vec(5) - value_vec(1);
+    end
         
 end
 
@@ -1,3 +1,6 @@
+% Calibrate the volatility spread of one cap / floor (one caplet rollout per
+% solver step). Caps and floors are excluded from calibrate_vola_spreads, since
+% the batch solver prices one option per lane and not a strip of caplets.
 function obj = calc_vola_spread (capfloor,valuation_date,discount_curve,vola_surface)
    obj = capfloor;
     if ( nargin < 4)
@@ -38,6 +38,9 @@ classdef Curve
       nodes = [];
       rates_base = [];
       rates_mc  = [];
+      rates_mc_scores = [];     % factor scores of MC rates (scenarios x factors)
+      rates_mc_loadings = [];   % mean curve and factor loadings of MC rates
+      rates_mc_handle = 0;      % handle of MC rates in shared scenario buffer pool
       rates_stress = [];
       basis = 3;
       floor = '';
@@ -69,6 +72,9 @@ classdef Curve
          % Get length of Value vector:
          rates_stress_rows = min(rows(a.rates_stress),5);
          [mc_rows mc_cols mc_stack] = size(a.rates_mc);
+         if ( isempty(a.rates_mc) )   % MC rates in factor or buffer representation
+            mc_stack = length(a.timestep_mc);
+         end
          rates_stress_cols = min(length(a.rates_stress),2);
          fprintf('name: %s\nid: %s\ndescription: %s\ntype: %s\n', ... 
             a.name,a.id,a.description,a.type);
@@ -285,6 +291,15 @@ can be \'base\', \'stress\' or a certain MC timestep like \'250d\'\.\n\
 @item obj.apply_rf_shocks(@var{scenario},@var{riskfactor_object}): Set shock curve values for @var{scenario}\n\
 Scenario shocks from provided @var{riskfactor_object} are used\n\
 \n\
+@item obj.compress_rates_mc(@var{tol},@var{max_factors}): Replace MC rates by a factor representation\n\
+with at most @var{max_factors} principal components and maximum absolute reconstruction error @var{tol}.\n\
+MC rates are kept if the tolerance can not be met.\n\
+\n\
+@item obj.store_rates_mc(): Move MC rates into the shared scenario buffer pool. The object only carries\n\
+the buffer handle afterwards. The buffers are freed at the start of the next MC run, even if curve\n\
+objects of the former run are still referenced (e.g. returned curve_struct in the workspace), so that\n\
+the MC rates of only one run are held in memory. Handles of freed buffers are invalid. See \'help scenario_buffer_cpp\'.\n\
+\n\
 @item obj.isProp(@var{attribute}): Return true, if attribute is a property of Curve class. Return false otherwise.\n\
 \n\
 @item Curve.help(@var{format},@var{returnflag}): show this message. Format can be [plain text, html or texinfo].\n\
@@ -332,6 +347,12 @@ underlying curves. Use @var{curve_function} to specify how to aggregated curves.
 @item @var{rates_base}: Vector with curve rates. Has to be of same column size as @var{nodes}.\n\
 @item @var{rates_mc}: Matrix with curve rates. Has to be of same column size as @var{nodes}.\n\
 Columns: nodes, Lines: scenarios. MC rates for several MC timesteps are stored in layers.\n\
+@item @var{rates_mc_loadings}: Optional factor representation of MC rates (used if @var{rates_mc} is empty).\n\
+First row contains the mean curve, all further rows the factor loadings per node.\n\
+@item @var{rates_mc_scores}: Factor scores of MC rates. Columns: factors, Lines: scenarios.\n\
+MC rates are reconstructed by rates_mc_loadings(1,:) + rates_mc_scores * rates_mc_loadings(2:end,:)\n\
+when queried with getValue or interpolated with getRate. See \'help compress_curve_scenarios\'.\n\
+@item @var{rates_mc_handle}: Handle of MC rates in shared scenario buffer pool (used if @var{rates_mc} is empty). Default: 0 (no buffer).\n\
 @item @var{rates_stress}: Matrix with curve rates. Has to be of same  as @var{nodes}.\n\
 Columns correspond to nodes, lines correspond to scenarios.\n\
 @item @var{timestep_mc}: String Cell array with MC timesteps. Automatically appended if values for new timesteps are set.\n\
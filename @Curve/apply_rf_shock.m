@@ -20,22 +20,31 @@ if ~(strcmpi(value_type,'Base'))
             else % MC scenarios
                 shocktype = rf.shocktype_mc;
             end
-            rates_shock = zeros(rows(rf.getRate(value_type, 1)),length(nodes));
-            % loop via all nodes
-            for kk = 1 : 1 : length(nodes)
-                node = nodes(kk);
-                % get shock
-                shock = rf.getRate(value_type, node);
-                rate_base = curve.getRate(value_type, node);
-                % apply shock to curve
-                if ( strcmpi(shocktype,'absolute'))
-                    rates_shock(:,kk) = shock + rate_base;
-                elseif ( strcmpi(shocktype,'relative'))
-                    rates_shock(:,kk) = shock .* rate_base;
-                else
-                    error ('Curve.getRate: Unknown shocktype >>%s<<',any2str(shocktype));
+            % get shocks and rates of all nodes: linear interpolation of
+            % all nodes at once, node by node otherwise
+            if ( strcmpi(rf.method_interpolation,'linear') ...
+                    && strcmpi(curve.method_interpolation,'linear') ...
+                    && all(round(rf.nodes) == rf.nodes) ...
+                    && all(round(curve.nodes) == curve.nodes) )
+                shock = interpolate_curve_vectorized(rf.nodes, ...
+                                    rf.getValue(value_type),nodes);
+                rate_base = interpolate_curve_vectorized(curve.nodes, ...
+                                    curve.getValue(value_type),nodes);
+            else
+                shock = zeros(rows(rf.getRate(value_type, 1)),length(nodes));
+                rate_base = zeros(rows(curve.getRate(value_type, 1)),length(nodes));
+                for kk = 1 : 1 : length(nodes)
+                    shock(:,kk) = rf.getRate(value_type, nodes(kk));
+                    rate_base(:,kk) = curve.getRate(value_type, nodes(kk));
                 end
-                
+            end
+            % apply shock to curve
+            if ( strcmpi(shocktype,'absolute'))
+                rates_shock = shock + rate_base;
+            elseif ( strcmpi(shocktype,'relative'))
+                rates_shock = shock .* rate_base;
+            else
+                error ('Curve.getRate: Unknown shocktype >>%s<<',any2str(shocktype));
             end
             % set cf values
             if ( strcmpi(value_type,'Stress'))
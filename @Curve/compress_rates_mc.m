@@ -0,0 +1,29 @@
+% method of class @Curve
+function curve = compress_rates_mc (curve, tol, max_factors)
+
+% input checks
+    if ( nargin < 3 )
+        error ('Curve.compress_rates_mc requires tolerance and maximum number of factors.');
+    end
+
+% MC timesteps with several scenarios are compressed page by page
+    if ( isempty(curve.rates_mc) || rows(curve.rates_mc) < 2 )
+        return;
+    end
+    no_pages = size(curve.rates_mc,3);
+    loadings_cell = cell(no_pages,1);
+    scores_cell = cell(no_pages,1);
+    for kk = 1 : 1 : no_pages
+        [loadings_cell{kk} scores_cell{kk}] = compress_curve_scenarios( ...
+                                curve.rates_mc(:,:,kk),tol,max_factors);
+        % keep dense rates if tolerance can not be met
+        if ( isempty(loadings_cell{kk}) )
+            fprintf('Curve.compress_rates_mc: MC rates of curve >>%s<< (page %d) can not be compressed with tolerance %s. Keeping dense MC rates.\n', ...
+                                curve.id,kk,any2str(tol));
+            return;
+        end
+    end
+    [loadings scores] = stack_curve_factors(loadings_cell,scores_cell);
+    curve = curve.set('rates_mc',[],'rates_mc_scores',scores, ...
+                                    'rates_mc_loadings',loadings);
+end
@@ -8,7 +8,6 @@ function rate = getRate (curve, value_type, node)
     
 % Curve variables
     nodes           = curve.nodes;
-    rates           = curve.getValue(value_type);
     interp_method   = curve.method_interpolation;
 
 % distinguish between integer and real nodes
@@ -17,6 +16,21 @@ function rate = getRate (curve, value_type, node)
         int_flag = true;
     end
 
+% factor representation of MC rates: linear interpolation of loadings only
+    if ( isempty(curve.rates_mc) && ~isempty(curve.rates_mc_loadings) ...
+            && strcmpi(interp_method,'linear') && int_flag ...
+            && ~isnumeric(curve.floor) && ~isnumeric(curve.cap) )
+        tmp_col = find(strcmp(lower(value_type),curve.timestep_mc),1);
+        if ~( isempty(tmp_col) )
+            loadings = interpolate_curve_vectorized(nodes, ...
+                                curve.rates_mc_loadings(:,:,tmp_col),node);
+            rate = loadings(1,:) + curve.rates_mc_scores(:,:,tmp_col) ...
+                                * loadings(2:end,:);
+            return;
+        end
+    end
+    rates           = curve.getValue(value_type);
+
 % interpolate
     % vector or linear interpolation -> call fast cpp method
     if ( (length(node) > 1 || strcmpi(interp_method,'linear')) && int_flag)
@@ -19,7 +19,26 @@ function s = getValue (curve, property)
         tmp_vec = strcmp(property,tmp_timestep_mc);
         if ( sum(tmp_vec) > 0)                  
             tmp_col = tmp_vec * (1:length(tmp_vec))';
-            s = obj.rates_mc(:,:,tmp_col);    
+            if ( isempty(obj.rates_mc) && obj.rates_mc_handle > 0 )
+                % rates stored in shared scenario buffer pool (floor and
+                % cap already applied, data is shared and not copied)
+                s = scenario_buffer_cpp('get',obj.rates_mc_handle);
+                if ( size(s,3) > 1 )
+                    s = s(:,:,tmp_col);
+                end
+            elseif ( isempty(obj.rates_mc) && ~isempty(obj.rates_mc_loadings) )
+                % reconstruct rates from factor representation
+                loadings = obj.rates_mc_loadings(:,:,tmp_col);
+                s = loadings(1,:) + obj.rates_mc_scores(:,:,tmp_col) * loadings(2:end,:);
+                if ( isnumeric(obj.floor) )
+                    s = max(s,obj.floor);
+                end
+                if ( isnumeric(obj.cap) )
+                    s = min(s,obj.cap);
+                end
+            else
+                s = obj.rates_mc(:,:,tmp_col);
+            end
         else
             %printf ('get: invalid property %s. No MC timestep found. Returning base rates.\n', property);
             s = obj.rates_base;
@@ -4,6 +4,9 @@ function obj = set(obj, varargin)
   typestruct = struct(...
                 'timestep_mc', 'special' , ...
                 'rates_mc', 'special' , ...
+                'rates_mc_scores', 'numeric' , ...
+                'rates_mc_loadings', 'numeric' , ...
+                'rates_mc_handle', 'numeric' , ...
                 'rates_stress', 'special' , ...
                 'rates_base', 'numeric' , ...
                 'alpha', 'numeric' , ...
@@ -52,5 +55,12 @@ function obj = set(obj, varargin)
     retval = return_checked_input(obj,val,prop,type);
     % store property in object
     obj.(prop) = retval;
+    % dense MC rates replace factor representation and buffered rates
+    % (the buffer itself may still be used by other copies of the object)
+    if ( strcmp(prop,'rates_mc') && ~isempty(retval) )
+        obj.rates_mc_scores = [];
+        obj.rates_mc_loadings = [];
+        obj.rates_mc_handle = 0;
+    end
   end
 end   
@@ -0,0 +1,13 @@
+% method of class @Curve
+function curve = store_rates_mc (curve)
+
+% move MC rates into shared scenario buffer pool: copies of the object
+% only carry the buffer handle and share the MC rates. Buffers are not freed
+% by the object (other copies may still use them), but at the start of the
+% next MC run (see scenario_buffer_cpp).
+    if ( isempty(curve.rates_mc) )
+        return;
+    end
+    handle = scenario_buffer_cpp('store',curve.rates_mc);
+    curve = curve.set('rates_mc',[],'rates_mc_handle',handle);
+end
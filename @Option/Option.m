@@ -291,9 +291,10 @@ Calculate the value of Options based on valuation date, scenario type, discount
 The pricing model is chosen based on Option type and instrument model attributes.\n\
 A path to precalculated Willow trees for pricing American options by Willowtree model can be provided.\n\
 \n\
-@item obj.calc_greeks(@var{valuation_date},@var{scenario}, @var{underlying}, @var{discount_curve}, @var{volatility_surface}, @var{path_static})\n\
+@item obj.calc_greeks(@var{valuation_date},@var{scenario}, @var{underlying}, @var{discount_curve}, @var{volatility_surface}, @var{path_static}, @var{greeks_mode})\n\
 Calculate sensitivities (the Greeks) for the given Option instrument.\n\
 For plain-vanilla European Options the Greeks are calculated by Black-Scholes pricing.\n\
+For American Options (CRR and Willowtree) the Greeks are calculated by one adjoint sweep through the CRR tree (@var{greeks_mode} 'analytic', default) or by repricing with shocked input parameters (@var{greeks_mode} 'bump').\n\
 The Greeks of all other Option types will be calculated by numeric approximation.\n\
 \n\
 @item obj.calc_vola_spread(@var{valuation_date}, @var{underlying}, @var{discount_curve}, @var{volatility_surface}, @var{path_static})\n\
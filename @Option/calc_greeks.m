@@ -1,4 +1,4 @@
-function obj = calc_greeks(option,valuation_date,value_type,underlying,discount_curve,tmp_vola_surf_obj,path_static)
+function obj = calc_greeks(option,valuation_date,value_type,underlying,discount_curve,tmp_vola_surf_obj,path_static,greeks_mode)
     obj = option;
     if ( nargin < 4)
         error('Error: No  discount curve, vola surface or underlying set. Aborting.');
@@ -12,6 +12,14 @@ function obj = calc_greeks(option,valuation_date,value_type,underlying,discount_
     if ( nargin < 6)
         path_static = pwd;
     end
+    % greeks of American options (CRR): 'analytic' (adjoint tree sweep) or
+    % 'bump' (repricing with shocked input parameters, validation mode)
+    if ( nargin < 8)
+        greeks_mode = 'analytic';
+    end
+    if ~( strcmpi(greeks_mode,'analytic') || strcmpi(greeks_mode,'bump') )
+        error('Option.calc_greeks: unknown greeks_mode >>%s<<. Allowed values: analytic, bump',greeks_mode);
+    end
     % Get discount curve nodes and rate
         tmp_nodes        = discount_curve.nodes;
         tmp_rates_base   = discount_curve.getValue('base');
@@ -89,7 +97,7 @@ function obj = calc_greeks(option,valuation_date,value_type,underlying,discount_
                 sensi_vec   = option_bjsten(call_flag, underlying_value_vec, ...
                                 tmp_strike, dtm_pricing_vec, rf_rate_conv_vec, ...
                                 imp_vola_shock_vec, divyield);              
-            else %  call CRR for both Willowtree and CRR model (less overhead)
+            elseif ( strcmpi(greeks_mode,'bump') ) %  call CRR for both Willowtree and CRR model (less overhead)
                 sensi_vec   = pricing_option_cpp(2,logical(call_flag),underlying_value_vec, ...
                                     tmp_strike,dtm_pricing_vec,rf_rate_conv_vec, ...
                                     imp_vola_shock_vec,divyield,800);
@@ -145,6 +153,16 @@ function obj = calc_greeks(option,valuation_date,value_type,underlying,discount_
                             tmp_underlying_value, tmp_strike, tmp_dtm_pricing, ...
                             tmp_rf_rate_conv, tmp_imp_vola_shock, divyield);
         end
+        % special case American Options (CRR and Willowtree): greeks from
+        % one adjoint sweep through CRR tree
+        if ( strcmpi(option_type,'American') && strcmpi(greeks_mode,'analytic') ...
+                    && ~strcmpi(obj.pricing_function_american,'BjSten') ) 
+            [theo_value theo_delta theo_gamma theo_vega theo_theta theo_rho] = ...
+                            pricing_option_cpp(2,logical(call_flag),tmp_underlying_value, ...
+                                    tmp_strike,tmp_dtm_pricing,tmp_rf_rate_conv, ...
+                                    tmp_imp_vola_shock,divyield,800);
+            theo_omega  = theo_delta .* tmp_underlying_value ./ theo_value;
+        end
     end   % close loop if tmp_dtm < 0
     
     
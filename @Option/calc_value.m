@@ -1,4 +1,4 @@
-function obj = calc_value(option,valuation_date,value_type,underlying,discount_curve,tmp_vola_surf_obj,path_static)
+function obj = calc_value(option,valuation_date,value_type,underlying,discount_curve,tmp_vola_surf_obj,path_static,para_object)
     obj = option;
     if ( nargin < 5)
         error('Error: No  discount curve, vola surface or underlying set. Aborting.');
@@ -12,6 +12,13 @@ function obj = calc_value(option,valuation_date,value_type,underlying,discount_c
     if ( nargin < 7)
         path_static = pwd;
     end
+    % grid based pricing of tree models for MC scenarios only
+    use_pricing_grid = false;
+    if ( nargin == 8 && ~(strcmpi(value_type,'base') || strcmpi(value_type,'stress')))
+        if ( isProp(para_object,'use_pricing_grid') )
+            use_pricing_grid = para_object.use_pricing_grid;
+        end
+    end
     % Get discount curve nodes and rate
         tmp_nodes           = discount_curve.nodes;
         tmp_rates           = discount_curve.getValue(value_type);
@@ -98,11 +105,31 @@ function obj = calc_value(option,valuation_date,value_type,underlying,discount_c
                              
       % Valuation for: American plain vanilla options
         elseif ( strcmpi(option_type,'American'))   % calling Willow tree option pricing model
-            if ( strcmpi(obj.pricing_function_american,'Willowtree') )
+            if ( strcmpi(obj.pricing_function_american,'Willowtree') && use_pricing_grid )
+                % price on grid over spot, vola and rate, interpolate scenarios
+                pricing_func = @(x) option_willowtree(call_flag,1,x(:,1),X,T, ...
+                                    x(:,3),x(:,2),0.0,option.timesteps_size, ...
+                                    option.willowtree_nodes,path_static);
+                theo_value  = pricing_grid(pricing_func, ...
+                                    [S .* ones(mc,1),sigma .* ones(mc,1),r .* ones(mc,1)], ...
+                                    para_object.pricing_grid_tolerance, ...
+                                    para_object.pricing_grid_max_nodes) .* multi;
+            
+            elseif ( strcmpi(obj.pricing_function_american,'Willowtree') )
                 theo_value  = option_willowtree(call_flag,1,S,X,T,r,sigma, ...
                                     0.0,option.timesteps_size, ...
                                     option.willowtree_nodes,path_static) .* multi;
                                     
+            elseif ( strcmpi(obj.pricing_function_american,'CRR') && use_pricing_grid )
+                % price on grid over spot, vola and rate, interpolate scenarios
+                treenodes   = round(T/option.timesteps_size);
+                pricing_func = @(x) pricing_option_cpp(2,logical(call_flag),x(:,1), ...
+                                    X,T,x(:,3),x(:,2),q,treenodes);
+                theo_value  = pricing_grid(pricing_func, ...
+                                    [S .* ones(mc,1),sigma .* ones(mc,1),r .* ones(mc,1)], ...
+                                    para_object.pricing_grid_tolerance, ...
+                                    para_object.pricing_grid_max_nodes) .* multi;
+                
             elseif ( strcmpi(obj.pricing_function_american,'CRR') )
                 %---------------------- end ------------------------------------
                 % TODO: consider using parallel package (only Linux supported, 
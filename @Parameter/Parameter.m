@@ -55,6 +55,8 @@ classdef Parameter
         reporting = 1;
         idx_figure = 1;
         calc_marg_incr_var = 0;
+        calc_evt_var = 0;         % GPD tail model VaR / ES of portfolio and aggregation keys
+        evt_tail_fraction = 0.025; % fraction of scenarios in GPD tail sample
         saving = 0;
         archive_flag = 0;
         stable_seed = 1;
@@ -68,6 +70,22 @@ classdef Parameter
         number_parallel_cores = 4;
         frob_norm_limit = 0.05;   % Frobenius Norm: threshold of rlzd corrmat and 
                             % input corrmat, where to draw new random numbers
+        use_corr_factors = 0;     % factor model (L*L'+diag(D.^2)) instead of full corrmat
+        no_corr_factors = 10;     % number of factors fitted to input corrmat
+        input_filename_corr_factors = ''; % factor loadings file (fit corrmat if empty)
+        marginal_distr_mode = 'exact'; % Pearson marginals: exact, table or validate
+        use_curve_factors = 0;    % store curve MC rates as PCA factor scores and loadings
+        curve_factor_tolerance = 0.00001; % max. abs. reconstruction error of curve rates
+        curve_max_factors = 5;    % max. number of factors per curve
+        use_scenario_buffer = 0;  % store curve MC rates in shared buffer pool (by handle)
+        use_approx_valuation = 0; % delta-gamma-vega approximation of MC values
+        approx_sample_size = 250; % number of MC scenarios fully revaluated
+        approx_error_limit = 0.05;% max. approximation error (rel. to max sample PnL)
+        use_pricing_grid = 0;     % grid based pricing of tree models in MC
+        pricing_grid_tolerance = 0.0001; % max. rel. interpolation error of grid
+        pricing_grid_max_nodes = 33;     % max. number of grid nodes per dimension
+        use_cf_cache_file = 0;    % persist cash flow schedule cache in static folder
+        use_vola_spread_cache_file = 0; % persist calibrated vola spreads in static folder
             
         % VAR specific variables
         mc = 50000;
@@ -103,6 +121,7 @@ classdef Parameter
         aggregation_key = {'asset_class','currency','id'};
         mc_timestep = '';
         mc_timestep_days = 0;
+        mc_path_timesteps = {};   % intermediate MC path steps (Brownian bridge), e.g. {'10d','60d'}
         scenario_set = {'stress'};
         tax_rate = 0.0;
 
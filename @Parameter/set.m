@@ -44,6 +44,8 @@ function obj = set(obj, varargin)
                 'use_parallel_pkg', 'boolean', ...
                 'number_parallel_cores', 'numeric', ...
                 'calc_marg_incr_var', 'boolean', ...
+                'calc_evt_var', 'boolean', ...
+                'evt_tail_fraction', 'numeric', ...
                 'stable_seed', 'boolean', ...
                 'mc_scen_analysis', 'boolean', ...
                 'aggregation_flag', 'boolean', ...
@@ -69,9 +71,26 @@ function obj = set(obj, varargin)
                 'mc_timestep', 'char' , ... 
                 'mc_timestep_days', 'numeric' , ... 
                 'scenario_set', 'cell' , ... 
+                'mc_path_timesteps', 'cell' , ... 
                 'runcode', 'char' , ... 
                 'no_stresstests', 'numeric', ...
                 'frob_norm_limit', 'numeric', ...
+                'use_corr_factors', 'boolean', ...
+                'no_corr_factors', 'numeric', ...
+                'input_filename_corr_factors', 'char', ...
+                'marginal_distr_mode', 'char', ...
+                'use_curve_factors', 'boolean', ...
+                'curve_factor_tolerance', 'numeric', ...
+                'curve_max_factors', 'numeric', ...
+                'use_scenario_buffer', 'boolean', ...
+                'use_approx_valuation', 'boolean', ...
+                'approx_sample_size', 'numeric', ...
+                'approx_error_limit', 'numeric', ...
+                'use_pricing_grid', 'boolean', ...
+                'pricing_grid_tolerance', 'numeric', ...
+                'pricing_grid_max_nodes', 'numeric', ...
+                'use_cf_cache_file', 'boolean', ...
+                'use_vola_spread_cache_file', 'boolean', ...
                 'scen_number', 'numeric', ...
                 'tax_rate', 'numeric', ...
                 'filename_sobol_direction_number', 'char', ...
@@ -64,6 +64,9 @@ classdef Position
 		var99_abs      = 0;
 		var999_abs     = 0;
 		var9999_abs    = 0;
+		var_evt_abs    = 0; % VaR of GPD tail model (portfolio only)
+		expshortfall_evt_abs = 0; % ES of GPD tail model (portfolio only)
+		scenario_order = []; % scenario numbers sorted by P&L (portfolio only)
 		srri_pos = 0;	% srri class of position [1...7]
 		sri_pos = 0;	% sri class of position [1...7]
 		vola_pos_pa = 0; % annualized position volatility
@@ -318,6 +321,10 @@ classdef Position
             fprintf('kurtosis_shock: %3.2f \n',a.kurtosis_shock); 
             fprintf('expshortfall_abs@%2.1f%%: %12.2f \n',a.var_confidence*100,a.expshortfall_abs);
             fprintf('expshortfall_rel@%2.1f%%: %2.1f%% \n',a.var_confidence*100,a.expshortfall_rel*100);
+            if ( a.var_evt_abs ~= 0 )
+                fprintf('var_evt_abs@%2.1f%%: %12.2f %s\n',a.var_confidence*100,a.var_evt_abs,a.currency);
+                fprintf('expshortfall_evt_abs@%2.1f%%: %12.2f %s\n',a.var_confidence*100,a.expshortfall_evt_abs,a.currency);
+            end
             fprintf('varhd_abs_after_tax@%2.1f%%: %12.2f %s\n',a.var_confidence*100,a.varhd_abs_at,a.currency);
 			fprintf('varhd_rel_after_tax@%2.1f%%: %2.1f%% \n',a.var_confidence*100,a.varhd_rel_at*100);
 			fprintf('tax_benefit: %12.2f %s\n',a.tax_benefit,a.currency); 
@@ -85,6 +85,16 @@ function obj = calc_risk (obj, scen_set, instrument_struct, index_struct, para)
           % d) Calculate Expected Shortfall as average of losses in sorted profit and loss vector from [1:confi_scenario-1]:
           expshortfall_abs      = - mean(pnl_abs_sorted(1:confi_scenario-1));
           expshortfall_rel      = - expshortfall_abs ./ base_value;
+          
+          % e) Calculate VaR and ES of GPD tail model (threshold from sorted P&L)
+          var_evt_abs = 0.0;
+          expshortfall_evt_abs = 0.0;
+          if ( para.calc_evt_var == true )
+            evt_nu = max(round(para.evt_tail_fraction * no_scen),2);
+            [evt_chi evt_sigma evt_u] = calibrate_gpd_cpp(pnl_abs_sorted,evt_nu);
+            [var_evt_abs expshortfall_evt_abs] = get_gpd_var(evt_chi,evt_sigma, ...
+                                    evt_u,para.quantile,no_scen,evt_nu);
+          end
          
           % sum up position standalone VaRs and calculate decomp VaR
           var_positionsum = 0.0;
@@ -208,13 +218,19 @@ function obj = calc_risk (obj, scen_set, instrument_struct, index_struct, para)
 			tmp_aggr_key_name           = aggr_key_struct( jj ).key_name;
 			tmp_aggregation_mat         = [aggr_key_struct( jj ).aggregation_mat];
 			aggregation_standalone_shock = zeros(length(length(tmp_aggr_cell)),1);
+			tmp_sorted_aggr_mat         = sort(tmp_aggregation_mat);
 			for ii = 1 : 1 : length(tmp_aggr_cell)
 				tmp_aggr_key_value          = tmp_aggr_cell{ii};
-				tmp_sorted_aggr_mat         = sort(tmp_aggregation_mat(:,ii));  
-				tmp_standalone_aggr_key_var = abs(dot(hd_vec,tmp_sorted_aggr_mat));
+				tmp_standalone_aggr_key_var = abs(dot(hd_vec,tmp_sorted_aggr_mat(:,ii)));
 				aggregation_standalone_shock(ii)  = tmp_standalone_aggr_key_var;
 			end
 			aggr_key_struct( jj ).aggregation_standalone_shock = aggregation_standalone_shock;
+			% GPD tail model VaR of all aggregation key values in one batch
+			if ( para.calc_evt_var == true && ~isempty(tmp_sorted_aggr_mat) )
+				[evt_chi evt_sigma evt_u] = calibrate_gpd_cpp(tmp_sorted_aggr_mat,evt_nu);
+				aggr_key_struct( jj ).aggregation_standalone_evt_var = get_gpd_var( ...
+						evt_chi,evt_sigma,evt_u,para.quantile,no_scen,evt_nu)';
+			end
 		  end
           % store aggr_key_struct
           obj = obj.set('aggr_key_struct',aggr_key_struct);
@@ -424,6 +440,10 @@ function obj = calc_risk (obj, scen_set, instrument_struct, index_struct, para)
 			obj = obj.set('var99_abs',var99_abs);
 			obj = obj.set('var999_abs',var999_abs);
 			obj = obj.set('var9999_abs',var9999_abs);
+			obj = obj.set('var_evt_abs',var_evt_abs);
+			obj = obj.set('expshortfall_evt_abs',expshortfall_evt_abs);
+			% store sorted scenario order for what-if calculations
+			obj = obj.set('scenario_order',scen_order_shock);
 			% in any case store failed position cell
 			obj = obj.set('position_failed_cell',position_failed_cell);
 	    end
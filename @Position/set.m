@@ -59,6 +59,9 @@ function obj = set(obj, varargin)
                 'var99_abs', 'numeric' , ...
                 'var999_abs', 'numeric' , ...
                 'var9999_abs', 'numeric' , ...
+                'var_evt_abs', 'numeric' , ...
+                'expshortfall_evt_abs', 'numeric' , ...
+                'scenario_order', 'numeric' , ...
                 'srri_pos', 'numeric' , ...
                 'sri_pos', 'numeric' , ...
                 'vola_pos_pa', 'numeric' , ...
@@ -98,6 +98,7 @@ classdef Retail < Instrument
         cf_values_mc  = [];
         cf_values_stress = [];
         timestep_mc_cf = {};
+        cf_batch_scenarios = {};    % scenarios rolled out by rollout_retail_batch
         ytm = 0.0;
         soy = 0.0;      % spread over yield
         sub_type = 'SAVPLAN';
@@ -40,18 +40,13 @@ function obj = calc_key_rates(retail,valuation_date,discount_curve)
     key_rate_shock = obj.key_rate_shock;
     key_rate_width = obj.key_rate_width;    
     
-    % new discount curve
-    curve_keyrate_up = zeros(1,length(cf_dates));
-    curve_keyrate_down = zeros(1,length(cf_dates));
-    % vectors for key rate durations and convexities
-    key_rate_eff_dur = zeros(1,length(key_terms));
-    key_rate_mon_dur = zeros(1,length(key_terms));
-    key_rate_eff_convex = zeros(1,length(key_terms));
-    key_rate_mon_convex = zeros(1,length(key_terms));
+    % get discount curve rates at all cash flow dates (set up once)
+    [rates_cf weights_cf] = get_curve_weights(disc_nodes,disc_rates, ...
+                                            cf_dates,interp_discount);
+    disc_rate = rates_cf * weights_cf;
     
-    % loop through all key rates and set up a new curve for each key rate.
-    % calculate up and down values for each key rate with the new curve.
-    % the new curve consists of the discount curve and key rate specific shocks.
+    % set up triangular key rate shocks of all key rates at all cash flow dates
+    krs_rate = zeros(length(key_terms),length(cf_dates));
     for ii = 1:1:length(key_terms)
         key_term = key_terms(ii);
         % generate key rate shock curve
@@ -63,42 +58,34 @@ function obj = calc_key_rates(retail,valuation_date,discount_curve)
         else
             krs_rates = [0,key_rate_shock,0];
         end
-        for jj = 1:1:length(cf_dates)
-            cf_date = cf_dates(jj);
-            % generate new curve (sum of discount curve and key rate shock curve)
-            disc_rate = interpolate_curve(disc_nodes,disc_rates, ...
-                                            cf_date,interp_discount);
-            krs_rate = interpolate_curve(krs_terms,krs_rates, ...
-                                            cf_date,'linear');
-            % convert krs_rate convention (cont, act/365) to curve conv
-            key_rate_shock_conv = convert_curve_rates(valuation_date,cf_date, ...
-                        krs_rate,'continuous','annual',3, ...
-                        curve_comp_type,curve_comp_freq,curve_basis);   
-            % store rate in new curve
-            curve_keyrate_up(jj) = disc_rate + key_rate_shock_conv;
-            curve_keyrate_down(jj) = disc_rate - key_rate_shock_conv;
-        end
-        curve_keyrates = [curve_keyrate_down ; curve_keyrate_up];
-        % calc bond values under key rate up and down shocks
-        c = discount_curve.set('rates_stress',curve_keyrates,'nodes',cf_dates);  
-        obj_tmp = obj;
-        % set base CF values for evaluation of key rates
-        obj_tmp = obj_tmp.set('cf_values_stress',obj.getCF('base'));                         
-		obj_tmp = obj_tmp.calc_value(valuation_date,'stress',c);              
-		value_krs = obj_tmp.getValue('stress');                        
-        value_krs_down  = value_krs(1);
-        value_krs_up    = value_krs(2);
-        % calc key rate duration and convexity
-        key_rate_dur    = (value_krs_down - value_krs_up) ...
-                                ./ (2 * key_rate_shock * base_value);
-        key_rate_convex = (value_krs_down + value_krs_up - 2*base_value) ...
-                                ./ (key_rate_shock^2 * base_value);
-        % store in vectors
-        key_rate_eff_dur(ii) = key_rate_dur;
-        key_rate_mon_dur(ii) = key_rate_dur * base_value;
-        key_rate_eff_convex(ii) = key_rate_convex;
-        key_rate_mon_convex(ii) = key_rate_convex * base_value;
+        % linear interpolation with constant extrapolation
+        krs_rate(ii,:) = interp1(krs_terms,krs_rates, ...
+                    min(max(cf_dates,krs_terms(1)),krs_terms(end)),'linear');
     end
+    % convert krs_rate convention (cont, act/365) to curve conv
+    key_rate_shock_conv = convert_curve_rates(valuation_date,cf_dates, ...
+                        krs_rate,'continuous','annual',3, ...
+                        curve_comp_type,curve_comp_freq,curve_basis);
+    % new curves (sum of discount curve and key rate shock curves): 
+    % first all down shocks, then all up shocks
+    curve_keyrates = [disc_rate - key_rate_shock_conv ; disc_rate + key_rate_shock_conv];
+    
+    % calc values under all key rate up and down shocks in one call
+    c = discount_curve.set('rates_stress',curve_keyrates,'nodes',cf_dates);  
+    obj_tmp = obj;
+    % set base CF values for evaluation of key rates
+    obj_tmp = obj_tmp.set('cf_values_stress',obj.getCF('base'));                         
+    obj_tmp = obj_tmp.calc_value(valuation_date,'stress',c);              
+    value_krs = obj_tmp.getValue('stress')(:)';
+    value_krs_down  = value_krs(1:length(key_terms));
+    value_krs_up    = value_krs(length(key_terms)+1:end);
+    % calc key rate durations and convexities
+    key_rate_eff_dur    = (value_krs_down - value_krs_up) ...
+                            ./ (2 * key_rate_shock * base_value);
+    key_rate_eff_convex = (value_krs_down + value_krs_up - 2*base_value) ...
+                            ./ (key_rate_shock^2 * base_value);
+    key_rate_mon_dur    = key_rate_eff_dur .* base_value;
+    key_rate_mon_convex = key_rate_eff_convex .* base_value;
     
     % store key rates
     obj = obj.set('key_rate_eff_dur',key_rate_eff_dur);   
@@ -21,6 +21,7 @@ function obj = set(obj, varargin)
                 'timestep_mc', 'special' , ...
                 'liquidity_class', 'char' , ...
                 'timestep_mc_cf', 'special' , ...
+                'cf_batch_scenarios', 'cell' , ...
                 'name', 'char' , ...
                 'id', 'char' , ...
                 'issue_date', 'date' , ...
@@ -26,6 +26,8 @@ classdef Riskfactor
       shift_type = [];
       shocktype_mc = '';    % either relative or absolute
       timestep_mc = {};
+      scenario_path = [];   % path shock values (scenarios x path steps)
+      timestep_path = [];   % path steps in days
     end
  
    % Class methods
@@ -258,6 +260,9 @@ For index surfaces equals moneyness. Default: 0.0\n\
 MC rates for several MC timesteps are stored in layers.\n\
 @item @var{scenario_stress}: Vector with risk factor shock values. \n\
 @item @var{timestep_mc}: String Cell array with MC timesteps. Automatically appended if values for new timesteps are set.\n\
+@item @var{scenario_path}: Matrix with risk factor shock values of MC paths (scenarios x path steps).\n\
+Path steps are queried by getValue with the timestep string (e.g. \'10d\').\n\
+@item @var{timestep_path}: Vector with path steps in days.\n\
 \n\
 @item @var{shocktype_mc}: Specify how to apply risk factor shocks in Monte Carlo\n\
 scenarios. Can be [absolute, relative, sln_relative].\n\
@@ -9,7 +9,7 @@
 %# @itemize @bullet
 %# @item base: return base value
 %# @item stress: return stress values
-%# @item 1d: return MC timestep
+%# @item 1d: return MC timestep (or path step in days or years, e.g. 90d or 1y, if MC paths are available)
 %# @end itemize
 %# @seealso{Instrument}
 %# @end deftypefn
@@ -35,6 +35,10 @@ function s = getValue (riskfactor, property, abs_flag, sensitivity) % method get
         if ( sum(tmp_vec) > 0)                  
             tmp_col = tmp_vec * (1:length(tmp_vec))';
             s = obj.scenario_mc(:,tmp_col);    
+        elseif ( ~isempty(obj.timestep_path) ...
+                        && any(obj.timestep_path == get_timestep_days(property)) )
+            % intermediate step of MC path (days or years, e.g. '90d' or '1y')
+            s = obj.scenario_path(:,obj.timestep_path == get_timestep_days(property));
         else
             %printf ('get: invalid property %s. Neither stress nor MC timestep found. Returning base value.\n', property);
             s = obj.value_base; 
@@ -0,0 +1,26 @@
+%# -*- texinfo -*-
+%# @deftypefn  {Function File} {@var{path_timesteps} =} get_path_timesteps (@var{riskfactor})
+%# Riskfactor Method get_path_timesteps
+%# Return a cell with the intermediate MC path steps of the risk factor as 
+%# timestep strings in days (e.g. @{'90d','180d'@}). Path steps which coincide 
+%# with a MC timestep are omitted. The returned timesteps can be used as 
+%# additional MC timesteps of market objects derived from the risk factor 
+%# (see load_yieldcurves and update_mktdata_objects).
+%# @seealso{Riskfactor, get_timestep_days}
+%# @end deftypefn
+
+function path_timesteps = get_path_timesteps (riskfactor)
+  obj = riskfactor;
+  path_timesteps = {};
+  if ( isempty(obj.timestep_path) || isempty(obj.scenario_path) )
+    return;
+  end
+  % days of MC timesteps (e.g. final step of path)
+  mc_days = cellfun(@get_timestep_days,obj.timestep_mc);
+  for kk = 1 : 1 : numel(obj.timestep_path)
+    tmp_days = obj.timestep_path(kk);
+    if ( ~any(mc_days == tmp_days) )
+      path_timesteps{end + 1} = sprintf('%dd',tmp_days);
+    end
+  end
+end
@@ -6,6 +6,8 @@ function obj = set(obj, varargin)
                 'basis', 'numeric' , ...
                 'scenario_mc', 'special' , ...
                 'timestep_mc', 'special' , ...
+                'scenario_path', 'numeric' , ...
+                'timestep_path', 'numeric' , ...
                 'scenario_stress', 'special' , ...
                 'shift_type', 'numeric' , ...
                 'shocktype_mc', 'char', ...
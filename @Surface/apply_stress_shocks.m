@@ -7,59 +7,51 @@ function [surface] = apply_stress_shocks (surface, stress_struct)
     end
   
 % what is done here:
-% - loop through all provided stress scenarios and get stress shocks / values
-% - combine these shocks and store them in stress sub-structs 
+% - compile all stress scenarios into a sparse shock matrix (if not already done)
+% - initialize all stresses with base values and apply only the stress 
+%   shocks defined for this surface
 % - store these struct in the surface attribute "shock_struct" and return object
 
-surface_stress_struct = struct();
+stress_engine = compile_stresstests(stress_struct);
 
-% iterate via all stress definitions
-for ii = 1:1:length(stress_struct)
-    % get struct with all market object shocks
-    subst = stress_struct(ii).objects;
-    % get appropriate market object
-    [mktstruct retcode] = get_sub_struct(subst,surface.id);
-    if ( retcode == 1)  % market data is contained in stress
-        type        = mktstruct.type;
-        shock_type  = mktstruct.shock_type;
-        shock_value = mktstruct.shock_value;
+% all stresses without shock definition: apply base value
+template_struct = struct();
+template_struct.id = '';
+template_struct.axis_x = surface.axis_x;
+template_struct.axis_y = surface.axis_y;
+if ( strcmpi(surface.type,'IRVol'))
+    template_struct.axis_z = surface.axis_z;
+end
+template_struct.cube = surface.values_base;
+surface_stress_struct = repmat(template_struct,1,stress_engine.number_stresses);
+[surface_stress_struct.id] = deal(stress_engine.stress_ids{:});
 
-        % get base rates and nodes of curve
-        surface_stress_struct(ii).id   = stress_struct(ii).id;
-        surface_stress_struct(ii).axis_x = surface.axis_x;
-        surface_stress_struct(ii).axis_y = surface.axis_y;
-        if ( strcmpi(surface.type,'IRVol'))
-            surface_stress_struct(ii).axis_z = surface.axis_z;
-        end
-        values_base = surface.values_base;
-    
-        if (strcmpi(shock_type,'relative'))
-            values_stress  = values_base .* shock_value;
-        elseif (strcmpi(shock_type,'absolute'))
-            values_stress  = values_base + shock_value;
-        elseif (strcmpi(shock_type,'value'))
-            values_stress  = values_base;
-            % overwrite base scenario axis values with stress axis values
-            surface_stress_struct(ii).axis_x = mktstruct.axis_x
-            surface_stress_struct(ii).axis_y = mktstruct.axis_y;
-            if ( strcmpi(surface.type,'IRVol')) 
-                surface_stress_struct(ii).axis_z = mktstruct.axis_z;
-            end
-        else
-            error('return_stress_shocks: unknown stress shock type: >>%s<<\n',any2str(shock_type));
-        end
-        % set stress scenario cube values
-        surface_stress_struct(ii).cube = values_stress;
-    else
-        % apply base value
-        surface_stress_struct(ii).cube = surface.values_base;
-        surface_stress_struct(ii).id   = stress_struct(ii).id;
-        surface_stress_struct(ii).axis_x = surface.axis_x;
-        surface_stress_struct(ii).axis_y = surface.axis_y;
+% iterate via all stress definitions of surface
+[stress_idx shock_defs] = get_stress_shocks(stress_engine,surface.id);
+values_base = surface.values_base;
+for kk = 1:1:length(stress_idx)
+    ii = stress_idx(kk);
+    mktstruct   = shock_defs{kk};
+    shock_type  = mktstruct.shock_type;
+    shock_value = mktstruct.shock_value;
+
+    if (strcmpi(shock_type,'relative'))
+        values_stress  = values_base .* shock_value;
+    elseif (strcmpi(shock_type,'absolute'))
+        values_stress  = values_base + shock_value;
+    elseif (strcmpi(shock_type,'value'))
+        values_stress  = values_base;
+        % overwrite base scenario axis values with stress axis values
+        surface_stress_struct(ii).axis_x = mktstruct.axis_x;
+        surface_stress_struct(ii).axis_y = mktstruct.axis_y;
         if ( strcmpi(surface.type,'IRVol')) 
-            surface_stress_struct(ii).axis_z = surface.axis_z;
+            surface_stress_struct(ii).axis_z = mktstruct.axis_z;
         end
+    else
+        error('return_stress_shocks: unknown stress shock type: >>%s<<\n',any2str(shock_type));
     end
+    % set stress scenario cube values
+    surface_stress_struct(ii).cube = values_stress;
 end
 
 
@@ -187,8 +187,9 @@ Methods for Swaption object @var{obj}:\n\
 Calculate the value of Swaptions based on valuation date, scenario type, discount curve, underlying instruments and volatility surface.\n\
 The pricing model is chosen based on Swaption type and instrument model attributes.\n\
 \n\
-@item obj.calc_greeks(@var{valuation_date},@var{scenario}, @var{discount_curve}, @var{volatility_surface}, @var{underlying_fixed_leg}, @var{underlying_floating_leg})\n\
-Calculate numerical sensitivities (the Greeks) for the given Swaption instrument.\n\
+@item obj.calc_greeks(@var{valuation_date},@var{scenario}, @var{discount_curve}, @var{volatility_surface}, @var{underlying_fixed_leg}, @var{underlying_floating_leg}, @var{greeks_mode})\n\
+Calculate sensitivities (the Greeks) for the given Swaption instrument.\n\
+Swaptions priced with forward rates get analytic Greeks of the Black76 or Bachelier formula (@var{greeks_mode} 'analytic', default) or numerical Greeks by repricing with shocked input parameters (@var{greeks_mode} 'bump'). Swaptions priced with underlying legs always get numerical Greeks.\n\
 \n\
 @item obj.calc_vola_spread(@var{valuation_date},@var{scenario}, @var{discount_curve}, @var{volatility_surface}, @var{underlying_fixed_leg}, @var{underlying_floating_leg})\n\
 Calibrate volatility spread in order to match the Swaption price with the market price. The volatility spread will be used for further pricing.\n\
@@ -1,8 +1,17 @@
-function obj = calc_greeks(swaption,valuation_date,value_type,discount_curve,tmp_vola_surf_obj,leg_fixed_obj,leg_float_obj)
+function obj = calc_greeks(swaption,valuation_date,value_type,discount_curve,tmp_vola_surf_obj,leg_fixed_obj,leg_float_obj,greeks_mode)
     obj = swaption;
     if ( nargin < 4)
         error('Error: No  discount curve or vola surface set. Aborting.');
     end
+    % greeks of pricing with forward rates: 'analytic' (derivatives of Black76
+    % or Bachelier formula) or 'bump' (repricing with shocked input parameters,
+    % validation mode)
+    if ( nargin < 8)
+        greeks_mode = 'analytic';
+    end
+    if ~( strcmpi(greeks_mode,'analytic') || strcmpi(greeks_mode,'bump') )
+        error('Swaption.calc_greeks: unknown greeks_mode >>%s<<. Allowed values: analytic, bump',greeks_mode);
+    end
 
     % Get discount curve nodes and rate
         tmp_nodes        = discount_curve.nodes;
@@ -140,49 +149,61 @@ function obj = calc_greeks(swaption,valuation_date,value_type,discount_curve,tmp
             end 
             tmp_imp_vola_shock = tmp_vola_surf_obj.getValue(value_type, ...
                  xx,yy,tmp_moneyness) + tmp_impl_vola_spread;
+            if ( strcmpi(greeks_mode,'analytic'))
+                % analytic derivatives of Black76 or Bachelier formula
+                if ( regexpi(tmp_model,'black'))
+                    model_id = 1;
+                else
+                    model_id = 2;
+                end
+                [theo_value theo_delta theo_gamma theo_vega theo_theta theo_rho] = ...
+                            pricing_swaption_cpp(model_id,logical(call_flag), ...
+                                        tmp_forward_shock,tmp_strike,tmp_effdate, ...
+                                        tmp_rf_rate_conv,tmp_imp_vola_shock, ...
+                                        tmp_swap_no_pmt,tmp_swap_tenor,Annuity);
+            else
+                % calculate shock to Y_u:
+                dY_u = 0.01 * tmp_forward_shock;  
+                dVola = tmp_imp_vola_shock * 0.01;
             
-            % calculate shock to Y_u:
-            dY_u = 0.01 * tmp_forward_shock;  
-            dVola = tmp_imp_vola_shock * 0.01;
-            
-            % set up sensi scenario vector with shocks to all input parameter
-            tmp_forward_shock_vec   = [tmp_forward_shock.*ones(1,1); ...
-                                            tmp_forward_shock * 0.99; ...
-                                            tmp_forward_shock * 1.01; ...
-                                            tmp_forward_shock.*ones(6,1)];
-            rf_rate_conv_vec        = [tmp_rf_rate_conv.*ones(3,1); ...
-                                            tmp_rf_rate_conv - 0.01; ...
-                                            tmp_rf_rate_conv + 0.01; ...
-                                            tmp_rf_rate_conv.*ones(4,1)];
-            imp_vola_shock_vec      = [tmp_imp_vola_shock.*ones(5,1); ...
-                                            tmp_imp_vola_shock * 0.99; ...
-                                            tmp_imp_vola_shock * 1.01; ...
-                                            tmp_imp_vola_shock.*ones(2,1)];
-            tmp_effdate_vec         = [tmp_effdate.*ones(7,1); ...
-                                            tmp_effdate - 1; ...
-                                            tmp_effdate + 1];
-            sensi_vec               = ones(9,1);
+                % set up sensi scenario vector with shocks to all input parameter
+                tmp_forward_shock_vec   = [tmp_forward_shock.*ones(1,1); ...
+                                                tmp_forward_shock * 0.99; ...
+                                                tmp_forward_shock * 1.01; ...
+                                                tmp_forward_shock.*ones(6,1)];
+                rf_rate_conv_vec        = [tmp_rf_rate_conv.*ones(3,1); ...
+                                                tmp_rf_rate_conv - 0.01; ...
+                                                tmp_rf_rate_conv + 0.01; ...
+                                                tmp_rf_rate_conv.*ones(4,1)];
+                imp_vola_shock_vec      = [tmp_imp_vola_shock.*ones(5,1); ...
+                                                tmp_imp_vola_shock * 0.99; ...
+                                                tmp_imp_vola_shock * 1.01; ...
+                                                tmp_imp_vola_shock.*ones(2,1)];
+                tmp_effdate_vec         = [tmp_effdate.*ones(7,1); ...
+                                                tmp_effdate - 1; ...
+                                                tmp_effdate + 1];
+                sensi_vec               = ones(9,1);
         
-            if ( regexpi(tmp_model,'black'))
-                % calculating effective greeks -> imply from derivatives
-                sensi_vec = swaption_black76(call_flag,tmp_forward_shock_vec, ...
-                                        tmp_strike,tmp_effdate_vec,rf_rate_conv_vec, ...
-                                        imp_vola_shock_vec,tmp_swap_no_pmt, ...
-                                        tmp_swap_tenor);    
+                if ( regexpi(tmp_model,'black'))
+                    % calculating effective greeks -> imply from derivatives
+                    sensi_vec = swaption_black76(call_flag,tmp_forward_shock_vec, ...
+                                            tmp_strike,tmp_effdate_vec,rf_rate_conv_vec, ...
+                                            imp_vola_shock_vec,tmp_swap_no_pmt, ...
+                                            tmp_swap_tenor);    
                                                         
-            else % Bachelier formula
-                % normal volatilities
-                dVola = 0.01;
-                imp_vola_shock_vec      = [tmp_imp_vola_shock.*ones(5,1); ...
-                                            tmp_imp_vola_shock - dVola; ...
-                                            tmp_imp_vola_shock + dVola; ...
-                                            tmp_imp_vola_shock.*ones(2,1)];
+                else % Bachelier formula
+                    % normal volatilities
+                    dVola = 0.01;
+                    imp_vola_shock_vec      = [tmp_imp_vola_shock.*ones(5,1); ...
+                                                tmp_imp_vola_shock - dVola; ...
+                                                tmp_imp_vola_shock + dVola; ...
+                                                tmp_imp_vola_shock.*ones(2,1)];
 
-                sensi_vec = swaption_bachelier(call_flag,tmp_forward_shock_vec, ...
-                                        tmp_strike,tmp_effdate_vec,rf_rate_conv_vec, ...
-                                        imp_vola_shock_vec,tmp_swap_no_pmt, ...
-                                        tmp_swap_tenor);
+                    sensi_vec = swaption_bachelier(call_flag,tmp_forward_shock_vec, ...
+                                            tmp_strike,tmp_effdate_vec, ...
+                                            imp_vola_shock_vec,Annuity);
 
+                end
             end
             
         else    % pricing with underlying float and fixed leg
@@ -247,11 +268,13 @@ function obj = calc_greeks(swaption,valuation_date,value_type,discount_curve,tmp
         
         % calculate numeric derivatives
         %sensi_vec = [theo_value_base;undvalue_down;undvalue_up;rfrate_down;rfrate_up;vola_down;vola_up;time_down;time_up]
-        theo_delta  = (sensi_vec(3) - sensi_vec(2)) / (2 * dY_u);
-        theo_gamma  = (sensi_vec(3) + sensi_vec(2) - 2 * sensi_vec(1))  / (dY_u).^2;
-        theo_vega   = (sensi_vec(7) - sensi_vec(6))/ (200 * dVola);
-        theo_theta  = -(sensi_vec(9) - sensi_vec(8)) / 2;
-        theo_rho    = (sensi_vec(5) - sensi_vec(4)) / 2;
+        if ( obj.use_underlyings == true || strcmpi(greeks_mode,'bump'))
+            theo_delta  = (sensi_vec(3) - sensi_vec(2)) / (2 * dY_u);
+            theo_gamma  = (sensi_vec(3) + sensi_vec(2) - 2 * sensi_vec(1))  / (dY_u).^2;
+            theo_vega   = (sensi_vec(7) - sensi_vec(6))/ (200 * dVola);
+            theo_theta  = -(sensi_vec(9) - sensi_vec(8)) / 2;
+            theo_rho    = (sensi_vec(5) - sensi_vec(4)) / 2;
+        end
         
             
     end   % close loop if tmp_dtm < 0
@@ -70,37 +70,17 @@ function obj = calc_value(swaption,valuation_date,value_type,discount_curve,tmp_
         basis_curve         = discount_curve.basis;
         comp_freq_curve     = discount_curve.compounding_freq;
         
-        % apply floor at 0.00001 for forward rates
-        if ( regexpi(tmp_model,'black'))
-            floor_flag          = true;
-        else
-            floor_flag          = false;
-        end
-        % Get underlying yield rates:       
-        tmp_forward_shock       = get_forward_rate(tmp_nodes,tmp_rates, ...
-                                    tmp_effdate,tmp_dtm-tmp_effdate, comp_type, ...
-                                    interp_method, comp_freq, basis, valuation_date, ...
-                                    comp_type_curve, basis_curve, ...
-                                    comp_freq_curve, floor_flag);
-        
-                 
-        % alternative calculation: Annuity = Sum(DF_OptionTerm_SwaptionMaturity)
-        % (DF(SwaptionMaturity) - DF(OptionTerm))/Annuity
-        Annuity = zeros(rows(tmp_forward_shock),1);
-        for ii=2:1:length(annuity_dates)
-            tmp_date = annuity_dates(ii);
-            tmp_rate = interpolate_curve(tmp_nodes,tmp_rates,tmp_date,interp_method);
-            Annuity = Annuity + discount_factor(valuation_date, ...
-                                        valuation_date+tmp_date, ...
-                                        tmp_rate,comp_type, basis, comp_freq);
-        end
-        DF_effdate_rate = interpolate_curve(tmp_nodes,tmp_rates,annuity_dates(1),interp_method);
-        DF_matdate_rate = interpolate_curve(tmp_nodes,tmp_rates,annuity_dates(end),interp_method);
-        DF_effdate = discount_factor(valuation_date, valuation_date+tmp_effdate, ...
-                                        DF_effdate_rate,comp_type, basis, comp_freq);
-        DF_matdate = discount_factor(valuation_date, valuation_date+tmp_dtm, ...
-                                        DF_matdate_rate,comp_type, basis, comp_freq);
-        tmp_forward_shock = (DF_effdate - DF_matdate)./Annuity;
+        % Underlying forward swap rate via annuity:
+        % Annuity = Sum(DF_OptionTerm_SwaptionMaturity)
+        % (DF(OptionTerm) - DF(SwaptionMaturity))/Annuity
+        % interpolation weights of annuity schedule are set up once, discount
+        % factors of all scenarios are calculated in compiled function
+        [tmp_rates_annuity annuity_weights] = get_curve_weights(tmp_nodes, ...
+                                tmp_rates,annuity_dates,interp_method);
+        annuity_tf = timefactor(valuation_date, valuation_date + ...
+                                [tmp_effdate,annuity_dates(2:end)], basis);
+        [Annuity tmp_forward_shock] = swap_annuity_cpp(tmp_rates_annuity, ...
+                                annuity_weights,annuity_tf,comp_type,comp_freq,1);
         
         % determining volatility cube axis
         if ( regexpi(tmp_vola_surf_obj.axis_x_name,'TENOR')) % standard case
@@ -138,14 +118,14 @@ function obj = calc_value(swaption,valuation_date,value_type,discount_curve,tmp_
             %TODO: implementation for cont rates only, allow any forward rates
             if ( regexpi(tmp_model,'black'))
                 tmp_forward_shock = max(0.0001,tmp_forward_shock); %apply floor
-                theo_value      = swaption_black76(call_flag,tmp_forward_shock, ...
-                                        tmp_strike,tmp_effdate,tmp_rf_rate_conv, ...
-                                        tmp_imp_vola_shock,tmp_swap_no_pmt, ...
-                                        tmp_swap_tenor) .* tmp_multiplier;
+                theo_value      = pricing_swaption_cpp(1,logical(call_flag), ...
+                                        tmp_forward_shock,tmp_strike,tmp_effdate, ...
+                                        tmp_rf_rate_conv,tmp_imp_vola_shock, ...
+                                        tmp_swap_no_pmt,tmp_swap_tenor,0) .* tmp_multiplier;
             else
-                theo_value      = swaption_bachelier(call_flag,tmp_forward_shock, ...
-                                        tmp_strike,tmp_effdate, ...
-                                        tmp_imp_vola_shock,Annuity) .* tmp_multiplier;         
+                theo_value      = pricing_swaption_cpp(2,logical(call_flag), ...
+                                        tmp_forward_shock,tmp_strike,tmp_effdate, ...
+                                        0,tmp_imp_vola_shock,0,0,Annuity) .* tmp_multiplier;
             end
         else    % pricing with underlying float and fixed leg
             % make sure underlying objects are existing
@@ -0,0 +1,423 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{results} @var{regression}] =} benchmark_oct_files (@var{size_set}, @var{baseline_file}, @var{result_file}, @var{tolerance}, @var{kernels})
+%#
+%# Micro-benchmark suite for the compiled oct file kernels.
+%# All kernels are called with reproducible synthetic inputs for all
+%# combinations of scenario and node numbers of the given size set:
+%# @itemize @bullet
+%# @item quick: 1k scenarios, 10 nodes
+%# @item default: 1k and 50k scenarios, 10 and 50 nodes
+%# @item full: 1k, 50k and 1M scenarios, 10, 50 and 200 nodes
+%# @end itemize
+%# Kernels without node dimension are measured for the first node number only.
+%# Cases with scenario x node input matrices of more than 25e6 entries are skipped.
+%# Tree and lattice kernels (american pricing_option_cpp, pricing_willowtree_cpp)
+%# and the stress interpolation kernels interpolate_surfacestruct and 
+%# interpolate_cubestruct (one structure array entry per scenario) are 
+%# measured up to 50k scenarios only.
+%# Batch kernels without scenario dimension (key_rates_cpp, rollout_savings_cpp)
+%# are measured with one bond or savings contract per scenario.
+%# The following kernels are not covered by the suite: calc_vola_basket_cpp,
+%# calibrate_bond_yield_cpp, cf_dates_cpp, cms_convexity_cpp, forward_rate_cpp,
+%# nearest_correlation_cpp, scenario_buffer_cpp and timefactor_cpp.
+%# Each case is called once for warm up and then repeated until at least
+%# 0.2 seconds (maximum 25 repetitions) are measured. The median runtime per
+%# call, the runtime in ns per element, the throughput (elements per second)
+%# and the size of the memory allocated for the return values are reported.
+%# The results are written to @var{result_file} (csv format with header line).
+%# If a @var{baseline_file} (result file of a former run) is given, all cases
+%# are compared against the baseline and flagged as regression, if the runtime
+%# per element exceeds the baseline runtime by more than @var{tolerance}.
+%# Without @var{baseline_file} argument the reference baseline 
+%# static/benchmark_oct_files_baseline.csv of the working directory is used 
+%# (if existing), an empty string disables the comparison. If the baseline
+%# contains none of the measured cases, no baseline is reported instead of
+%# a regression check result. The reference 
+%# baseline is machine specific and has to be refreshed on the reference
+%# machine with benchmark_oct_files('default','',baseline_file).
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{size_set}: quick, default or full (optional, default: default)
+%# @item @var{baseline_file}: csv file with baseline results (optional, default: static/benchmark_oct_files_baseline.csv)
+%# @item @var{result_file}: csv file for benchmark results (optional)
+%# @item @var{tolerance}: relative tolerance for regression check (optional, default: 0.25)
+%# @item @var{kernels}: cell with kernel names to benchmark (optional, default: all)
+%# @item @var{results}: OUTPUT: structure array with benchmark results per case
+%# @item @var{regression}: OUTPUT: true, if any case exceeds the baseline
+%# @end itemize
+%# @seealso{test_oct_files, profiler_analysis}
+%# @end deftypefn
+
+function [results regression] = benchmark_oct_files(size_set, baseline_file, result_file, tolerance, kernels)
+
+if ( nargin < 1 || isempty(size_set) )
+    size_set = 'default';
+end
+if ( nargin < 2 )
+    % reference baseline
+    baseline_file = fullfile(pwd,'static','benchmark_oct_files_baseline.csv');
+    if ( exist(baseline_file,'file') ~= 2 )
+        baseline_file = '';
+    end
+end
+if ( nargin < 3 )
+    result_file = '';
+end
+if ( nargin < 4 || isempty(tolerance) )
+    tolerance = 0.25;
+end
+if ( nargin < 5 )
+    kernels = {};
+end
+
+switch ( lower(size_set) )
+  case 'quick'
+    scenario_vec = [1000];
+    node_vec = [10];
+  case 'default'
+    scenario_vec = [1000,50000];
+    node_vec = [10,50];
+  case 'full'
+    scenario_vec = [1000,50000,1000000];
+    node_vec = [10,50,200];
+  otherwise
+    error('benchmark_oct_files: unknown size set >>%s<<',size_set);
+end
+
+max_entries = 25e6;
+min_time = 0.2;
+max_repeats = 25;
+
+results = struct('kernel',{},'scenarios',{},'nodes',{},'elements',{}, ...
+                'repeats',{},'time_s',{},'ns_per_element',{},'throughput',{}, ...
+                'output_bytes',{},'baseline_ns',{},'ratio',{},'regression',{});
+fprintf('=== Running benchmarks for oct files (%s) ===\n',size_set);
+fprintf('%-32s | %8s | %5s | %10s | %12s | %12s | %12s\n','Kernel', ...
+        'Scen','Nodes','Time [ms]','ns / element','Elements / s','Output [B]');
+for mc = scenario_vec
+    for jj = 1 : 1 : length(node_vec)
+        no_nodes = node_vec(jj);
+        % kernels without node dimension for first node number only
+        bench_cases = get_benchmark_cases(mc,no_nodes,kernels,(jj == 1), ...
+                                                                max_entries);
+        for kk = 1 : 1 : length(bench_cases)
+            bc = bench_cases(kk);
+            % warm up (caches, lazy initialization)
+            retval = bc.fcall();
+            output_bytes = sizeof(retval);
+            clear retval;
+            runtime = [];
+            while ( sum(runtime) < min_time && length(runtime) < max_repeats )
+                tic;
+                retval = bc.fcall();
+                runtime(end+1) = toc;
+                clear retval;
+            end
+            tmp = struct();
+            tmp.kernel = bc.name;
+            tmp.scenarios = mc;
+            tmp.nodes = no_nodes * bc.uses_nodes;
+            tmp.elements = bc.elements;
+            tmp.repeats = length(runtime);
+            tmp.time_s = median(runtime);
+            tmp.ns_per_element = tmp.time_s ./ bc.elements .* 1e9;
+            tmp.throughput = bc.elements ./ max(tmp.time_s,eps);
+            tmp.output_bytes = output_bytes;
+            tmp.baseline_ns = NaN;
+            tmp.ratio = NaN;
+            tmp.regression = false;
+            results(end+1) = tmp;
+            fprintf('%-32s | %8d | %5d | %10.3f | %12.3f | %12.4g | %12d\n', ...
+                    tmp.kernel,tmp.scenarios,tmp.nodes,tmp.time_s * 1000, ...
+                    tmp.ns_per_element,tmp.throughput,tmp.output_bytes);
+        end
+    end
+end
+
+% compare against baseline
+regression = false;
+if ~( isempty(baseline_file) )
+    baseline = read_benchmark_file(baseline_file);
+    fprintf('=== Comparison with baseline %s (tolerance %2.1f%%) ===\n', ...
+                                                baseline_file,tolerance*100);
+    no_missing = 0;
+    for kk = 1 : 1 : length(results)
+        idx = find(strcmp(baseline.kernel,results(kk).kernel) ...
+                    & baseline.scenarios == results(kk).scenarios ...
+                    & baseline.nodes == results(kk).nodes, 1);
+        if ( isempty(idx) )
+            no_missing = no_missing + 1;
+            continue;
+        end
+        results(kk).baseline_ns = baseline.ns_per_element(idx);
+        results(kk).ratio = results(kk).ns_per_element ./ results(kk).baseline_ns;
+        results(kk).regression = ( results(kk).ratio > 1 + tolerance );
+        if ( results(kk).regression )
+            regression = true;
+            fprintf('REGRESSION: %s (%d scenarios, %d nodes): %9.3f ns / element vs. baseline %9.3f ns / element\n', ...
+                results(kk).kernel,results(kk).scenarios,results(kk).nodes, ...
+                results(kk).ns_per_element,results(kk).baseline_ns);
+        end
+    end
+    if ( no_missing == length(results) )
+        fprintf('WARNING: no baseline: %s contains none of the %d cases. Regression check skipped.\n', ...
+                                                baseline_file,length(results));
+    else
+        if ( no_missing > 0 )
+            fprintf('WARNING: no baseline results for %d of %d cases.\n', ...
+                                                no_missing,length(results));
+        end
+        if ( regression == false )
+            fprintf('No regression found.\n');
+        end
+    end
+end
+
+% write machine-readable results
+if ~( isempty(result_file) )
+    fid = fopen(result_file,'w');
+    if ( fid < 0 )
+        error('benchmark_oct_files: cannot open result file >>%s<<',result_file);
+    end
+    fprintf(fid,'kernel,scenarios,nodes,elements,repeats,time_s,ns_per_element,throughput,output_bytes\n');
+    for kk = 1 : 1 : length(results)
+        fprintf(fid,'%s,%d,%d,%d,%d,%.9g,%.9g,%.9g,%d\n',results(kk).kernel, ...
+            results(kk).scenarios,results(kk).nodes,results(kk).elements, ...
+            results(kk).repeats,results(kk).time_s,results(kk).ns_per_element, ...
+            results(kk).throughput,results(kk).output_bytes);
+    end
+    fclose(fid);
+end
+
+end
+
+% ##################    Helper Functions    ################
+
+function bench_cases = get_benchmark_cases(mc,no_nodes,kernels,scalar_cases,max_entries)
+% define all kernels with reproducible synthetic inputs
+    rand('state',0);
+    randn('state',0);
+    bench_cases = struct('name',{},'fcall',{},'elements',{},'uses_nodes',{});
+    % kernels with scenario x node input matrices
+    if ( mc * no_nodes <= max_entries )
+        nodes = round(linspace(30,10950,no_nodes));
+        rates = 0.01 + 0.02 .* nodes ./ 10950 + 0.005 .* randn(mc,1);
+        cf_values = repmat(3,mc,no_nodes);
+        df = exp(-rates .* nodes ./ 365);
+        timesteps = round(linspace(60,10000,10));
+        bench_cases(end+1) = set_case('calculate_npv_cpp', ...
+                @() calculate_npv_cpp(cf_values,df),mc * no_nodes,true);
+        bench_cases(end+1) = set_case('interpolate_curve_vectorized', ...
+                @() interpolate_curve_vectorized(nodes,rates,timesteps), ...
+                mc * length(timesteps),true);
+        bench_cases(end+1) = set_case('interpolate_curve_vectorized_mc', ...
+                @() interpolate_curve_vectorized_mc(nodes,rates,3000),mc,true);
+        rf_para = repmat([1,0.0001,0.2,0,0,0;4,0,0.01,0.02,0.03,0.1], ...
+                                                    ceil(no_nodes/2),1);
+        rf_para = rf_para(1:no_nodes,:);
+        Y = randn(mc,no_nodes);
+        bench_cases(end+1) = set_case('riskfactor_scenarios_cpp', ...
+                @() riskfactor_scenarios_cpp(Y,rf_para,250),mc * no_nodes,true);
+        % quantile tables of t distributed marginals on normal score grid
+        z_grid = (-8:0.01:8)';
+        X_tab = repmat(z_grid .* (1 + 0.1 .* z_grid.^2),1,no_nodes);
+        U = rand(mc,no_nodes);
+        bench_cases(end+1) = set_case('pearson_marginal_cpp', ...
+                @() pearson_marginal_cpp(U,X_tab,-8,0.01),mc * no_nodes,true);
+        % schedule dates at all curve nodes (unit interpolation weights)
+        tf_nodes = nodes' ./ 365;
+        weights_nodes = eye(no_nodes);
+        bench_cases(end+1) = set_case('swap_annuity_cpp', ...
+                @() swap_annuity_cpp(rates,weights_nodes,tf_nodes,'cont',1,1), ...
+                mc * no_nodes,true);
+        age_cf = 66 + floor(nodes' ./ 365);
+        bench_cases(end+1) = set_case('rollout_retail_cpp', ...
+                @() rollout_retail_cpp(rates,weights_nodes,tf_nodes,'cont',1, ...
+                    repmat(1000,no_nodes,1),age_cf,0:1:120,repmat(0.99,1,121),65), ...
+                mc * no_nodes,true);
+        pp_outstanding = linspace(100,100 / no_nodes,no_nodes);
+        bench_cases(end+1) = set_case('rollout_prepayment_cpp', ...
+                @() rollout_prepayment_cpp(0,abs(rates),weights_nodes,1, ...
+                    tf_nodes','simple',1,repmat(100 / no_nodes,1,no_nodes), ...
+                    0.03 .* pp_outstanding,pp_outstanding),mc * no_nodes,true);
+        % one bond with 10 cash flows per scenario, one key term per node
+        cf_days = repmat(round(linspace(365,10950,10))',mc,1);
+        kr_row_ptr = (0:10:10 * mc)';
+        kr_rates = 0.01 + 0.002 .* randn(10 * mc,1);
+        bench_cases(end+1) = set_case('key_rates_cpp', ...
+                @() key_rates_cpp(kr_row_ptr,cf_days,repmat(3,10 * mc,1), ...
+                    kr_rates,zeros(10 * mc,1),cf_days ./ 365,cf_days ./ 365, ...
+                    'cont',1,nodes',0.01,365),10 * mc * no_nodes,true);
+        % one curve per scenario (structure array)
+        curve_struct = struct('id',num2cell(1:mc),'cube',{rates(1,:)}, ...
+                                                        'axis_x',{nodes});
+        bench_cases(end+1) = set_case('interpolate_curvestruct', ...
+                @() interpolate_curvestruct(curve_struct,3000 + 1000 .* rand(mc,1)), ...
+                mc,true);
+    end
+    % kernels with scenario vector input
+    if ( scalar_cases == true )
+        S = 100 .* exp(0.2 .* randn(mc,1));
+        x_unit = rand(mc,1);
+        bench_cases(end+1) = set_case('pricing_option_cpp (european)', ...
+                @() pricing_option_cpp(1,true,S,100,365,0.01,0.25,0.0),mc,false);
+        % binomial tree: 1M scenarios take too long
+        if ( mc <= 50000 )
+            bench_cases(end+1) = set_case('pricing_option_cpp (american)', ...
+                @() pricing_option_cpp(2,false,S,100,365,0.01,0.25,0.0,100),mc,false);
+        end
+        bench_cases(end+1) = set_case('pricing_swaption_cpp', ...
+                @() pricing_swaption_cpp(1,true,0.0006 .* S,0.062,1825,0.06, ...
+                                                    0.2,2,3,0),mc,false);
+        bench_cases(end+1) = set_case('betainc_lentz_vec', ...
+                @() betainc_lentz_vec(x_unit,2.5,3.5),mc,false);
+        bench_cases(end+1) = set_case('gammainc_lentz_vec', ...
+                @() gammainc_lentz_vec(1 + 5 .* x_unit,2.5),mc,false);
+        w = [0.3,0.3,0.4];
+        S_basket = 100 .* exp(0.2 .* randn(mc,3));
+        sigma_basket = repmat([0.2,0.25,0.3],mc,1);
+        r_basket = repmat([0.8,0.85,0.9],mc,1);
+        bench_cases(end+1) = set_case('optimize_basket_forwardprice', ...
+                @() optimize_basket_forwardprice(w,S_basket,0.01,r_basket, ...
+                        sigma_basket,1,100,0,1,300,sqrt(eps)),mc,false);
+        if ( mc <= 50000 )
+            bench_cases(end+1) = set_case('pricing_willowtree_cpp', ...
+                @() pricing_willowtree_cpp(true,true,S,100,365,0.01,0.25,0.0,5,20), ...
+                mc,false);
+            % one volatility surface / cube per scenario (stress structure array)
+            axis_x = [30,91,182,365,730,1095,1825,3650];
+            axis_y = linspace(0.5,1.5,9);
+            axis_z = [365,730,1825,3650,7300];
+            vola_struct = struct('id',num2cell(1:mc), ...
+                    'cube',{0.2 + 0.05 .* rand(9,8)},'axis_x',{axis_x}, ...
+                    'axis_y',{axis_y});
+            bench_cases(end+1) = set_case('interpolate_surfacestruct', ...
+                @() interpolate_surfacestruct(vola_struct,500,0.5 + rand(mc,1)), ...
+                mc,false);
+            vola_struct = struct('id',num2cell(1:mc), ...
+                    'cube',{0.2 + 0.05 .* rand(9,8,5)},'axis_x',{axis_x}, ...
+                    'axis_y',{axis_y},'axis_z',{axis_z});
+            bench_cases(end+1) = set_case('interpolate_cubestruct', ...
+                @() interpolate_cubestruct(vola_struct,500,0.9,400 + 7000 .* rand(mc,1)), ...
+                mc,false);
+        end
+        % Hull-White tree: callable 5Y bond with annual coupons, call in 3Y
+        R_matrix = 0.01 + 0.002 .* randn(mc,1) + repmat(0.002 .* (1:6),mc,1);
+        tree_cf = repmat([3,3,3,3,103],mc,1);
+        accr_int = repmat(3,mc,5);
+        sigma_hw = repmat(0.01,mc,1);
+        bench_cases(end+1) = set_case('pricing_callable_bond_cpp', ...
+                @() pricing_callable_bond_cpp(true,5,5,0.1,sigma_hw,365 .* (1:5), ...
+                    tree_cf,R_matrix,ones(1,6),1:6,100,3,100,accr_int,false),mc,false);
+        % human capital: mc simulations of 10 yearly income cash flows
+        bench_cases(end+1) = set_case('pricing_humancapital_cpp', ...
+                @() pricing_humancapital_cpp(80000,20000,ones(1,10),365 .* (1:10), ...
+                    linspace(0.005,0.02,10),0.02,0.2,0.9,0.005,0.02,-0.2,0.1,-0.5, ...
+                    mc,linspace(0.999,0.95,10),repmat(0.02,1,10)),10 * mc,false);
+        % one savings contract with 12 monthly payments per scenario
+        sav_row_ptr = (0:12:12 * mc)';
+        tf_sav = repmat((12:-1:1)' ./ 12,mc,1);
+        bench_cases(end+1) = set_case('rollout_savings_cpp', ...
+                @() rollout_savings_cpp(sav_row_ptr,repmat(100,12 * mc,1), ...
+                    tf_sav + 5,tf_sav,0.02 + 0.01 .* x_unit,2,1,0.1,0.05), ...
+                12 * mc,false);
+        pnl_sorted = sort(1000 .* randn(mc,1));
+        bench_cases(end+1) = set_case('calibrate_gpd_cpp', ...
+                @() calibrate_gpd_cpp(pnl_sorted,max(round(0.025 * mc),2)),mc,false);
+        direction_file = fullfile(pwd,'static','joe-kuo-old.1111');
+        if ( exist(direction_file,'file') == 2 )
+            bench_cases(end+1) = set_case('calc_sobol_cpp', ...
+                @() calc_sobol_cpp(mc,10,direction_file),10 * mc,false);
+        end
+    end
+
+    % restrict to given kernels
+    if ~( isempty(kernels) )
+        kernel_names = regexprep({bench_cases.name},' \(.*\)$','');
+        bench_cases = bench_cases(ismember(kernel_names,kernels));
+    end
+end
+
+function bc = set_case(name,fcall,elements,uses_nodes)
+    bc = struct('name',name,'fcall',fcall,'elements',elements, ...
+                                                'uses_nodes',uses_nodes);
+end
+
+function baseline = read_benchmark_file(filename)
+% read kernel name, scenarios, nodes and ns per element from result file
+    fid = fopen(filename,'r');
+    if ( fid < 0 )
+        error('benchmark_oct_files: cannot open baseline file >>%s<<',filename);
+    end
+    baseline = struct('kernel',{cell(1,0)},'scenarios',zeros(1,0), ...
+                        'nodes',zeros(1,0),'ns_per_element',zeros(1,0));
+    fgetl(fid); % header
+    tline = fgetl(fid);
+    while ischar(tline)
+        tmp = strsplit(tline,',');
+        if ( length(tmp) >= 7 )
+            baseline.kernel{end+1} = tmp{1};
+            baseline.scenarios(end+1) = str2double(tmp{2});
+            baseline.nodes(end+1) = str2double(tmp{3});
+            baseline.ns_per_element(end+1) = str2double(tmp{7});
+        end
+        tline = fgetl(fid);
+    end
+    fclose(fid);
+end
+
+%!test
+%! result_file = [tempname(),'.csv'];
+%! [results regression] = benchmark_oct_files('quick','',result_file,0.25, ...
+%!                          {'calculate_npv_cpp','interpolate_curve_vectorized_mc'});
+%! assert(length(results),2)
+%! assert({results.kernel},{'calculate_npv_cpp','interpolate_curve_vectorized_mc'})
+%! assert([results.elements],[10000,1000])
+%! assert([results.output_bytes],[8000,8000])
+%! assert(all([results.ns_per_element] > 0))
+%! assert(regression,false)
+%! % artificial baseline with ten times faster kernels
+%! baseline_file = [tempname(),'.csv'];
+%! fid = fopen(baseline_file,'w');
+%! fprintf(fid,'kernel,scenarios,nodes,elements,repeats,time_s,ns_per_element,throughput,output_bytes\n');
+%! fprintf(fid,'calculate_npv_cpp,1000,10,10000,1,0,%.9g,0,8000\n',results(1).ns_per_element / 10);
+%! fclose(fid);
+%! [results regression] = benchmark_oct_files('quick',baseline_file,'',0.25, ...
+%!                          {'calculate_npv_cpp','interpolate_curve_vectorized_mc'});
+%! assert(regression,true)
+%! assert([results.regression],[true,false])
+%! assert(isnan(results(2).baseline_ns))
+%! % result file as baseline
+%! [results regression] = benchmark_oct_files('quick',result_file,'',Inf, ...
+%!                          {'calculate_npv_cpp'});
+%! assert(regression,false)
+%! assert(results(1).baseline_ns > 0)
+%! % baseline without measured cases (header only)
+%! fid = fopen(baseline_file,'w');
+%! fprintf(fid,'kernel,scenarios,nodes,elements,repeats,time_s,ns_per_element,throughput,output_bytes\n');
+%! fclose(fid);
+%! [results regression] = benchmark_oct_files('quick',baseline_file,'',0.25, ...
+%!                          {'calculate_npv_cpp'});
+%! assert(regression,false)
+%! assert(isnan(results(1).baseline_ns))
+%! % all kernels of batch routines
+%! new_kernels = {'pearson_marginal_cpp','swap_annuity_cpp','rollout_retail_cpp', ...
+%!          'rollout_prepayment_cpp','key_rates_cpp','rollout_savings_cpp'};
+%! results = benchmark_oct_files('quick','','',0.25,new_kernels);
+%! assert(sort({results.kernel}),sort(new_kernels))
+%! assert(all([results.ns_per_element] > 0))
+%! delete(result_file);
+%! delete(baseline_file);
@@ -12,6 +12,10 @@
 %# -*- texinfo -*-
 %# @deftypefn {Function File} {[@var{retcode} @var{rlzd_corr} @var{diff_corr}]=} calc_rlzd_corr (@var{riskfactor_cell}, @var{riskfactor_struct}, @var{corr_target}, @var{para_object}, @var{mc_timestep}, @var{path_reports}, @var{plot_flag})
 %# Calculate correlation matrix and call plotting function for realized risk factor correlations. Optional (false): plot_flag.
+%# The target correlation @var{corr_target} is either a correlation matrix or a
+%# struct with factor loadings L and idiosyncratic volatilities D of a factor
+%# model. For factor models, only the target correlations of the first 500 risk
+%# factors are set up and compared (the full matrix is never set up).
 %#
 %# @seealso{plot_corr_matrix}
 %# @end deftypefn
@@ -30,6 +34,15 @@ if numel(riskfactor_cell) < 1
 	error('plot_rlzd_corr: no risk factors contained in riskfactor_cell\n');
 end
 
+% factor model: target correlations of subset of risk factors only
+if isstruct(corr_target)
+	idx_test = 1:min(numel(riskfactor_cell),500);
+	riskfactor_cell = riskfactor_cell(idx_test);
+	L = corr_target.L(idx_test,:);
+	D = corr_target.D(:);
+	corr_target = L * L' + diag(D(idx_test).^2);
+end
+
 rlzd_mc_values = zeros(para_object.mc,numel(riskfactor_cell));
 
 for ii = 1 : 1 : length(riskfactor_cell)
@@ -68,6 +81,8 @@ if rx != tx || ry != ty
 end
 corr_target = corr_target .* 100;
 diff_corr = rlzd_corr - corr_target;
+fprintf('calc_rlzd_corr: Max. absolute difference between realized and target correlations: %2.2f%%. Frobenius norm: %2.2f%%\n', ...
+				max(abs(diff_corr(:))),norm(diff_corr,'fro'));
 
 
 % plotting
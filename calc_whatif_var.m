@@ -0,0 +1,119 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {@var{whatif} =} calc_whatif_var (@var{whatif_engine}, @var{pnl_trade}, @var{var_limit})
+%#
+%# Calculate the portfolio VaR and ES after adding new trades, the incremental
+%# VaR and the marginal (Euler) VaR contribution of each trade without full
+%# re-aggregation and re-sorting of the portfolio P&L.
+%# Each column of @var{pnl_trade} contains the scenario P&L of one trade
+%# (valued alone in portfolio currency). The new portfolio P&L differs from the
+%# current P&L by at most m = max(abs(pnl_trade)) per scenario, therefore all
+%# scenarios among the required smallest ranks of the new P&L are found within
+%# the current sorted P&L below the threshold pnl_sorted(no_ranks) + 2 * m.
+%# Only these candidate scenarios are evaluated and sorted, which are a small
+%# fraction of all scenarios for trades small relative to the portfolio.
+%# The engine is not changed: accepted trades are added to the portfolio with
+%# whatif_commit_trade before the next what-if calculation.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{whatif_engine}: what-if engine (see compile_whatif_engine)
+%# @item @var{pnl_trade}: scenario P&L of new trades (scenarios x trades)
+%# @item @var{var_limit}: VaR limit for pre-trade limit check (optional, default Inf)
+%# @item @var{whatif}: RETURN: structure with fields (one value per trade)
+%# @itemize @bullet
+%# @item varhd_abs: new portfolio VaR (quantile estimator)
+%# @item var_abs: new portfolio VaR (confidence scenario)
+%# @item expshortfall_abs: new portfolio expected shortfall
+%# @item incr_var: incremental VaR (new portfolio VaR - current portfolio VaR)
+%# @item decomp_var: marginal VaR contribution of trade in new portfolio
+%# @item limit_breach: true, if new portfolio VaR exceeds @var{var_limit}
+%# @item no_candidates: number of evaluated candidate scenarios
+%# @end itemize
+%# @end itemize
+%# @seealso{compile_whatif_engine, whatif_commit_trade}
+%# @end deftypefn
+
+function whatif = calc_whatif_var(whatif_engine, pnl_trade, var_limit)
+
+if ( nargin < 2 || nargin > 3 )
+    print_usage();
+end
+if ( nargin < 3 )
+    var_limit = Inf;
+end
+if ( rows(pnl_trade) ~= length(whatif_engine.pnl) )
+    error('calc_whatif_var: trade P&L has %d scenarios, portfolio P&L %d', ...
+                            rows(pnl_trade),length(whatif_engine.pnl));
+end
+
+no_trades = columns(pnl_trade);
+no_ranks = whatif_engine.no_ranks;
+confi_scenario = whatif_engine.confi_scenario;
+whatif = struct();
+whatif.varhd_abs = zeros(1,no_trades);
+whatif.var_abs = zeros(1,no_trades);
+whatif.expshortfall_abs = zeros(1,no_trades);
+whatif.decomp_var = zeros(1,no_trades);
+whatif.no_candidates = zeros(1,no_trades);
+
+for jj = 1 : 1 : no_trades
+    trade = pnl_trade(:,jj);
+    % candidate scenarios from current sorted P&L (binary search)
+    threshold = whatif_engine.pnl_sorted(no_ranks) + 2 * max(abs(trade));
+    no_cand = max(lookup(whatif_engine.pnl_sorted,threshold),no_ranks);
+    cand = whatif_engine.scen_order(1:no_cand);
+    [pnl_new idx] = sort(whatif_engine.pnl(cand) + trade(cand));
+    pnl_new = pnl_new(1:no_ranks);
+    cand = cand(idx(1:no_ranks));
+    % risk figures of new portfolio
+    whatif.varhd_abs(jj) = - dot(whatif_engine.hd_vec,pnl_new);
+    whatif.var_abs(jj) = - pnl_new(confi_scenario);
+    whatif.expshortfall_abs(jj) = - mean(pnl_new(1:confi_scenario-1));
+    whatif.decomp_var(jj) = - dot(whatif_engine.hd_vec,trade(cand));
+    whatif.no_candidates(jj) = no_cand;
+end
+whatif.incr_var = whatif.varhd_abs - whatif_engine.varhd_abs;
+whatif.limit_breach = whatif.varhd_abs > var_limit;
+
+end
+
+%!test
+%! randn('state',42);
+%! pnl = 1000 * randn(5000,1);
+%! para = struct('quantile',0.99,'quantile_estimator','hd','quantile_bandwidth',50);
+%! whatif_engine = compile_whatif_engine(pnl,para);
+%! trades = [50 * randn(5000,1), -0.5 * pnl, zeros(5000,1)];
+%! whatif = calc_whatif_var(whatif_engine,trades,2000);
+%! hd_vec = get_quantile_estimator('hd',5000,1:5000,0.01,50);
+%! for jj = 1 : 1 : 3
+%!   pnl_sorted = sort(pnl + trades(:,jj));
+%!   assert(whatif.varhd_abs(jj),-dot(hd_vec,pnl_sorted),1e-6)
+%!   assert(whatif.var_abs(jj),-pnl_sorted(50))
+%!   assert(whatif.expshortfall_abs(jj),-mean(pnl_sorted(1:49)),1e-6)
+%! end
+%! assert(whatif.incr_var,whatif.varhd_abs - whatif_engine.varhd_abs,1e-6)
+%! assert(whatif.incr_var(3),0,1e-6)
+%! assert(whatif.decomp_var(3),0)
+%! assert(whatif.limit_breach,[true,false,true])
+%! assert(whatif.no_candidates(1) < 5000)
+%!test
+%! pnl = [-5;3;-10;1;-2;4;-1;2;0;-3];
+%! para = struct('quantile',0.8,'quantile_estimator','singular','quantile_bandwidth',0);
+%! whatif_engine = compile_whatif_engine(pnl,para);
+%! whatif = calc_whatif_var(whatif_engine,pnl);
+%! assert(whatif.varhd_abs,10)
+%! assert(whatif.decomp_var,5)
+%! assert(whatif.limit_breach,false)
+%!error calc_whatif_var(compile_whatif_engine([1;2;3],struct('quantile',0.5,'quantile_estimator','singular','quantile_bandwidth',0)),[1;2])
@@ -0,0 +1,172 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{x} @var{retcode} @var{iterations}] =} calibrate_bond_yields (@var{type}, @var{valuation_date}, @var{cf_dates}, @var{cf_values}, @var{value_dirty}, @var{rates}, @var{comp_type}, @var{basis}, @var{comp_freq})
+%#
+%# Calibrate yields to maturity or spreads over yield of many bonds at once.
+%# The cash flows of all bonds are packed in compressed sparse row format and
+%# solved in the compiled function calibrate_bond_yield_cpp by Newton
+%# iterations with analytic derivative (bisection fallback).
+%# @*
+%# Calibration types:
+%# @itemize @bullet
+%# @item 'ytm': yield to maturity (discrete annual compounding, act/365).
+%# Input parameters @var{rates}, @var{comp_type}, @var{basis} and
+%# @var{comp_freq} are ignored.
+%# @item 'soy': spread over yield (continuous, act/365). The spread is converted
+%# into the curve conventions @var{comp_type}, @var{basis} and @var{comp_freq}
+%# and added to the curve rates at all cash flow dates.
+%# @end itemize
+%# Variables:
+%# @itemize @bullet
+%# @item @var{type}: string: 'ytm' or 'soy'
+%# @item @var{valuation_date}: valuation date (datenum or string)
+%# @item @var{cf_dates}: cell with cash flow dates in days from valuation date
+%# per bond (or numeric vector for one bond)
+%# @item @var{cf_values}: cell with cash flow values per bond (or numeric vector
+%# for one bond)
+%# @item @var{value_dirty}: vector with dirty market values
+%# @item @var{rates}: cell with curve rates at cash flow dates per bond
+%# (or numeric vector for one bond)
+%# @item @var{comp_type}: curve compounding type (string or cell of strings)
+%# @item @var{basis}: curve day count basis (scalar, string, vector or cell)
+%# @item @var{comp_freq}: curve compounding frequency (scalar, string, vector or
+%# cell)
+%# @item @var{x}: OUTPUT: calibrated yields or spreads
+%# @item @var{retcode}: OUTPUT: 0 (success) or 255 (no solution)
+%# @item @var{iterations}: OUTPUT: number of solver iterations
+%# @end itemize
+%# @seealso{calibrate_bond_yield_cpp, calibrate_generic, convert_curve_rates}
+%# @end deftypefn
+
+function [x retcode iterations] = calibrate_bond_yields(type, valuation_date, ...
+                    cf_dates, cf_values, value_dirty, rates, comp_type, basis, comp_freq)
+
+if ( nargin < 5 )
+    print_usage();
+end
+if ischar(valuation_date)
+    valuation_date = datenum(valuation_date,1);
+end
+if ~( iscell(cf_dates) )
+    cf_dates = {cf_dates};
+end
+if ~( iscell(cf_values) )
+    cf_values = {cf_values};
+end
+value_dirty = value_dirty(:);
+no_bonds = length(value_dirty);
+if ( length(cf_dates) ~= no_bonds || length(cf_values) ~= no_bonds )
+    error('calibrate_bond_yields: cf_dates and cf_values need one entry per value');
+end
+
+% start parameter and bounds (as in calibrate_generic)
+x0 = 0.01;
+lb = -1;
+ub = 1;
+
+% pack cash flows in compressed sparse row format
+no_cf = cellfun(@numel,cf_dates(:));
+if ~( isequal(no_cf,cellfun(@numel,cf_values(:))) )
+    error('calibrate_bond_yields: number of cash flow dates and values differ');
+end
+row_ptr = [0;cumsum(no_cf)];
+packed_dates = zeros(row_ptr(end),1);
+packed_values = zeros(row_ptr(end),1);
+for ii = 1 : 1 : no_bonds
+    packed_dates(row_ptr(ii)+1:row_ptr(ii+1)) = cf_dates{ii}(:);
+    packed_values(row_ptr(ii)+1:row_ptr(ii+1)) = cf_values{ii}(:);
+end
+d2 = valuation_date + packed_dates;
+tf_spread = timefactor(valuation_date, d2, 3);
+
+if ( strcmpi(type,'ytm') )
+    mode = 0;
+    tf_curve = tf_spread;
+    packed_rates = zeros(row_ptr(end),1);
+    comp_type_num = 2;
+    comp_freq_num = 1;
+elseif ( strcmpi(type,'soy') )
+    if ( nargin < 9 )
+        error('calibrate_bond_yields: curve rates and conventions required for spread over yield');
+    end
+    mode = 1;
+    if ~( iscell(rates) )
+        rates = {rates};
+    end
+    packed_rates = zeros(row_ptr(end),1);
+    for ii = 1 : 1 : no_bonds
+        packed_rates(row_ptr(ii)+1:row_ptr(ii+1)) = rates{ii}(:);
+    end
+    comp_type_num = get_bond_conventions(comp_type,no_bonds,@(x) get_convention_num('compounding_type',x));
+    comp_freq_num = get_bond_conventions(comp_freq,no_bonds,@(x) get_convention_num('compounding_freq',x));
+    basis_num = get_bond_conventions(basis,no_bonds,@(x) get_convention_num('basis',x));
+    % time factors in curve basis (one call per basis)
+    basis_cf = zeros(row_ptr(end),1);
+    for ii = 1 : 1 : no_bonds
+        basis_cf(row_ptr(ii)+1:row_ptr(ii+1)) = basis_num(ii);
+    end
+    tf_curve = zeros(row_ptr(end),1);
+    for bb = unique(basis_cf)'
+        idx = basis_cf == bb;
+        tf_curve(idx) = timefactor(valuation_date, d2(idx), bb);
+    end
+else
+    error('calibrate_bond_yields: unknown type >>%s<<. Must be ytm or soy.',any2str(type));
+end
+
+[x retcode iterations] = calibrate_bond_yield_cpp(mode, row_ptr, packed_values, ...
+                tf_curve, tf_spread, packed_rates, comp_type_num, comp_freq_num, ...
+                value_dirty, x0, lb, ub);
+
+end
+
+% ------------------------------------------------------------------------------
+% helper functions
+function num = get_bond_conventions(conv,no_bonds,conv_func)
+    if ~( iscell(conv) )
+        if ( ischar(conv) || numel(conv) == 1 )
+            conv = {conv};
+        else
+            conv = num2cell(conv(:));
+        end
+    end
+    num = cellfun(conv_func,conv(:));
+    if ( length(num) == 1 )
+        num = repmat(num,no_bonds,1);
+    elseif ( length(num) ~= no_bonds )
+        error('calibrate_bond_yields: conventions need 1 or %d entries',no_bonds);
+    end
+end
+
+%!test
+%! cf_dates = {[365,730];[365];[182,365,547,730]};
+%! cf_values = {[5,105];[110];[2,2,2,102]};
+%! value = [100;100;101];
+%! [ytm retcode] = calibrate_bond_yields('ytm','31-Dec-2016',cf_dates,cf_values,value);
+%! assert(ytm(1:2),[0.05;0.10],0.0000001)
+%! assert(retcode,[0;0;0])
+%! df = discount_factor(736695,736695+cf_dates{3},ytm(3),'disc',3,'annual');
+%! assert(cf_values{3} * df',101,0.0000001)
+%!test
+%! cf_dates = {[365,730];[730]};
+%! cf_values = {[3,103];[100]};
+%! rates = {[0.01,0.02];[0.02]};
+%! value = [100;100*exp(-0.06)];
+%! [soy retcode] = calibrate_bond_yields('soy','31-Dec-2016',cf_dates,cf_values,value, ...
+%!                      rates,{'disc';'cont'},3,{'annual';1});
+%! assert(retcode,[0;0])
+%! assert(soy(2),0.01,0.0000001)
+%! x = convert_curve_rates(736695,cf_dates{1},soy(1),'continuous','annual',3,'disc','annual',3);
+%! df = discount_factor(736695,736695+cf_dates{1},rates{1}+x,'disc',3,'annual');
+%! assert(cf_values{1} * df',100,0.0000001)
@@ -0,0 +1,218 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{vola_spread} @var{retcode}] =} calibrate_vola_spread_batch (@var{model}, @var{p}, @var{market_value})
+%#
+%# Calibrate implied volatility spreads of many instruments simultaneously.
+%# Each instrument is one lane of the input vectors. All lanes are solved
+%# with vectorised Newton iterations using the analytic vega of the
+%# pricing model. Lanes without convergence are solved by vectorised
+%# bisection on a bracketing volatility interval.
+%# @*
+%# Supported pricing models (value times multiplier):
+%# @itemize @bullet
+%# @item 'bs': Black-Scholes (see option_bs): fields S, X, T, r, q
+%# @item 'black76': Black-76 swaption (see swaption_black76): fields F, X, T,
+%# r, m (number of payments per year), tau (swap tenor)
+%# @item 'bachelier': normal swaption (see swaption_bachelier): fields F, X, T,
+%# annuity
+%# @end itemize
+%# Variables:
+%# @itemize @bullet
+%# @item @var{model}: string or cell of strings with pricing model per lane
+%# @item @var{p}: structure with column vectors call_flag, sigma (volatility
+%# without spread), multi (multiplier), T (time in days, act/365) and the model
+%# specific fields. Unused fields can be omitted.
+%# @item @var{market_value}: column vector with market values
+%# @item @var{vola_spread}: OUTPUT: implied volatility spreads
+%# @item @var{retcode}: OUTPUT: 0 (success) or 255 (no solution, spread is 0)
+%# @end itemize
+%# @seealso{calibrate_generic, calibrate_vola_spreads, option_bs, swaption_black76, swaption_bachelier}
+%# @end deftypefn
+
+function [vola_spread retcode] = calibrate_vola_spread_batch(model, p, market_value)
+
+if ( nargin < 3 )
+    print_usage();
+end
+market_value = market_value(:);
+no_lanes = length(market_value);
+% fill all fields to lane length
+model_id = get_model_id(model,no_lanes);
+p = fill_lanes(p,no_lanes);
+
+vol_min = 0.0001;       % lower boundary of volatility (as in calc_vola_spread)
+tol = 1e-8 .* max(1,abs(market_value));
+max_iter = 50;
+
+% 1. vectorised Newton iterations
+vol = max(p.sigma,vol_min);
+converged = false(no_lanes,1);
+active = true(no_lanes,1);
+for iter = 1 : 1 : max_iter
+    [value vega] = price_lanes(model_id,p,vol,active);
+    diff_value = value - market_value;
+    converged(active) = abs(diff_value(active)) < tol(active);
+    active = active & ~converged;
+    % stop lanes without vega (Newton step not defined)
+    active = active & vega > eps & isfinite(diff_value);
+    if ~( any(active) )
+        break;
+    end
+    vol(active) = max(vol_min, vol(active) - diff_value(active) ./ vega(active));
+end
+
+% 2. bisection fallback for all non-converged lanes
+fallback = ~converged;
+if ( any(fallback) )
+    vol_lo = zeros(no_lanes,1) + vol_min;
+    vol_hi = max(2 .* p.sigma,1.0);
+    value_lo = price_lanes(model_id,p,vol_lo,fallback);
+    value_hi = price_lanes(model_id,p,vol_hi,fallback);
+    % expand upper boundary until market value is bracketed
+    for kk = 1 : 1 : 20
+        expand = fallback & value_hi < market_value;
+        if ~( any(expand) )
+            break;
+        end
+        vol_hi(expand) = 2 .* vol_hi(expand);
+        value_hi = price_lanes(model_id,p,vol_hi,expand);
+    end
+    bracketed = fallback & value_lo <= market_value & value_hi >= market_value;
+    for kk = 1 : 1 : 100
+        if ~( any(bracketed) )
+            break;
+        end
+        vol_mid = 0.5 .* (vol_lo + vol_hi);
+        value_mid = price_lanes(model_id,p,vol_mid,bracketed);
+        upper = bracketed & value_mid > market_value;
+        lower = bracketed & ~upper;
+        vol_hi(upper) = vol_mid(upper);
+        vol_lo(lower) = vol_mid(lower);
+        vol(bracketed) = vol_mid(bracketed);
+        converged(bracketed) = abs(value_mid(bracketed) - market_value(bracketed)) ...
+                                    < tol(bracketed);
+        bracketed = bracketed & ~converged;
+    end
+end
+
+% return spreads of converged lanes
+retcode = zeros(no_lanes,1);
+retcode(~converged) = 255;
+vola_spread = vol - p.sigma;
+vola_spread(~converged) = 0.0;
+
+end
+
+% ------------------------------------------------------------------------------
+% helper functions
+function model_id = get_model_id(model,no_lanes)
+    if ( ischar(model) )
+        model = repmat({model},no_lanes,1);
+    end
+    model_id = zeros(no_lanes,1);
+    model_id(strcmpi(model(:),'bs')) = 1;
+    model_id(strcmpi(model(:),'black76')) = 2;
+    model_id(strcmpi(model(:),'bachelier')) = 3;
+    if ( any(model_id == 0) )
+        error('calibrate_vola_spread_batch: unknown model >>%s<<. Must be bs, black76 or bachelier.', ...
+                    model{find(model_id == 0,1)});
+    end
+end
+
+function p = fill_lanes(p,no_lanes)
+    lane_fields = {'call_flag','sigma','multi','T','S','F','X','r','q','m','tau','annuity'};
+    for ii = 1 : 1 : length(lane_fields)
+        if ~( isfield(p,lane_fields{ii}) )
+            p.(lane_fields{ii}) = zeros(no_lanes,1);
+        elseif ( isscalar(p.(lane_fields{ii})) )
+            p.(lane_fields{ii}) = repmat(p.(lane_fields{ii}),no_lanes,1);
+        else
+            p.(lane_fields{ii}) = p.(lane_fields{ii})(:);
+        end
+    end
+end
+
+% values and analytic vega of all lanes (calculated for selected lanes only)
+function [value vega] = price_lanes(model_id,p,vol,sel)
+    value = zeros(length(vol),1);
+    vega = zeros(length(vol),1);
+    T = p.T ./ 365;
+    sqrt_T = sqrt(T);
+    eta = 2 .* (p.call_flag == 1) - 1;
+    % Black-Scholes
+    idx = sel & model_id == 1;
+    if ( any(idx) )
+        d1 = (log(p.S(idx) ./ p.X(idx)) + (p.r(idx) - p.q(idx) ...
+                + 0.5 .* vol(idx).^2) .* T(idx)) ./ (vol(idx) .* sqrt_T(idx));
+        d2 = d1 - vol(idx) .* sqrt_T(idx);
+        value(idx) = eta(idx) .* (exp(-p.q(idx) .* T(idx)) .* p.S(idx) ...
+                    .* normcdf_fast(eta(idx) .* d1) - p.X(idx) ...
+                    .* exp(-p.r(idx) .* T(idx)) .* normcdf_fast(eta(idx) .* d2)) ...
+                    .* p.multi(idx);
+        vega(idx) = exp(-p.q(idx) .* T(idx)) .* p.S(idx) .* normpdf_fast(d1) ...
+                    .* sqrt_T(idx) .* p.multi(idx);
+    end
+    % Black-76 swaption
+    idx = sel & model_id == 2;
+    if ( any(idx) )
+        F = p.F(idx);
+        d1 = (log(F ./ p.X(idx)) + (0.5 .* vol(idx).^2) .* T(idx)) ...
+                ./ (vol(idx) .* sqrt_T(idx));
+        d2 = d1 - vol(idx) .* sqrt_T(idx);
+        annuity = (1 - (1 ./ ((1 + F ./ p.m(idx)) .^ (p.tau(idx) .* p.m(idx))))) ./ F;
+        scaling = exp(-p.r(idx) .* T(idx)) .* annuity .* p.multi(idx);
+        value(idx) = eta(idx) .* (F .* normcdf_fast(eta(idx) .* d1) ...
+                    - p.X(idx) .* normcdf_fast(eta(idx) .* d2)) .* scaling;
+        vega(idx) = F .* normpdf_fast(d1) .* sqrt_T(idx) .* scaling;
+    end
+    % Bachelier swaption
+    idx = sel & model_id == 3;
+    if ( any(idx) )
+        d1 = (p.F(idx) - p.X(idx)) ./ (vol(idx) .* sqrt_T(idx));
+        scaling = sqrt_T(idx) .* p.annuity(idx) .* p.multi(idx);
+        value(idx) = vol(idx) .* scaling .* (eta(idx) .* d1 ...
+                    .* normcdf_fast(eta(idx) .* d1) + normpdf_fast(d1));
+        vega(idx) = scaling .* normpdf_fast(d1);
+    end
+end
+
+function y = normcdf_fast(x)
+    y = 0.5 .* (1 + erf(x ./ sqrt(2)));
+end
+
+function y = normpdf_fast(x)
+    y = exp(-x.^2 ./ 2) ./ sqrt(2*pi);
+end
+
+%!test
+%! value = option_bs(1,100,[90;100;110],365,0.01,[0.15;0.2;0.25],0.02) .* 2;
+%! p = struct('call_flag',1,'S',100,'X',[90;100;110],'T',365,'r',0.01,'q',0.02,'multi',2,'sigma',0.2);
+%! [spread retcode] = calibrate_vola_spread_batch('bs',p,value);
+%! assert(spread,[-0.05;0.0;0.05],0.0000001)
+%! assert(retcode,[0;0;0])
+%!test
+%! v1 = swaption_black76(1,0.0609090679070339,0.062,1825,0.06,0.25,2,3) * 100;
+%! v2 = swaption_bachelier(0,1.954904222037591e-002,0.03,3650,0.0075,8.2844976761307) * 100;
+%! p = struct('call_flag',[1;0],'F',[0.0609090679070339;1.954904222037591e-002], ...
+%!          'X',[0.062;0.03],'T',[1825;3650],'r',[0.06;0],'m',[2;0],'tau',[3;0], ...
+%!          'annuity',[0;8.2844976761307],'multi',100,'sigma',[0.2;0.006656276]);
+%! [spread retcode] = calibrate_vola_spread_batch({'black76';'bachelier'},p,[v1;v2;]);
+%! assert(spread,[0.05;0.0075-0.006656276],0.0000001)
+%! assert(retcode,[0;0])
+%!test
+%! p = struct('call_flag',[1;1],'S',100,'X',100,'T',365,'r',0.0,'q',0.0,'multi',1,'sigma',0.2);
+%! [spread retcode] = calibrate_vola_spread_batch('bs',p,[8.0;150]);
+%! assert(retcode,[0;255])
+%! assert(spread(2),0.0)
+%! assert(option_bs(1,100,100,365,0.0,0.2+spread(1),0.0),8.0,0.000001)
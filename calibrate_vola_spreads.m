@@ -0,0 +1,322 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{instrument_struct} @var{no_calibrated}] =} calibrate_vola_spreads (@var{valuation_date}, @var{instrument_struct}, @var{curve_struct}, @var{index_struct}, @var{surface_struct}, @var{para_object})
+%#
+%# Calibrate the implied volatility spreads of all European options on indizes
+%# (Black-Scholes model) and all swaptions priced with forward rates (Black-76
+%# or normal model) in one batch before the instrument valuation.
+%# The pricing inputs of all instruments are collected and all spreads are
+%# solved simultaneously by calibrate_vola_spread_batch. Calibrated instruments
+%# get the calibration flag set, so that no further calibration takes place
+%# during instrument valuation. All other instruments and instruments without
+%# solution are calibrated during instrument valuation as before.
+%# @*
+%# Caps and floors are not part of the batch: their value is the sum of all
+%# caplets / floorlets, each with its own forward rate, volatility from the
+%# surface (term and moneyness of the caplet) and optional convexity
+%# adjustment, priced in rollout_structured_cashflows. A batch lane prices
+%# one option with one analytic vega, so caps and floors keep the
+%# calibration in CapFloor.calc_vola_spread.
+%# @*
+%# Calibrated spreads are cached with a key of all pricing inputs and the market
+%# value. If para_object.use_vola_spread_cache_file is set, the cache is loaded
+%# from and saved to file vola_spread_cache.mat in folder para_object.path_static.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{valuation_date}: valuation date
+%# @item @var{instrument_struct}: structure with all instruments
+%# @item @var{curve_struct}: structure with all curves
+%# @item @var{index_struct}: structure with all indizes
+%# @item @var{surface_struct}: structure with all surfaces
+%# @item @var{para_object}: Parameter object
+%# @item @var{instrument_struct}: OUTPUT: structure with calibrated instruments
+%# @item @var{no_calibrated}: OUTPUT: number of calibrated instruments
+%# @end itemize
+%# @seealso{calibrate_vola_spread_batch, calibrate_generic}
+%# @end deftypefn
+
+function [instrument_struct no_calibrated] = calibrate_vola_spreads(valuation_date, ...
+                instrument_struct, curve_struct, index_struct, surface_struct, ...
+                para_object)
+
+persistent vola_cache;
+cache_version = 1;
+
+if ( nargin < 6 )
+    print_usage();
+end
+no_calibrated = 0;
+if ~( strcmpi(para_object.cvar_type,'base') )
+    return;
+end
+if ( ischar(valuation_date) )
+    valuation_date = datenum(valuation_date,1);
+end
+if ( isempty(vola_cache) )
+    vola_cache = containers.Map('KeyType','char','ValueType','any');
+end
+cache_file = fullfile(para_object.path_static,'vola_spread_cache.mat');
+if ( para_object.use_vola_spread_cache_file == true && exist(cache_file,'file') == 2 )
+    tmp = load(cache_file);
+    if ( isfield(tmp,'vola_cache_version') && tmp.vola_cache_version == cache_version )
+        for ii = 1 : 1 : length(tmp.vola_cache_keys)
+            vola_cache(tmp.vola_cache_keys{ii}) = tmp.vola_cache_values{ii};
+        end
+    end
+end
+
+% collect pricing inputs of all instruments
+lanes = struct('call_flag',{},'sigma',{},'multi',{},'T',{},'S',{},'F',{}, ...
+                'X',{},'r',{},'q',{},'m',{},'tau',{},'annuity',{});
+lane_model = {};
+lane_market_value = [];
+lane_instr_idx = [];
+lane_keys = {};
+lane_cached = [];
+for ii = 1 : 1 : length(instrument_struct)
+    obj = instrument_struct(ii).object;
+    if ~( any(strcmpi(class(obj),{'Option','Swaption'})) )
+        continue;
+    end
+    if ( obj.calibration_flag == true )
+        continue;
+    end
+    try
+        if ( strcmpi(class(obj),'Option') )
+            [lane model] = get_option_lane(obj,valuation_date,instrument_struct, ...
+                                    curve_struct,index_struct,surface_struct);
+        else
+            [lane model] = get_swaption_lane(obj,valuation_date, ...
+                                    curve_struct,surface_struct);
+        end
+    catch
+        lane = [];
+    end
+    if ( isempty(lane) )
+        continue;
+    end
+    tmp_key = get_cache_key(valuation_date,obj,model,lane);
+    lanes(end+1) = lane;
+    lane_model{end+1,1} = model;
+    lane_market_value(end+1,1) = obj.value_base;
+    lane_instr_idx(end+1,1) = ii;
+    lane_keys{end+1,1} = tmp_key;
+    lane_cached(end+1,1) = isKey(vola_cache,tmp_key);
+end
+if ( isempty(lane_instr_idx) )
+    return;
+end
+
+% calibrate all lanes without cached spread in one batch
+vola_spread = zeros(length(lane_instr_idx),1);
+retcode = zeros(length(lane_instr_idx),1);
+for kk = find(lane_cached)'
+    vola_spread(kk) = vola_cache(lane_keys{kk});
+end
+solve_idx = find(~lane_cached);
+if ~( isempty(solve_idx) )
+    p = struct();
+    lane_fields = fieldnames(lanes);
+    for ff = 1 : 1 : length(lane_fields)
+        p.(lane_fields{ff}) = [lanes(solve_idx).(lane_fields{ff})]';
+    end
+    [vola_spread(solve_idx) retcode(solve_idx)] = calibrate_vola_spread_batch( ...
+                    lane_model(solve_idx),p,lane_market_value(solve_idx));
+end
+
+% store calibrated spreads in instruments and cache
+for kk = 1 : 1 : length(lane_instr_idx)
+    if ( retcode(kk) > 0 )
+        continue;   % calibration during instrument valuation
+    end
+    vola_cache(lane_keys{kk}) = vola_spread(kk);
+    ii = lane_instr_idx(kk);
+    obj = instrument_struct(ii).object;
+    obj = obj.set('vola_spread',vola_spread(kk),'calibration_flag',true);
+    instrument_struct(ii).object = obj;
+    no_calibrated = no_calibrated + 1;
+end
+
+if ( para_object.use_vola_spread_cache_file == true )
+    vola_cache_version = cache_version;
+    vola_cache_keys = keys(vola_cache);
+    vola_cache_values = values(vola_cache);
+    save('-v7',cache_file,'vola_cache_version','vola_cache_keys','vola_cache_values');
+end
+
+end
+
+% ------------------------------------------------------------------------------
+% helper functions
+
+% pricing inputs of European options on indizes (see Option.calc_vola_spread)
+function [lane model] = get_option_lane(obj,valuation_date,instrument_struct, ...
+                                    curve_struct,index_struct,surface_struct)
+    lane = [];
+    model = 'bs';
+    if ~( strcmpi(obj.option_type,'European') )
+        return;
+    end
+    % options on instruments and baskets need valuated underlyings
+    [tmp_obj ret_code] = get_sub_object(instrument_struct,obj.underlying);
+    if ( ret_code == 1 )
+        return;
+    end
+    [underlying ret_code] = get_sub_object(index_struct,obj.underlying);
+    [discount_curve ret_code_curve] = get_sub_object(curve_struct,obj.discount_curve);
+    [vola_surf ret_code_surf] = get_sub_object(surface_struct,obj.vola_surface);
+    if ( ret_code == 0 || ret_code_curve == 0 || ret_code_surf == 0 )
+        return;
+    end
+    tmp_dtm = datenum(obj.maturity_date,1) - valuation_date;
+    if ( tmp_dtm <= 0 )
+        return;
+    end
+    if ( obj.call_flag == 1 )
+        moneyness_exponent = 1;
+    else
+        moneyness_exponent = -1;
+    end
+    r = interpolate_curve(discount_curve.nodes,discount_curve.getValue('base'), ...
+                                                    tmp_dtm) + obj.spread;
+    S = underlying.getValue('base');
+    sigma = vola_surf.getValue('base',tmp_dtm,(S ./ obj.strike).^moneyness_exponent);
+    r = convert_curve_rates(valuation_date,tmp_dtm,r, ...
+                    discount_curve.compounding_type,discount_curve.compounding_freq, ...
+                    discount_curve.basis,'cont','annual',3);
+    T = timefactor(valuation_date,valuation_date + tmp_dtm,obj.basis) .* 365;
+    lane = struct('call_flag',obj.call_flag,'sigma',sigma,'multi',obj.multiplier, ...
+                'T',T,'S',S,'F',0,'X',obj.strike,'r',r,'q',obj.get('div_yield'), ...
+                'm',0,'tau',0,'annuity',0);
+end
+
+% pricing inputs of swaptions with forward rates (see Swaption.calc_vola_spread)
+function [lane model] = get_swaption_lane(obj,valuation_date,curve_struct,surface_struct)
+    lane = [];
+    model = 'black76';
+    if ( obj.use_underlyings == true )
+        return;
+    end
+    [discount_curve ret_code_curve] = get_sub_object(curve_struct,obj.discount_curve);
+    [vola_surf ret_code_surf] = get_sub_object(surface_struct,obj.vola_surface);
+    if ( ret_code_curve == 0 || ret_code_surf == 0 )
+        return;
+    end
+    if ( obj.call_flag == true )
+        call_flag = 1;
+        moneyness_exponent = 1;
+    else
+        call_flag = 0;
+        moneyness_exponent = -1;
+    end
+    tmp_nodes = discount_curve.nodes;
+    tmp_rates_base = discount_curve.getValue('base');
+    interp_method = discount_curve.method_interpolation;
+    tmp_effdate = timefactor(valuation_date,datenum(obj.maturity_date,1),obj.basis) .* 365;
+    if (strcmpi(obj.term_unit,'days'))
+        term_days = obj.term;
+    elseif (strcmpi(obj.term_unit,'months'))
+        term_days = obj.term * 30;
+    else % years
+        term_days = obj.term * 365;
+    end
+    tmp_dtm = tmp_effdate + term_days * obj.tenor;
+    annuity_dates = [tmp_effdate:term_days:tmp_dtm];
+    tmp_effdate = max(tmp_effdate,1);
+    if ( tmp_dtm < 0 || length(annuity_dates) < 2 )
+        return;
+    end
+    % forward swap rate and annuity from discount factors
+    Annuity = 0.0;
+    for ii = 2 : 1 : length(annuity_dates)
+        tmp_rate = interpolate_curve(tmp_nodes,tmp_rates_base,annuity_dates(ii),interp_method);
+        Annuity = Annuity + discount_factor(valuation_date,valuation_date + annuity_dates(ii), ...
+                                    tmp_rate,obj.compounding_type,obj.basis,obj.compounding_freq);
+    end
+    DF_effdate_rate = interpolate_curve(tmp_nodes,tmp_rates_base,annuity_dates(1),interp_method);
+    DF_matdate_rate = interpolate_curve(tmp_nodes,tmp_rates_base,annuity_dates(end),interp_method);
+    DF_effdate = discount_factor(valuation_date,valuation_date + tmp_effdate, ...
+                    DF_effdate_rate,obj.compounding_type,obj.basis,obj.compounding_freq);
+    DF_matdate = discount_factor(valuation_date,valuation_date + tmp_dtm, ...
+                    DF_matdate_rate,obj.compounding_type,obj.basis,obj.compounding_freq);
+    F = (DF_effdate - DF_matdate) ./ Annuity;
+    % volatility cube axis
+    if ( regexpi(vola_surf.axis_x_name,'TENOR'))
+        xx = tmp_effdate;
+        yy = obj.tenor * 365;
+    elseif ( regexpi(vola_surf.axis_x_name,'TERM'))
+        xx = obj.tenor * 365;
+        yy = tmp_effdate;
+    else
+        xx = 0;
+        yy = 0;
+    end
+    if ( regexpi(vola_surf.moneyness_type,'-'))
+        moneyness = (obj.strike - F);
+    else
+        moneyness = (F ./ obj.strike).^moneyness_exponent;
+    end
+    sigma = vola_surf.getValue('base',xx,yy,moneyness);
+    r = interpolate_curve(tmp_nodes,tmp_rates_base,tmp_effdate) + obj.spread;
+    r = convert_curve_rates(valuation_date,tmp_dtm,r, ...
+                    discount_curve.compounding_type,discount_curve.compounding_freq, ...
+                    discount_curve.basis,'cont','annual',3);
+    if ( regexpi(obj.model,'black'))
+        F = max(0.0001,F);
+    else
+        model = 'bachelier';
+    end
+    lane = struct('call_flag',call_flag,'sigma',sigma,'multi',obj.multiplier, ...
+                'T',tmp_effdate,'S',0,'F',F,'X',obj.strike,'r',r,'q',0, ...
+                'm',obj.no_payments,'tau',obj.tenor,'annuity',Annuity);
+end
+
+% hash of market value and all pricing inputs
+function cache_key = get_cache_key(valuation_date,obj,model,lane)
+    lane_values = struct2cell(lane);
+    cache_key = hash('md5',[class(obj),'|',obj.id,'|',model,'|', ...
+                sprintf('%.17g,',valuation_date,obj.value_base,[lane_values{:}])]);
+end
+
+%!test
+%! para_object = Parameter();
+%! c = Curve();
+%! c = c.set('id','IR_EUR','nodes',[730,3650,4380],'rates_base',[0.0001001034,0.0045624391,0.0062559362],'method_interpolation','linear');
+%! v = Surface();
+%! v = v.set('id','VOLA_INDEX','axis_x',3650,'axis_x_name','TERM','axis_y',1.1,'axis_y_name','MONEYNESS');
+%! v = v.set('values_base',0.210360082233);
+%! v = v.set('type','INDEXVol');
+%! i = Index();
+%! i = i.set('id','INDEX','value_base',326.9);
+%! o = Option();
+%! o = o.set('id','OPT_EUR','underlying','INDEX','discount_curve','IR_EUR','vola_surface','VOLA_INDEX');
+%! o = o.set('maturity_date','29-Mar-2026','strike',384.7481,'multiplier',1);
+%! o = o.set('value_base',70.00,'calibration_flag',false);
+%! instrument_struct(1).id = o.id;
+%! instrument_struct(1).object = o;
+%! curve_struct(1).id = c.id;
+%! curve_struct(1).object = c;
+%! index_struct(1).id = i.id;
+%! index_struct(1).object = i;
+%! surface_struct(1).id = v.id;
+%! surface_struct(1).object = v;
+%! [instrument_struct no_calibrated] = calibrate_vola_spreads('31-Mar-2016', ...
+%!          instrument_struct,curve_struct,index_struct,surface_struct,para_object);
+%! assert(no_calibrated,1)
+%! assert(instrument_struct(1).object.calibration_flag,true)
+%! ref = o.calc_vola_spread('31-Mar-2016',i,c,v);
+%! assert(instrument_struct(1).object.vola_spread,ref.vola_spread,0.00001)
+%! calib = instrument_struct(1).object.calc_value('31-Mar-2016','base',i,c,v);
+%! assert(calib.getValue('base'),70.000,0.001);
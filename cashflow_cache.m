@@ -0,0 +1,135 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{retval} @var{entry}] =} cashflow_cache (@var{action}, @var{key}, @var{entry})
+%#
+%# Cache for scenario independent cash flow schedules (cash flow dates,
+%# cash flow values, accrued interest and last coupon date) used by
+%# rollout_structured_cashflows. The cache key is a hash of all instrument
+%# terms and the valuation date. The cache lives in memory during an Octave
+%# session and can be saved to and loaded from a file to reuse the schedules
+%# between runs.
+%# @*
+%# Actions:
+%# @itemize @bullet
+%# @item 'get': [@var{hit} @var{entry}] = cashflow_cache('get',@var{key})
+%# @item 'set': cashflow_cache('set',@var{key},@var{entry})
+%# @item 'clear': remove all entries and reset statistics
+%# @item 'stats': @var{stats} = cashflow_cache('stats'): structure with number
+%# of entries, hits and misses
+%# @item 'save': @var{number} = cashflow_cache('save',@var{filename})
+%# @item 'load': @var{number} = cashflow_cache('load',@var{filename}): entries
+%# are merged into the cache. A missing file is ignored.
+%# @end itemize
+%# @seealso{rollout_structured_cashflows}
+%# @end deftypefn
+
+function [retval entry] = cashflow_cache(action, key, entry)
+
+persistent cache;
+persistent hits;
+persistent misses;
+cache_version = 1;
+
+if ( nargin < 1 )
+    print_usage();
+end
+if ( isempty(cache) )
+    cache = containers.Map('KeyType','char','ValueType','any');
+    hits = 0;
+    misses = 0;
+end
+
+retval = [];
+switch ( lower(action) )
+case 'get'
+    if ( isKey(cache,key) )
+        retval = true;
+        entry = cache(key);
+        hits = hits + 1;
+    else
+        retval = false;
+        entry = [];
+        misses = misses + 1;
+    end
+case 'set'
+    if ( nargin < 3 )
+        error('cashflow_cache: no entry given for key >>%s<<',key);
+    end
+    cache(key) = entry;
+case 'clear'
+    cache = containers.Map('KeyType','char','ValueType','any');
+    hits = 0;
+    misses = 0;
+case 'stats'
+    retval = struct('entries',cache.Count,'hits',hits,'misses',misses);
+case 'save'
+    cf_cache_version = cache_version;
+    cf_cache_keys = keys(cache);
+    cf_cache_values = values(cache);
+    save('-v7',key,'cf_cache_version','cf_cache_keys','cf_cache_values');
+    retval = length(cf_cache_keys);
+case 'load'
+    retval = 0;
+    if ( exist(key,'file') ~= 2 )
+        return;
+    end
+    tmp = load(key);
+    if ~( isfield(tmp,'cf_cache_version') && tmp.cf_cache_version == cache_version )
+        fprintf('cashflow_cache: ignoring cache file >>%s<< with unknown version\n',key);
+        return;
+    end
+    for ii = 1 : 1 : length(tmp.cf_cache_keys)
+        cache(tmp.cf_cache_keys{ii}) = tmp.cf_cache_values{ii};
+    end
+    retval = length(tmp.cf_cache_keys);
+otherwise
+    error('cashflow_cache: unknown action >>%s<<',any2str(action));
+end
+
+end
+
+%!test
+%! cashflow_cache('clear');
+%! [hit entry] = cashflow_cache('get','key_a');
+%! assert(hit,false)
+%! cashflow_cache('set','key_a',struct('ret_values',[1,2,3]));
+%! [hit entry] = cashflow_cache('get','key_a');
+%! assert(hit,true)
+%! assert(entry.ret_values,[1,2,3])
+%! stats = cashflow_cache('stats');
+%! assert([stats.entries,stats.hits,stats.misses],[1,1,1])
+%! tmp_file = [tempname(),'.mat'];
+%! assert(cashflow_cache('save',tmp_file),1)
+%! cashflow_cache('clear');
+%! assert(cashflow_cache('load',tmp_file),1)
+%! [hit entry] = cashflow_cache('get','key_a');
+%! assert(hit,true)
+%! delete(tmp_file);
+%! cashflow_cache('clear');
+%!test
+%! cashflow_cache('clear');
+%! b = Bond();
+%! b = b.set('Name','Test_FRB','coupon_rate',0.035,'value_base',101.25,'coupon_generation_method','backward','sub_type','FRB');
+%! b = b.set('maturity_date','01-Feb-2025','notional',100,'compounding_type','simple','issue_date','01-Feb-2011');
+%! [d1 v1 i1 p1 a1 l1] = rollout_structured_cashflows('31-Mar-2016','base',b);
+%! [d2 v2 i2 p2 a2 l2] = rollout_structured_cashflows('31-Mar-2016','stress',b);
+%! stats = cashflow_cache('stats');
+%! assert([stats.entries,stats.hits],[1,1])
+%! assert(d2,d1)
+%! assert(v2,v1)
+%! assert(a2,a1)
+%! b = b.set('coupon_rate',0.04);
+%! [d3 v3] = rollout_structured_cashflows('31-Mar-2016','base',b);
+%! assert(v3(end) > v1(end))
+%! cashflow_cache('clear');
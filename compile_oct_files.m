@@ -14,7 +14,11 @@
 %# @deftypefn {Function File} {} compile_oct_files (@var{path_octarisk})
 %#
 %# Compile all .cc files in folder  @var{path_octarisk}/oct_files and move
-%# successfully compiled .oct files to top folder. 
+%# successfully compiled .oct files to top folder. Shared header files (.h)
+%# in this folder are included by the .cc files and are not compiled.
+%# All files are compiled with thread support (-pthread). The number of worker
+%# threads of multithreaded oct files is set by environment variable
+%# OCTARISK_THREADS (default: number of hardware threads).
 %#
 %# @end deftypefn
 
@@ -31,14 +35,16 @@ counter_compiled = 0;
 chdir(path_to_oct_files);
 for ii = 1 : 1 : length(oct_file_list)
     tmp_filename = oct_file_list( ii ).name;
-    if ( regexpi(tmp_filename,'.cc') )    % cc source code file found -> compile
+    if ( regexpi(tmp_filename,'\.cc$') )    % cc source code file found -> compile
         counter_cc += 1;
         try
             fprintf('File >>%s<< found. Trying to compile... \n',tmp_filename);
             link_to_file = strcat(path_to_oct_files,'/',tmp_filename);
             
-            % compile .cc file (forcing gnu++11 standards)
-            [outfile, status] =feval("mkoctfile","-v","-O3","-std=gnu++11",link_to_file);
+            % compile .cc file (forcing gnu++11 standards, shared headers,
+            % std::thread workers)
+            [outfile, status] =feval("mkoctfile","-v","-O3","-std=gnu++11", ...
+                                "-pthread",strcat("-I",path_to_oct_files),link_to_file);
             if ( status == 0 )
                 fprintf('----> File >>%s<< successfully compiled\n',tmp_filename);
                 counter_compiled += 1;
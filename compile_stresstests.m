@@ -0,0 +1,107 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {@var{stress_engine} =} compile_stresstests (@var{stresstest_struct})
+%#
+%# Compile all stresstest definitions into a sparse shock matrix (market
+%# objects x stresstests). Each non-zero entry points to the shock definition
+%# of the market object in the given stresstest. All market data stress
+%# functions (load_riskfactor_stresses, update_mktdata_objects,
+%# Surface.apply_stress_shocks) get the stresses of one object by a single
+%# lookup and evaluate the non-zero shocks only. Therefore the effort scales with
+%# the number of defined shocks instead of the number of market objects
+%# times the number of stresstests.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{stresstest_struct}: structure with all stresstests (see load_stresstests)
+%# @item @var{stress_engine}: RETURN: structure with fields
+%# @itemize @bullet
+%# @item number_stresses: number of stresstests
+%# @item stress_ids: cell with stresstest ids
+%# @item object_ids: sorted cell with all (lower case) market object ids
+%# @item shock_matrix: sparse matrix (objects x stresstests) with indizes
+%# into shock_defs
+%# @item shock_defs: cell with all shock definitions
+%# @end itemize
+%# @end itemize
+%# @seealso{load_stresstests, get_stress_shocks}
+%# @end deftypefn
+
+function stress_engine = compile_stresstests(stresstest_struct)
+
+if ( nargin ~= 1 )
+    print_usage();
+end
+
+% already compiled
+if ( isfield(stresstest_struct,'shock_matrix') )
+    stress_engine = stresstest_struct;
+    return;
+end
+
+number_stresses = length(stresstest_struct);
+obj_ids = {};
+stress_cols = [];
+shock_defs = {};
+% collect all object shocks of all stresstests (one entry per non-zero shock)
+for ii = 1 : 1 : number_stresses
+    subst = stresstest_struct(ii).objects;
+    if ~( isstruct(subst) && isfield(subst,'id') )
+        continue;
+    end
+    for jj = 1 : 1 : length(subst)
+        obj_ids{end + 1} = lower(subst(jj).id);
+        stress_cols(end + 1) = ii;
+        shock_defs{end + 1} = subst(jj);
+    end
+end
+
+stress_engine = struct();
+stress_engine.number_stresses = number_stresses;
+if ( isfield(stresstest_struct,'id') )
+    stress_engine.stress_ids = {stresstest_struct.id};
+else
+    stress_engine.stress_ids = repmat({''},1,number_stresses);
+end
+[object_ids tmp_idx obj_rows] = unique(obj_ids);
+stress_engine.object_ids = object_ids;
+% first definition wins for duplicate shocks of an object in one stresstest
+% (sparse would sum up duplicate entries)
+[tmp_pairs first_idx] = unique([obj_rows(:),stress_cols(:)],'rows','first');
+stress_engine.shock_matrix = sparse(obj_rows(first_idx),stress_cols(first_idx), ...
+                        first_idx,length(object_ids),number_stresses);
+stress_engine.shock_defs = shock_defs;
+
+end
+
+%!test
+%! s(1).id = 'Base';
+%! s(1).objects = '';
+%! s(2).id = 'EQ_down';
+%! s(2).objects(1).id = 'RF_EQ';
+%! s(2).objects(1).shock_value = 0.5;
+%! s(2).objects(2).id = 'IR_EUR';
+%! s(2).objects(2).shock_value = 0.01;
+%! s(3).id = 'EQ_up';
+%! s(3).objects(1).id = 'RF_EQ';
+%! s(3).objects(1).shock_value = 1.5;
+%! e = compile_stresstests(s);
+%! assert(e.number_stresses,3)
+%! assert(e.object_ids,{'ir_eur','rf_eq'})
+%! assert(full(e.shock_matrix),[0,2,0;0,1,3])
+%! [stress_idx shock_defs] = get_stress_shocks(e,'RF_EQ');
+%! assert(stress_idx,[2,3])
+%! assert(shock_defs{2}.shock_value,1.5)
+%! [stress_idx shock_defs] = get_stress_shocks(e,'IX_UNKNOWN');
+%! assert(isempty(stress_idx),true)
@@ -0,0 +1,96 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {@var{whatif_engine} =} compile_whatif_engine (@var{pnl}, @var{para}, @var{scen_order})
+%#
+%# Compile the portfolio scenario P&L into a what-if engine for incremental
+%# and marginal VaR calculations of new trades (see calc_whatif_var).
+%# The sorted portfolio P&L, the sorted scenario order and the quantile
+%# estimator weights are calculated once. Only the ranks up to the last
+%# scenario with a non-negligible quantile estimator weight (at least up to the
+%# confidence scenario) are required for all VaR and ES figures.
+%# The sorted scenario order is usually taken from the portfolio object
+%# (Position property scenario_order stored by calc_risk), otherwise the
+%# P&L is sorted. Accepted trades are added to the engine with
+%# whatif_commit_trade, so the engine need not be compiled again.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{pnl}: portfolio scenario P&L (scenario values - base value)
+%# @item @var{para}: parameter object or struct with quantile, quantile_estimator
+%# and quantile_bandwidth
+%# @item @var{scen_order}: sorted scenario order of @var{pnl} (optional)
+%# @item @var{whatif_engine}: RETURN: structure with fields
+%# @itemize @bullet
+%# @item pnl: portfolio scenario P&L (column vector)
+%# @item pnl_sorted: sorted portfolio scenario P&L
+%# @item scen_order: scenario numbers sorted by P&L
+%# @item confi_scenario: rank of confidence scenario
+%# @item no_ranks: number of ranks required for VaR and ES calculation
+%# @item hd_vec: quantile estimator weights of all required ranks
+%# @item varhd_abs: portfolio VaR (quantile estimator)
+%# @item var_abs: portfolio VaR (confidence scenario)
+%# @item expshortfall_abs: portfolio expected shortfall
+%# @end itemize
+%# @end itemize
+%# @seealso{calc_whatif_var, whatif_commit_trade, get_quantile_estimator}
+%# @end deftypefn
+
+function whatif_engine = compile_whatif_engine(pnl, para, scen_order)
+
+if ( nargin < 2 || nargin > 3 )
+    print_usage();
+end
+
+pnl = pnl(:);
+no_scen = length(pnl);
+if ( nargin < 3 || length(scen_order) ~= no_scen )
+    [pnl_sorted scen_order] = sort(pnl);
+else
+    scen_order = scen_order(:);
+    pnl_sorted = pnl(scen_order);
+end
+
+confi = 1 - para.quantile;
+confi_scenario = max(round(confi * no_scen),1);
+hd_vec = get_quantile_estimator(para.quantile_estimator, no_scen, ...
+                                1:1:no_scen,confi,para.quantile_bandwidth);
+% ranks with non-negligible quantile estimator weight
+no_ranks = max([confi_scenario, ...
+                find(abs(hd_vec) > eps * max(abs(hd_vec)),1,'last')]);
+
+whatif_engine = struct();
+whatif_engine.pnl = pnl;
+whatif_engine.pnl_sorted = pnl_sorted;
+whatif_engine.scen_order = scen_order;
+whatif_engine.confi_scenario = confi_scenario;
+whatif_engine.no_ranks = no_ranks;
+whatif_engine.hd_vec = hd_vec(1:no_ranks);
+whatif_engine.varhd_abs = - dot(hd_vec,pnl_sorted);
+whatif_engine.var_abs = - pnl_sorted(confi_scenario);
+whatif_engine.expshortfall_abs = - mean(pnl_sorted(1:confi_scenario-1));
+
+end
+
+%!test
+%! pnl = [-5;3;-10;1;-2;4;-1;2;0;-3];
+%! para = struct('quantile',0.8,'quantile_estimator','singular','quantile_bandwidth',0);
+%! whatif_engine = compile_whatif_engine(pnl,para);
+%! assert(whatif_engine.pnl_sorted,sort(pnl))
+%! assert(whatif_engine.confi_scenario,2)
+%! assert(whatif_engine.no_ranks,2)
+%! assert(whatif_engine.var_abs,5)
+%! assert(whatif_engine.varhd_abs,5)
+%! assert(whatif_engine.expshortfall_abs,10)
+%! [tmp scen_order] = sort(pnl);
+%! assert(compile_whatif_engine(pnl,para,scen_order),whatif_engine)
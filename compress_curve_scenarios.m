@@ -0,0 +1,118 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{loadings} @var{scores} @var{max_err}] =} compress_curve_scenarios (@var{rates}, @var{tol}, @var{max_factors})
+%#
+%# Compress MC scenario rates of a curve (scenarios x nodes) into a factor
+%# representation by principal component analysis:
+%# rates ~ loadings(1,:) + scores * loadings(2:end,:).
+%# The first row of @var{loadings} contains the mean curve over all scenarios,
+%# the following rows contain the principal component loadings per node.
+%# The smallest number of factors is chosen, for which the maximum absolute
+%# reconstruction error over all scenarios and nodes is below @var{tol}.
+%# If the tolerance can not be met with at most @var{max_factors} factors
+%# (or with less factors than nodes), empty matrices are returned and the
+%# rates should be stored without compression.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{rates}: MC scenario rates (scenarios x nodes)
+%# @item @var{tol}: maximum absolute reconstruction error
+%# @item @var{max_factors}: maximum number of factors (optional, default 5)
+%# @item @var{loadings}: OUTPUT: mean curve and factor loadings ((k+1) x nodes)
+%# @item @var{scores}: OUTPUT: factor scores (scenarios x k)
+%# @item @var{max_err}: OUTPUT: maximum absolute reconstruction error
+%# @end itemize
+%# @seealso{load_yieldcurves, update_mktdata_objects}
+%# @end deftypefn
+
+function [loadings scores max_err] = compress_curve_scenarios(rates, tol, max_factors)
+    if ( nargin < 2 )
+        print_usage ();
+    end
+    if ( nargin < 3 )
+        max_factors = 5;
+    end
+    loadings = [];
+    scores = [];
+    max_err = Inf;
+    [mc no_nodes] = size(rates);
+    if ( mc < 2 || ndims(rates) > 2 )
+        return;
+    end
+    mu = mean(rates,1);
+    X = rates - mu;
+    % principal components from covariance of nodes (nodes x nodes)
+    [V lambda] = eig(X' * X);
+    [lambda idx] = sort(diag(lambda),'descend');
+    V = V(:,idx);
+    % factor representation has to be smaller than dense representation
+    for k = 0 : 1 : min(round(max_factors),no_nodes - 1)
+        tmp_scores = X * V(:,1:k);
+        tmp_err = max(max(abs(X - tmp_scores * V(:,1:k)')));
+        if ( tmp_err <= tol )
+            loadings = [mu; V(:,1:k)'];
+            scores = tmp_scores;
+            max_err = tmp_err;
+            return;
+        end
+    end
+end
+
+%!test
+%! nodes = [365,730,1825,3650,7300];
+%! F = [0.01,-0.005;0.02,0.003;-0.01,0.004;0.005,-0.002];
+%! B = [1,1,1,1,1;-1,-0.5,0,0.5,1];
+%! rates = repmat([0.01,0.012,0.015,0.02,0.025],4,1) + F * B;
+%! [loadings scores max_err] = compress_curve_scenarios(rates,1e-10,5);
+%! assert(size(loadings),[3,5])
+%! assert(size(scores),[4,2])
+%! assert(loadings(1,:) + scores * loadings(2:end,:),rates,1e-10)
+%! assert(max_err <= 1e-10)
+%!test
+%! rates = [0.01,0.02;0.03,0.01;0.02,0.05];
+%! [loadings scores] = compress_curve_scenarios(rates,1e-10,5);
+%! assert(isempty(loadings))
+%! assert(isempty(scores))
+%! [loadings scores max_err] = compress_curve_scenarios(rates,1,5);
+%! assert(size(loadings),[1,2])
+%! assert(max_err <= 1)
+%!test
+%! nodes = [365,730,1825,3650,7300];
+%! F = [0.01,-0.005;0.02,0.003;-0.01,0.004;0.005,-0.002];
+%! rates = repmat([0.01,0.012,0.015,0.02,0.025],4,1) + F * [1,1,1,1,1;-1,-0.5,0,0.5,1];
+%! c = Curve();
+%! c = c.set('id','IR_EUR','type','Discount Curve','nodes',nodes, ...
+%!     'rates_base',[0.01,0.012,0.015,0.02,0.025],'method_interpolation','linear', ...
+%!     'rates_mc',rates,'timestep_mc','250d');
+%! d = c;
+%! c = c.compress_rates_mc(1e-10,5);
+%! assert(isempty(c.get('rates_mc')))
+%! assert(size(c.get('rates_mc_scores')),[4,2])
+%! assert(c.getValue('250d'),rates,1e-10)
+%! assert(c.getRate('250d',1000),d.getRate('250d',1000),1e-10)
+%! assert(c.getRate('250d',[500,9000]),d.getRate('250d',[500,9000]),1e-10)
+%!test
+%! nodes = [365,730,1825,3650,7300];
+%! F = [0.01,-0.005;0.02,0.003;-0.01,0.004;0.005,-0.002];
+%! rates = repmat([0.01,0.012,0.015,0.02,0.025],4,1) + F * [1,1,1,1,1;-1,-0.5,0,0.5,1];
+%! rates(:,:,2) = repmat([0.01,0.012,0.015,0.02,0.025],4,1) + F(:,1) * [1,1,1,1,1];
+%! c = Curve();
+%! c = c.set('id','IR_EUR','type','Discount Curve','nodes',nodes, ...
+%!     'rates_base',[0.01,0.012,0.015,0.02,0.025],'method_interpolation','linear', ...
+%!     'rates_mc',rates,'timestep_mc',{'90d','250d'});
+%! c = c.compress_rates_mc(1e-10,5);
+%! assert(isempty(c.get('rates_mc')))
+%! assert(size(c.get('rates_mc_scores')),[4,2,2])
+%! assert(c.getValue('90d'),rates(:,:,1),1e-10)
+%! assert(c.getValue('250d'),rates(:,:,2),1e-10)
@@ -11,45 +11,62 @@
 %# details.
 
 %# -*- texinfo -*-
-%# @deftypefn {Function File} {[@var{A_scaled} @var{pos_sem_def_bool}] =} correct_correlation_matrix(@var{M})
+%# @deftypefn {Function File} {[@var{A_scaled} @var{pos_sem_def_bool} @var{warm_start}] =} correct_correlation_matrix(@var{M}, @var{warm_start})
 %# Return a positive semi-definite matrix @var{A_scaled} to a given input 
 %# matrix @var{M}. This function tests for indefiniteness of the input matrix 
-%# and eventuallry adjusts negative Eivenvalues to 0 or slightly positive values 
-%# via some iteration steps.
+%# by an attempted Cholesky decomposition (eigenvalues are only calculated for
+%# singular matrices). Indefinite matrices are replaced by the nearest
+%# correlation matrix (Frobenius norm), which is calculated by a semismooth
+%# Newton method (Qi and Sun) in oct-file nearest_correlation_cpp.
 %# @*
-%# Reference: 'Implementing Value at Risk', Best, Philip W., 1998.
+%# The optional struct @var{warm_start} holds the results of a previous call
+%# (e.g. previous day's correlation matrix) and is returned with updated values:
+%# @itemize @bullet
+%# @item @var{M}: input matrix
+%# @item @var{A}: repaired matrix
+%# @item @var{chol}: upper Cholesky factor of repaired matrix (empty if singular),
+%# reused by scenario_generation_MC for drawing correlated random numbers
+%# @item @var{y}: dual variables of Newton method
+%# @end itemize
+%# If the input matrix equals the input matrix of the warm start, the repaired
+%# matrix is taken without any calculation. Otherwise the dual variables are
+%# used as starting point of the Newton method.
+%# @*
+%# Reference: 'A quadratically convergent Newton method for computing the
+%# nearest correlation matrix', Qi, H. and Sun, D., 2006.
+%# @seealso{nearest_correlation_cpp}
 %# @end deftypefn
 
-function [A_scaled pos_sem_def_bool]= correct_correlation_matrix(M)
-pos_sem_def_bool = testpsd(M);
+function [A_scaled pos_sem_def_bool warm_start] = correct_correlation_matrix(M,warm_start)
+if ( nargin < 2 || ~isstruct(warm_start) )
+    warm_start = struct();
+end
+% unchanged input matrix: take repaired matrix of warm start
+if ( isfield(warm_start,'M') && isfield(warm_start,'A') ...
+                && isequal(size(warm_start.M),size(M)) && all(warm_start.M(:) == M(:)) )
+    fprintf  ('Input matrix unchanged. Taking repaired matrix of warm start.\n')
+    A_scaled = warm_start.A;
+    pos_sem_def_bool = true;
+    return;
+end
+[pos_sem_def_bool U] = testpsd(M);
 if (pos_sem_def_bool == true)
     fprintf  ('Input matrix is positive semidefinite\n')
     A_scaled = M;
+    warm_start.M = M;
+    warm_start.A = M;
+    warm_start.chol = U;
     return;
 else
     fprintf ('Input matrix is not positive semidefinite. Starting correction.\n')
 end
-A_scaled = M;
-limit = 0.0;
-step = 0;
-break_bool = 0;
-while ( pos_sem_def_bool == 0 ) 
-    %tic;
-    %limit
-    lambda_min = limitEV(A_scaled,limit);
-    [V lambda] = eig(A_scaled);
-    A = V * lambda_min * inv(V);
-    A_scaled = rescale ( A );
-    pos_sem_def_bool = testpsd(A_scaled);
-    limit = step * 0.00000001;  
-    step = step + 1;
-    %toc;
-    if ( step > 50 )
-        break_bool = 1;
-        break;
-    end
+% warm start with dual variables of previous solution
+y0 = [];
+if ( isfield(warm_start,'y') && numel(warm_start.y) == rows(M) )
+    y0 = warm_start.y;
 end
-if ( break_bool == 1 )
+[A_scaled y step retcode] = nearest_correlation_cpp(M,y0);
+if ( retcode ~= 0 )
     fprintf ('!! Warning: No positive semidefinite solution was reached !!\n');
 end
 % Get final test statistics
@@ -65,36 +82,38 @@ fprintf('   Maximum correlation deviation: %1.4f \n', Max_diff);
 fprintf('   Frobenius norm: %1.4f \n', Frobenius_Norm);
 %fprintf('   Maximum singular value: %1.4f \n', Max_Singular_Value_Norm);
 fprintf('   Algorithm converged after %d steps.\n', step);
-pos_sem_def_bool =testpsd(A_scaled);
+[pos_sem_def_bool U] = testpsd(A_scaled);
 if (pos_sem_def_bool == true)
     fprintf ('Correction successful: Matrix is positive semidefinite.\n')
 end
+warm_start.M = M;
+warm_start.A = A_scaled;
+warm_start.chol = U;
+warm_start.y = y;
 end
 % %#%#%#%#%#%#%#%#%#%##    Helper Functions    %#%#%#%#%#%#%#%#%#%#
 
-% Function for rescaling and symmetrizing
-function res = rescale ( A )
-    % columnwise rescaling to diagonal elements == 1
-    Balance = diag(1./sqrt(diag(A)));
-    A_scaled = Balance * A * Balance';
-    % symmetrizing: taking lower triangular matrix and mirror values to 
-    %               upper triangular matrix
-    trilower = tril(A_scaled);
-    %D = diag(trilower);
-    [nr,nc]=size(trilower);
-    triupper = trilower';
-    res = trilower + triupper - eye(nc);
-end
-
-% set Eigenvalues to limit
-function lambda = limitEV(M, limit)
-    % get Eigenvalues and Eigenvectors
-    [V lambda] = eig(M);
-    lambda(lambda < 0 ) = limit;
+% test matrix for positive semidefinitness: attempted Cholesky decomposition,
+% eigenvalues only for singular matrices
+function [pos_sem_def_bool U] = testpsd(M)
+    [U p] = chol(M);
+    if ( p == 0 )
+        pos_sem_def_bool = true;
+    else
+        U = [];
+        pos_sem_def_bool = ( min(eig((M + M') ./ 2)) >= -rows(M) * eps );
+    end
 end
 
-% test matrix for positive semidefinitness
-function pos_sem_def_bool = testpsd(M)
-    [V lambda] = eig(M);
-    pos_sem_def_bool = all( all ( lambda >= 0 ));
-end
+%!test
+%! [A pos_sem_def_bool warm_start] = correct_correlation_matrix([1,1,0;1,1,1;0,1,1]);
+%! assert(pos_sem_def_bool,true)
+%! assert(A,[1,0.760689853,0.157298106;0.760689853,1,0.760689853;0.157298106,0.760689853,1],0.000001)
+%! [A2 pos_sem_def_bool warm_start2] = correct_correlation_matrix([1,1,0;1,1,1;0,1,1],warm_start);
+%! assert(A2,A)
+%! assert(warm_start2.chol,warm_start.chol)
+%!test
+%! M = [1,0.5;0.5,1];
+%! [A pos_sem_def_bool warm_start] = correct_correlation_matrix(M);
+%! assert(A,M)
+%! assert(warm_start.chol,chol(M),sqrt(eps))
@@ -79,12 +79,14 @@ end
 %! assert(b.soy,-0.00274310399175057,0.0001);
 %! b = b.set('soy',0.00);
 %! b = b.calc_value('31-Mar-2016','base',c);
-%! b = b.calc_sensitivities('31-Mar-2016',c);
+%! b = b.calc_sensitivities('31-Mar-2016',c,[],'bump');
 %! assert(b.getValue('base'),99.1420775289364,0.00001);
 %! assert(b.get('convexity'),64.1806456611515,0.00001);
 %! assert(b.get('mod_duration'),5.63642375918384,0.00001);
 %! assert(b.get('eff_duration'),7.67144764167465,0.00001);
 %! assert(b.get('mac_duration'),7.66223670737639,0.00001);
+%! b = b.calc_sensitivities('31-Mar-2016',c);
+%! assert(b.get('eff_duration'),7.67144764167465,-0.005);
 %! b = b.rollout('stress','31-Mar-2016');
 %! b = b.calc_value('31-Mar-2016','stress',c);
 %! assert(b.getValue('stress'),[91.8547937772494;118.8336876898364],0.0000001); 
@@ -99,7 +101,7 @@ end
 %! c = c.set('id','IR_EUR','nodes',[30,91,365,730,1095,1460,1825,2190,2555,2920,3285,3650,4015],'rates_base',[0.00010026,0.00010027,0.00010027,0.00010014,0.00010009,0.00096236,0.00231387,0.00376975,0.005217,0.00660956,0.00791501,0.00910955,0.01018287],'method_interpolation','linear');
 %! b = b.calc_value('31-Dec-2015','base',c);
 %! assert(b.getValue('base'),105.619895060083,0.0000001)
-%! b = b.calc_sensitivities('31-Mar-2016',c);
+%! b = b.calc_sensitivities('31-Mar-2016',c,[],'bump');
 %! assert(b.get('last_coupon_date'),-52);
 %! assert(b.get('convexity'),106.724246965278,0.0000001)
 %! assert(b.get('mod_duration'),9.09611845785009,0.0000001)
@@ -110,6 +112,13 @@ end
 %! assert(b.get('dv01'),0.106605762118726,0.0000001)
 %! assert(b.get('pv01'),-0.106549401094469,0.0000001)
 %! assert(b.get('spread_duration'),10.1124142671261,0.0000001)
+%! b = b.calc_sensitivities('31-Mar-2016',c,[],'analytic');
+%! assert(b.get('eff_duration'),10.1124142671261,-0.005)
+%! assert(b.get('eff_convexity'),106.827013628121,-0.005)
+%! assert(b.get('dv01'),0.106605762118726,-0.000001)
+%! assert(b.get('pv01'),-0.106549401094469,-0.000001)
+%! assert(b.get('spread_duration'),b.get('eff_duration'))
+%! assert(b.get('mac_duration'),10.0933391311049,0.0000001)
 
 %!test 
 %! fprintf('\tdoc_instrument:\tPricing 3rd Fixed Rate Bond Object\n');
@@ -124,11 +133,14 @@ end
 %! c = c.set('id','IR_EUR','nodes',[365,3650],'rates_base',[0.01,0.04],'method_interpolation','monotone-convex');
 %! c = c.set('rates_stress',[0.02,0.05;0.005,0.014]);
 %! b = b.calc_value('30-Sep-2016','base',c);
-%! b = b.calc_sensitivities('30-Sep-2016',c);
+%! b = b.calc_sensitivities('30-Sep-2016',c,[],'bump');
 %! assert(b.getValue('base'),117.317469891155,0.000000001);
 %! assert(b.get('eff_duration'),0.167123365467675,0.000000001);
 %! assert(b.get('mac_duration'),0.167123287671233,0.000000001);
 %! assert(b.get('eff_convexity'),0.0279301997816818,0.000000001);
+%! b = b.calc_sensitivities('30-Sep-2016',c);
+%! assert(b.get('eff_duration'),0.167123365467675,-0.0001);
+%! assert(b.get('eff_convexity'),0.0279301997816818,-0.0001);
 %! b = b.rollout('stress','30-Sep-2016');
 %! b = b.calc_value('30-Sep-2016','stress',c);
 %! assert(b.getValue('stress'),[117.121568822210;117.415543267658],0.000000001);
@@ -144,7 +156,7 @@ end
 %! c = c.set('id','IR_EUR','nodes',[365,3650],'rates_base',[0.01,0.01],'method_interpolation','linear');
 %! b = b.calc_value('30-Dec-2016','base',c);
 %! b = b.calc_key_rates('30-Dec-2016',c);
-%! b = b.calc_sensitivities('30-Dec-2016',c);
+%! b = b.calc_sensitivities('30-Dec-2016',c,[],'bump');
 %! assert(sum(b.get('key_rate_eff_dur')),b.get('eff_duration'),sqrt(eps));
 %! assert(sum(b.get('key_rate_eff_convex')),b.get('eff_convexity'),sqrt(eps));
 
@@ -199,11 +211,14 @@ end
 %! assert(b.get('eff_duration'),3.93109370316470e-005,0.00001);
 %! assert(b.get('mac_duration'),0.747367046218197,0.00001);
 %! r = r.set('floor',0.0);
-%! b = b.calc_sensitivities('30-Jun-2016',c,r);
+%! b = b.calc_sensitivities('30-Jun-2016',c,r,'bump');
 %! assert(b.get('eff_convexity'),74.2605311454306,0.00001);
 %! assert(b.get('eff_duration'),0.371340971970093,0.00001);
 %! assert(b.get('mac_duration'),0.747367046218197,0.00001);
 %! assert(b.get('spread_duration'),0.747374010847449,0.00001)
+%! b = b.calc_sensitivities('30-Jun-2016',c,r);
+%! assert(b.get('eff_duration'),0.371340971970093,0.00001);
+%! assert(b.get('spread_duration'),0.747374010847449,-0.0001)
 
 %!test 
 %! fprintf('\tdoc_instrument:\tPricing Stochastic Cash Flow Object\n');
@@ -519,9 +534,12 @@ end
 %! o = o.set('value_base',100);
 %! o = o.calc_vola_spread('31-Mar-2016',i,c,v);
 %! assert(o.getValue('base'),100.000,0.001);
-%! o = o.calc_greeks('31-Mar-2016','base',i,c,v);
+%! o = o.calc_greeks('31-Mar-2016','base',i,c,v,pwd,'bump');
 %! assert(o.get('theo_delta'),-0.624297868987391,sqrt(eps));
 %! assert(o.get('theo_vega'),3.31289415079807,sqrt(eps));
+%! o = o.calc_greeks('31-Mar-2016','base',i,c,v);
+%! assert(o.get('theo_delta'),-0.624297868987391,0.01);
+%! assert(o.get('theo_vega'),3.31289415079807,0.01);
 %! o = Option();
 %! o = o.set('maturity_date','29-Mar-2026','currency','USD','timesteps_size',5,'willowtree_nodes',30);
 %! o = o.set('strike',368.7362,'multiplier',1,'sub_Type','OPT_AM_P');
@@ -684,6 +702,11 @@ end
 %! assert(floor.get('eff_convexity'),802.649265026805,0.000000001);
 %! assert(floor.get('vega'),0.00254896021660968,0.000000001);
 %! assert(floor.get('theta'),0.00327523346664615,0.000000001);
+%! floor_bump = floor.calc_sensitivities('30-Jun-2016','base',c,v,c,'bump');
+%! assert(floor.get('eff_duration'),floor_bump.get('eff_duration'));
+%! assert(floor.get('spread_duration'),floor_bump.get('spread_duration'),-0.001);
+%! assert(floor.get('dv01'),floor_bump.get('dv01'),-0.000001);
+%! assert(floor.get('pv01'),floor_bump.get('pv01'),-0.000001);
 
 %!test
 %! fprintf('\tdoc_instrument:\tPricing Bond Future and underlying FRB\n');
@@ -1095,6 +1118,11 @@ end
 %! assert(base_value,53.1857840724563,0.00000001);
 % John c. Hull, Option Future and Derivatives gives an put option value of 1.8093 (for 500 steps)
 %! assert(option_value,1.7978,0.0001);
+%! b_bump = b.calc_sensitivities(valuation_date,curve,[],'bump',call_schedule,put_schedule);
+%! b = b.calc_sensitivities(valuation_date,curve,[],'analytic',call_schedule,put_schedule);
+%! assert(b.get('dv01'),b_bump.get('dv01'),-0.001);
+%! assert(b.get('pv01'),b_bump.get('pv01'),-0.001);
+%! assert(b.get('eff_duration'),b_bump.get('eff_duration'),-0.01);
 %! value_type = 'stress';
 %! b = b.rollout(value_type,valuation_date);
 %! b = b.calc_value(valuation_date,value_type,curve,call_schedule,put_schedule);
@@ -1642,6 +1670,13 @@ end
 %! r = r.calc_key_rates(valuation_date,c);
 %! assert(r.getValue('base'),56832.026205,0.00001);
 %! assert(r.getValue('stress')(1),72734.246324,0.00001);
+%! r2 = r.set('Name','Test_SAVPLAN_B','coupon_rate',0.02,'savings_rate',250,'bonus_value_current',0.0);
+%! [ret_dates ret_values ret_int] = rollout_retail_cashflows(valuation_date,'base',{r,r2});
+%! [ret_dates2 ret_values2 ret_int2] = rollout_retail_cashflows(valuation_date,'base',r2);
+%! assert(ret_dates{2},ret_dates2)
+%! assert(ret_values{2},ret_values2,1e-8)
+%! assert(ret_int{2},ret_int2,1e-8)
+%! assert(ret_values{1},r.get('cf_values'),1e-8)
 %! fprintf('\tdoc_instrument:\tPricing Defined Contribution Plan A\n');
 %! r = Retail();
 %! r = r.set('Name','Test_DCP_A','sub_type','DCP','coupon_rate',0.00,'coupon_generation_method','forward','term',1,'term_unit','months');
@@ -15,6 +15,8 @@
 %#
 %# Compute the forward rate of caplets or floorlets according to Black, Normal or
 %# analytical calculation formulas.
+%# F, X, tf and sigma can be scalars, vectors or matrices (e.g. scenarios x
+%# reset dates) of compatible size. All rates are calculated elementwise.
 %#
 %# Input and output variables:
 %# @itemize @bullet
@@ -24,7 +26,7 @@
 %# @item @var{tf}: time factor until forward start date (in days) [required] 
 %# @item @var{sigma}: swap volatility according to tenor, term and moneyness (act/365 continuous)[required] 
 %# @item @var{model}: model (Black, Normal, Analytical) [required]
-%# @item @var{rate}: OUTPUT: adjusted forward rate
+%# @item @var{rate}: OUTPUT: adjusted forward rate (size of broadcasted inputs)
 %# @end itemize
 %#
 %# For Black model, the following formulas are applied:
@@ -70,42 +72,46 @@ end
 if ~isnumeric(X)
     error('getCapFloorRate: Strike rate X is not a valid number')
 end
-if ~isnumeric(sigma) || sigma < 0
+if ~isnumeric(sigma) || any(sigma(:) < 0)
     error('getCapFloorRate: Volatility sigma is not a valid number')
 end
 
-% model dependent calculation
-if (strcmpi(model,'Black') && X > 0.0 && sigma > 0.0)  % Black model only if X positive
-    if ( F < 0 )
+% expand all input parameters to common size (e.g. scenarios x reset dates)
+tmp_zeros = zeros(size(F + X + tf + sigma));
+F = F + tmp_zeros;
+X = X + tmp_zeros;
+tf = tf + tmp_zeros;
+sigma = sigma + tmp_zeros;
+if (CapFlag == true)
+    eta = 1;
+else
+    eta = -1;
+end
+
+% model dependent calculation (elementwise)
+if (strcmpi(model,'Black'))
+    % Black model only if X and sigma positive, analytical model otherwise
+    idx = X > 0.0 & sigma > 0.0;
+    if ( any(F(idx) < 0) )
         error ('getCapFloorRate: forward rate in Black model is negative. Use normal model instead.');
     end
-    d1 = (log(F./X) + 0.5.*(sigma.^2).*tf)./(sigma.*sqrt(tf));
-    d2 = d1 - sigma.*sqrt(tf);
-    if (CapFlag == true)
-        N1 = 0.5.*(1+erf(d1./sqrt(2)));
-        N2 = 0.5.*(1+erf(d2./sqrt(2)));
-        rate = (F.*N1 - X.*N2);
-    else
-        N1 = 0.5.*(1+erf(-d1./sqrt(2)));
-        N2 = 0.5.*(1+erf(-d2./sqrt(2)));
-        rate = (X.*N2 - F.*N1);
+    rate = max(0, eta .* (F - X));
+    if ( any(idx(:)) )
+        d1 = (log(F(idx)./X(idx)) + 0.5.*(sigma(idx).^2).*tf(idx)) ...
+                                    ./(sigma(idx).*sqrt(tf(idx)));
+        d2 = d1 - sigma(idx).*sqrt(tf(idx));
+        N1 = 0.5.*(1+erf(eta.*d1./sqrt(2)));
+        N2 = 0.5.*(1+erf(eta.*d2./sqrt(2)));
+        rate(idx) = eta .* (F(idx).*N1 - X(idx).*N2);
     end
 elseif (strcmpi(model,'Normal'))
-    d = (F - X) ./ (sigma*sqrt(tf));
+    d = (F - X) ./ (sigma.*sqrt(tf));
     const = 1 / sqrt(2*pi);
     pdf_d = const*exp(-d.^2 /2);
-    if (CapFlag == true)
-        rate = (F - X) .* 0.5.*(1+erf(d./sqrt(2)))  + sigma*sqrt(tf) .* pdf_d;
-    else
-        rate = (X - F) .* 0.5.*(1+erf(-d./sqrt(2))) + sigma*sqrt(tf) .* pdf_d;
-    end
+    rate = eta .* (F - X) .* 0.5.*(1+erf(eta.*d./sqrt(2))) + sigma.*sqrt(tf) .* pdf_d;
 % analytical model: just compare forward rates with strike rate
 else
-    if  (CapFlag == true)
-        rate = max(0, F - X);
-    else
-        rate = max(0, X - F);
-    end
+    rate = max(0, eta .* (F - X));
 end
 
 end
@@ -126,4 +132,16 @@ end
 %!assert(getCapFloorRate(true, 0.0103061692, 0.01, 4, 0.003, 'Analytic'),3.0617e-004,0.00001);
 %!assert(getCapFloorRate(true, [0.01;0.015], 0.01, 4, 0.003, 'Normal'),[0.0023937;0.0056798],0.00001);
 %!assert(getCapFloorRate(true, [0.01;0.015], 0.01, 4, 0.003, 'Black'),[2.3937e-005;5.0000e-003],0.00001);
-  
\ No newline at end of file
+  
+%!test
+%! F = [0.01,0.012;0.015,0.02];
+%! sigma = [0.003,0.004;0.0035,0.0045];
+%! rate = getCapFloorRate(false,F,0.012,[1,2],sigma,'Normal');
+%! for ii = 1 : 1 : 2
+%!     for jj = 1 : 1 : 2
+%!         assert(rate(ii,jj),getCapFloorRate(false,F(ii,jj),0.012,jj,sigma(ii,jj),'Normal'),sqrt(eps))
+%!     end
+%! end
+%! rate = getCapFloorRate(true,F,[0.0,0.012],[1,2],sigma,'Black');
+%! assert(rate(:,1),F(:,1),sqrt(eps))
+%! assert(rate(2,2),getCapFloorRate(true,0.02,0.012,2,0.0045,'Black'),sqrt(eps))
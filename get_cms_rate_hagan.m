@@ -69,42 +69,32 @@ cms_dates = [days_to_issue,cms_dates];
 % time factor between valuation date and swap issue date
 TF = timefactor(valuation_date,swapissuedatenum,basis);
 
-if strcmpi(interp_method,'linear') % vectorized interpolation approach
-    rates_cms_dates = curve.getRate(value_type,cms_dates);
-    cms_df = discount_factor (valuation_date, (cms_dates + valuation_date), ...
-                            rates_cms_dates, comp_type_curve, basis_curve, comp_freq_curve);
+% interpolation weights of curve nodes at all cms dates (set up once)
+if ( any(strcmpi(interp_method,{'linear','mm','constant','previous','next'})) ...
+            && ~strcmpi(curve.get('method_extrapolation'),'linear') )
+    [rates_cms weights_cms] = get_curve_weights(nodes,rates,cms_dates,interp_method);
 else % conventional loop through all nodes
     % Preallocate memory
-    cms_df = zeros(rows(rates),length(cms_dates));
+    rates_cms = zeros(rows(rates),length(cms_dates));
     for ii = 1:1:length(cms_dates)
-        tmp_date = cms_dates(ii);
         % interpolate rates from given curve rates
-        r_curve = curve.getRate(value_type,tmp_date);
-        % calculate discount factor
-        cms_df(:,ii) = discount_factor (valuation_date, (tmp_date + valuation_date), ...
-                            r_curve, comp_type_curve, basis_curve, comp_freq_curve);
+        rates_cms(:,ii) = curve.getRate(value_type,cms_dates(ii));
     end
+    weights_cms = eye(length(cms_dates));
 end
 % calculate time factor
 tf_df = timefactor(cms_dates(1:end-1)',cms_dates(2:end)',basis)';
+tf_cms = timefactor(valuation_date,cms_dates + valuation_date,basis_curve);
 
 % TODO: implement swap premiums at start and end of swap lifetime
-prem_end = 0.0; %swap.premium_at_end;
-prem_start = 0.0; %swap.premium_at_start;
-
-cms_df(:,1) = cms_df(:,1) .* (prem_start + swap.notional);
-cms_df(:,2:end-1) = cms_df(:,2:end-1) .* (swap.notional);
-cms_df(:,end) = cms_df(:,end) .* (prem_end + swap.notional);
-
-% Calculate CMS rate:
-
-% get difference between first and last df
-nominator = cms_df(:,1) - cms_df(:,end);
-
- % sum up all timefactor weighted discount factors
-cms_df_tmp = cms_df(:,2:end);  % remove first discount factor
-Annuity = sum(cms_df_tmp.*tf_df,2);
-cms_rate = nominator ./ Annuity;
+% (premiums at start and end are zero -> all discount factors are scaled
+% with notional)
+
+% Calculate CMS rate and annuity of all scenarios in compiled function:
+% CMS rate = (DF(start) - DF(end)) / sum(DF .* tf_df)
+[Annuity cms_rate] = swap_annuity_cpp(rates_cms,weights_cms,tf_cms, ...
+                            comp_type_curve,comp_freq_curve,tf_df);
+Annuity = Annuity .* swap.notional;
                        
 
 % Convexity Adjustment according to Hagan Paper "Convexity Conundrums", 2003:
@@ -133,7 +123,6 @@ denom_t0_t1 = q.^-(1); % timefactor between underlying cms payment date and fixi
 delta = nom_t0_tp ./ denom_t0_t1;
 
 n = length(tf_df); % n is total number of payments of underlying swap
-dG = dG(cms_rate,delta,n,q); % calculate derivative of Bond pricing function G
 
 % Discount Factor: Hagan specifies adjustment to value, but we want adjustment to rates
 % Calculation of discount factor at payment date
@@ -141,51 +130,39 @@ rate_paymentdate = curve.getRate(value_type,payment_date - valuation_date);
 Dt_p = discount_factor (valuation_date, payment_date, ...
                 rate_paymentdate, comp_type_curve, basis_curve, comp_freq_curve);
 % distinguish between CMS Swaplets, Caplets and Floorlets
+if (strcmpi(model,'Black'))
+    model_id = 1;
+else
+    model_id = 2;
+end
+X = 0.0;
 convex_adj = 0.0;
 if ( regexpi( instrument.sub_type,'FLOATING') || regexpi( instrument.sub_type,'FRN_SPECIAL'))                         
-    if (strcmpi(model,'Black')) % Formula 3.5b
-        convex_adj = dG .* (exp(sigma.^2 .* TF) -1) .* cms_rate.^2 .*  Annuity ./ Dt_p;
-    else    % normal model Formula 3.6b
-        convex_adj = dG .* TF .* sigma.^2 .*  Annuity ./ Dt_p;
-    end
+    % Black model: Formula 3.5b, normal model: Formula 3.6b
+    payoff = 0;
 elseif ( regexpi( instrument.sub_type,'^CAP') )  % CMS rate adjustment to caplet
+    % normal model: Formula 3.6c
+    payoff = 1;
     X = instrument.strike;
-    h = (cms_rate - X) ./ (sigma*sqrt(TF));
-    cdf_h = 0.5.*(1+erf(h./sqrt(2)));
-    if (strcmpi(model,'Black')) % Formula 3.5c
-        %convex_adj = yet to be implemented...
+    if ( model_id == 1 ) % Formula 3.5c
         fprintf('WARNING: get_cms_rate_hagan: Convexity Adjustment for Cap Black model not yet implemented. Setting adjustment to zero.\n');
-    else    % normal model Formula 3.6c
-        convex_adj = dG .* TF .* sigma.^2 .*  Annuity ./ Dt_p .* cdf_h;
     end
 elseif ( regexpi( instrument.sub_type,'^FLOOR') )  % CMS rate adjustment to floorlet
+    % normal model: Formula 3.6d
+    payoff = 2;
     X = instrument.strike;
-    h = (X - cms_rate) ./ (sigma*sqrt(TF));
-    cdf_h = 0.5.*(1+erf(h./sqrt(2)));
-    if (strcmpi(model,'Black')) % Formula 3.5d
-        %convex_adj =  yet to be implemented...
+    if ( model_id == 1 ) % Formula 3.5d
         fprintf('WARNING: get_cms_rate_hagan: Convexity Adjustment for floor Black model not yet implemented. Setting adjustment to zero.\n');
-    else    % normal model Formula 3.6d
-        convex_adj = -dG .* TF .* sigma.^2 .*  Annuity ./ Dt_p .* cdf_h;
     end
+else
+    payoff = -1;
+end
+% convexity adjustment of all scenarios in compiled function
+if ( payoff >= 0 )
+    convex_adj = cms_convexity_cpp(model_id,payoff,cms_rate,Annuity,Dt_p, ...
+                                sigma,TF,delta,n,q,X);
 end
 
 end % end main function
 
-% #######################   Derivative functions   #############################
-% first derivative of G (Appendix A.1 Model 1: formula A.3 of Hagans paper)
-% G is standard bond math model: G ~ (f / (1 + f/q)^delta)*(1 - (1/(1+f/q)^n))^(-1)
-% dG = (((q+x)/q)^(n-δ) (q (-1+((q+x)/q)^n)-x (n+(-1+((q+x)/q)^n) (-1+δ))))/((q+x) (-1+((q+x)/q)^n)^2)
-function ret = dG(f,delta,n,q)
-    % f = cms_rate
-    % t_0 = CMS swaps start date
-    % t_1 = CMS swap new cf date
-    % t_p = pay date
-    % n = number of underlying swaps payment
-    %delta = ( t_p - t_0 ) ./ ( t_1 - t_0 )
-    % q = number of payments per period
-    fq = f./q;
-    ret = (1 + fq - delta.*fq) .* ( (1+fq ).^(n - delta - 1) ./ ( (1+fq ).^(n) - 1) ) ...
-                - n.*fq .* ( (1+fq ).^(n - delta - 1) ./ ( (1+fq ).^(n) - 1).^2 );
-end
 %######################
@@ -0,0 +1,94 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{num}] =} get_convention_num (@var{convention}, @var{value})
+%#
+%# Map a compounding type, compounding frequency or day count convention to the
+%# numeric value expected by compiled functions (e.g. rollout_savings_cpp or
+%# calibrate_bond_yield_cpp). Numeric values are returned unchanged.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{convention}: string: 'compounding_type', 'compounding_freq' or
+%# 'basis'
+%# @item @var{value}: compounding type ('simple', 'discrete', 'continuous'),
+%# compounding frequency ('daily', 'weekly', 'monthly', 'quarterly',
+%# 'semi-annual', 'annual') or day count convention (see get_basis)
+%# @item @var{num}: OUTPUT: compounding type 1 (simple), 2 (discrete) or
+%# 3 (continuous), compounding frequency per year or day count basis
+%# @end itemize
+%# @seealso{get_basis, convert_curve_rates}
+%# @end deftypefn
+
+function num = get_convention_num(convention, value)
+
+if ( nargin ~= 2 )
+    print_usage();
+end
+
+if ~( ischar(value) )
+    num = value;
+    return;
+end
+
+switch ( lower(convention) )
+case 'compounding_type'
+    if ( regexpi(value,'simp') )
+        num = 1;
+    elseif ( regexpi(value,'disc') )
+        num = 2;
+    elseif ( regexpi(value,'cont') )
+        num = 3;
+    else
+        error('get_convention_num: Need valid compounding_type. Unknown >>%s<<',value)
+    end
+case 'compounding_freq'
+    if ( regexpi(value,'^da') )
+        num = 365;
+    elseif ( regexpi(value,'^week') )
+        num = 52;
+    elseif ( regexpi(value,'^month') )
+        num = 12;
+    elseif ( regexpi(value,'^quarter') )
+        num = 4;
+    elseif ( regexpi(value,'^semi-annual') )
+        num = 2;
+    elseif ( regexpi(value,'^annual') )
+        num = 1;
+    else
+        error('get_convention_num: Need valid compounding frequency. Unknown >>%s<<',value)
+    end
+case 'basis'
+    num = get_basis(value);
+otherwise
+    error('get_convention_num: Unknown convention >>%s<<',any2str(convention))
+end
+
+end
+
+%!assert(get_convention_num('compounding_type','simple'),1)
+%!assert(get_convention_num('compounding_type','Discrete'),2)
+%!assert(get_convention_num('compounding_type','cont'),3)
+%!assert(get_convention_num('compounding_type',2),2)
+%!assert(get_convention_num('compounding_freq','daily'),365)
+%!assert(get_convention_num('compounding_freq','weekly'),52)
+%!assert(get_convention_num('compounding_freq','monthly'),12)
+%!assert(get_convention_num('compounding_freq','quarterly'),4)
+%!assert(get_convention_num('compounding_freq','semi-annual'),2)
+%!assert(get_convention_num('compounding_freq','annual'),1)
+%!assert(get_convention_num('compounding_freq',4),4)
+%!assert(get_convention_num('basis','act/360'),2)
+%!assert(get_convention_num('basis',0),0)
+%!error get_convention_num('compounding_type','dummy')
+%!error get_convention_num('compounding_freq','dummy')
+%!error get_convention_num('dummy','annual')
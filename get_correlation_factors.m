@@ -0,0 +1,103 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{L} @var{D} @var{frob_norm}] =} get_correlation_factors (@var{corr_matrix}, @var{k}, @var{max_iter})
+%#
+%# Fit a factor model with @var{k} principal factors and idiosyncratic
+%# variances to a given correlation matrix: corr_matrix ~ L * L' + diag(D.^2).
+%# The loadings are calculated by iterated principal axis factoring: the
+%# k largest eigenvalues and eigenvectors of corr_matrix - diag(D.^2) are
+%# updated until the idiosyncratic variances D.^2 = 1 - sum(L.^2,2) converge.
+%# The first iteration is equal to a principal component analysis. Loadings of
+%# risk factors with communalities above 1 are rescaled, so that the fitted
+%# matrix is a valid correlation matrix (unit diagonal, positive semidefinite).
+%# For large matrices only the k largest eigenvalues are calculated (eigs).
+%# Correlated standard normal random numbers are given by F * L' + E .* D' with
+%# independent standard normal factors F (mc x k) and residuals E (mc x n).
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{corr_matrix}: correlation matrix (n x n)
+%# @item @var{k}: number of factors
+%# @item @var{max_iter}: maximum number of iterations (optional, default 500)
+%# @item @var{L}: OUTPUT: factor loadings (n x k)
+%# @item @var{D}: OUTPUT: idiosyncratic standard deviations (n x 1)
+%# @item @var{frob_norm}: OUTPUT: Frobenius norm of difference between fitted
+%# and input correlation matrix
+%# @end itemize
+%# @seealso{scenario_generation_MC, load_correlation_factors}
+%# @end deftypefn
+
+function [L D frob_norm] = get_correlation_factors(corr_matrix, k, max_iter)
+    if ( nargin < 2 )
+        print_usage ();
+    end
+    if ( nargin < 3 )
+        max_iter = 500;
+    end
+    n = rows(corr_matrix);
+    k = min(max(round(k),1),n);
+    corr_matrix = (corr_matrix + corr_matrix') ./ 2;
+    psi = zeros(n,1);   % idiosyncratic variances
+    for iter = 1 : 1 : max_iter
+        A = corr_matrix - diag(psi);
+        if ( n <= 500 || k >= n - 1 )
+            [V lambda] = eig((A + A') ./ 2);
+            [lambda idx] = sort(diag(lambda),'descend');
+            V = V(:,idx(1:k));
+            lambda = lambda(1:k);
+        else
+            [V lambda] = eigs(A,k,'la');
+            lambda = diag(lambda);
+        end
+        L = V .* sqrt(max(lambda,0))';
+        psi_new = max(1 - sum(L.^2,2),0);
+        if ( max(abs(psi_new - psi)) < 1e-8 )
+            psi = psi_new;
+            break;
+        end
+        psi = psi_new;
+    end
+    % rescale loadings with communalities above 1 (Heywood cases)
+    communality = sum(L.^2,2);
+    idx = communality > 1;
+    L(idx,:) = L(idx,:) ./ sqrt(communality(idx));
+    D = sqrt(max(1 - sum(L.^2,2),0));
+    % Frobenius norm of L * L' + diag(D.^2) - corr_matrix without building
+    % the fitted n x n matrix (trace identities)
+    d2 = D.^2;
+    frob_sq = sumsq(corr_matrix(:)) - 2 * sum(sum(L .* (corr_matrix * L))) ...
+            - 2 * sum(d2 .* diag(corr_matrix)) + sumsq(reshape(L' * L,[],1)) ...
+            + 2 * sum(d2 .* sum(L.^2,2)) + sum(d2.^2);
+    frob_norm = sqrt(max(frob_sq,0));
+    fprintf('get_correlation_factors: %d factors fitted to %d risk factors after %d iterations. Frobenius norm: %1.4f\n', ...
+                                        k,n,iter,frob_norm);
+end
+
+%!test
+%! L0 = [0.8,0.1;0.7,-0.2;0.6,0.3;0.5,0.5;0.4,-0.4;0.3,0.2];
+%! D0 = sqrt(1 - sum(L0.^2,2));
+%! C = L0 * L0' + diag(D0.^2);
+%! [L D frob_norm] = get_correlation_factors(C,2);
+%! assert(L * L' + diag(D.^2),C,0.000001)
+%! assert(D,D0,0.000001)
+%! assert(frob_norm < 0.000001)
+%!test
+%! C = [1,0.9,0.1,0.3;0.9,1,0.2,0.4;0.1,0.2,1,-0.1;0.3,0.4,-0.1,1];
+%! [L D frob_norm] = get_correlation_factors(C,2);
+%! assert(frob_norm,norm(L * L' + diag(D.^2) - C,'fro'),sqrt(eps))
+%!test
+%! C = [1,0.9,0.1;0.9,1,0.2;0.1,0.2,1];
+%! [L D] = get_correlation_factors(C,1);
+%! assert(diag(L * L' + diag(D.^2)),ones(3,1),sqrt(eps))
+%! assert(min(eig(L * L' + diag(D.^2))) > -sqrt(eps))
@@ -0,0 +1,69 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{rates} @var{weights}] =} get_curve_weights (@var{nodes}, @var{values}, @var{timesteps}, @var{interp_method})
+%#
+%# Calculate interpolation weights of curve nodes at all timesteps. The
+%# interpolated rates of all scenarios are given by rates * weights.
+%# For interpolation methods linear in curve rates (linear, mm, constant,
+%# previous, next) the weights depend on nodes and timesteps only and the
+%# curve values are returned unchanged. For all other interpolation methods
+%# the interpolated rates are returned with unit weights.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{nodes}: curve nodes (1 x N)
+%# @item @var{values}: curve rates of all scenarios (S x N)
+%# @item @var{timesteps}: timesteps to be interpolated (1 x D)
+%# @item @var{interp_method}: interpolation method (see interpolate_curve)
+%# @item @var{rates}: OUTPUT: curve rates (S x N) or interpolated rates (S x D)
+%# @item @var{weights}: OUTPUT: interpolation weights (N x D) or unit matrix (D x D)
+%# @end itemize
+%# @seealso{interpolate_curve}
+%# @end deftypefn
+
+function [rates weights] = get_curve_weights(nodes, values, timesteps, interp_method)
+    no_steps = length(timesteps);
+    if ( any(strcmpi(interp_method,{'linear','mm','constant','previous','next'})) )
+        unit_values = eye(length(nodes));
+        weights = zeros(length(nodes),no_steps);
+        for ii = 1 : 1 : no_steps
+            weights(:,ii) = interpolate_curve(nodes,unit_values,timesteps(ii),interp_method);
+        end
+        rates = values;
+    else
+        rates = zeros(rows(values),no_steps);
+        for ii = 1 : 1 : no_steps
+            rates(:,ii) = interpolate_curve(nodes,values,timesteps(ii),interp_method);
+        end
+        weights = eye(no_steps);
+    end
+end
+
+%!test
+%! nodes = [365,730,1095];
+%! values = [0.01,0.02,0.04;0.02,0.03,0.05];
+%! [rates weights] = get_curve_weights(nodes,values,[100,500,900,2000],'linear');
+%! assert(rates,values)
+%! exp_rates = [interpolate_curve(nodes,values,100,'linear'), ...
+%!              interpolate_curve(nodes,values,500,'linear'), ...
+%!              interpolate_curve(nodes,values,900,'linear'), ...
+%!              interpolate_curve(nodes,values,2000,'linear')];
+%! assert(rates * weights,exp_rates,sqrt(eps))
+%!test
+%! nodes = [365,730,1095];
+%! values = [0.01,0.02,0.04];
+%! [rates weights] = get_curve_weights(nodes,values,[500,900],'loglinear');
+%! assert(weights,eye(2))
+%! assert(rates,[interpolate_curve(nodes,values,500,'loglinear'), ...
+%!              interpolate_curve(nodes,values,900,'loglinear')],sqrt(eps))
@@ -15,6 +15,10 @@
 %#
 %# Compute the forward rate calculated from interpolated rates from a  
 %# yield curve. CAUTION: the forward rate is floored to 0.000001.
+%# Forward rates of a whole reset schedule can be calculated in one call:
+%# if @var{days_to_t1} and @var{days_to_t2} are vectors of length D, a MxD
+%# matrix with forward rates of all periods and scenarios is returned.
+%# All forward rates are calculated in the compiled function forward_rate_cpp.
 %# Explanation of Input Parameters:
 %# @*
 %# Variables:
@@ -22,13 +26,16 @@
 %# @item @var{nodes}: is a 1xN vector with all timesteps of the given curve
 %# @item @var{rates}: is MxN matrix with curve rates defined in columns. Each 
 %# row contains a specific scenario with different curve structure
-%# @item @var{days_to_t1}: is a scalar, specifiying term1 in days
-%# @item @var{days_to_t2}: is a scalar, specifiying term2 in days after term1
+%# @item @var{days_to_t1}: is a scalar or vector, specifiying term1 in days
+%# @item @var{days_to_t2}: is a scalar or vector, specifiying term2 in days
+%# after term1
 %# @item @var{comp_type}: (optional) specifies compounding rule (simple, 
 %# discrete, continuous (defaults to 'cont')).
 %# @item @var{interp_method}: (optional) specifies interpolation method for 
 %# retrieving interest rates (defaults to 'linear').
-%# @item @var{comp_freq}: (optional) compounding frequency (default: annual)
+%# @item @var{comp_freq}: (optional) compounding frequency (default: annual).
+%# The forward rate does not depend on the compounding frequency of the
+%# instrument.
 %# @item @var{basis}: (optional) day count convention of instrument (default: act/365)
 %# @item @var{valuation_date}: (optional) valuation date (default: today)
 %# @item @var{comp_type_curve}: (optional) compounding type of curve
@@ -36,7 +43,7 @@
 %# @item @var{comp_freq_curve}: (optional) compounding frequency of curve
 %# @item @var{floor_flag}: (optional) Bool: flooring forward rates to 0.000001
 %# @end itemize
-%# @seealso{interpolate_curve, convert_curve_rates,timefactor}
+%# @seealso{interpolate_curve, convert_curve_rates, timefactor, get_curve_weights, forward_rate_cpp}
 %# @end deftypefn
 
 function forward_rate = get_forward_rate(nodes, rates, days_to_t1, days_to_t2, ...
@@ -125,9 +132,9 @@ if ~isnumeric (days_to_t1)
     error ('days_to_t1 must be numeric ')
 elseif ~isnumeric (days_to_t2)
     error ('days_to_t2 must be numeric ')
-elseif days_to_t1 < 0
+elseif any(days_to_t1 < 0)
     error ('days_to_t1 must be zero or positive ')
-elseif days_to_t2 < 0
+elseif any(days_to_t2 < 0)
     error ('days_to_t2 must be zero or positive ')        
 end
 no_scen_nodes = columns(nodes);
@@ -140,71 +147,30 @@ if ( issorted(nodes) ~= 1)
     disp('Nodes have to be sorted')
 end 
 
-% Get compounding type:
-if ischar(comp_type)
-    if ( strcmpi(comp_type,'simple') )
-        compounding_type = 1;
-    elseif ( regexpi(comp_type,'disc'))
-        compounding_type = 2;
-    elseif ( strcmpi(comp_type,'cont')  || strcmpi(comp_type,'continuous') )
-        compounding_type = 3;
-    else
-        error('Need valid comp_type type [disc, simple, cont]')
-    end
-end
-
-% error check compounding frequency
-if ischar(comp_freq)
-    if ( strcmpi(comp_freq,'daily') || strcmpi(comp_freq,'day'))
-        compounding = 365;
-    elseif ( strcmpi(comp_freq,'weekly') || strcmpi(comp_freq,'week'))
-        compounding = 52;
-    elseif ( strcmpi(comp_freq,'monthly') || strcmpi(comp_freq,'month'))
-        compounding = 12;
-    elseif ( strcmpi(comp_freq,'quarterly')  ||  strcmpi(comp_freq,'quarter'))
-        compounding = 4;
-    elseif ( strcmpi(comp_freq,'semi-annual'))
-        compounding = 2;
-    elseif ( strcmpi(comp_freq,'annual') )
-        compounding = 1;       
-    else
-        error('Need valid compounding frequency')
-    end
-else
-    compounding = comp_freq;
-end
 % Start Calculation
-% Get rates at timesteps1 / 2
-r1_curve = interpolate_curve(nodes,rates,days_to_t1,interp_method);
-r2_curve = interpolate_curve(nodes,rates,(days_to_t2 + days_to_t1),interp_method);
-% convert interpolated rates from curve convention to instrument convention
-% Get time length between valuation date and timesteps (in years)
-r1 = convert_curve_rates(valuation_date,days_to_t1,r1_curve, ...
-                        comp_type_curve,comp_freq_curve,basis_curve, ...
-                        comp_type,compounding,basis);
-r2 = convert_curve_rates(valuation_date,(days_to_t2 + days_to_t1),r2_curve, ...
-                        comp_type_curve,comp_freq_curve,basis_curve, ...
-                        comp_type,compounding,basis);                   
-% calculate timefactor   
-d1 = timefactor (valuation_date,(days_to_t1 + valuation_date),basis);
-d2 = timefactor (valuation_date,(days_to_t1 + days_to_t2 + valuation_date),basis);
-
-% 3 cases
-if ( compounding_type == 1)      % simple
-    tmp_rate = ((( 1 + (r2 .* d2)) ./ ( 1 + (r1 .* d1) ) ) - 1 ) ./ ( d2 - d1 );
-elseif ( compounding_type == 2)      % discrete
-    tmp_rate = (  ( 1 + (r2 ./ compounding) ).^(compounding * d2) ...
-                ./ ( 1 + (r1 ./ compounding) ).^(compounding * d1) ) ...
-                .^(1 ./ (d2 - d1)) - 1;
-elseif ( compounding_type == 3)      % continuous
-    tmp_rate = ( r2 .* d2 - r1 .* d1  ) ./ (  d2 - d1 );
-end
-
-if ( floor_flag == true )
-    forward_rate = max(tmp_rate,0.000001);
-else
-    forward_rate = tmp_rate;
+% forward start and end dates of all periods
+days_to_t1 = days_to_t1(:)';
+days_to_t2 = days_to_t2(:)';
+if ( length(days_to_t1) == 1 )
+    days_to_t1 = repmat(days_to_t1,1,length(days_to_t2));
+elseif ( length(days_to_t2) == 1 )
+    days_to_t2 = repmat(days_to_t2,1,length(days_to_t1));
+elseif ( length(days_to_t1) ~= length(days_to_t2) )
+    error ('days_to_t1 and days_to_t2 must have equal length')
 end
+timesteps = [days_to_t1, days_to_t1 + days_to_t2];
+% Get interpolation weights of curve nodes at all timesteps
+[rates_steps weights] = get_curve_weights(nodes,rates,timesteps,interp_method);
+% Get time length between valuation date and timesteps (in years) in curve 
+% and instrument basis
+tf_curve = timefactor (valuation_date,(timesteps + valuation_date),basis_curve);
+tf = timefactor (valuation_date,(timesteps + valuation_date),basis);
+
+% Conversion of interpolated rates from curve convention to instrument 
+% convention leaves discount factors unchanged -> calculate forward rates
+% from curve discount factors in compiled function
+forward_rate = forward_rate_cpp(rates_steps,weights,tf_curve,tf, ...
+                        comp_type_curve,comp_freq_curve,comp_type,floor_flag);
 
 end
 
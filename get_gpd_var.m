@@ -41,9 +41,21 @@ function [VAR ES] = get_gpd_var(chi, sigma, u, q, n, nu)
     end
     % Calculate VAR and ES
     VAR = u + sigma./chi.*(( n./nu .*( 1- q ) ).^(-chi) -1);
+    % exponential tail in the limit chi -> 0
+    exp_tail = ( abs(chi) < 1e-8 ) & true(size(VAR));
+    if ( any(exp_tail(:)) )
+        VAR_exp = u - sigma .* log( n./nu .*( 1- q ) ) + zeros(size(VAR));
+        VAR(exp_tail) = VAR_exp(exp_tail);
+    end
     ES = (VAR + sigma - chi .* u) ./ ( 1 - chi );
 end
 
 %!test
 %! aa = get_gpd_var(0.00001,1632.9,5930.8,[0.99;0.995;0.999],50000,1250);
 %! assert (aa - [7427.0179919;8558.8723169;11186.9869299],[0.000000;0.0000000;0.0000000],0.00001);
+%!test
+%! [VAR ES] = get_gpd_var([0,0.00001],[1632.9,1632.9],[5930.8,5930.8],0.995,50000,1250);
+%! assert (VAR,[8558.8723169 - 0.00001 * 1632.9 * log(5)^2 / 2,8558.8723169],0.1);
+%! assert (ES(1),VAR(1) + 1632.9,0.000001);
+%! [VAR ES] = get_gpd_var(0,0,100,0.995,50000,1250);
+%! assert ([VAR ES],[100,100]);
@@ -17,7 +17,7 @@
 %# this program; if not, see <http://www.gnu.org/licenses/>.
  
 %# -*- texinfo -*-
-%# @deftypefn {Function File} {[@var{r} @var{type} ] =} get_marginal_distr_pearson (@var{mu}, @var{sigma}, @var{skew}, @var{kurt}, @var{Z})
+%# @deftypefn {Function File} {[@var{r} @var{type} ] =} get_marginal_distr_pearson (@var{mu}, @var{sigma}, @var{skew}, @var{kurt}, @var{Z}, @var{mode})
 %#
 %# Compute a marginal distribution for given set of uniform random variables 
 %# with given mean, standard deviation skewness and kurtosis. The mapping is 
@@ -29,16 +29,28 @@
 %# R package version 0.97. @*
 %# URL: http://CRAN.R-project.org/package=PearsonDS @*
 %# licensed under the GPL >= 2.0 @*
+%# @*
+%# In modes 'table' and 'validate' all risk factors (columns of Z) are 
+%# transformed at once: the Pearson type is classified once per risk factor,
+%# the exact inverse CDF is evaluated on a table of 1601 equally spaced normal
+%# scores between -8 and 8 and all scenarios are interpolated by the oct-file
+%# pearson_marginal_cpp (monotone cubic interpolation in normal scores).
+%# Pearson type IV quantiles are calculated by numerical integration of the
+%# density. Mode 'validate' additionally evaluates the exact inverse CDF for 
+%# all scenarios and prints the maximum absolute interpolation error.
+%# @*
 %# Input and output variables:
 %# @itemize @bullet
-%# @item @var{mu}:      mean of marginal distribution (scalar)
-%# @item @var{sigma}:   standard deviation of marginal distribution (scalar)
-%# @item @var{skew}:    skewness of marginal distribution (scalar)
-%# @item @var{kurt}:    kurtosis of marginal distribution (scalar)
-%# @item @var{Z}:       uniform distributed random variables (Nx1 vector)
-%# @item @var{r}:       OUTPUT: Nx1 vector with random variables distributed 
+%# @item @var{mu}:      mean of marginal distribution (scalar or 1xN vector)
+%# @item @var{sigma}:   standard deviation of marginal distribution (scalar or 1xN vector)
+%# @item @var{skew}:    skewness of marginal distribution (scalar or 1xN vector)
+%# @item @var{kurt}:    kurtosis of marginal distribution (scalar or 1xN vector)
+%# @item @var{Z}:       uniform distributed random variables (MxN matrix, 
+%# only one column in mode 'exact')
+%# @item @var{mode}:    'exact' (default), 'table' or 'validate' (optional)
+%# @item @var{r}:       OUTPUT: MxN matrix with random variables distributed 
 %# according to Pearson type (vector)
-%# @item @var{type}:    OUTPUT: Pearson distribution type (I - VII) (scalar)
+%# @item @var{type}:    OUTPUT: Pearson distribution type (I - VII) (1xN vector)
 %# @end itemize
 %# The marginal distribution type is chosen according to the input parameters 
 %# out of the Pearson Type I-VII distribution family: @*
@@ -53,10 +65,21 @@
 %# @item @var{Type VI}  = beta-prime or F distribution
 %# @item @var{Type VII} = Student's t distribution 
 %# @end itemize
-%# @seealso{discount_factor}
+%# @seealso{discount_factor, pearson_marginal_cpp}
 %# @end deftypefn
 
-function [r,type] = get_marginal_distr_pearson(mu,sigma,skew,kurt,Z)
+function [r,type] = get_marginal_distr_pearson(mu,sigma,skew,kurt,Z,mode)
+
+if ( nargin < 6 )
+    mode = 'exact';
+end
+
+% transform all risk factors via inverse CDF lookup tables
+if ( ~strcmpi(mode,'exact') )
+    [r type] = get_marginal_distr_table(mu,sigma,skew,kurt,Z, ...
+                                            strcmpi(mode,'validate'));
+    return;
+end
 
 % Classify Pearson Distribution Type I - VII and calculate shape parameters 
 % (scale and location will be applied in the end)
@@ -69,6 +92,63 @@ end
 
 % generate standard marginal distribution (zero mean, unit variance) values for 
 % given correlated random numbers
+r = get_pearson_inv(retvec,Z);
+
+% apply scale and location parameter
+r = r.*sigma + mu;
+
+end % end of Main function
+
+%%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%##
+
+function [r type] = get_marginal_distr_table(mu,sigma,skew,kurt,Z,validate_flag)
+% transform all columns of Z with inverse CDF lookup tables on normal scores
+dim = columns(Z);
+mu = mu .* ones(1,dim);
+sigma = sigma .* ones(1,dim);
+skew = skew .* ones(1,dim);
+kurt = kurt .* ones(1,dim);
+if ( any(kurt <= 0.0) )
+    error('ERROR: get_marginal_distr_pearson: kurtosis has to be larger than 0.0\n');
+end
+z_min = -8;
+dz = 0.01;
+z_tab = (z_min:dz:-z_min)';
+u_tab = normcdf(z_tab);
+X_tab = zeros(rows(z_tab),dim);
+type = zeros(1,dim);
+retvec_cell = cell(1,dim);
+% classify Pearson type once per risk factor and evaluate exact quantiles
+for jj = 1 : 1 : dim
+    retvec_cell{jj} = classify_pearson(mu(jj),sigma(jj),skew(jj),kurt(jj));
+    type(jj) = retvec_cell{jj}(1);
+    X_tab(:,jj) = get_pearson_inv(retvec_cell{jj},u_tab,true) .* sigma(jj) + mu(jj);
+end
+% remove numerical noise of iterative inverse functions in the tails
+X_tab = cummax(X_tab);
+r = pearson_marginal_cpp(Z,X_tab,z_min,dz);
+
+% validate interpolation against exact inverse CDF
+if ( validate_flag == true )
+    for jj = 1 : 1 : dim
+        r_exact = get_pearson_inv(retvec_cell{jj},Z(:,jj),true) ...
+                                                    .* sigma(jj) + mu(jj);
+        fprintf('get_marginal_distr_pearson: risk factor %d (type %d): max. absolute error of inverse CDF table: %e\n', ...
+                                    jj,type(jj),max(abs(r(:,jj) - r_exact)));
+    end
+end
+end
+
+%%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%##
+
+function r = get_pearson_inv(retvec,Z,quantile_flag)
+% standard marginal distribution values (zero mean, unit variance) for uniform
+% random numbers. Type IV: empirical distribution of uncorrelated Pearson IV 
+% random numbers or exact quantiles (quantile_flag = true)
+if ( nargin < 3 )
+    quantile_flag = false;
+end
+type = retvec(1);
 if ( type == 0)
     % normal distribution
     r = norminv(Z,0,1);
@@ -100,10 +180,14 @@ elseif ( type == 4)
     nu = retvec(3);
     a = retvec(4);
     lambda = retvec(5);
-    r_uncorr = rpears4(m,nu,a,lambda,length(Z));
-    % uncorrelated distribution -> draw correlated univariate random numbers 
-    % from 'empirical' pearson type IV distribution:
-    r =  empirical_inv (Z, r_uncorr);
+    if ( quantile_flag == true )
+        r = pearson4_inv(m,nu,a,lambda,Z);
+    else
+        r_uncorr = rpears4(m,nu,a,lambda,length(Z));
+        % uncorrelated distribution -> draw correlated univariate random numbers 
+        % from 'empirical' pearson type IV distribution:
+        r =  empirical_inv (Z, r_uncorr);
+    end
 elseif ( type == 5)
     % inverse gamma distribution
     c1 = retvec(2); 
@@ -134,10 +218,49 @@ elseif ( type == 7)
     r = sqrt(c0 ./ (1-c2)) .* tinv(Z,nu);
 end
 
-% apply scale and location parameter
-r = r.*sigma + mu;
+end
 
-end % end of Main function
+%%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%##
+
+function r = pearson4_inv(m,nu,a,lam,U)
+% quantiles of Pearson type IV distribution: r = a*tan(theta) + lam, where 
+% theta has density cos(theta)^(2m-2) * exp(-nu*theta) on (-pi/2,pi/2).
+% CDF is integrated numerically (trapezoidal rule) and inverted by 
+% interpolation of log probabilities, tails are extrapolated by power law.
+b = 2*(m-1);
+n = 200000;
+theta = linspace(-pi/2,pi/2,n+1)';
+logf = b .* log(cos(theta)) - nu .* theta;
+f = exp(logf - max(logf));
+f([1,end]) = 0;
+area = (f(1:end-1) + f(2:end)) ./ 2;
+cdf_lo = [0; cumsum(area)];
+cdf_hi = flipud([0; cumsum(flipud(area))]);
+cdf_lo = cdf_lo ./ cdf_lo(end);
+cdf_hi = cdf_hi ./ cdf_hi(1);
+U = U(:);
+r = zeros(size(U));
+% lower half: interpolate in log probabilities
+idx = U <= 0.5;
+k = find(cdf_lo > 0 & [diff(cdf_lo) > 0; false]);
+r(idx) = interp_log_cdf(log(cdf_lo(k)),theta(k) + pi/2,log(U(idx)),b) - pi/2;
+% upper half: mirror image with survival function
+idx = ~idx;
+k = find(cdf_hi > 0 & [false; diff(cdf_hi) < 0]);
+r(idx) = pi/2 - interp_log_cdf(flipud(log(cdf_hi(k))), ...
+                flipud(pi/2 - theta(k)),log(1 - U(idx)),b);
+r = a .* tan(r) + lam;
+end
+
+function x = interp_log_cdf(log_cdf,x_node,log_u,b)
+% interpolate distance x from boundary for given log probabilities,
+% power law tail CDF ~ x^(b+1) below first node
+x = interp1(log_cdf,x_node,log_u,'linear');
+idx = log_u < log_cdf(1);
+x(idx) = x_node(1) .* exp((log_u(idx) - log_cdf(1)) ./ (b + 1));
+idx = log_u >= log_cdf(end);
+x(idx) = x_node(end);
+end
 
 %%#%#%#%#%#%#%#%#%#%#%#%#%#%#%#%##
 
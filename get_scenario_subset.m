@@ -0,0 +1,156 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{curve_struct} @var{index_struct} @var{riskfactor_struct} @var{surface_struct}] =} get_scenario_subset (@var{scenario}, @var{scen_idx}, @var{curve_struct}, @var{index_struct}, @var{riskfactor_struct}, @var{surface_struct})
+%#
+%# Return copies of all market data structures which contain only the Monte Carlo
+%# scenario rows @var{scen_idx} of MC timestep @var{scenario}. All other MC
+%# timesteps are removed from the returned objects, base and stress values are
+%# kept. Used for revaluating instruments on a sample of MC scenarios only.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{scenario}: MC timestep (e.g. '250d')
+%# @item @var{scen_idx}: vector with scenario numbers to keep
+%# @item @var{curve_struct}: structure with all curves
+%# @item @var{index_struct}: structure with all indizes
+%# @item @var{riskfactor_struct}: structure with all riskfactors
+%# @item @var{surface_struct}: structure with all surfaces
+%# @end itemize
+%# @seealso{instrument_approximation}
+%# @end deftypefn
+
+function [curve_struct index_struct riskfactor_struct surface_struct] = ...
+                get_scenario_subset(scenario, scen_idx, curve_struct, ...
+                            index_struct, riskfactor_struct, surface_struct)
+
+if ( nargin ~= 6 )
+    print_usage();
+end
+if ( strcmpi(scenario,'base') || strcmpi(scenario,'stress') )
+    error('get_scenario_subset: scenario >>%s<< is not a MC timestep',scenario);
+end
+scen_idx = scen_idx(:);
+
+% Curves: rates_mc (scenarios x nodes x timesteps)
+for ii = 1 : 1 : length(curve_struct)
+    if ~( isfield(curve_struct(ii),'object') && isobject(curve_struct(ii).object) )
+        continue;
+    end
+    obj = curve_struct(ii).object;
+    tmp_col = find(strcmp(scenario,obj.timestep_mc));
+    if ( ~isempty(tmp_col) && (~isempty(obj.rates_mc) || obj.rates_mc_handle > 0) )
+        rates_mc = obj.getValue(scenario);
+        if ( rows(rates_mc) > 1 )
+            rates_mc = rates_mc(scen_idx,:);
+        end
+        obj = obj.set('rates_mc',rates_mc,'timestep_mc',scenario);
+        curve_struct(ii).object = obj;
+    elseif ( ~isempty(tmp_col) && ~isempty(obj.rates_mc_loadings) )
+        % factor representation: subset of scores only
+        rates_mc_scores = obj.rates_mc_scores(:,:,tmp_col(1));
+        if ( rows(rates_mc_scores) > 1 )
+            rates_mc_scores = rates_mc_scores(scen_idx,:);
+        end
+        obj = obj.set('rates_mc_scores',rates_mc_scores, ...
+                'rates_mc_loadings',obj.rates_mc_loadings(:,:,tmp_col(1)), ...
+                'timestep_mc',scenario);
+        curve_struct(ii).object = obj;
+    end
+end
+
+% Indizes and risk factors: scenario_mc (scenarios x timesteps)
+index_struct = subset_scenario_mc(index_struct,scenario,scen_idx);
+riskfactor_struct = subset_scenario_mc(riskfactor_struct,scenario,scen_idx);
+
+% Surfaces: risk factor shock values stored in shock_struct
+for ii = 1 : 1 : length(surface_struct)
+    if ~( isfield(surface_struct(ii),'object') && isobject(surface_struct(ii).object) )
+        continue;
+    end
+    obj = surface_struct(ii).object;
+    shock_struct = obj.shock_struct;
+    if ( isfield(shock_struct,scenario) )
+        tmp_s = getfield(shock_struct,scenario);
+        if ( rows(tmp_s.values) > 1 )
+            tmp_s.values = tmp_s.values(scen_idx,:);
+        end
+        shock_struct = setfield(shock_struct,scenario,tmp_s);
+        obj.shock_struct = shock_struct;
+        surface_struct(ii).object = obj;
+    end
+end
+
+end
+
+% ------------------------------------------------------------------------------
+% helper function: subset of scenario_mc for Index and Riskfactor objects
+function input_struct = subset_scenario_mc(input_struct,scenario,scen_idx)
+    for ii = 1 : 1 : length(input_struct)
+        if ~( isfield(input_struct(ii),'object') && isobject(input_struct(ii).object) )
+            continue;
+        end
+        obj = input_struct(ii).object;
+        tmp_col = find(strcmp(scenario,obj.timestep_mc));
+        if ( ~isempty(tmp_col) && ~isempty(obj.scenario_mc) )
+            scenario_mc = obj.scenario_mc(:,tmp_col(1));
+            if ( rows(scenario_mc) > 1 )
+                scenario_mc = scenario_mc(scen_idx);
+            end
+            obj = obj.set('scenario_mc',scenario_mc,'timestep_mc',scenario);
+            input_struct(ii).object = obj;
+        end
+    end
+end
+
+%!test
+%! c = Curve();
+%! c = c.set('id','IR_TEST','nodes',[365,730],'rates_base',[0.01,0.02], ...
+%!           'rates_mc',[0.01,0.02;0.02,0.03;0.03,0.04;0.04,0.05],'timestep_mc','10d');
+%! curve_struct(1).id = c.id;
+%! curve_struct(1).object = c;
+%! r = Riskfactor();
+%! r = r.set('id','RF_TEST','scenario_mc',[0.1;0.2;0.3;0.4],'timestep_mc','10d');
+%! riskfactor_struct(1).id = r.id;
+%! riskfactor_struct(1).object = r;
+%! [cs is rs ss] = get_scenario_subset('10d',[2;4],curve_struct,struct(),riskfactor_struct,struct());
+%! assert(cs(1).object.getValue('10d'),[0.02,0.03;0.04,0.05],sqrt(eps))
+%! assert(cs(1).object.getValue('base'),[0.01,0.02],sqrt(eps))
+%! assert(rs(1).object.getValue('10d'),[0.2;0.4],sqrt(eps))
+%!test
+%! scenario_buffer_cpp('clear');
+%! rates = [0.01,0.02;0.02,0.03;0.03,0.04;0.04,0.05];
+%! c = Curve();
+%! c = c.set('id','IR_TEST','nodes',[365,730],'rates_base',[0.01,0.02], ...
+%!           'rates_mc',rates,'timestep_mc','10d','method_interpolation','linear');
+%! d = c.store_rates_mc();
+%! assert(isempty(d.get('rates_mc')))
+%! assert(d.get('rates_mc_handle') > 0)
+%! assert(d.getValue('10d'),rates)
+%! assert(d.getRate('10d',500),c.getRate('10d',500),sqrt(eps))
+%! curve_struct(1).id = d.id;
+%! curve_struct(1).object = d;
+%! cs = get_scenario_subset('10d',[2;4],curve_struct,struct(),struct(),struct());
+%! assert(cs(1).object.getValue('10d'),rates([2,4],:))
+%! assert(cs(1).object.get('rates_mc_handle'),0)
+%! % original curve keeps its buffer
+%! assert(d.getValue('10d'),rates)
+%! [no_buffers no_bytes] = scenario_buffer_cpp('info');
+%! assert([no_buffers no_bytes],[1,64])
+%! % dense rates on a copy keep the buffer of the original curve
+%! e = d.set('rates_mc',rates(1:2,:));
+%! assert(e.get('rates_mc_handle'),0)
+%! assert(d.getValue('10d'),rates)
+%! assert(scenario_buffer_cpp('info'),1)
+%! scenario_buffer_cpp('clear');
+%! assert(scenario_buffer_cpp('info'),0)
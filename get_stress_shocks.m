@@ -0,0 +1,44 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{stress_idx} @var{shock_defs}] =} get_stress_shocks (@var{stress_engine}, @var{object_id})
+%#
+%# Return all stresstest numbers and shock definitions of a market object
+%# from a compiled stress engine (see compile_stresstests). The object id
+%# is matched case insensitive.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{stress_engine}: compiled stresstests
+%# @item @var{object_id}: market object id
+%# @item @var{stress_idx}: RETURN: row vector with stresstest numbers
+%# @item @var{shock_defs}: RETURN: cell with shock definitions
+%# @end itemize
+%# @seealso{compile_stresstests}
+%# @end deftypefn
+
+function [stress_idx shock_defs] = get_stress_shocks(stress_engine, object_id)
+
+stress_idx = [];
+shock_defs = {};
+if ( isempty(stress_engine.object_ids) )
+    return;
+end
+obj_row = lookup(stress_engine.object_ids,lower(object_id),'m');
+if ( obj_row == 0 )
+    return;
+end
+[tmp_row stress_idx def_idx] = find(stress_engine.shock_matrix(obj_row,:));
+shock_defs = stress_engine.shock_defs(def_idx);
+
+end
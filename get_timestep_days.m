@@ -0,0 +1,56 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{days}] =} get_timestep_days (@var{timestep})
+%#
+%# Convert a MC timestep or MC path step string into number of days. Days are
+%# specified as 'Nd' (e.g. '10d'), years as 'Ny' with 365 days per year 
+%# (e.g. '1y' -> 365). Upper case units are accepted as well.
+%# NaN is returned if the string is no valid timestep.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{timestep}: timestep string (e.g. '250d', '1y')
+%# @item @var{days}: OUTPUT: number of days (NaN for invalid timesteps)
+%# @end itemize
+%# @seealso{octarisk}
+%# @end deftypefn
+
+function days = get_timestep_days(timestep)
+if nargin ~= 1
+    print_usage ();
+end
+
+days = NaN;
+if ~ischar(timestep)
+    return;
+end
+tokens = regexp(strtrim(timestep),'^(\d+)([dDyY])$','tokens','once');
+if isempty(tokens)
+    return;
+end
+days = str2double(tokens{1});
+if ( strcmpi(tokens{2},'y') )
+    days = 365 * days;
+end
+end
+
+%!assert(get_timestep_days('1d'),1)
+%!assert(get_timestep_days('250d'),250)
+%!assert(get_timestep_days('10D'),10)
+%!assert(get_timestep_days('1y'),365)
+%!assert(get_timestep_days(' 2Y '),730)
+%!assert(isnan(get_timestep_days('1m')))
+%!assert(isnan(get_timestep_days('d')))
+%!assert(isnan(get_timestep_days('1.5y')))
+%!assert(isnan(get_timestep_days(10)))
@@ -0,0 +1,248 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{ret_instr_obj} @var{approx_flag} @var{approx_error}] =} instrument_approximation (@var{instr_obj}, @var{valuation_date}, @var{scenario}, @var{instrument_struct}, @var{surface_struct}, @var{matrix_struct}, @var{curve_struct}, @var{index_struct}, @var{riskfactor_struct}, @var{para_object})
+%#
+%# Sensitivity based approximation of instrument values for all MC scenarios.
+%# Base sensitivities (delta, gamma, vega and rho for options, key rate
+%# durations and effective convexity for bonds) are combined with the risk
+%# factor shocks of all MC scenarios in one matrix multiplication.
+%# @*
+%# Error monitoring: the instrument is fully revaluated for a sample of
+%# @var{para_object.approx_sample_size} MC scenarios. The approximation error
+%# is the maximum absolute deviation of approximated and fully revaluated
+%# values relative to the maximum absolute full valuation PnL of the sample.
+%# If this error exceeds @var{para_object.approx_error_limit} (or if
+%# the instrument type is not supported), the instrument is fully revaluated
+%# for all scenarios (fallback).
+%# @*
+%# Supported instruments: Bonds with fixed cash flows (sub types FRB, ZCB,
+%# SWAP_FIXED and FAB without prepayments) and Options on single underlyings.
+%# Cash flows of approximated bonds are scenario independent and are set to
+%# the base cash flows. Floating and CMS bonds are always fully revaluated,
+%# since their cash flows depend on the MC scenario. Base and stress 
+%# scenarios are always fully revaluated.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{instr_obj}: instrument, which has to be valuated
+%# @item @var{valuation_date}: valuation date
+%# @item @var{scenario}: scenario ['base','stress', MC timestep: e.g. '250d']
+%# @item @var{instrument_struct}: structure with all instruments in session
+%# @item @var{surface_struct}: structure with all surfaces in session
+%# @item @var{matrix_struct}: structure with all matrizes in session
+%# @item @var{curve_struct}: structure with all curves in session
+%# @item @var{index_struct}: structure with all indizes in session
+%# @item @var{riskfactor_struct}: structure with all riskfactors in session
+%# @item @var{para_object}: parameter object
+%# @item @var{ret_instr_obj}: RETURN: evaluated instrument object
+%# @item @var{approx_flag}: RETURN: boolean, true if values are approximated
+%# @item @var{approx_error}: RETURN: approximation error on sample scenarios
+%# @end itemize
+%# @seealso{instrument_valuation, get_scenario_subset}
+%# @end deftypefn
+
+function [ret_instr_obj approx_flag approx_error] = instrument_approximation( ...
+                        instr_obj, valuation_date, scenario, ...
+                        instrument_struct, surface_struct, matrix_struct, ...
+                        curve_struct, index_struct, riskfactor_struct, para_object)
+
+if ( nargin < 10 )
+    print_usage();
+end
+
+approx_flag = false;
+approx_error = NaN;
+scen_number = para_object.scen_number;
+sample_size = min(para_object.approx_sample_size,scen_number);
+
+% A) check for supported instruments and scenarios, fallback otherwise
+if ( strcmpi(scenario,'base') || strcmpi(scenario,'stress') ...
+            || ~( strcmpi(instr_obj.type,'option') ...
+                    || ( strcmpi(instr_obj.type,'bond') ...
+                            && has_fixed_cashflows(instr_obj) ) ) ...
+            || sample_size < 1 || sample_size >= scen_number )
+    ret_instr_obj = instr_obj.valuate(valuation_date, scenario, ...
+                        instrument_struct, surface_struct, ...
+                        matrix_struct, curve_struct, index_struct, ...
+                        riskfactor_struct, para_object);
+    return;
+end
+
+% B) full valuation for sample scenarios (base sensitivities are calculated
+%    during valuation of MC scenarios)
+scen_idx = unique(round(linspace(1,scen_number,sample_size)))';
+[curve_sample index_sample riskfactor_sample surface_sample] = ...
+                get_scenario_subset(scenario, scen_idx, curve_struct, ...
+                            index_struct, riskfactor_struct, surface_struct);
+para_sample = para_object;
+para_sample.scen_number = length(scen_idx);
+sample_obj = instr_obj.valuate(valuation_date, scenario, ...
+                        instrument_struct, surface_sample, ...
+                        matrix_struct, curve_sample, index_sample, ...
+                        riskfactor_sample, para_sample);
+value_sample = sample_obj.getValue(scenario);
+
+% C) approximate all MC scenarios
+[theo_value retcode] = calc_approx_value(sample_obj, valuation_date, ...
+                        scenario, instrument_struct, surface_struct, ...
+                        curve_struct, index_struct);
+
+% D) error monitoring
+if ( retcode == 1 && rows(theo_value) == scen_number )
+    pnl_norm = max(abs(value_sample - sample_obj.getValue('base')));
+    if ( pnl_norm == 0 )
+        pnl_norm = max(abs(sample_obj.getValue('base')),eps);
+    end
+    approx_error = max(abs(theo_value(scen_idx) - value_sample)) / pnl_norm;
+    if ( approx_error <= para_object.approx_error_limit )
+        approx_flag = true;
+    end
+end
+
+if ( approx_flag == true )
+    ret_instr_obj = sample_obj.set('timestep_mc',scenario,'value_mc',theo_value);
+    % fixed cash flows are scenario independent: base cash flows for all scenarios
+    if ( strcmpi(sample_obj.type,'bond') )
+        ret_instr_obj = ret_instr_obj.set('cf_values_mc', ...
+                            ret_instr_obj.get('cf_values'),'timestep_mc_cf',scenario);
+    end
+else    % fallback: full valuation of all scenarios
+    ret_instr_obj = instr_obj.valuate(valuation_date, scenario, ...
+                        instrument_struct, surface_struct, ...
+                        matrix_struct, curve_struct, index_struct, ...
+                        riskfactor_struct, para_object);
+end
+
+end
+
+% ------------------------------------------------------------------------------
+% helper function: bonds with scenario independent cash flows
+function retval = has_fixed_cashflows(obj)
+    retval = false;
+    if ( any(strcmpi(obj.sub_type,{'FRB','SWAP_FIXED','ZCB'})) )
+        retval = true;
+    elseif ( strcmpi(obj.sub_type,'FAB') && ~( isprop(obj,'prepayment_flag') ...
+                                        && obj.prepayment_flag == true ) )
+        retval = true;
+    end
+end
+
+% ------------------------------------------------------------------------------
+% helper function: delta-gamma-vega approximation
+%   theo_value = value_base + X * g with scenario shock matrix X
+%   (scenarios x sensitivities) and sensitivity vector g
+function [theo_value retcode] = calc_approx_value(obj, valuation_date, ...
+                scenario, instrument_struct, surface_struct, curve_struct, ...
+                index_struct)
+    theo_value = [];
+    retcode = 0;
+    value_base = obj.getValue('base');
+
+    if ( strcmpi(obj.type,'bond') )
+        [disc_curve ret_code] = get_sub_object(curve_struct, obj.discount_curve);
+        if ( ret_code == 0 )
+            return;
+        end
+        % key rate durations or effective duration at Macaulay duration
+        key_terms = obj.key_term;
+        krd = obj.key_rate_eff_dur;
+        if ( isempty(krd) || length(krd) ~= length(key_terms) )
+            key_terms = max(round(obj.mac_duration * 365),1);
+            krd = obj.eff_duration;
+        end
+        dr = zeros(1,length(key_terms));
+        for ii = 1 : 1 : length(key_terms)
+            tmp_dr = disc_curve.getRate(scenario,key_terms(ii)) ...
+                                - disc_curve.getRate('base',key_terms(ii));
+            if ( ii == 1 )
+                dr = zeros(rows(tmp_dr),length(key_terms));
+            end
+            dr(:,ii) = tmp_dr;
+        end
+        % parallel equivalent shift for convexity term
+        if ( sum(krd) ~= 0 )
+            dr_par = dr * (krd(:) ./ sum(krd));
+        else
+            dr_par = mean(dr,2);
+        end
+        X = [-value_base .* dr, 0.5 .* value_base .* dr_par.^2];
+        g = [krd(:); obj.eff_convexity];
+
+    elseif ( strcmpi(obj.type,'option') )
+        [disc_curve ret_code] = get_sub_object(curve_struct, obj.discount_curve);
+        if ( ret_code == 0 )
+            return;
+        end
+        [vola_surf ret_code] = get_sub_object(surface_struct, obj.vola_surface);
+        if ( ret_code == 0 )
+            return;
+        end
+        % get underlying: index, risk factor or instrument with MC values
+        [underlying ret_code] = get_sub_object(index_struct, obj.underlying);
+        if ( ret_code == 0 )
+            [underlying ret_code] = get_sub_object(instrument_struct, obj.underlying);
+            if ( ret_code == 0 || strcmpi(class(underlying),'Synthetic') ...
+                    || sum(strcmp(scenario,underlying.timestep_mc)) == 0 )
+                return;
+            end
+        end
+        if ( strfind(underlying.get('id'),'RF_') )
+            S = Riskfactor.get_abs_values('GBM', ...
+                                underlying.getValue(scenario), obj.spot);
+            S_base = obj.spot;
+        else
+            S = underlying.getValue(scenario);
+            S_base = underlying.getValue('base');
+        end
+        if ( obj.call_flag == 1 )
+            moneyness_exponent = 1;
+        else
+            moneyness_exponent = -1;
+        end
+        tmp_dtm = datenum(obj.maturity_date,1) - valuation_date;
+        if ( tmp_dtm < 0 )
+            theo_value = zeros(rows(S),1);
+            retcode = 1;
+            return;
+        end
+        % shocks of underlying, volatility and interest rates
+        dS = S - S_base;
+        dvol = vola_surf.getValue(scenario,tmp_dtm, ...
+                                (S ./ obj.strike).^moneyness_exponent) ...
+             - vola_surf.getValue('base',tmp_dtm, ...
+                                (S_base ./ obj.strike).^moneyness_exponent);
+        dr = disc_curve.getRate(scenario,tmp_dtm) ...
+                                - disc_curve.getRate('base',tmp_dtm);
+        len = max([rows(dS),rows(dvol),rows(dr)]);
+        % vega and rho are given for 1 percentage point shifts
+        X = [dS .* ones(len,1), 0.5 .* dS.^2 .* ones(len,1), ...
+             100 .* dvol .* ones(len,1), 100 .* dr .* ones(len,1)];
+        g = [obj.theo_delta; obj.theo_gamma; obj.theo_vega; obj.theo_rho];
+    else
+        return;
+    end
+
+    theo_value = value_base + X * g;
+    retcode = 1;
+end
+
+%!test
+%! para_object = Parameter();
+%! para_object.scen_number = 1;
+%! c = Cash();
+%! c = c.set('id','CASH_TEST','value_base',100);
+%! [obj approx_flag approx_error] = instrument_approximation(c,736330,'base', ...
+%!                     struct(),struct(),struct(),struct(),struct(),struct(),para_object);
+%! assert(approx_flag,false)
+%! assert(obj.getValue('base'),100)
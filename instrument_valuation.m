@@ -52,6 +52,11 @@ end
 scen_number = para_object.scen_number;
 path_static = para_object.path_static;
 first_eval = para_object.first_eval;
+% base cash flows, base values and sensitivities do not depend on the scenario
+% set. They are calculated in the first evaluation only and reused for all
+% further scenario sets (first_eval == 0, see valuate_scenario_sets).
+calc_base = ( ~strcmpi(scenario,'base') && first_eval == 1 );
+calc_static = ( strcmpi(scenario,'base') || first_eval == 1 );
 
 
 
@@ -187,7 +192,7 @@ elseif ( strfind(tmp_type,'option') > 0 )
         end
     end
     % calculate value
-    if (~strcmpi(scenario,'base') )
+    if ( calc_base )
         % calculate greeks
         
         % different pricing methods for Beisser Basket instruments or all other 
@@ -216,7 +221,8 @@ elseif ( strfind(tmp_type,'option') > 0 )
         
     else    % basket option types Levy or VCV
         option = option.calc_value(valuation_date,scenario,tmp_underlying_obj, ...
-                                tmp_rf_curve_obj,tmp_vola_surf_obj,path_static);
+                                tmp_rf_curve_obj,tmp_vola_surf_obj,path_static, ...
+                                para_object);
     end
     
     % store option object:
@@ -268,13 +274,13 @@ elseif ( strfind(tmp_type,'swaption') > 0 )
                                 riskfactor_struct, para_object);
         end
         %Calculate base values of swaption
-        if (~strcmpi(scenario,'base') )
+        if ( calc_base )
             swaption = swaption.calc_value(valuation_date,'base',tmp_rf_curve_obj,tmp_vola_surf_obj,fixed_leg,float_leg);
         end
         swaption = swaption.calc_value(valuation_date,scenario,tmp_rf_curve_obj,tmp_vola_surf_obj,fixed_leg,float_leg);
     else     % use reference curve for extracting forward rates
         %Calculate base values of swaption
-        if (~strcmpi(scenario,'base') )
+        if ( calc_base )
             swaption = swaption.calc_value(valuation_date,'base',tmp_rf_curve_obj,tmp_vola_surf_obj);
         end
         swaption = swaption.calc_value(valuation_date,scenario,tmp_rf_curve_obj,tmp_vola_surf_obj);
@@ -362,14 +368,16 @@ elseif (strcmpi(tmp_type,'forward') )
         tmp_und_crv_obj = [];
     end
     %Calculate values of  forward
-    if (~strcmpi(scenario,'base') )
+    if ( calc_base )
     % Base value
         forward = forward.calc_value(valuation_date,'base',tmp_curve_object, ...
                         tmp_underlying_object,tmp_und_crv_obj,index_struct);
     end
     % calculate sensitivities
+    if ( calc_static )
         forward = forward.calc_sensitivities(valuation_date,tmp_curve_object, ...
                         tmp_underlying_object,tmp_und_crv_obj,index_struct);
+    end
     
     % calculation of value for scenario               
         forward = forward.calc_value(valuation_date,scenario,tmp_curve_object, ...
@@ -445,7 +453,9 @@ elseif ( sum(strcmpi(tmp_type,'bond')) > 0 )
     % b) Get Cashflow dates and values of instrument depending on type (cash settlement):
         if( sum(strcmpi(tmp_sub_type,{'FRB','SWAP_FIXED','ZCB','CASHFLOW'})) > 0 )       % Fixed Rate Bond instruments (incl. swap fixed leg)
             % rollout cash flows for all scenarios
-            bond = bond.rollout('base',valuation_date);
+            if ( calc_static )
+                bond = bond.rollout('base',valuation_date);
+            end
             % cash flow values are equal for base and all scenarios -> copy values without new rollout
             if ( strcmpi(scenario,'stress') && ~strcmpi(scenario,'base'))
                bond = bond.set('cf_values_stress',bond.get('cf_values'));
@@ -473,7 +483,7 @@ elseif ( sum(strcmpi(tmp_type,'bond')) > 0 )
                 fprintf('WARNING: instrument_valuation: No consumer price index_struct object found for id >>%s<<\n',cpi_id);
             end
             % cashflow rollout      
-            if (~strcmpi(scenario,'base') )
+            if ( calc_base )
                 bond = bond.rollout('base',valuation_date,iec_curve,hist_curve,cpi_index);
             end
             bond = bond.rollout(scenario,valuation_date,iec_curve,hist_curve,cpi_index);
@@ -508,12 +518,14 @@ elseif ( sum(strcmpi(tmp_type,'bond')) > 0 )
                     fprintf('WARNING: instrument_valuation: No discount curve_struct object found for id >>%s<<\n',tmp_ir_curve);
                 end
             
-                if (~strcmpi(scenario,'base') )
+                if ( calc_base )
                     bond = bond.rollout('base',valuation_date,psa_curve,pp_surface,tmp_curve_object);
                 end
                 bond = bond.rollout(scenario,valuation_date,psa_curve,pp_surface,tmp_curve_object);
             else % fixed amortizing bond without prepayment
-                bond = bond.rollout('base',valuation_date);
+                if ( calc_static )
+                    bond = bond.rollout('base',valuation_date);
+                end
                 % cash flow values are equal for base and all scenarios -> copy values without new rollout
                 if ( strcmpi(scenario,'stress') && ~strcmpi(scenario,'base'))
                    bond = bond.set('cf_values_stress',bond.get('cf_values'));
@@ -526,7 +538,7 @@ elseif ( sum(strcmpi(tmp_type,'bond')) > 0 )
                 tmp_ref_curve   = bond.get('reference_curve');
                 tmp_ref_object  = get_sub_object(curve_struct, tmp_ref_curve);
             % rollout cash flows for all scenarios
-                if (~strcmpi(scenario,'base') )
+                if ( calc_base )
                     bond = bond.rollout('base',tmp_ref_object,valuation_date);
                 end
                 bond = bond.rollout(scenario,tmp_ref_object,valuation_date);
@@ -537,7 +549,7 @@ elseif ( sum(strcmpi(tmp_type,'bond')) > 0 )
                 tmp_surface     = bond.get('vola_surface');
                 tmp_surf_object = get_sub_object(surface_struct, tmp_surface);
             % rollout cash flows for all scenarios 
-                if (~strcmpi(scenario,'base') )
+                if ( calc_base )
                     bond = bond.rollout('base', valuation_date,tmp_ref_object,tmp_surf_object);
                 end
                 bond = bond.rollout(scenario, valuation_date,tmp_ref_object,tmp_surf_object);
@@ -568,7 +580,7 @@ elseif ( sum(strcmpi(tmp_type,'bond')) > 0 )
                 tmp_ref_object = Curve();
             end 
             % rollout cash flows for all scenarios 
-            if (~strcmpi(scenario,'base') )
+            if ( calc_base )
                 bond = bond.rollout('base', valuation_date, ...
                                     tmp_hazard_object,tmp_ref_asset_object, ...
                                     tmp_ref_object);
@@ -584,7 +596,7 @@ elseif ( sum(strcmpi(tmp_type,'bond')) > 0 )
                 tmp_surface      = bond.get('stochastic_surface');
                 tmp_surf_obj     = get_sub_object(riskfactor_struct, tmp_surface);
             % rollout cash flows for all scenarios
-                if (~strcmpi(scenario,'base') )
+                if ( calc_base )
                     bond = bond.rollout('base',tmp_rf_obj,tmp_surf_obj);
                 end
                 bond = bond.rollout(scenario,tmp_rf_obj,tmp_surf_obj); 
@@ -596,17 +608,10 @@ elseif ( sum(strcmpi(tmp_type,'bond')) > 0 )
             bond = bond.calc_spread_over_yield(valuation_date,tmp_curve_object);
         end
     % d) get net present value of all Cashflows (discounting of all cash flows)
-       if (~strcmpi(scenario,'base') )
+       if ( calc_base )
             bond = bond.calc_value (valuation_date,'base',tmp_curve_object);
-            % calculate sensitivities
-            if( strcmpi(tmp_sub_type,'FRN') || strcmpi(tmp_sub_type,'SWAP_FLOATING'))
-                bond = bond.calc_sensitivities(valuation_date,tmp_curve_object,tmp_ref_object);
-            else
-                bond = bond.calc_sensitivities(valuation_date,tmp_curve_object);
-            end
-            % calculate key rate durations and convexities - computationally very expensive!
-            bond = bond.calc_key_rates(valuation_date,tmp_curve_object);
-        else
+       end
+       if ( calc_static )
             % calculate sensitivities
             if( strcmpi(tmp_sub_type,'FRN') || strcmpi(tmp_sub_type,'SWAP_FLOATING'))
                 bond = bond.calc_sensitivities(valuation_date,tmp_curve_object,tmp_ref_object);
@@ -620,13 +625,13 @@ elseif ( sum(strcmpi(tmp_type,'bond')) > 0 )
         bond = bond.calc_value (valuation_date,scenario,tmp_curve_object);
         
         % calculate yield to maturity
-        %if (strcmpi(scenario,'base') )
-        bond = bond.calc_yield_to_mat(valuation_date);
-        if( strcmpi(tmp_sub_type,'ILB')) % calculate break even inflation rate
-			bond = bond.calc_ilb_break_even (valuation_date, ...
-							   tmp_curve_object,iec_curve,hist_curve,cpi_index);				
+        if ( calc_static )
+            bond = bond.calc_yield_to_mat(valuation_date);
+            if( strcmpi(tmp_sub_type,'ILB')) % calculate break even inflation rate
+                bond = bond.calc_ilb_break_even (valuation_date, ...
+                            tmp_curve_object,iec_curve,hist_curve,cpi_index);
+            end
         end
-        %end
 
     % e) store bond object:
     ret_instr_obj = bond;
@@ -637,9 +642,12 @@ elseif ( sum(strcmpi(tmp_type,'bond')) > 0 )
 elseif strcmpi(tmp_type,'retail')
     % Using Retail class
         obj = instr_obj;
+    % cash flows rolled out in batch before valuation (see rollout_retail_batch)
+        batch_flag = any(strcmpi(obj.cf_batch_scenarios,scenario));
+        batch_base_flag = any(strcmpi(obj.cf_batch_scenarios,'base'));
         
     % check, whether instrument already valuated for current scenario --> delete properties
-       if ~(strcmpi(scenario,'base') || strcmpi(scenario,'stress'))
+       if ~(strcmpi(scenario,'base') || strcmpi(scenario,'stress') || batch_flag)
            if ( sum(strcmpi(obj.timestep_mc_cf,scenario))>0)   % scenario already exists
                obj = obj.set('timestep_mc_cf',{});
                obj = obj.set('cf_values_mc',[]);
@@ -657,7 +665,9 @@ elseif strcmpi(tmp_type,'retail')
     % b) Get Cashflow dates and values of instrument depending on type (cash settlement):
         if( sum(strcmpi(tmp_sub_type,{'SAVPLAN'})) > 0 )       % Savings Plan
             % rollout cash flows for all scenarios
-            obj = obj.rollout('base',valuation_date);
+            if ( calc_static && ~batch_base_flag )
+                obj = obj.rollout('base',valuation_date);
+            end
             % cash flow values are equal for base and all scenarios -> copy values without new rollout
             if ( strcmpi(scenario,'stress') && ~strcmpi(scenario,'base'))
                obj = obj.set('cf_values_stress',obj.get('cf_values'));
@@ -666,10 +676,12 @@ elseif strcmpi(tmp_type,'retail')
             end         
         elseif( strcmpi(tmp_sub_type,'DCP') )       % Defined Contribution Plan
             % rollout cash flows for all scenarios
-                if (~strcmpi(scenario,'base') )
+                if ( calc_base && ~batch_base_flag )
                     obj = obj.rollout('base',valuation_date,tmp_curve_object);
                 end
-                obj = obj.rollout(scenario,valuation_date,tmp_curve_object);
+                if ~( batch_flag )
+                    obj = obj.rollout(scenario,valuation_date,tmp_curve_object);
+                end
         elseif( strcmpi(tmp_sub_type,'RETEXP') || strcmpi(tmp_sub_type,'GOVPEN'))       % Retirement Expenses or Government Pension
 			% get inflation expectation curve
 			tmp_infl_exp_curve  = obj.get('infl_exp_curve');
@@ -686,10 +698,12 @@ elseif strcmpi(tmp_type,'retail')
 			
 			if (obj.widow_pension_flag == false)
 				% rollout cash flows for all scenarios
-				if (~strcmpi(scenario,'base') )
+				if ( calc_base && ~batch_base_flag )
 					obj = obj.rollout('base',valuation_date,infl_curve,longev_table);
 				end
-				obj = obj.rollout(scenario,valuation_date,infl_curve,longev_table);
+				if ~( batch_flag )
+					obj = obj.rollout(scenario,valuation_date,infl_curve,longev_table);
+				end
 			elseif (obj.widow_pension_flag == true)
 				% get longevity table widow
 				tmp_longev_table_widow  = obj.get('longevity_table_widow');
@@ -698,10 +712,12 @@ elseif strcmpi(tmp_type,'retail')
 					fprintf('WARNING: instrument_valuation: No curve_struct object found for id >>%s<<\n',tmp_longev_table_widow);
 				end
 				% rollout cash flows for all scenarios
-				if (~strcmpi(scenario,'base') )
+				if ( calc_base && ~batch_base_flag )
 					obj = obj.rollout('base',valuation_date,infl_curve,longev_table,longev_table2);
 				end
-				obj = obj.rollout(scenario,valuation_date,infl_curve,longev_table,longev_table2);
+				if ~( batch_flag )
+					obj = obj.rollout(scenario,valuation_date,infl_curve,longev_table,longev_table2);
+				end
 			end
 		
 		elseif( strcmpi(tmp_sub_type,'HC'))       % Retirement Expenses or Government Pension
@@ -730,25 +746,25 @@ elseif strcmpi(tmp_type,'retail')
         end 
 	% c) final valuation of retail object (incl. base valuation)
 		if( strcmpi(tmp_sub_type,'HC')) 
-			if (~strcmpi(scenario,'base') )
+			if ( calc_base )
 				obj = obj.calc_value (valuation_date,'base',tmp_curve_object, infl_curve, longev_table, equity_rf);
 			end
 			obj = obj.calc_value (valuation_date,scenario,tmp_curve_object, infl_curve, longev_table, equity_rf);
 		else
-			if (~strcmpi(scenario,'base') )
+			if ( calc_base )
 				obj = obj.calc_value (valuation_date,'base',tmp_curve_object);
 			end
 			obj = obj.calc_value (valuation_date,scenario,tmp_curve_object);
         end
     % d) calculate (key rate) durations and convexities
-		%if (strcmpi(scenario,'base') )
-		if( strcmpi(tmp_sub_type,'HC')) 
-			obj = obj.calc_sensitivities (valuation_date, tmp_curve_object, infl_curve, longev_table);
-		else
-			obj = obj.calc_sensitivities(valuation_date,tmp_curve_object);
-			%obj = obj.calc_key_rates(valuation_date,tmp_curve_object);
+		if ( calc_static )
+			if( strcmpi(tmp_sub_type,'HC')) 
+				obj = obj.calc_sensitivities (valuation_date, tmp_curve_object, infl_curve, longev_table);
+			else
+				obj = obj.calc_sensitivities(valuation_date,tmp_curve_object);
+				%obj = obj.calc_key_rates(valuation_date,tmp_curve_object);
+			end
 		end
-        %end    
     % store retail object:
     ret_instr_obj = obj;
 % ==============================================================================
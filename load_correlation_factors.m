@@ -0,0 +1,105 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{L} @var{D} @var{cell_rf}] =} load_correlation_factors (@var{path_mktdata}, @var{file_corr_factors})
+%#
+%# Load factor loadings of a factor correlation model from a csv file.
+%# The first column contains the risk factor id, all further columns the
+%# loadings on the factors (one row per risk factor), e.g.
+%# @example
+%# @group
+%# riskfactorCHAR,factor_1NMBR,factor_2NMBR
+%# RF_EQ_DE,0.8,0.1
+%# RF_IR_EUR,0.3,-0.4
+%# @end group
+%# @end example
+%# The idiosyncratic standard deviations are given by D = sqrt(1 - sum(L.^2,2)),
+%# so that L * L' + diag(D.^2) is a valid correlation matrix.
+%# Lines containing '%' or '#' are treated as comments.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{path_mktdata}: path to market data folder
+%# @item @var{file_corr_factors}: filename of factor loadings file
+%# @item @var{L}: OUTPUT: factor loadings (n x k)
+%# @item @var{D}: OUTPUT: idiosyncratic standard deviations (n x 1)
+%# @item @var{cell_rf}: OUTPUT: cell with risk factor ids (order of rows of L)
+%# @end itemize
+%# @seealso{get_correlation_factors, load_correlation_matrix}
+%# @end deftypefn
+
+function [L D cell_rf] = load_correlation_factors(path_mktdata,file_corr_factors)
+
+if ( nargin < 2 )
+    print_usage ();
+end
+separator = ',';
+file_in = strcat(path_mktdata,'/',file_corr_factors);
+
+% A) parse input data: remove comments and empty lines
+in = fileread(file_in);
+lines = strsplit(in,{"\r\n","\n","\r"});
+clear in;
+lines_out = {};
+for kk = 1 : 1 : length(lines)
+    tmp_lines = strtrim(lines{kk});
+    if ( ~isempty(tmp_lines) && isempty(regexp(tmp_lines,'[%#]','once')) )
+        lines_out{ length(lines_out) + 1} = tmp_lines;
+    end
+end
+if ( length(lines_out) < 2 )
+    error('load_correlation_factors: no factor loadings found in file >>%s<<\n',file_in);
+end
+
+% B) first row is header with risk factor column and factor columns
+tmp_header = strsplit(lines_out{1},separator);
+no_factors = length(tmp_header) - 1;
+no_rf = length(lines_out) - 1;
+cell_rf = cell(1,no_rf);
+L = zeros(no_rf,no_factors);
+for jj = 1 : 1 : no_rf
+    tmp_cell = strsplit(lines_out{jj+1},separator);
+    if ( length(tmp_cell) ~= no_factors + 1 )
+        error('load_correlation_factors: expected >>%d<< loadings for risk factor >>%s<<\n', ...
+                                            no_factors,tmp_cell{1});
+    end
+    cell_rf{jj} = upper(strtrim(tmp_cell{1}));
+    L(jj,:) = str2double(tmp_cell(2:end));
+end
+if ( any(isnan(L(:))) )
+    error('load_correlation_factors: factor loadings are not NUMERIC\n');
+end
+
+% C) idiosyncratic standard deviations
+communality = sum(L.^2,2);
+if ( any(communality > 1 + sqrt(eps)) )
+    error('load_correlation_factors: sum of squared loadings larger than 1 for risk factor >>%s<<\n', ...
+                                    cell_rf{find(communality > 1 + sqrt(eps),1)});
+end
+D = sqrt(max(1 - communality,0));
+
+fprintf('SUCCESS: loaded >>%d<< factor loadings for >>%d<< riskfactors. \n',no_factors,no_rf);
+
+end
+
+%!test
+%! tmp_file = tempname();
+%! fid = fopen(tmp_file,'w');
+%! fprintf(fid,'riskfactorCHAR,factor_1NMBR,factor_2NMBR\n# comment\nRF_EQ_DE,0.8,0.1\nrf_ir_eur,0.3,-0.4\n');
+%! fclose(fid);
+%! [pathstr name ext] = fileparts(tmp_file);
+%! [L D cell_rf] = load_correlation_factors(pathstr,[name ext]);
+%! delete(tmp_file);
+%! assert(L,[0.8,0.1;0.3,-0.4],sqrt(eps))
+%! assert(D,sqrt([0.35;0.75]),sqrt(eps))
+%! assert(cell_rf,{'RF_EQ_DE','RF_IR_EUR'})
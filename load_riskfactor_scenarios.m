@@ -13,6 +13,8 @@
 %# -*- texinfo -*-
 %# @deftypefn {Function File} {[@var{riskfactor_struct} @var{rf_failed_cell}] =} load_riskfactor_scenarios(@var{riskfactor_struct}, @var{M_struct}, @var{mc_timestep}, @var{mc_timestep_days},@var{para_object})
 %# Generate MC scenario shock values for risk factor curve objects. Store all MC scenario shock values in provided struct and return the final struct and a cell containing all failed risk factor ids.
+%# The process parameters of all risk factors are collected in one table and the shock values of all risk factors are calculated in one pass by the oct-file riskfactor_scenarios_cpp.
+%# If M_struct contains MC paths (field path: scenarios x path steps x risk factors, field path_days: path steps in days), the shock values of all path steps are stored as scenario x step block (scenario_path) in each risk factor object.
 %# @end deftypefn
 
 function [tmp_riskfactor_struct rf_failed_cell ] = load_riskfactor_scenarios(riskfactor_struct,M_struct,riskfactor_cell,mc_timestep,mc_timestep_days,para_object)
@@ -36,59 +38,78 @@ try
 	tmp_ts  = mc_timestep;    % get timestep string
 	ts      = mc_timestep_days;  % get timestep days
 	Y_tmp   = M_struct( 1 ).matrix; % get matrix with correlated random numbers for all risk factors
-	for ii = 1 : 1 : length( riskfactor_cell )    % loop via all risk factors in order of their appearance in corr_matrix: 
-		rf_id = riskfactor_cell{ii};              % calculate risk factor deltas in each MC scenario
+	% parameter table of all risk factors in order of their appearance in corr_matrix:
+	% [model_id, drift, sigma, start, mr_level, mr_rate]
+	rf_para = zeros(length( riskfactor_cell ),6);
+	for ii = 1 : 1 : length( riskfactor_cell )
+		rf_id = riskfactor_cell{ii};
         tmp_rf_type = strsplit(rf_id,'_'){2};
 		rf_object = tmp_riskfactor_struct(ii).object;
 		tmp_model = rf_object.model;
-		tmp_drift = rf_object.mean / 250;
-		tmp_sigma = rf_object.std;
 		tmp_id = rf_object.id;
-		% correlated random variables vector from corr. random matrix M:
-		Y       = Y_tmp(:,ii);
 		% Case Dependency:
         % only update risk factor if risk factor type is part of shred
         if (strcmpi(shred_type,'TOTAL') || (sum(strcmpi(tmp_rf_type,shred_type))>0 ))
+			rf_para(ii,2) = rf_object.mean / 250;
+			rf_para(ii,3) = rf_object.std;
 			% Geometric Brownian Motion Riskfactor Modeling
 				if ( strcmpi(tmp_model,'GBM') || strcmpi(tmp_model,'SLN')  )
-					tmp_delta       = Y + ((tmp_drift - 0.5 .* (tmp_sigma./ sqrt(250)).^2) .* ts);
+					rf_para(ii,1) = 1;
 			% Brownian Motion Riskfactor Modeling
 				elseif ( strcmpi(tmp_model,'BM') )
-					tmp_delta       = Y + (tmp_drift * ts);
-			% Black-Karasinski (log-normal mean reversion) Riskfactor Modeling
-				elseif ( strcmpi(tmp_model,'BKM') )
-					% startlevel, sigma_p_a, mr_level, mr_rate
-					tmp_start       = rf_object.value_base;
-					tmp_mr_level    = rf_object.mr_level;
-					tmp_mr_rate     = rf_object.mr_rate;    
-					tmp_delta       = Y + (tmp_mr_rate * ( tmp_mr_level - tmp_start ) * ts);
-			% Ornstein-Uhlenbeck process 
-				elseif ( strcmpi(tmp_model,'OU') )    
-					% startlevel, sigma_p_a, mr_level, mr_rate
-					tmp_start       = rf_object.value_base;
-					tmp_mr_level    = rf_object.mr_level;
-					tmp_mr_rate     = rf_object.mr_rate;     
-					tmp_delta       = Y + (tmp_mr_rate * ( tmp_mr_level - tmp_start ) * ts);
-			% Square-root diffusion process
-				elseif ( strcmpi(tmp_model,'SRD') )    
-					% startlevel, sigma_p_a, mr_level, mr_rate
-					tmp_start       = rf_object.value_base;
-					tmp_mr_level    = rf_object.mr_level;
-					tmp_mr_rate     = rf_object.mr_rate;     
-					tmp_delta       = sqrt(tmp_start) .* Y + (tmp_mr_rate * ( tmp_mr_level - tmp_start ) * ts);
-					if (2 * tmp_mr_rate * tmp_mr_level < std(Y).^2)
-						fprintf('WARNING: load_riskfactor_scenarios: Square root diffusion process can lead to negative values for risk factor >>%s<<: 2*mr_rate*mr_level <= volatility^2.\n',tmp_id);
+					rf_para(ii,1) = 2;
+			% Black-Karasinski (log-normal mean reversion), Ornstein-Uhlenbeck 
+			% and square-root diffusion process: startlevel, mr_level, mr_rate
+				elseif ( strcmpi(tmp_model,'BKM') || strcmpi(tmp_model,'OU') ...
+											|| strcmpi(tmp_model,'SRD') )
+					if ( strcmpi(tmp_model,'BKM') )
+						rf_para(ii,1) = 3;
+					elseif ( strcmpi(tmp_model,'OU') )
+						rf_para(ii,1) = 4;
+					else
+						rf_para(ii,1) = 5;
+						if (2 * rf_object.mr_rate * rf_object.mr_level < std(Y_tmp(:,ii)).^2)
+							fprintf('WARNING: load_riskfactor_scenarios: Square root diffusion process can lead to negative values for risk factor >>%s<<: 2*mr_rate*mr_level <= volatility^2.\n',tmp_id);
+						end
 					end
+					rf_para(ii,4) = rf_object.value_base;
+					rf_para(ii,5) = rf_object.mr_level;
+					rf_para(ii,6) = rf_object.mr_rate;
+				else
+					error('Unknown model >>%s<<',tmp_model);
 				end
         else % risk factor NOT to be shocked - not part of shred! Default case:
             fprintf('OCTARISK::load_riskfactor_scenarios: Riskfactor >>%s<< not part of shred, providing base values\n',tmp_id);
-            % do not store shocked scenarios
-            %tmp_delta = rf_object.value_base .* ones(numel(Y),1);
-            tmp_delta = zeros(numel(Y),1);
+            % do not store shocked scenarios (model_id 0: zero increments)
         end
-		
+	end  % close loop via all risk factors  
+	
+	% calculate risk factor MC scenario values of all risk factors in one pass
+	tmp_id = 'Dummy';
+	delta_matrix = riskfactor_scenarios_cpp(Y_tmp,rf_para,ts);
+	clear Y_tmp;
+	% path mode: shock values for all path steps (drift up to path step)
+	use_path = isfield(M_struct,'path') && ~isempty(M_struct( 1 ).path);
+	if ( use_path )
+		path_days = M_struct( 1 ).path_days;
+		no_steps = size(M_struct( 1 ).path,2);
+		no_rf = size(M_struct( 1 ).path,3);
+		delta_path = zeros(rows(delta_matrix),no_steps,no_rf);
+		for kk = 1 : 1 : no_steps
+			delta_path(:,kk,:) = reshape(riskfactor_scenarios_cpp( ...
+						reshape(M_struct( 1 ).path(:,kk,:),[],no_rf),rf_para, ...
+						path_days(kk)),[],1,no_rf);
+		end
+	end
+	
+	for ii = 1 : 1 : length( riskfactor_cell )
+		rf_object = tmp_riskfactor_struct(ii).object;
+		tmp_id = rf_object.id;
         % store increment for actual riskfactor and scenario number
-        rf_object = rf_object.set('scenario_mc',tmp_delta,'timestep_mc',tmp_ts);
+        rf_object = rf_object.set('scenario_mc',delta_matrix(:,ii),'timestep_mc',tmp_ts);
+        if ( use_path )
+			rf_object = rf_object.set('scenario_path',delta_path(:,:,ii),'timestep_path',path_days);
+        end
 		% store risk factor object back into struct:
 		tmp_riskfactor_struct( ii ).object = rf_object;   
 		number_riskfactors = number_riskfactors + 1;
@@ -13,12 +13,17 @@
 %# -*- texinfo -*-
 %# @deftypefn {Function File} {[@var{riskfactor_struct} @var{rf_failed_cell}] =} load_riskfactor_stresses(@var{riskfactor_struct}, @var{stresstest_struct})
 %# Generate stresses for risk factor objects (except curves). Store all stresses in provided struct and return the final struct and a cell containing all failed risk factor ids.
+%# The stresstests are compiled once (see compile_stresstests), only the
+%# stresstests containing shocks of a risk factor are evaluated. A precompiled
+%# stress engine can be passed instead of the stresstest struct.
 %# @end deftypefn
 
 function [riskfactor_struct rf_failed_cell ] = load_riskfactor_stresses(riskfactor_struct,stresstest_struct)
 
 rf_failed_cell = {};
 number_riskfactors = 0;
+stress_engine = compile_stresstests(stresstest_struct);
+number_stresses = stress_engine.number_stresses;
 % loop via all riskfactors, take IDs from struct und apply delta
 for kk = 1 : 1 : length( riskfactor_struct )        % check whether risk factor is contained in risk type cell 
     tmp_object = riskfactor_struct( kk ).object;
@@ -26,20 +31,13 @@ for kk = 1 : 1 : length( riskfactor_struct )        % check whether risk factor
     % update only Equity, Commodity, FX risk factors etc.
     if ~( strcmpi(tmp_object.type,{'RF_IR','RF_VOLA','RF_SPREAD'}))
         try
-            stress_values = zeros(length(stresstest_struct),1) ;
+            stress_values = zeros(number_stresses,1) ;
             number_riskfactors = number_riskfactors + 1;
-                % iterate via all stress definitions
-            for ii = 1:1:length(stresstest_struct)
-                    % get struct with all market object shocks
-                    subst = stresstest_struct(ii).objects;
-                    % get appropriate market object
-                    [shockstruct retcode] = get_sub_struct(subst,tmp_object.id);
-                    if ( retcode == 1)      % object_id is contained in stress
-                            stress_values(ii) = return_stress_shocks(tmp_object,shockstruct);
-                    else
-                            % apply stress shock base value
-                            stress_values(ii) = 0.0; % tmp_object.getValue('base');
-                    end
+            % iterate via all stress definitions of risk factor (all other
+            % stresses: apply stress shock base value 0.0)
+            [stress_idx shock_defs] = get_stress_shocks(stress_engine,tmp_object.id);
+            for ii = 1:1:length(stress_idx)
+                stress_values(stress_idx(ii)) = return_stress_shocks(tmp_object,shock_defs{ii});
             end
             % set instrument stress vector
             tmp_object = tmp_object.set('scenario_stress',stress_values);
@@ -53,7 +51,7 @@ end     % end for loop through all risk factors
  
 rf_failed_cell = unique(rf_failed_cell); 
 % returning statistics
-fprintf('SUCCESS: specified >>%d<< risk factor stresses in %d stresstests.\n',number_riskfactors,length(stresstest_struct));
+fprintf('SUCCESS: specified >>%d<< risk factor stresses in %d stresstests.\n',number_riskfactors,number_stresses);
 if (length(rf_failed_cell) > 0 )
     fprintf('WARNING: >>%d<< risk factor stress generations failed: \n',length(rf_failed_cell));
     rf_failed_cell
@@ -11,16 +11,34 @@
 %# details.
 
 %# -*- texinfo -*-
-%# @deftypefn {Function File} {[@var{rf_ir_cur_cell} @var{curve_struct}] =} load_yieldcurves(@var{curve_struct}, @var{riskfactor_struct}, @var{mc_timestep}, @var{path_output}, @var{saving})
+%# @deftypefn {Function File} {[@var{rf_ir_cur_cell} @var{curve_struct}] =} load_yieldcurves(@var{curve_struct}, @var{riskfactor_struct}, @var{mc_timestep}, @var{path_output}, @var{saving}, @var{run_mc}, @var{para_object})
 %# Generate curve objects from risk factor objects. Store all curves in provided 
 %# struct and return the final struct and a cell containing all interest rate 
 %# risk factor currency / ratings.
+%# If parameter use_curve_factors of the optional @var{para_object} is set, 
+%# MC scenario shocks are stored in a factor representation (see 
+%# compress_curve_scenarios) with maximum absolute reconstruction error 
+%# curve_factor_tolerance. Each MC timestep is compressed as it is loaded; if
+%# one timestep can not be compressed, a warning is printed and the dense
+%# rates of all timesteps are stored. If parameter use_scenario_buffer is set, MC scenario 
+%# shocks are moved into the shared scenario buffer pool (see scenario_buffer_cpp).
+%# Intermediate MC path steps of the risk factors (see get_path_timesteps) are
+%# stored as additional MC timesteps of the curve, named in days (e.g. '90d').
 %# @end deftypefn
 
 function [rf_ir_cur_cell curve_struct curve_failed_cell] = load_yieldcurves( ...
-                curve_struct,riskfactor_struct,mc_timestep,path_output,saving,run_mc)
+                curve_struct,riskfactor_struct,mc_timestep,path_output,saving,run_mc,para_object)
 
 curve_failed_cell = {};
+% optional factor representation of curve scenarios
+use_curve_factors = false;
+use_scenario_buffer = false;
+if ( nargin > 6 )
+    use_curve_factors = para_object.use_curve_factors;
+    use_scenario_buffer = para_object.use_scenario_buffer;
+    curve_factor_tolerance = para_object.curve_factor_tolerance;
+    curve_max_factors = para_object.curve_max_factors;
+end
 % 1) Processing Yield Curve: Getting Cell with IDs of IR nodes
 
 % load dynamically cellarray with all RF curves (IR and SPREAD) as defined in 
@@ -107,55 +125,101 @@ for ii = 1 : 1 : length(rf_ir_cur_cell)
         %curve_object = curve_object.set('rates_stress',tmp_rates_stress);   
         % loop via all mc timesteps
         if ( run_mc == true )
-			tmp_ts = mc_timestep;
-			% get original yield curve
-			tmp_rates_shock = [];  
-			tmp_nodes = [];
-			tmp_model_cell = {};
-			sln_level = [];
+			% MC timestep and intermediate MC path steps of risk factors (if
+			% available) are stored as MC timesteps of the curve
+			tmp_ts_cell = {mc_timestep};
 			for jj = 1 : 1 : length( riskfactor_struct )
 				tmp_rf_struct_obj = riskfactor_struct( jj ).object;
-				tmp_rf_id = tmp_rf_struct_obj.id;
-				if ( regexpi(tmp_rf_id,tmp_curve_id) == 1 )           
-					tmp_delta_shock     = tmp_rf_struct_obj.getValue(tmp_ts);
-					% just needed for sorting final results:
-					tmp_node            = tmp_rf_struct_obj.get('node'); 
-					tmp_nodes           = cat(2,tmp_nodes,tmp_node);
-					% Calculate new absolute values from Riskfactor PnL 
-					% depending on riskfactor model:
-					tmp_model           = tmp_rf_struct_obj.get('model');
-					tmp_model_cell{end + 1 } = tmp_model;
-					% it is assumend that all risk factors have same shocktype
-					%   (only last risk factor model type is relevant)
-					if ( strcmpi(tmp_model,{'GBM','BKM'}))
-						tmp_shocktype_mc = 'relative';
-						tmp_delta_shock = exp(tmp_delta_shock);
-					elseif ( strcmpi(tmp_model,{'SLN'}))    
-						tmp_shocktype_mc = 'sln_relative';
-						tmp_delta_shock = exp(tmp_delta_shock);
-						% store SLN shifts in vector
-						sln_level = cat(2,sln_level,tmp_rf_struct_obj.get('sln_level'));
-					else
-						tmp_shocktype_mc = 'absolute';
-					end  
-					if ( rows(tmp_rates_shock) >  rows(tmp_delta_shock))
-						error('load_yieldcurves: >>%s<< not modelled in Scenarios.\n',tmp_rf_id);
+				if ( regexpi(tmp_rf_struct_obj.id,tmp_curve_id) == 1 )
+					tmp_ts_cell = [tmp_ts_cell, tmp_rf_struct_obj.get_path_timesteps()];
+					break;
+				end
+			end
+			tmp_rates_mc = [];
+			% factor representation: each timestep is compressed as it is
+			% loaded, so that the dense rates of all timesteps are not held
+			compress_flag = use_curve_factors;
+			loadings_cell = {};
+			scores_cell = {};
+			for kk = 1 : 1 : length(tmp_ts_cell)
+				tmp_ts = tmp_ts_cell{kk};
+				% get original yield curve
+				tmp_rates_shock = [];  
+				tmp_nodes = [];
+				tmp_model_cell = {};
+				sln_level = [];
+				for jj = 1 : 1 : length( riskfactor_struct )
+					tmp_rf_struct_obj = riskfactor_struct( jj ).object;
+					tmp_rf_id = tmp_rf_struct_obj.id;
+					if ( regexpi(tmp_rf_id,tmp_curve_id) == 1 )           
+						tmp_delta_shock     = tmp_rf_struct_obj.getValue(tmp_ts);
+						% just needed for sorting final results:
+						tmp_node            = tmp_rf_struct_obj.get('node'); 
+						tmp_nodes           = cat(2,tmp_nodes,tmp_node);
+						% Calculate new absolute values from Riskfactor PnL 
+						% depending on riskfactor model:
+						tmp_model           = tmp_rf_struct_obj.get('model');
+						tmp_model_cell{end + 1 } = tmp_model;
+						% it is assumend that all risk factors have same shocktype
+						%   (only last risk factor model type is relevant)
+						if ( strcmpi(tmp_model,{'GBM','BKM'}))
+							tmp_shocktype_mc = 'relative';
+							tmp_delta_shock = exp(tmp_delta_shock);
+						elseif ( strcmpi(tmp_model,{'SLN'}))    
+							tmp_shocktype_mc = 'sln_relative';
+							tmp_delta_shock = exp(tmp_delta_shock);
+							% store SLN shifts in vector
+							sln_level = cat(2,sln_level,tmp_rf_struct_obj.get('sln_level'));
+						else
+							tmp_shocktype_mc = 'absolute';
+						end  
+						if ( rows(tmp_rates_shock) >  rows(tmp_delta_shock))
+							error('load_yieldcurves: >>%s<< not modelled in Scenarios.\n',tmp_rf_id);
+						end
+						tmp_rates_shock = cat(2,tmp_rates_shock,tmp_delta_shock);
+					end
+				end  
+				% sort nodes and accordingly original and stress rates:
+					[tmp_nodes tmp_indizes] = sort(tmp_nodes);
+					tmp_rates_shock = tmp_rates_shock(:,tmp_indizes);
+				% check, whether all risk factors of one curve have the same model
+				if ( length(unique(tmp_model_cell)) > 1 )
+					fprintf('WARNING: octarisk::load_yieldcurves: ', ...
+							'one curve has different stochastic models ', ...
+							'for their nodes: %s\n',tmp_model_cell);
+				end
+				if ( compress_flag == true )
+					if ( rows(tmp_rates_shock) > 1 )
+						[loadings_cell{kk} scores_cell{kk}] = compress_curve_scenarios( ...
+								tmp_rates_shock,curve_factor_tolerance,curve_max_factors);
+						if ~( isempty(loadings_cell{kk}) )
+							continue;
+						end
+						fprintf('WARNING: octarisk::load_yieldcurves: MC rates of curve >>%s<< for timestep >>%s<< can not be compressed with tolerance %s. Storing dense MC rates.\n', ...
+								tmp_curve_id,tmp_ts,any2str(curve_factor_tolerance));
+					end
+					% dense rates of former timesteps from factor
+					% representation (error below tolerance)
+					for pp = 1 : 1 : kk - 1
+						tmp_rates_mc(:,:,pp) = loadings_cell{pp}(1,:) ...
+								+ scores_cell{pp} * loadings_cell{pp}(2:end,:);
 					end
-					tmp_rates_shock = cat(2,tmp_rates_shock,tmp_delta_shock);
 				end
-			end  
-			% sort nodes and accordingly original and stress rates:
-				[tmp_nodes tmp_indizes] = sort(tmp_nodes);
-				tmp_rates_shock = tmp_rates_shock(:,tmp_indizes);
-			% check, whether all risk factors of one curve have the same model
-			if ( length(unique(tmp_model_cell)) > 1 )
-				fprintf('WARNING: octarisk::load_yieldcurves: ', ...
-						'one curve has different stochastic models ', ...
-						'for their nodes: %s\n',tmp_model_cell);
+				compress_flag = false;
+				tmp_rates_mc(:,:,kk) = tmp_rates_shock;
 			end
 			% Save curves into struct
-			curve_object = curve_object.set('rates_mc',tmp_rates_shock, ...
-											'timestep_mc',tmp_ts); 
+			if ( compress_flag == true )
+				[tmp_loadings tmp_scores] = stack_curve_factors(loadings_cell,scores_cell);
+				curve_object = curve_object.set('rates_mc_scores',tmp_scores, ...
+						'rates_mc_loadings',tmp_loadings,'timestep_mc',tmp_ts_cell);
+			else
+				curve_object = curve_object.set('rates_mc',tmp_rates_mc, ...
+											'timestep_mc',tmp_ts_cell); 
+			end
+            if ( use_scenario_buffer == true )
+                curve_object = curve_object.store_rates_mc();
+            end
             % store shocktype_mc
             curve_object = curve_object.set('shocktype_mc',tmp_shocktype_mc);
             % store shifted log-normal shift parameters
@@ -207,7 +271,20 @@ if saving == 1
     % Saving curve_struct: loop via all objects in structs and convert
     tmp_curve_struct = curve_struct;
     for ii = 1 : 1 : length( tmp_curve_struct )
-        tmp_curve_struct(ii).object = struct(tmp_curve_struct(ii).object);
+        tmp_object = tmp_curve_struct(ii).object;
+        tmp_struct = struct(tmp_object);
+        % write dense MC rates of buffered or compressed curves
+        if ( isempty(tmp_object.rates_mc) && ( tmp_object.rates_mc_handle > 0 ...
+                            || ~isempty(tmp_object.rates_mc_loadings) ) )
+            for kk = 1 : 1 : length(tmp_object.timestep_mc)
+                tmp_struct.rates_mc(:,:,kk) = ...
+                            tmp_object.getValue(tmp_object.timestep_mc{kk});
+            end
+            tmp_struct.rates_mc_handle = 0;
+            tmp_struct.rates_mc_scores = [];
+            tmp_struct.rates_mc_loadings = [];
+        end
+        tmp_curve_struct(ii).object = tmp_struct;
     end 
     savename = 'tmp_curve_struct';
     fullpath = [path_output, savename, endung];
@@ -224,3 +301,28 @@ if (length(curve_failed_cell) > 0 )
 end 
 
 end
+
+%!test
+%! r1 = Riskfactor('RF_IR_EUR_1Y');
+%! r1 = r1.set('type','RF_IR','model','HW','node',365,'value_base',0.01,'shift_type',0);
+%! r1 = r1.set('scenario_mc',[0.01;-0.01],'timestep_mc','1y');
+%! r1 = r1.set('scenario_path',[0.004,0.01;-0.006,-0.01],'timestep_path',[90,365]);
+%! r2 = Riskfactor('RF_IR_EUR_2Y');
+%! r2 = r2.set('type','RF_IR','model','HW','node',730,'value_base',0.02,'shift_type',0);
+%! r2 = r2.set('scenario_mc',[0.02;-0.02],'timestep_mc','1y');
+%! r2 = r2.set('scenario_path',[0.008,0.02;-0.012,-0.02],'timestep_path',[90,365]);
+%! riskfactor_struct = struct();
+%! riskfactor_struct(1).id = r1.id;
+%! riskfactor_struct(1).object = r1;
+%! riskfactor_struct(2).id = r2.id;
+%! riskfactor_struct(2).object = r2;
+%! assert(r1.get_path_timesteps(),{'90d'})
+%! assert(r1.getValue('1y'),[0.01;-0.01])
+%! assert(r1.getValue('90D'),[0.004;-0.006])
+%! [rf_ir_cur_cell curve_struct] = load_yieldcurves(struct(),riskfactor_struct,'1y','',0,true);
+%! assert(rf_ir_cur_cell,{'RF_IR_EUR'})
+%! c = curve_struct(1).object;
+%! assert(c.get('timestep_mc'),{'1y','90d'})
+%! assert(c.getValue('1y'),[0.01,0.02;-0.01,-0.02],eps)
+%! assert(c.getValue('90d'),[0.004,0.008;-0.006,-0.012],eps)
+%! assert(c.getValue('base'),[0,0])
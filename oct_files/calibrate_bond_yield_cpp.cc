@@ -0,0 +1,326 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <cmath>
+#include <algorithm>
+#include <octave/parse.h>
+
+static bool any_bad_argument(const octave_value_list& args);
+
+// discount factor and derivative with respect to rate
+static inline void get_df(const double& rate, const double& tf, const int& comp_type,
+                          const double& comp_freq, double& df, double& ddf)
+{
+    if (comp_type == 1)         // simple
+    {
+        const double tmp = 1.0 + rate * tf;
+        df = 1.0 / tmp;
+        ddf = -tf / (tmp * tmp);
+    }
+    else if (comp_type == 2)    // discrete
+    {
+        const double tmp = 1.0 + rate / comp_freq;
+        df = std::pow(tmp, -comp_freq * tf);
+        ddf = -tf * df / tmp;
+    }
+    else                        // continuous
+    {
+        df = std::exp(-rate * tf);
+        ddf = -tf * df;
+    }
+}
+
+// spread (continuous, act/365) converted into curve compounding and basis
+// (see convert_curve_rates) and derivative with respect to spread
+static inline void get_spread(const double& x, const double& tf_origin,
+                              const double& tf_target, const int& comp_type,
+                              const double& comp_freq, double& c, double& dc)
+{
+    if (tf_target == 0.0)
+    {
+        c = x;
+        dc = 1.0;
+    }
+    else if (comp_type == 1)    // CONT -> SMP
+    {
+        const double tmp = std::exp(x * tf_origin);
+        c = (tmp - 1.0) / tf_target;
+        dc = tf_origin * tmp / tf_target;
+    }
+    else if (comp_type == 2)    // CONT -> DISC
+    {
+        const double tmp = std::exp(x * tf_origin / (comp_freq * tf_target));
+        c = (tmp - 1.0) * comp_freq;
+        dc = tf_origin / tf_target * tmp;
+    }
+    else                        // CONT -> CONT
+    {
+        c = x * tf_origin / tf_target;
+        dc = tf_origin / tf_target;
+    }
+}
+
+// difference of net present value and market value and derivative
+static void get_npv_diff(const int& mode, const double& x,
+                         const octave_idx_type& start, const octave_idx_type& end,
+                         const ColumnVector& cf_values, const ColumnVector& tf_curve,
+                         const ColumnVector& tf_spread, const ColumnVector& rates,
+                         const int& comp_type, const double& comp_freq,
+                         const double& value, double& diff, double& ddiff)
+{
+    diff = -value;
+    ddiff = 0.0;
+    for (octave_idx_type kk = start; kk < end; ++kk)
+    {
+        double c = x;
+        double dc = 1.0;
+        if (mode == 1)
+            get_spread(x, tf_spread(kk), tf_curve(kk), comp_type, comp_freq, c, dc);
+        double df, ddf;
+        get_df(rates(kk) + c, tf_curve(kk), comp_type, comp_freq, df, ddf);
+        diff += cf_values(kk) * df;
+        ddiff += cf_values(kk) * ddf * dc;
+    }
+}
+
+DEFUN_DLD (calibrate_bond_yield_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {[@var{x} @var{retcode} @var{iterations}]} = calibrate_bond_yield_cpp(@var{mode}, @var{row_ptr}, @var{cf_values}, @var{tf_curve}, @var{tf_spread}, @var{rates}, @var{comp_type}, @var{comp_freq}, @var{value}, @var{x0}, @var{lb}, @var{ub})\n\
+\n\
+Calibrate yields to maturity or spreads over yield of many bonds at once.\n\
+\n\
+This function should be called from Octave scripts calc_yield_to_mat.m,\n\
+calc_spread_over_yield.m (class Bond) and calibrate_bond_yields.m.\n\
+Cash flows of all bonds are packed in compressed sparse row format: the\n\
+cash flows of bond b are stored at positions row_ptr(b)+1 ... row_ptr(b+1)\n\
+of all cash flow vectors. For each bond the root of\n\
+sum(cf_values .* df(rates + x)) - value is calculated by Newton iterations\n\
+with analytic derivative. Newton steps leaving the bounds are halved towards\n\
+the bound. Bonds without Newton convergence are solved by bisection, if the\n\
+root is bracketed by the bounds.\n\
+\n\
+Mode 0 (yield to maturity): x is added to rates (usually zero).\n\
+Mode 1 (spread over yield): x is a continuous act/365 spread, which is\n\
+converted into the curve compounding and basis for each cash flow and\n\
+added to the interpolated curve rates.\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{mode}: Integer: 0 (yield to maturity) or 1 (spread over yield)\n\
+@item @var{row_ptr}: Integer: offsets of cash flows of all bonds (B+1 x 1)\n\
+@item @var{cf_values}: Double: cash flow values (N x 1)\n\
+@item @var{tf_curve}: Double: time factors of cash flows in rate basis (N x 1)\n\
+@item @var{tf_spread}: Double: time factors act/365 of cash flows (N x 1)\n\
+@item @var{rates}: Double: rates at cash flow dates (N x 1)\n\
+@item @var{comp_type}: Integer: compounding type 1 (simple), 2 (discrete),\n\
+3 (continuous) (scalar or B x 1)\n\
+@item @var{comp_freq}: Double: compounding frequency (scalar or B x 1)\n\
+@item @var{value}: Double: dirty market values (B x 1)\n\
+@item @var{x0}: Double: start values (scalar or B x 1)\n\
+@item @var{lb}: Double: lower bound (scalar)\n\
+@item @var{ub}: Double: upper bound (scalar)\n\
+@item @var{x}: Double: OUTPUT: calibrated yields or spreads (B x 1)\n\
+@item @var{retcode}: Double: OUTPUT: 0 (converged) or 255 (B x 1)\n\
+@item @var{iterations}: Double: OUTPUT: number of iterations (B x 1)\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+x = calibrate_bond_yield_cpp(0,[0;2],[5;105],[1;2],[1;2],[0;0],2,1,100,0.01,-1,1)\n\
+x = 0.050000\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  if (nargin != 12 )
+  {
+    print_usage ();
+	error("Expecting 12 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	int mode                = args(0).int_value ();
+	ColumnVector row_ptr    = ColumnVector (args(1).array_value ());
+	ColumnVector cf_values  = ColumnVector (args(2).array_value ());
+	ColumnVector tf_curve   = ColumnVector (args(3).array_value ());
+	ColumnVector tf_spread  = ColumnVector (args(4).array_value ());
+	ColumnVector rates      = ColumnVector (args(5).array_value ());
+	ColumnVector comp_type  = ColumnVector (args(6).array_value ());
+	ColumnVector comp_freq  = ColumnVector (args(7).array_value ());
+	ColumnVector value      = ColumnVector (args(8).array_value ());
+	ColumnVector x0         = ColumnVector (args(9).array_value ());
+	double lb               = args(10).double_value ();
+	double ub               = args(11).double_value ();
+
+	const octave_idx_type no_bonds = value.numel ();
+	const octave_idx_type no_cf = cf_values.numel ();
+	if ( row_ptr.numel () != no_bonds + 1 )
+		error("calibrate_bond_yield_cpp: row_ptr needs %d entries (number of bonds + 1)", (int) no_bonds + 1);
+	if ( tf_curve.numel () != no_cf || tf_spread.numel () != no_cf || rates.numel () != no_cf )
+		error("calibrate_bond_yield_cpp: tf_curve, tf_spread and rates need %d entries", (int) no_cf);
+	if ( row_ptr(0) != 0 || row_ptr(no_bonds) != no_cf )
+		error("calibrate_bond_yield_cpp: row_ptr has to start with 0 and end with number of cash flows");
+	for (octave_idx_type bb = 0; bb < no_bonds; ++bb)
+		if ( row_ptr(bb+1) < row_ptr(bb) )
+			error("calibrate_bond_yield_cpp: row_ptr has to be non-decreasing");
+	if ( (comp_type.numel () != 1 && comp_type.numel () != no_bonds)
+			|| (comp_freq.numel () != 1 && comp_freq.numel () != no_bonds)
+			|| (x0.numel () != 1 && x0.numel () != no_bonds) )
+		error("calibrate_bond_yield_cpp: comp_type, comp_freq and x0 need 1 or %d entries", (int) no_bonds);
+	if ( lb >= ub )
+		error("calibrate_bond_yield_cpp: lower bound has to be smaller than upper bound");
+
+	const int max_iter = 100;
+	const int max_iter_bisection = 200;
+	ColumnVector x (no_bonds);
+	ColumnVector retcode (no_bonds, 255.0);
+	ColumnVector iterations (no_bonds, 0.0);
+
+	// loop over all bonds
+	for (octave_idx_type bb = 0; bb < no_bonds; ++bb)
+	{
+		// catch ctrl + c
+		OCTAVE_QUIT;
+		const octave_idx_type start = static_cast<octave_idx_type>(row_ptr(bb));
+		const octave_idx_type end = static_cast<octave_idx_type>(row_ptr(bb+1));
+		const int tmp_comp_type = static_cast<int>(comp_type((comp_type.numel () == 1) ? 0 : bb));
+		const double tmp_comp_freq = comp_freq((comp_freq.numel () == 1) ? 0 : bb);
+		const double tol = 1e-10 * std::max(1.0, std::abs(value(bb)));
+		double xx = std::min(ub, std::max(lb, x0((x0.numel () == 1) ? 0 : bb)));
+		double diff, ddiff;
+		bool converged = false;
+		int iter = 0;
+
+		// a) Newton iterations with analytic derivative
+		for (iter = 1; iter <= max_iter; ++iter)
+		{
+			get_npv_diff(mode, xx, start, end, cf_values, tf_curve, tf_spread,
+						rates, tmp_comp_type, tmp_comp_freq, value(bb), diff, ddiff);
+			if ( std::abs(diff) < tol )
+			{
+				converged = true;
+				break;
+			}
+			if ( !(ddiff != 0.0) || !std::isfinite(diff) || !std::isfinite(ddiff) )
+				break;
+			double x_new = xx - diff / ddiff;
+			// keep iterations inside bounds
+			if ( x_new <= lb )
+				x_new = 0.5 * (xx + lb);
+			else if ( x_new >= ub )
+				x_new = 0.5 * (xx + ub);
+			xx = x_new;
+		}
+
+		// b) bisection, if root is bracketed by bounds
+		if ( !converged )
+		{
+			double x_lo = lb + 1e-12 * (ub - lb);
+			double x_hi = ub;
+			double diff_lo, diff_hi;
+			get_npv_diff(mode, x_lo, start, end, cf_values, tf_curve, tf_spread,
+						rates, tmp_comp_type, tmp_comp_freq, value(bb), diff_lo, ddiff);
+			get_npv_diff(mode, x_hi, start, end, cf_values, tf_curve, tf_spread,
+						rates, tmp_comp_type, tmp_comp_freq, value(bb), diff_hi, ddiff);
+			if ( std::isfinite(diff_lo) && std::isfinite(diff_hi)
+					&& (diff_lo <= 0.0) != (diff_hi <= 0.0) )
+			{
+				for (int kk = 1; kk <= max_iter_bisection; ++kk)
+				{
+					++iter;
+					xx = 0.5 * (x_lo + x_hi);
+					get_npv_diff(mode, xx, start, end, cf_values, tf_curve, tf_spread,
+								rates, tmp_comp_type, tmp_comp_freq, value(bb), diff, ddiff);
+					if ( std::abs(diff) < tol )
+					{
+						converged = true;
+						break;
+					}
+					if ( (diff <= 0.0) == (diff_lo <= 0.0) )
+					{
+						x_lo = xx;
+						diff_lo = diff;
+					}
+					else
+						x_hi = xx;
+				}
+			}
+		}
+		x(bb) = xx;
+		iterations(bb) = iter;
+		if ( converged )
+			retcode(bb) = 0.0;
+	}
+
+  // return values
+	octave_value_list option_outargs;
+	option_outargs(0) = x;
+	option_outargs(1) = retcode;
+	option_outargs(2) = iterations;
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    if (!args(0).isnumeric () || args(0).numel () != 1
+        || (args(0).int_value () != 0 && args(0).int_value () != 1))
+    {
+        error("calibrate_bond_yield_cpp: expecting mode to be 0 or 1");
+        return true;
+    }
+
+    for (int ii = 1; ii < 10; ++ii)
+    {
+        if (!args(ii).isnumeric ())
+        {
+            error("calibrate_bond_yield_cpp: expecting argument %d to be numeric",ii + 1);
+            return true;
+        }
+    }
+
+    if (!args(10).isnumeric () || args(10).numel () != 1)
+    {
+        error("calibrate_bond_yield_cpp: expecting lb to be a numeric scalar");
+        return true;
+    }
+
+    if (!args(11).isnumeric () || args(11).numel () != 1)
+    {
+        error("calibrate_bond_yield_cpp: expecting ub to be a numeric scalar");
+        return true;
+    }
+
+    return false;
+}
+
+/*
+%!assert(calibrate_bond_yield_cpp(0,[0;2],[5;105],[1;2],[1;2],[0;0],2,1,100,0.01,-1,1),0.05,0.0000001)
+%!test
+%! [x retcode] = calibrate_bond_yield_cpp(0,[0;2;3],[5;105;110],[1;2;1],[1;2;1],[0;0;0],2,1,[100;100],0.01,-1,1);
+%! assert(x,[0.05;0.10],0.0000001)
+%! assert(retcode,[0;0])
+%!test
+%! [x retcode] = calibrate_bond_yield_cpp(1,[0;1],100,2,2,0.01,3,1,100*exp(-0.04),0.0,-1,1);
+%! assert(x,0.01,0.0000001)
+%! [x retcode] = calibrate_bond_yield_cpp(0,[0;1],100,1,1,0,2,1,500,0.01,-0.5,1);
+%! assert(retcode,255)
+*/
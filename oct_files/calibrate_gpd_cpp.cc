@@ -0,0 +1,330 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <cmath>
+#include <vector>
+#include <limits>
+#include "thread_helpers.h"
+
+static bool any_bad_argument(const octave_value_list& args);
+
+static bool gpd_nll (const std::vector<double>& y, const double& xi,
+			const double& beta, double& f, double* grad, double* hess);
+
+static void gpd_fit (const std::vector<double>& y, double& xi, double& beta,
+			double& nll);
+
+DEFUN_DLD (calibrate_gpd_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {[@var{chi} @var{sigma} @var{u} @var{nll}]} = calibrate_gpd_cpp(@var{pnl_sorted}, @var{nu})\n\
+\n\
+Calibrate generalized Pareto distributions to the loss tails of several\n\
+sorted profit and loss distributions by maximum likelihood estimation.\n\
+\n\
+Each column of @var{pnl_sorted} contains a profit and loss distribution sorted\n\
+in ascending order (largest losses first), e.g. the sorted P&L vectors of\n\
+calc_risk. The threshold @var{u} is the loss of scenario @var{nu} + 1, the\n\
+tail sample consists of the @var{nu} exceedances y = loss - u of the largest\n\
+losses. The negative log-likelihood of the GPD\n\
+nll = nu * log(sigma) + (1 + 1 / chi) * sum(log(1 + chi * y / sigma))\n\
+is minimized by Newton steps with analytic gradient and Hessian, starting\n\
+from method of moments estimates. The limit chi -> 0 (exponential tail) is\n\
+evaluated by series expansions. The shape parameter is restricted to chi > -1.\n\
+Degenerate tails (all exceedances zero) return chi = 0 and sigma = 0.\n\
+The parameters can be used for VaR and ES calculation with get_gpd_var.\n\
+The distributions are calibrated in parallel by worker threads (number of\n\
+threads set by environment variable OCTARISK_THREADS, default: all hardware\n\
+threads).\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{pnl_sorted}: Double: sorted profit and loss (scenarios x distributions)\n\
+@item @var{nu}: Double: number of tail scenarios (scalar or one per distribution)\n\
+@item @var{chi}: Double: OUTPUT: GPD shape parameters (1 x distributions)\n\
+@item @var{sigma}: Double: OUTPUT: GPD scale parameters (1 x distributions)\n\
+@item @var{u}: Double: OUTPUT: threshold losses (1 x distributions)\n\
+@item @var{nll}: Double: OUTPUT: negative log-likelihood (1 x distributions)\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+p = ((1:1000)' - 0.5) ./ 1000;\n\
+y = 100 ./ 0.2 .* ((1 - p).^(-0.2) - 1);\n\
+pnl_sorted = -[sort(y,'descend') + 500; linspace(500,0,9000)'];\n\
+[chi sigma u] = calibrate_gpd_cpp(pnl_sorted,1000)\n\
+chi = 0.1981\n\
+sigma = 100.15\n\
+u = 500\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  if (nargin != 2 )
+  {
+    print_usage ();
+	error("Expecting 2 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	Matrix pnl_sorted   = args(0).matrix_value ();
+	NDArray nu_vec      = args(1).array_value ();
+
+	const octave_idx_type no_scen = pnl_sorted.rows ();
+	const octave_idx_type no_distr = pnl_sorted.cols ();
+	if ( nu_vec.numel () != 1 && nu_vec.numel () != no_distr )
+		error("calibrate_gpd_cpp: expecting scalar nu or one nu per column");
+
+	// check all tail sizes before starting the worker threads
+	std::vector<octave_idx_type> nu_distr (no_distr);
+	for (octave_idx_type jj = 0; jj < no_distr; ++jj)
+	{
+		nu_distr[jj] = static_cast<octave_idx_type>
+						(nu_vec(nu_vec.numel () == 1 ? 0 : jj));
+		if ( nu_distr[jj] < 2 || nu_distr[jj] >= no_scen )
+			error("calibrate_gpd_cpp: nu has to be between 2 and %d", (int) no_scen - 1);
+	}
+
+	RowVector chi (no_distr);
+	RowVector sigma (no_distr);
+	RowVector u (no_distr);
+	RowVector nll (no_distr);
+	const double* pnl_ptr = pnl_sorted.data ();
+	double* chi_ptr = chi.fortran_vec ();
+	double* sigma_ptr = sigma.fortran_vec ();
+	double* u_ptr = u.fortran_vec ();
+	double* nll_ptr = nll.fortran_vec ();
+
+	// distributions are fitted independently by the worker threads
+	parallel_blocks(no_distr, 1,
+		[&](const octave_idx_type col_start, const octave_idx_type col_end)
+	{
+		std::vector<double> y;
+		for (octave_idx_type jj = col_start; jj < col_end; ++jj)
+		{
+			const octave_idx_type nu = nu_distr[jj];
+			const double* pnl_col = pnl_ptr + jj * no_scen;
+			// threshold and exceedances of largest losses
+			u_ptr[jj] = - pnl_col[nu];
+			y.resize (nu);
+			for (octave_idx_type ii = 0; ii < nu; ++ii)
+				y[ii] = std::max(- pnl_col[ii] - u_ptr[jj], 0.0);
+			gpd_fit (y, chi_ptr[jj], sigma_ptr[jj], nll_ptr[jj]);
+		}
+	});
+
+  // return values
+	octave_value_list option_outargs;
+	option_outargs(0) = chi;
+	option_outargs(1) = sigma;
+	option_outargs(2) = u;
+	option_outargs(3) = nll;
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+// negative log-likelihood of GPD with gradient and Hessian (xi, beta)
+// (hess: [d2/dxi2, d2/dxi dbeta, d2/dbeta2]), false if parameters infeasible
+bool gpd_nll (const std::vector<double>& y, const double& xi,
+			const double& beta, double& f, double* grad, double* hess)
+{
+	if ( beta <= 0.0 || xi <= -1.0 )
+		return false;
+	const double n = static_cast<double> (y.size ());
+	double g_sum = 0.0, g_xi_sum = 0.0, g_xixi_sum = 0.0;
+	double tg_t_sum = 0.0, tg_xit_sum = 0.0, bb_sum = 0.0;
+	for (std::size_t ii = 0; ii < y.size (); ++ii)
+	{
+		const double t = y[ii] / beta;
+		const double w = 1.0 + xi * t;
+		if ( w <= 0.0 )
+			return false;
+		// g = (1 + 1/xi) * log(1 + xi * t) and derivatives
+		const double g_t = (1.0 + xi) / w;
+		const double g_tt = - (1.0 + xi) * xi / (w * w);
+		const double g_xit = (1.0 - t) / (w * w);
+		double g, g_xi, g_xixi;
+		if ( std::fabs(xi * t) < 1e-4 )
+		{
+			// series expansion in xi: g = sum c_k * xi^k
+			const double t2 = t * t;
+			const double t3 = t2 * t;
+			const double t4 = t3 * t;
+			const double c1 = t - 0.5 * t2;
+			const double c2 = t3 / 3.0 - 0.5 * t2;
+			const double c3 = t3 / 3.0 - 0.25 * t4;
+			const double c4 = 0.2 * t4 * t - 0.25 * t4;
+			g = t + xi * (c1 + xi * (c2 + xi * (c3 + xi * c4)));
+			g_xi = c1 + xi * (2.0 * c2 + xi * (3.0 * c3 + xi * 4.0 * c4));
+			g_xixi = 2.0 * c2 + xi * (6.0 * c3 + xi * 12.0 * c4);
+		}
+		else
+		{
+			const double L = std::log(w);
+			g = (1.0 + 1.0 / xi) * L;
+			g_xi = - L / (xi * xi) + (1.0 + 1.0 / xi) * t / w;
+			g_xixi = 2.0 * L / (xi * xi * xi) - 2.0 * t / (xi * xi * w)
+						- (1.0 + 1.0 / xi) * t * t / (w * w);
+		}
+		g_sum += g;
+		g_xi_sum += g_xi;
+		g_xixi_sum += g_xixi;
+		tg_t_sum += t * g_t;
+		tg_xit_sum += t * g_xit;
+		bb_sum += 2.0 * t * g_t + t * t * g_tt;
+	}
+	f = n * std::log(beta) + g_sum;
+	grad[0] = g_xi_sum;
+	grad[1] = (n - tg_t_sum) / beta;
+	hess[0] = g_xixi_sum;
+	hess[1] = - tg_xit_sum / beta;
+	hess[2] = (bb_sum - n) / (beta * beta);
+	return true;
+}
+
+// maximum likelihood fit of GPD to exceedances y
+void gpd_fit (const std::vector<double>& y, double& xi, double& beta,
+			double& nll)
+{
+	const double n = static_cast<double> (y.size ());
+	double mean = 0.0, var = 0.0, y_max = 0.0;
+	for (std::size_t ii = 0; ii < y.size (); ++ii)
+	{
+		mean += y[ii];
+		y_max = std::max(y_max, y[ii]);
+	}
+	mean /= n;
+	for (std::size_t ii = 0; ii < y.size (); ++ii)
+		var += (y[ii] - mean) * (y[ii] - mean);
+	var /= (n - 1.0);
+	// degenerate tail: no exceedances
+	if ( mean <= 0.0 )
+	{
+		xi = 0.0;
+		beta = 0.0;
+		nll = std::numeric_limits<double>::quiet_NaN();
+		return;
+	}
+	// method of moments start values (exponential tail as fallback)
+	xi = 0.0;
+	beta = mean;
+	if ( var > 0.0 )
+	{
+		const double ratio = mean * mean / var;
+		const double xi0 = 0.5 * (1.0 - ratio);
+		const double beta0 = 0.5 * mean * (ratio + 1.0);
+		if ( xi0 > -0.5 && xi0 < 0.9 && 1.0 + xi0 * y_max / beta0 > 0.0 )
+		{
+			xi = xi0;
+			beta = beta0;
+		}
+	}
+	double f, grad[2], hess[3];
+	gpd_nll (y, xi, beta, f, grad, hess);
+	// Newton iterations with step halving
+	for (int iter = 0; iter < 100; ++iter)
+	{
+		double d_xi, d_beta;
+		const double det = hess[0] * hess[2] - hess[1] * hess[1];
+		if ( hess[0] > 0.0 && det > 0.0 )
+		{
+			d_xi = - (hess[2] * grad[0] - hess[1] * grad[1]) / det;
+			d_beta = - (hess[0] * grad[1] - hess[1] * grad[0]) / det;
+		}
+		else    // scaled gradient step if Hessian is not positive definite
+		{
+			d_xi = - grad[0] / std::max(std::fabs(hess[0]), 1e-12);
+			d_beta = - grad[1] / std::max(std::fabs(hess[2]), 1e-12);
+		}
+		double alpha = 1.0;
+		double f_new, grad_new[2], hess_new[3];
+		bool accepted = false;
+		for (int kk = 0; kk < 60; ++kk)
+		{
+			if ( gpd_nll (y, xi + alpha * d_xi, beta + alpha * d_beta,
+							f_new, grad_new, hess_new) && f_new <= f )
+			{
+				accepted = true;
+				break;
+			}
+			alpha *= 0.5;
+		}
+		if ( !accepted )
+			break;
+		xi += alpha * d_xi;
+		beta += alpha * d_beta;
+		const double df = f - f_new;
+		f = f_new;
+		grad[0] = grad_new[0];
+		grad[1] = grad_new[1];
+		hess[0] = hess_new[0];
+		hess[1] = hess_new[1];
+		hess[2] = hess_new[2];
+		if ( std::fabs(alpha * d_xi) < 1e-10 * (1.0 + std::fabs(xi))
+				&& std::fabs(alpha * d_beta) < 1e-10 * beta && df < 1e-12 * (1.0 + std::fabs(f)) )
+			break;
+	}
+	nll = f;
+}
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    for (int ii = 0; ii < 2; ++ii)
+    {
+        if (!args(ii).isnumeric ())
+        {
+            error("calibrate_gpd_cpp: expecting argument %d to be numeric",ii + 1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+%!test
+%! p = ((1:1000)' - 0.5) ./ 1000;
+%! y = 100 ./ 0.2 .* ((1 - p).^(-0.2) - 1);
+%! pnl_sorted = -[sort(y,'descend') + 500; linspace(500,0,9000)'];
+%! [chi sigma u] = calibrate_gpd_cpp(pnl_sorted,1000);
+%! assert([chi sigma u],[0.2,100,500],[0.01,1,0])
+%!test
+%! p = ((1:500)' - 0.5) ./ 500;
+%! Y = [-50 .* log(1 - p), 100 ./ -0.2 .* ((1 - p).^0.2 - 1)];
+%! pnl_sorted = -[sort(Y,'descend') + 10; repmat(linspace(10,0,5000)',1,2)];
+%! [chi sigma u nll] = calibrate_gpd_cpp(pnl_sorted,[500,500]);
+%! assert(chi,[0,-0.2],0.02)
+%! assert(sigma,[50,100],2)
+%! assert(u,[10,10])
+%! [chi sigma u] = calibrate_gpd_cpp(zeros(100,1),10);
+%! assert([chi sigma u],[0,0,0])
+%!test
+%! % identical results on single and multiple worker threads
+%! p = ((1:500)' - 0.5) ./ 500;
+%! Y = -50 .* log(1 - p) .* (1:6) + 100 ./ 0.2 .* ((1 - p).^(-0.2) - 1) .* (0:5);
+%! pnl_sorted = -[sort(Y,'descend') + 10; repmat(linspace(10,0,5000)',1,6)];
+%! tmp_threads = getenv('OCTARISK_THREADS');
+%! setenv('OCTARISK_THREADS','1');
+%! [chi1 sigma1 u1 nll1] = calibrate_gpd_cpp(pnl_sorted,500);
+%! setenv('OCTARISK_THREADS','4');
+%! [chi4 sigma4 u4 nll4] = calibrate_gpd_cpp(pnl_sorted,500);
+%! setenv('OCTARISK_THREADS',tmp_threads);
+%! assert([chi4;sigma4;u4;nll4],[chi1;sigma1;u1;nll1])
+*/
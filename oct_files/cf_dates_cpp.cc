@@ -0,0 +1,367 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <octave/parse.h>
+
+static bool any_bad_argument(const octave_value_list& args);
+
+// Octave datenum of 01-Jan-1970
+static const long datenum_epoch = 719529;
+
+// days since 01-Jan-1970 for proleptic gregorian calendar
+static long days_from_civil(long y, long m, long d)
+{
+    y -= m <= 2;
+    const long era = (y >= 0 ? y : y - 399) / 400;
+    const long yoe = y - era * 400;
+    const long doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+static void civil_from_days(long z, long& y, long& m, long& d)
+{
+    z += 719468;
+    const long era = (z >= 0 ? z : z - 146096) / 146097;
+    const long doe = z - era * 146097;
+    const long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const long mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = yoe + era * 400 + (m <= 2);
+}
+
+static inline long datenum_from_civil(long y, long m, long d)
+{
+    return days_from_civil(y, m, d) + datenum_epoch;
+}
+
+static inline void civil_from_datenum(long dn, long& y, long& m, long& d)
+{
+    civil_from_days(dn - datenum_epoch, y, m, d);
+}
+
+static inline bool is_leap_year(long y)
+{
+    return (y % 4 == 0 && y % 100 != 0) || (y % 400 == 0);
+}
+
+static inline long eom_datenum(long y, long m)
+{
+    return (m == 12) ? datenum_from_civil(y + 1, 1, 1) - 1
+                     : datenum_from_civil(y, m + 1, 1) - 1;
+}
+
+// add days, months or years to a date (end of month is preserved,
+// see addtodatefinancial.m)
+static long add_to_date(long dn, long value, int unit)
+{
+    if (unit == 0)     // days
+        return dn + value;
+    long months = (unit == 2) ? 12 * value : value;
+    long y, m, d;
+    civil_from_datenum(dn, y, m, d);
+    const bool eom_flag = ( dn == eom_datenum(y, m) );
+    long total = y * 12 + (m - 1) + months;
+    long new_y = (total >= 0) ? total / 12 : (total - 11) / 12;
+    long new_m = total - new_y * 12 + 1;
+    if (eom_flag)
+        return eom_datenum(new_y, new_m);
+    if (new_m == 2 && !is_leap_year(new_y) && d > 28)
+        d = 28;
+    // days exceeding end of month roll over into next month (as datenum)
+    return datenum_from_civil(new_y, new_m, 1) + d - 1;
+}
+
+// saturday and sunday (datenum modulo 7 equals 1 or 2)
+static inline bool is_weekend(long dn)
+{
+    const long wd = ((dn % 7) + 7) % 7;
+    return (wd == 1 || wd == 2);
+}
+
+// next (direction 1) or previous (direction -1) business day after refdate
+// (see busdate of financial package)
+static long business_date(long refdate, int direction, const std::vector<long>& hol)
+{
+    long bd = refdate + direction;
+    while ( is_weekend(bd) || std::binary_search(hol.begin(), hol.end(), bd) )
+        bd += direction;
+    return bd;
+}
+
+static Matrix get_datevec(const std::vector<long>& dates)
+{
+    Matrix retvec (dates.size (), 6, 0.0);
+    for (size_t ii = 0; ii < dates.size (); ++ii)
+    {
+        long y, m, d;
+        civil_from_datenum(dates[ii], y, m, d);
+        retvec(ii,0) = y;
+        retvec(ii,1) = m;
+        retvec(ii,2) = d;
+    }
+    return retvec;
+}
+
+static ColumnVector get_colvec(const std::vector<long>& dates)
+{
+    ColumnVector retvec (dates.size ());
+    for (size_t ii = 0; ii < dates.size (); ++ii)
+        retvec(ii) = dates[ii];
+    return retvec;
+}
+
+DEFUN_DLD (cf_dates_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {[@var{cf_datesnum} @var{cf_dates} @var{cf_business_datesnum} @var{cf_business_dates}]} = cf_dates_cpp(@var{issue_date}, @var{maturity_date}, @var{term}, @var{term_unit}, @var{coupon_generation_method}, @var{long_first_period}, @var{long_last_period}, @var{enable_business_day_rule}, @var{business_day_rule}, @var{business_day_direction}, @var{holidays})\n\
+\n\
+Generate the cash flow date schedule between issue and maturity date.\n\
+\n\
+This function should be called from the get_cf_dates functions of Octave\n\
+scripts rollout_structured_cashflows.m and rollout_retail_cashflows.m.\n\
+Cash flow dates are generated backward from maturity date or forward\n\
+from issue date (end of month is preserved, see addtodatefinancial).\n\
+Short or long first and last periods are applied afterwards.\n\
+Business day adjusted dates are the next (direction 1) or previous\n\
+(direction -1) business day after cf_date - 1 + business_day_rule.\n\
+Weekends and the given holidays are no business days.\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{issue_date}: Double: issue date (datenum)\n\
+@item @var{maturity_date}: Double: maturity date (datenum)\n\
+@item @var{term}: Double: term between cash flow dates\n\
+@item @var{term_unit}: String: unit of term [days,months,years]\n\
+@item @var{coupon_generation_method}: String: [backward,forward,zero]\n\
+@item @var{long_first_period}: Boolean: long (true) or short first period\n\
+@item @var{long_last_period}: Boolean: long (true) or short last period\n\
+@item @var{enable_business_day_rule}: Boolean: adjust dates to business days\n\
+@item @var{business_day_rule}: Integer: days added to cash flow dates\n\
+@item @var{business_day_direction}: Integer: 1 (next) or -1 (previous)\n\
+@item @var{holidays}: Double: OPTIONAL: holiday dates (datenum)\n\
+@item @var{cf_datesnum}: Double: OUTPUT: cash flow dates (datenum column vector)\n\
+@item @var{cf_dates}: Double: OUTPUT: cash flow dates (datevec matrix)\n\
+@item @var{cf_business_datesnum}: Double: OUTPUT: business day adjusted dates\n\
+@item @var{cf_business_dates}: Double: OUTPUT: business day adjusted dates (datevec)\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+cf_datesnum = cf_dates_cpp(736330,736695,6,'months','backward',0,0,0,0,1)\n\
+cf_datesnum =\n\
+   736330\n\
+   736511\n\
+   736695\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  if (nargin < 10 || nargin > 11 )
+  {
+    print_usage ();
+	error("Expecting either 10 or 11 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	long issue_date         = static_cast<long>(std::floor(args(0).double_value ()));
+	long maturity_date      = static_cast<long>(std::floor(args(1).double_value ()));
+	double term_input       = args(2).double_value ();
+	std::string term_unit   = args(3).string_value ();
+	std::string method      = args(4).string_value ();
+	bool long_first_period  = args(5).bool_value ();
+	bool long_last_period   = args(6).bool_value ();
+	bool enable_bdr         = args(7).bool_value ();
+	long business_day_rule  = static_cast<long>(args(8).double_value ());
+	int business_day_direction = (args(9).double_value () < 0.0) ? -1 : 1;
+	std::vector<long> hol;
+	if ( nargin == 11 )
+	{
+		NDArray hol_vec = args(10).array_value ();
+		for (octave_idx_type ii = 0; ii < hol_vec.numel (); ++ii)
+			hol.push_back(static_cast<long>(std::floor(hol_vec(ii))));
+		std::sort(hol.begin(), hol.end());
+	}
+	std::transform(term_unit.begin(), term_unit.end(), term_unit.begin(), ::tolower);
+	std::transform(method.begin(), method.end(), method.begin(), ::tolower);
+
+	int unit = -1;
+	if ( term_unit == "days" || term_unit == "day" )
+		unit = 0;
+	else if ( term_unit == "months" || term_unit == "month" )
+		unit = 1;
+	else if ( term_unit == "years" || term_unit == "year" )
+		unit = 2;
+	else
+		error("cf_dates_cpp: unknown unit >>%s<<. Must be days,months,years.",term_unit.c_str());
+	long term = static_cast<long>(std::floor(term_input + 0.5));
+	if ( issue_date > maturity_date )
+		error("cf_dates_cpp: Issue date later than maturity date");
+
+	// a) generate cash flow dates
+	std::vector<long> cf_dates;
+	if ( method == "backward" )
+	{
+		if ( term <= 0 )
+			error("cf_dates_cpp: term has to be positive");
+		cf_dates.push_back(maturity_date);
+		for (long mult = 1; ; ++mult)
+		{
+			// catch ctrl + c
+			OCTAVE_QUIT;
+			long cf_date = add_to_date(maturity_date, -term * mult, unit);
+			if ( cf_date < issue_date )
+				break;
+			cf_dates.push_back(cf_date);
+		}
+		std::reverse(cf_dates.begin(), cf_dates.end());
+	}
+	else if ( method == "forward" )
+	{
+		if ( term <= 0 )
+			error("cf_dates_cpp: term has to be positive");
+		cf_dates.push_back(issue_date);
+		for (long mult = 1; ; ++mult)
+		{
+			// catch ctrl + c
+			OCTAVE_QUIT;
+			long cf_date = add_to_date(issue_date, term * mult, unit);
+			if ( cf_date > maturity_date )
+				break;
+			cf_dates.push_back(cf_date);
+		}
+	}
+	else if ( method == "zero" )
+	{
+		cf_dates.push_back(issue_date);
+		cf_dates.push_back(maturity_date);
+	}
+	else
+		error("cf_dates_cpp: unknown coupon generation method >>%s<<",method.c_str());
+
+	// b) adjust first and last coupon period to issue and maturity date
+	if ( cf_dates.front () > issue_date )
+	{
+		if ( long_first_period )
+			cf_dates.front () = issue_date;
+		else
+			cf_dates.insert(cf_dates.begin (), issue_date);
+	}
+	if ( cf_dates.back () < maturity_date )
+	{
+		if ( long_last_period )
+			cf_dates.back () = maturity_date;
+		else
+			cf_dates.push_back(maturity_date);
+	}
+	// special case: only one cashflow date
+	if ( cf_dates.size () == 1 )
+	{
+		cf_dates.clear ();
+		cf_dates.push_back(issue_date);
+		cf_dates.push_back(maturity_date);
+	}
+
+	// c) business day adjustment
+	std::vector<long> cf_business_dates (cf_dates);
+	if ( enable_bdr )
+	{
+		for (size_t ii = 0; ii < cf_dates.size (); ++ii)
+			cf_business_dates[ii] = business_date(cf_dates[ii] - 1 + business_day_rule,
+									business_day_direction, hol);
+	}
+
+  // return values
+	octave_value_list option_outargs;
+	option_outargs(0) = get_colvec(cf_dates);
+	option_outargs(1) = get_datevec(cf_dates);
+	option_outargs(2) = get_colvec(cf_business_dates);
+	option_outargs(3) = get_datevec(cf_business_dates);
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    if (!args(0).isnumeric () || args(0).numel () != 1)
+    {
+        error("cf_dates_cpp: expecting issue_date to be a numeric scalar");
+        return true;
+    }
+
+    if (!args(1).isnumeric () || args(1).numel () != 1)
+    {
+        error("cf_dates_cpp: expecting maturity_date to be a numeric scalar");
+        return true;
+    }
+
+    if (!args(2).isnumeric () || args(2).numel () != 1)
+    {
+        error("cf_dates_cpp: expecting term to be a numeric scalar");
+        return true;
+    }
+
+    if (!args(3).is_string ())
+    {
+        error("cf_dates_cpp: expecting term_unit to be a string");
+        return true;
+    }
+
+    if (!args(4).is_string ())
+    {
+        error("cf_dates_cpp: expecting coupon_generation_method to be a string");
+        return true;
+    }
+
+    for (int ii = 5; ii < 10; ++ii)
+    {
+        if (!(args(ii).isnumeric () || args(ii).islogical ()) || args(ii).numel () != 1)
+        {
+            error("cf_dates_cpp: expecting argument %d to be a numeric or boolean scalar",ii + 1);
+            return true;
+        }
+    }
+
+    if (args.length () == 11 && !args(10).isnumeric ())
+    {
+        error("cf_dates_cpp: expecting holidays to be a numeric");
+        return true;
+    }
+
+    return false;
+}
+
+/*
+%!assert(cf_dates_cpp(736330,736695,6,'months','backward',0,0,0,0,1),[736330;736511;736695])
+%!assert(cf_dates_cpp(datenum('21-Apr-2015'),datenum('21-Apr-2020'),12,'months','zero',0,0,0,0,1),[datenum('21-Apr-2015');datenum('21-Apr-2020')])
+%!test
+%! [cf_datesnum cf_dates] = cf_dates_cpp(datenum('30-Apr-2016'),datenum('31-Dec-2016'),2,'months','forward',0,0,0,0,1);
+%! assert(cf_datesnum,datenum({'30-Apr-2016';'30-Jun-2016';'31-Aug-2016';'31-Oct-2016';'31-Dec-2016'}))
+%! assert(cf_dates(2,1:3),[2016,6,30])
+%!test
+%! [cf_datesnum cf_dates cf_bd_num] = cf_dates_cpp(datenum('02-Jan-2016'),datenum('02-Jul-2016'),3,'months','backward',0,0,1,0,1,[]);
+%! assert(cf_bd_num,datenum({'04-Jan-2016';'04-Apr-2016';'04-Jul-2016'}))
+*/
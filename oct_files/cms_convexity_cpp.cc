@@ -0,0 +1,190 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <cmath>
+#include <octave/parse.h>
+
+static bool any_bad_argument(const octave_value_list& args);
+
+// value of scalar or vector input at position ii
+static inline double lane (const NDArray& x, const octave_idx_type& ii)
+{
+    return (x.numel () == 1) ? x(0) : x(ii);
+}
+
+// first derivative of bond pricing function G (Hagan, formula A.3)
+static inline double get_dG (const double& f, const double& delta,
+                             const double& n, const double& q)
+{
+    const double fq = f / q;
+    const double tmp = std::pow(1.0 + fq, n) - 1.0;
+    const double tmp_pow = std::pow(1.0 + fq, n - delta - 1.0);
+    return (1.0 + fq - delta * fq) * (tmp_pow / tmp) - n * fq * (tmp_pow / (tmp * tmp));
+}
+
+DEFUN_DLD (cms_convexity_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {@var{convex_adj}} = cms_convexity_cpp(@var{model}, @var{payoff}, @var{cms_rate}, @var{annuity}, @var{df_payment}, @var{sigma}, @var{TF}, @var{delta}, @var{n}, @var{q}, @var{X})\n\
+\n\
+Compute CMS convexity adjustments according to Hagan for all scenarios.\n\
+\n\
+This function should be called from Octave script get_cms_rate_hagan.m.\n\
+The convexity adjustment is given by Hagan, Convexity Conundrums, 2003,\n\
+Appendix A.1 Model 1 (formulas 3.5b, 3.6b, 3.6c and 3.6d).\n\
+Convexity adjustments of CMS caplets and floorlets in the Black model are\n\
+not implemented and set to zero.\n\
+All input parameters (except @var{model} and @var{payoff}) can be scalars or\n\
+vectors of equal length.\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{model}: Integer: volatility model (1=Black, 2=Normal)\n\
+@item @var{payoff}: Integer: CMS payoff (0=swaplet, 1=caplet, 2=floorlet)\n\
+@item @var{cms_rate}: Double: forward CMS rate\n\
+@item @var{annuity}: Double: annuity of underlying swap\n\
+@item @var{df_payment}: Double: discount factor at payment date\n\
+@item @var{sigma}: Double: volatility\n\
+@item @var{TF}: Double: time factor between valuation and swap issue date\n\
+@item @var{delta}: Double: number of periods between swap issue and payment date\n\
+@item @var{n}: Double: number of payments of underlying swap\n\
+@item @var{q}: Double: number of payments per year\n\
+@item @var{X}: Double: strike rate (caplet and floorlet only)\n\
+@item @var{convex_adj}: Double: OUTPUT: convexity adjustment (column vector)\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+convex_adj = cms_convexity_cpp(2,0,0.02,4.5,0.95,0.008,1,1,5,1,0)\n\
+convex_adj = 0.00012119\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  if (nargin != 11 )
+  {
+    print_usage ();
+	error("Expecting 11 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	int model             = args(0).int_value ();
+	int payoff            = args(1).int_value ();
+	NDArray cms_rate      = args(2).array_value ();
+	NDArray annuity       = args(3).array_value ();
+	NDArray df_payment    = args(4).array_value ();
+	NDArray sigma         = args(5).array_value ();
+	NDArray TF            = args(6).array_value ();
+	NDArray delta         = args(7).array_value ();
+	NDArray n             = args(8).array_value ();
+	NDArray q             = args(9).array_value ();
+	NDArray X             = args(10).array_value ();
+
+	// get output length
+	octave_idx_type len = 1;
+	for (int ii = 2; ii < 11; ++ii)
+	{
+		const octave_idx_type tmp_len = args(ii).numel ();
+		if ( tmp_len != 1 )
+		{
+			if ( len != 1 && tmp_len != len )
+				error("cms_convexity_cpp: all input vectors need equal length");
+			len = tmp_len;
+		}
+	}
+
+	ColumnVector convex_adj (len, 0.0);
+	// Black caplets and floorlets are not implemented
+	if ( model == 1 && payoff != 0 )
+		return octave_value (convex_adj);
+
+	// loop over all scenarios
+	for (octave_idx_type ii = 0; ii < len; ++ii)
+	{
+		// catch ctrl + c
+		OCTAVE_QUIT;
+		const double f = lane(cms_rate, ii);
+		const double tmp_sigma = lane(sigma, ii);
+		const double tmp_TF = lane(TF, ii);
+		const double dG = get_dG(f, lane(delta, ii), lane(n, ii), lane(q, ii));
+		const double scaling = lane(annuity, ii) / lane(df_payment, ii);
+		if ( payoff == 0 )
+		{
+			if ( model == 1 )   // Formula 3.5b
+				convex_adj(ii) = dG * (std::exp(tmp_sigma * tmp_sigma * tmp_TF) - 1.0)
+									* f * f * scaling;
+			else                // Formula 3.6b
+				convex_adj(ii) = dG * tmp_TF * tmp_sigma * tmp_sigma * scaling;
+		}
+		else
+		{
+			// caplet: Formula 3.6c, floorlet: Formula 3.6d
+			const double eta = (payoff == 1) ? 1.0 : -1.0;
+			const double h = eta * (f - lane(X, ii)) / (tmp_sigma * std::sqrt(tmp_TF));
+			const double cdf_h = 0.5 * (1.0 + std::erf(h / std::sqrt(2.0)));
+			convex_adj(ii) = eta * dG * tmp_TF * tmp_sigma * tmp_sigma * scaling * cdf_h;
+		}
+	}
+
+  // return values
+	octave_value_list option_outargs;
+	option_outargs(0) = convex_adj;
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    if (!args(0).isnumeric () || args(0).numel () != 1
+        || (args(0).int_value () != 1 && args(0).int_value () != 2))
+    {
+        error("cms_convexity_cpp: expecting model to be 1 (Black) or 2 (Normal)");
+        return true;
+    }
+
+    if (!args(1).isnumeric () || args(1).numel () != 1
+        || args(1).int_value () < 0 || args(1).int_value () > 2)
+    {
+        error("cms_convexity_cpp: expecting payoff to be 0 (swaplet), 1 (caplet) or 2 (floorlet)");
+        return true;
+    }
+
+    for (int ii = 2; ii < 11; ++ii)
+    {
+        if (!args(ii).isnumeric ())
+        {
+            error("cms_convexity_cpp: expecting argument %d to be numeric",ii + 1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+%!assert(cms_convexity_cpp(2,0,0.02,4.5,0.95,0.008,1,1,5,1,0),0.000121191951486,0.0000000001)
+%!test
+%! f = [0.02;0.03];
+%! dG = (1 + f - 2.*f) .* ((1+f).^(5-2-1) ./ ((1+f).^5 - 1)) - 5.*f .* ((1+f).^(5-2-1) ./ ((1+f).^5 - 1).^2);
+%! assert(cms_convexity_cpp(1,0,f,4.5,0.95,0.2,2,2,5,1,0),dG .* (exp(0.2^2*2) - 1) .* f.^2 .* 4.5 ./ 0.95,sqrt(eps))
+%! h = (f - 0.025) ./ (0.008*sqrt(2));
+%! assert(cms_convexity_cpp(2,1,f,4.5,0.95,0.008,2,2,5,1,0.025),dG .* 2 .* 0.008^2 .* 4.5 ./ 0.95 .* 0.5.*(1+erf(h./sqrt(2))),sqrt(eps))
+%! assert(cms_convexity_cpp(1,2,f,4.5,0.95,0.2,2,2,5,1,0.025),[0;0])
+*/
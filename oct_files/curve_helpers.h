@@ -0,0 +1,94 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+// Shared helper functions of the curve based oct files (swap_annuity_cpp,
+// forward_rate_cpp, rollout_retail_cpp, rollout_prepayment_cpp and
+// key_rates_cpp). Header only:
+// the oct files are compiled one by one in compile_oct_files.m.
+
+#ifndef OCTARISK_CURVE_HELPERS_H
+#define OCTARISK_CURVE_HELPERS_H
+
+#include <octave/oct.h>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+// map compounding type to 1 (simple), 2 (discrete) or 3 (continuous)
+static inline int get_compounding_type(std::string comp_type,
+											const char* caller)
+{
+	std::transform(comp_type.begin(), comp_type.end(), comp_type.begin(), ::tolower);
+	if ( comp_type.find("simp") != std::string::npos )
+		return 1;
+	else if ( comp_type.find("disc") != std::string::npos )
+		return 2;
+	else if ( comp_type.find("cont") != std::string::npos )
+		return 3;
+	error("%s: Need valid compounding_type. Unknown >>%s<<",caller,comp_type.c_str());
+	return 3;
+}
+
+// map compounding frequency to number of compounding periods per year
+static inline double get_compounding_freq(const octave_value& comp_freq,
+											const char* caller)
+{
+	if ( !comp_freq.is_string () )
+		return comp_freq.double_value ();
+	std::string freq = comp_freq.string_value ();
+	std::transform(freq.begin(), freq.end(), freq.begin(), ::tolower);
+	if ( freq.compare(0, 2, "da") == 0 )
+		return 365.0;
+	else if ( freq.compare(0, 4, "week") == 0 )
+		return 52.0;
+	else if ( freq.compare(0, 5, "month") == 0 )
+		return 12.0;
+	else if ( freq.compare(0, 7, "quarter") == 0 )
+		return 4.0;
+	else if ( freq.compare(0, 11, "semi-annual") == 0 )
+		return 2.0;
+	else if ( freq.compare(0, 6, "annual") == 0 )
+		return 1.0;
+	error("%s: Need valid compounding frequency. Unknown >>%s<<",caller,freq.c_str());
+	return 1.0;
+}
+
+// non-zero interpolation weights (nodes x dates, usually two nodes per date)
+// in compressed column format: the weights of date dd are stored in
+// nz_node / nz_weight at positions nz_ptr[dd] to nz_ptr[dd+1] - 1
+static inline void get_nonzero_weights(const Matrix& weights,
+					std::vector<octave_idx_type>& nz_ptr,
+					std::vector<octave_idx_type>& nz_node,
+					std::vector<double>& nz_weight)
+{
+	const octave_idx_type no_nodes = weights.rows ();
+	const octave_idx_type no_dates = weights.cols ();
+	nz_ptr.assign (no_dates + 1, 0);
+	nz_node.clear ();
+	nz_weight.clear ();
+	for (octave_idx_type dd = 0; dd < no_dates; ++dd)
+	{
+		for (octave_idx_type nn = 0; nn < no_nodes; ++nn)
+		{
+			if ( weights(nn,dd) != 0.0 )
+			{
+				nz_node.push_back(nn);
+				nz_weight.push_back(weights(nn,dd));
+			}
+		}
+		nz_ptr[dd+1] = nz_node.size ();
+	}
+}
+
+#endif
@@ -0,0 +1,199 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <octave/parse.h>
+#include "curve_helpers.h"
+
+static bool any_bad_argument(const octave_value_list& args);
+
+// discount factor of annualized rate for given time factor
+static inline double get_df(const double& rate, const double& tf,
+                            const int& comp_type, const double& comp_freq)
+{
+    if (comp_type == 1)         // simple
+        return 1.0 / (1.0 + rate * tf);
+    else if (comp_type == 2)    // discrete
+        return std::pow(1.0 + rate / comp_freq, -comp_freq * tf);
+    else                        // continuous
+        return std::exp(-rate * tf);
+}
+
+DEFUN_DLD (forward_rate_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {@var{forward_rates}} = forward_rate_cpp(@var{rates}, @var{weights}, @var{tf_curve}, @var{tf}, @var{comp_type_curve}, @var{comp_freq_curve}, @var{comp_type}, @var{floor_flag})\n\
+\n\
+Compute forward rates of a reset schedule for all scenarios in one call.\n\
+\n\
+This function should be called from Octave script get_forward_rate.m.\n\
+A reset schedule of D forward periods [t1,t2] is given by 2D timesteps\n\
+(D forward start dates followed by D forward end dates). The curve rates\n\
+at all timesteps of scenario s are given by rates(s,:) * weights.\n\
+Curve discount factors DF1 and DF2 are calculated with the curve\n\
+compounding type, frequency and time factors (curve basis). Since converting\n\
+rates into the instrument compounding and basis leaves discount factors\n\
+unchanged, the forward rate is given by (with instrument time factors d1, d2):\n\
+@itemize @bullet\n\
+@item simple: (DF1 / DF2 - 1) / (d2 - d1)\n\
+@item discrete: (DF1 / DF2)^(1 / (d2 - d1)) - 1\n\
+@item continuous: log(DF1 / DF2) / (d2 - d1)\n\
+@end itemize\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{rates}: Double: curve rates of all scenarios (S x N matrix)\n\
+@item @var{weights}: Double: interpolation weights of curve nodes at all\n\
+forward start and end dates (N x 2D matrix)\n\
+@item @var{tf_curve}: Double: time factors (curve basis) of all forward start\n\
+and end dates (2D x 1)\n\
+@item @var{tf}: Double: time factors (instrument basis) of all forward start\n\
+and end dates (2D x 1)\n\
+@item @var{comp_type_curve}: String: compounding type of curve\n\
+@item @var{comp_freq_curve}: Double or String: compounding frequency of curve\n\
+@item @var{comp_type}: String: compounding type of instrument\n\
+@item @var{floor_flag}: Boolean: floor forward rates at 0.000001\n\
+@item @var{forward_rates}: Double: OUTPUT: forward rates (S x D matrix)\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+forward_rates = forward_rate_cpp([0.06,0.06],[1,0;0,1],[1;2],[1;2],'cont',1,'cont',true)\n\
+forward_rates = 0.060000\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  if (nargin != 8 )
+  {
+    print_usage ();
+	error("Expecting 8 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	Matrix rates             = args(0).matrix_value ();
+	Matrix weights           = args(1).matrix_value ();
+	ColumnVector tf_curve    = ColumnVector (args(2).array_value ());
+	ColumnVector tf          = ColumnVector (args(3).array_value ());
+	int comp_type_curve      = get_compounding_type(args(4).string_value (), "forward_rate_cpp");
+	double comp_freq_curve   = get_compounding_freq(args(5), "forward_rate_cpp");
+	int comp_type            = get_compounding_type(args(6).string_value (), "forward_rate_cpp");
+	bool floor_flag          = args(7).bool_value ();
+
+	const octave_idx_type no_scen = rates.rows ();
+	const octave_idx_type no_nodes = rates.cols ();
+	const octave_idx_type no_steps = weights.cols ();
+	const octave_idx_type no_periods = no_steps / 2;
+	if ( weights.rows () != no_nodes )
+		error("forward_rate_cpp: weights need %d rows (number of curve nodes)", (int) no_nodes);
+	if ( no_steps != 2 * no_periods )
+		error("forward_rate_cpp: weights need an even number of columns (forward start and end dates)");
+	if ( tf_curve.numel () != no_steps || tf.numel () != no_steps )
+		error("forward_rate_cpp: tf_curve and tf need %d entries", (int) no_steps);
+
+	// non-zero interpolation weights of all timesteps (usually two nodes)
+	std::vector<octave_idx_type> nz_ptr, nz_node;
+	std::vector<double> nz_weight;
+	get_nonzero_weights(weights, nz_ptr, nz_node, nz_weight);
+
+	Matrix forward_rates (no_scen, no_periods);
+
+	// loop over all forward periods and scenarios
+	for (octave_idx_type dd = 0; dd < no_periods; ++dd)
+	{
+		// catch ctrl + c
+		OCTAVE_QUIT;
+		const octave_idx_type d2 = dd + no_periods;
+		const double dt = tf(d2) - tf(dd);
+		for (octave_idx_type ss = 0; ss < no_scen; ++ss)
+		{
+			double r1 = 0.0;
+			for (octave_idx_type kk = nz_ptr[dd]; kk < nz_ptr[dd+1]; ++kk)
+				r1 += rates(ss,nz_node[kk]) * nz_weight[kk];
+			double r2 = 0.0;
+			for (octave_idx_type kk = nz_ptr[d2]; kk < nz_ptr[d2+1]; ++kk)
+				r2 += rates(ss,nz_node[kk]) * nz_weight[kk];
+			// growth factor of forward period
+			const double growth = get_df(r1, tf_curve(dd), comp_type_curve, comp_freq_curve)
+								/ get_df(r2, tf_curve(d2), comp_type_curve, comp_freq_curve);
+			double tmp_rate;
+			if (comp_type == 1)         // simple
+				tmp_rate = (growth - 1.0) / dt;
+			else if (comp_type == 2)    // discrete
+				tmp_rate = std::pow(growth, 1.0 / dt) - 1.0;
+			else                        // continuous
+				tmp_rate = std::log(growth) / dt;
+			if ( floor_flag == true )
+				tmp_rate = std::max(tmp_rate, 0.000001);
+			forward_rates(ss,dd) = tmp_rate;
+		}
+	}
+
+  // return values
+	octave_value_list option_outargs;
+	option_outargs(0) = forward_rates;
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    for (int ii = 0; ii < 4; ++ii)
+    {
+        if (!args(ii).isnumeric ())
+        {
+            error("forward_rate_cpp: expecting argument %d to be numeric",ii + 1);
+            return true;
+        }
+    }
+
+    if (!args(4).is_string () || !args(6).is_string ())
+    {
+        error("forward_rate_cpp: expecting comp_type_curve and comp_type to be strings");
+        return true;
+    }
+
+    if (!args(5).is_string () && (args(5).numel () != 1 || args(5).double_value () <= 0.0))
+    {
+        error("forward_rate_cpp: expecting comp_freq_curve to be a string or a positive scalar");
+        return true;
+    }
+
+    if (args(7).numel () != 1)
+    {
+        error("forward_rate_cpp: expecting floor_flag to be a scalar");
+        return true;
+    }
+
+    return false;
+}
+
+/*
+%!assert(forward_rate_cpp([0.06,0.06],[1,0;0,1],[1;2],[1;2],'cont',1,'cont',true),0.06,0.0000001)
+%!test
+%! r = [0.05,0.06;-0.01,-0.02];
+%! fwd = forward_rate_cpp(r,[1,0;0,1],[1;2],[1;2],'disc','annual','simple',false);
+%! assert(fwd,(1+r(:,2)).^2 ./ (1+r(:,1)) - 1,sqrt(eps))
+%! fwd = forward_rate_cpp(r,[1,0;0,1],[1;2],[1;2],'disc','annual','simple',true);
+%! assert(fwd,[(1.06^2/1.05 - 1);0.000001],sqrt(eps))
+*/
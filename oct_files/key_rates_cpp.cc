@@ -0,0 +1,295 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <octave/parse.h>
+#include "curve_helpers.h"
+
+static bool any_bad_argument(const octave_value_list& args);
+
+// discount factor and derivative with respect to rate
+static inline void get_df(const double& rate, const double& tf, const int& comp_type,
+                          const double& comp_freq, double& df, double& ddf)
+{
+    if (comp_type == 1)         // simple
+    {
+        const double tmp = 1.0 + rate * tf;
+        df = 1.0 / tmp;
+        ddf = -tf / (tmp * tmp);
+    }
+    else if (comp_type == 2)    // discrete
+    {
+        const double tmp = 1.0 + rate / comp_freq;
+        df = std::pow(tmp, -comp_freq * tf);
+        ddf = -tf * df / tmp;
+    }
+    else                        // continuous
+    {
+        df = std::exp(-rate * tf);
+        ddf = -tf * df;
+    }
+}
+
+// shock (continuous, act/365) converted into curve compounding and basis
+// (see convert_curve_rates) and derivative with respect to shock
+static inline void get_shock(const double& x, const double& tf_origin,
+                             const double& tf_target, const int& comp_type,
+                             const double& comp_freq, double& c, double& dc)
+{
+    if (tf_target == 0.0)
+    {
+        c = x;
+        dc = 1.0;
+    }
+    else if (comp_type == 1)    // CONT -> SMP
+    {
+        const double tmp = std::exp(x * tf_origin);
+        c = (tmp - 1.0) / tf_target;
+        dc = tf_origin * tmp / tf_target;
+    }
+    else if (comp_type == 2)    // CONT -> DISC
+    {
+        const double tmp = std::exp(x * tf_origin / (comp_freq * tf_target));
+        c = (tmp - 1.0) * comp_freq;
+        dc = tf_origin / tf_target * tmp;
+    }
+    else                        // CONT -> CONT
+    {
+        c = x * tf_origin / tf_target;
+        dc = tf_origin / tf_target;
+    }
+}
+
+// triangular key rate bucket weight of cash flow date t (linear interpolation
+// with constant extrapolation, first and last bucket are flat outside)
+static inline double get_bucket_weight(const double& t, const ColumnVector& key_terms,
+                                       const octave_idx_type& kk, const double& width)
+{
+    const octave_idx_type no_keys = key_terms.numel ();
+    const double key_term = key_terms(kk);
+    if ( t <= key_term - width )
+        return (kk == 0) ? 1.0 : 0.0;
+    else if ( t >= key_term + width )
+        return (kk == no_keys - 1 && kk > 0) ? 1.0 : 0.0;
+    else if ( t <= key_term )
+        return (kk == 0) ? 1.0 : (t - key_term + width) / width;
+    else
+        return (kk == no_keys - 1 && kk > 0) ? 1.0 : (key_term + width - t) / width;
+}
+
+DEFUN_DLD (key_rates_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {[@var{value_down} @var{value_up} @var{dv01}]} = key_rates_cpp(@var{row_ptr}, @var{cf_dates}, @var{cf_values}, @var{rates}, @var{spread}, @var{tf_curve}, @var{tf_shock}, @var{comp_type_curve}, @var{comp_freq_curve}, @var{key_terms}, @var{key_rate_shock}, @var{key_rate_width})\n\
+\n\
+Compute key rate shocked values and analytical key rate DV01 of a batch of\n\
+bonds for all key terms in one pass over all cash flows.\n\
+\n\
+This function should be called from Octave script calc_key_rates.m.\n\
+Cash flows of all B bonds are stored consecutively, cash flows of bond b are\n\
+given by entries row_ptr(b)+1 ... row_ptr(b+1). The triangular bucket weight\n\
+w of each key term (width @var{key_rate_width}, flat outside of first and\n\
+last key term) is calculated once per cash flow date. Cash flows with\n\
+cf_dates <= 0 are skipped (see pricing_npv). The key rate shock\n\
+w * @var{key_rate_shock} (continuous, act/365) is converted into the curve\n\
+conventions (see convert_curve_rates) and added to or subtracted from the\n\
+curve rate (floored at -0.99999) before adding the converted spread.\n\
+The DV01 is the analytical derivative of the bond value with respect to a\n\
+key rate shock of -1bp (continuous, act/365):\n\
+dv01 = 0.0001 * sum (cf_value * w * dDF/dy * dy/dshock) * (-1)\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{row_ptr}: Double: start index of cash flows of each bond (B+1 x 1)\n\
+@item @var{cf_dates}: Double: cash flow dates in days from valuation date\n\
+@item @var{cf_values}: Double: cash flow values\n\
+@item @var{rates}: Double: curve rates at cash flow dates\n\
+@item @var{spread}: Double: spread over yield in curve conventions\n\
+@item @var{tf_curve}: Double: time factors of cash flow dates (curve basis)\n\
+@item @var{tf_shock}: Double: time factors of cash flow dates (act/365)\n\
+@item @var{comp_type_curve}: String: compounding type of curve\n\
+@item @var{comp_freq_curve}: Double or String: compounding frequency of curve\n\
+@item @var{key_terms}: Double: key terms in days (K x 1)\n\
+@item @var{key_rate_shock}: Double: key rate shock size (continuous, act/365)\n\
+@item @var{key_rate_width}: Double: width of key rate shocks in days\n\
+@item @var{value_down}: Double: OUTPUT: values under key rate down shocks (B x K)\n\
+@item @var{value_up}: Double: OUTPUT: values under key rate up shocks (B x K)\n\
+@item @var{dv01}: Double: OUTPUT: analytical key rate DV01 (B x K)\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+[value_down value_up dv01] = key_rates_cpp([0;2],[365;730],[5;105],[0.01;0.01],[0;0],[1;2],[1;2],'cont',1,[365,730],0.01,365)\n\
+value_down =\n\
+   107.92   109.95\n\
+value_up =\n\
+   107.82   105.83\n\
+dv01 =\n\
+   0.00049502   0.02058417\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  if (nargin != 12 )
+  {
+    print_usage ();
+	error("Expecting 12 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	ColumnVector row_ptr     = ColumnVector (args(0).array_value ());
+	ColumnVector cf_dates    = ColumnVector (args(1).array_value ());
+	ColumnVector cf_values   = ColumnVector (args(2).array_value ());
+	ColumnVector rates       = ColumnVector (args(3).array_value ());
+	ColumnVector spread      = ColumnVector (args(4).array_value ());
+	ColumnVector tf_curve    = ColumnVector (args(5).array_value ());
+	ColumnVector tf_shock    = ColumnVector (args(6).array_value ());
+	int comp_type_curve      = get_compounding_type(args(7).string_value (), "key_rates_cpp");
+	double comp_freq_curve   = get_compounding_freq(args(8), "key_rates_cpp");
+	ColumnVector key_terms   = ColumnVector (args(9).array_value ());
+	double key_rate_shock    = args(10).double_value ();
+	double key_rate_width    = args(11).double_value ();
+
+	const octave_idx_type no_bonds = row_ptr.numel () - 1;
+	const octave_idx_type no_cf = cf_dates.numel ();
+	const octave_idx_type no_keys = key_terms.numel ();
+	if ( cf_values.numel () != no_cf || rates.numel () != no_cf
+			|| spread.numel () != no_cf || tf_curve.numel () != no_cf
+			|| tf_shock.numel () != no_cf )
+		error("key_rates_cpp: all cash flow vectors need %d entries", (int) no_cf);
+	if ( row_ptr(0) != 0 || row_ptr(no_bonds) != no_cf )
+		error("key_rates_cpp: row_ptr has to start with 0 and end with %d", (int) no_cf);
+
+	Matrix value_down (no_bonds, no_keys, 0.0);
+	Matrix value_up (no_bonds, no_keys, 0.0);
+	Matrix dv01 (no_bonds, no_keys, 0.0);
+
+	// loop over all bonds and cash flows
+	for (octave_idx_type bb = 0; bb < no_bonds; ++bb)
+	{
+		// catch ctrl + c
+		OCTAVE_QUIT;
+		const octave_idx_type start = static_cast<octave_idx_type> (row_ptr(bb));
+		const octave_idx_type end = static_cast<octave_idx_type> (row_ptr(bb+1));
+		for (octave_idx_type jj = start; jj < end; ++jj)
+		{
+			// cash flows on or before valuation date are not valuated
+			if ( cf_dates(jj) <= 0.0 )
+				continue;
+			const double tf_c = tf_curve(jj);
+			const double tf_s = tf_shock(jj);
+			const double cf = cf_values(jj);
+			// analytical derivative of discount factor at unshocked curve
+			double df, ddf, c, dc;
+			get_df(std::max(rates(jj), -0.99999) + spread(jj), tf_c,
+							comp_type_curve, comp_freq_curve, df, ddf);
+			get_shock(0.0, tf_s, tf_c, comp_type_curve, comp_freq_curve, c, dc);
+			const double dv01_cf = -0.0001 * cf * ddf * dc;
+			// key rate shocks of all key terms with non-zero bucket weight
+			for (octave_idx_type kk = 0; kk < no_keys; ++kk)
+			{
+				const double w = get_bucket_weight(cf_dates(jj), key_terms, kk,
+															key_rate_width);
+				if ( w == 0.0 )
+				{
+					value_down(bb,kk) += cf * df;
+					value_up(bb,kk) += cf * df;
+					continue;
+				}
+				get_shock(w * key_rate_shock, tf_s, tf_c, comp_type_curve,
+								comp_freq_curve, c, dc);
+				double df_shock, ddf_shock;
+				get_df(std::max(rates(jj) - c, -0.99999) + spread(jj), tf_c,
+							comp_type_curve, comp_freq_curve, df_shock, ddf_shock);
+				value_down(bb,kk) += cf * df_shock;
+				get_df(std::max(rates(jj) + c, -0.99999) + spread(jj), tf_c,
+							comp_type_curve, comp_freq_curve, df_shock, ddf_shock);
+				value_up(bb,kk) += cf * df_shock;
+				dv01(bb,kk) += w * dv01_cf;
+			}
+		}
+	}
+
+  // return values
+	octave_value_list option_outargs;
+	option_outargs(0) = value_down;
+	option_outargs(1) = value_up;
+	option_outargs(2) = dv01;
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    for (int ii = 0; ii < 12; ++ii)
+    {
+        if ( ii == 7 || ii == 8 )
+            continue;
+        if (!args(ii).isnumeric ())
+        {
+            error("key_rates_cpp: expecting argument %d to be numeric",ii + 1);
+            return true;
+        }
+    }
+
+    if (!args(7).is_string ())
+    {
+        error("key_rates_cpp: expecting comp_type_curve to be a string");
+        return true;
+    }
+
+    if (!args(8).is_string () && (args(8).numel () != 1 || args(8).double_value () <= 0.0))
+    {
+        error("key_rates_cpp: expecting comp_freq_curve to be a string or a positive scalar");
+        return true;
+    }
+
+    if (args(0).numel () < 1 || args(10).numel () != 1 || args(11).numel () != 1
+        || args(11).double_value () <= 0.0)
+    {
+        error("key_rates_cpp: expecting row_ptr, key_rate_shock and positive key_rate_width");
+        return true;
+    }
+
+    return false;
+}
+
+/*
+%!test
+%! [value_down value_up dv01] = key_rates_cpp([0;2],[365;730],[5;105],[0.01;0.01],[0;0],[1;2],[1;2],'cont',1,[365,730],0.01,365);
+%! assert(value_down,[5 + 105*exp(-0.02),5*exp(-0.01) + 105],sqrt(eps))
+%! assert(value_up,[5*exp(-0.02) + 105*exp(-0.02),5*exp(-0.01) + 105*exp(-0.04)],sqrt(eps))
+%! assert(dv01,0.0001 .* [5*exp(-0.01),2*105*exp(-0.02)],sqrt(eps))
+%! % cash flows on or before valuation date are skipped
+%! [value_down2 value_up2 dv01_2] = key_rates_cpp([0;4],[-30;0;365;730],[7;7;5;105],[0.01;0.01;0.01;0.01],[0;0;0;0],[-1/12;0;1;2],[-1/12;0;1;2],'cont',1,[365,730],0.01,365);
+%! assert(value_down2,value_down,sqrt(eps))
+%! assert(value_up2,value_up,sqrt(eps))
+%! assert(dv01_2,dv01,sqrt(eps))
+%!test
+%! % sum of key rate DV01 equals analytical DV01 of parallel shift (simple curve)
+%! tf = [0.5;1.5;2.5;4];
+%! df = 1 ./ (1 + 0.02 .* tf);
+%! [value_down value_up dv01] = key_rates_cpp([0;4],[182;547;912;1460],[1;1;1;101],[0.02;0.02;0.02;0.02],[0;0;0;0],tf,tf,'simple',1,[365,730,1095],0.0001,365);
+%! assert(sum(dv01),0.0001 .* sum([1;1;1;101] .* df.^2 .* tf),sqrt(eps))
+%! assert(sum(value_down - value_up) ./ 2,sum(dv01),0.000001)
+*/
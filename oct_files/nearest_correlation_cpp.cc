@@ -0,0 +1,412 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <octave/EIG.h>
+#include <cmath>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <octave/parse.h>
+
+static bool any_bad_argument(const octave_value_list& args);
+
+static void get_sorted_eig(const Matrix& A, ColumnVector& lambda, Matrix& P);
+
+static ColumnVector get_jacobian_product(const Matrix& Pa, const Matrix& Pb,
+            const Matrix& tau, const ColumnVector& h);
+
+DEFUN_DLD (nearest_correlation_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {[@var{X} @var{y} @var{iter} @var{retcode}]} = nearest_correlation_cpp(@var{G}, @var{y0}, @var{tol}, @var{maxit})\n\
+\n\
+Compute the nearest correlation matrix (Frobenius norm) to a symmetric matrix.\n\
+\n\
+This function should be called from Octave script correct_correlation_matrix.m.\n\
+The quadratically convergent semismooth Newton method of Qi and Sun (2006)\n\
+is applied to the dual problem: the dual variables @var{y} (one per row) are\n\
+updated until the diagonal of the projection of G + diag(y) onto the cone\n\
+of positive semidefinite matrices equals one. Each Newton step needs one\n\
+eigendecomposition (LAPACK), the Newton equation is solved by a\n\
+preconditioned conjugate gradient method, the step length is set by an\n\
+Armijo line search. The dual variables of a previous solution\n\
+(e.g. previous day's correlation matrix) can be used as warm start.\n\
+The solution is finally rescaled to unit diagonal.\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{G}: Double: symmetric input matrix (n x n)\n\
+@item @var{y0}: Double: warm start of dual variables (n x 1 or empty, default 1 - diag(G))\n\
+@item @var{tol}: Double: tolerance of norm of diag(X) - 1 (default 1e-7)\n\
+@item @var{maxit}: Integer: maximum number of Newton steps (default 100)\n\
+@item @var{X}: Double: OUTPUT: nearest correlation matrix (n x n)\n\
+@item @var{y}: Double: OUTPUT: dual variables (warm start for next call, n x 1)\n\
+@item @var{iter}: Integer: OUTPUT: number of Newton steps\n\
+@item @var{retcode}: Integer: OUTPUT: 0 (converged), 1 (maximum number of\n\
+steps reached), 2 (line search failed)\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+X = nearest_correlation_cpp([1,1,0;1,1,1;0,1,1])\n\
+X =\n\
+   1.00000   0.76069   0.15730\n\
+   0.76069   1.00000   0.76069\n\
+   0.15730   0.76069   1.00000\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  if (nargin < 1 || nargin > 4 )
+  {
+    print_usage ();
+	error("Expecting 1 to 4 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	Matrix G         = args(0).matrix_value ();
+	const octave_idx_type n = G.rows ();
+	double tol       = 1.0e-7;
+	int maxit        = 100;
+	if ( nargin > 2 )
+		tol = args(2).double_value ();
+	if ( nargin > 3 )
+		maxit = args(3).int_value ();
+
+	// symmetrize input matrix
+	for (octave_idx_type ii = 0; ii < n; ++ii)
+		for (octave_idx_type jj = ii + 1; jj < n; ++jj)
+		{
+			const double tmp = 0.5 * (G(ii,jj) + G(jj,ii));
+			G(ii,jj) = tmp;
+			G(jj,ii) = tmp;
+		}
+
+	// dual variables: warm start or 1 - diag(G)
+	ColumnVector y (n);
+	if ( nargin > 1 && args(1).numel () > 0 )
+	{
+		if ( args(1).numel () != n )
+			error("nearest_correlation_cpp: expecting y0 to be empty or of length %d", (int) n);
+		y = ColumnVector (args(1).array_value ());
+	}
+	else
+	{
+		for (octave_idx_type ii = 0; ii < n; ++ii)
+			y(ii) = 1.0 - G(ii,ii);
+	}
+
+	// parameter of line search and conjugate gradient method
+	const double mu = 1.0e-4;
+	const int maxit_ls = 30;
+	const int maxit_cg = 200;
+
+	ColumnVector lambda (n);
+	Matrix P (n, n);
+	Matrix X (G);
+	ColumnVector Fy (n);
+	for (octave_idx_type ii = 0; ii < n; ++ii)
+		X(ii,ii) += y(ii);
+	get_sorted_eig(X, lambda, P);
+
+	int iter = 0;
+	int retcode = 1;
+	while ( iter <= maxit )
+	{
+		// catch ctrl + c
+		OCTAVE_QUIT;
+
+		// dual objective and gradient diag(P_S(G + diag(y))) - 1
+		octave_idx_type r = 0;
+		double theta = 0.0;
+		for (octave_idx_type kk = 0; kk < n; ++kk)
+		{
+			if ( lambda(kk) > 0.0 )
+			{
+				theta += 0.5 * lambda(kk) * lambda(kk);
+				++r;
+			}
+		}
+		double norm_F = 0.0;
+		for (octave_idx_type ii = 0; ii < n; ++ii)
+		{
+			double tmp = 0.0;
+			for (octave_idx_type kk = 0; kk < r; ++kk)
+				tmp += P(ii,kk) * P(ii,kk) * lambda(kk);
+			Fy(ii) = tmp - 1.0;
+			norm_F += Fy(ii) * Fy(ii);
+			theta -= y(ii);
+		}
+		norm_F = std::sqrt(norm_F);
+		if ( norm_F <= tol )
+		{
+			retcode = 0;
+			break;
+		}
+		if ( iter == maxit )
+			break;
+		++iter;
+
+		// blocks of eigenvectors with positive (a) and non-positive (b) eigenvalues
+		Matrix Pa = (r > 0) ? P.extract(0, 0, n - 1, r - 1) : Matrix (n, 0);
+		Matrix Pb = (r < n) ? P.extract(0, r, n - 1, n - 1) : Matrix (n, 0);
+		Matrix tau (r, n - r);
+		for (octave_idx_type kk = 0; kk < r; ++kk)
+			for (octave_idx_type ll = r; ll < n; ++ll)
+				tau(kk,ll - r) = lambda(kk) / (lambda(kk) - lambda(ll));
+
+		// diagonal preconditioner
+		ColumnVector c (n);
+		for (octave_idx_type ii = 0; ii < n; ++ii)
+		{
+			double tmp_a = 0.0;
+			for (octave_idx_type kk = 0; kk < r; ++kk)
+				tmp_a += Pa(ii,kk) * Pa(ii,kk);
+			double tmp_ab = 0.0;
+			for (octave_idx_type kk = 0; kk < r; ++kk)
+			{
+				const double q_ik = Pa(ii,kk) * Pa(ii,kk);
+				for (octave_idx_type ll = 0; ll < n - r; ++ll)
+					tmp_ab += q_ik * tau(kk,ll) * Pb(ii,ll) * Pb(ii,ll);
+			}
+			c(ii) = std::max(tmp_a * tmp_a + 2.0 * tmp_ab, 1.0e-8);
+		}
+
+		// Newton direction: solve V d = -F by preconditioned CG
+		const double tol_cg = std::max(std::min(1.0e-2, 0.1 * norm_F) * norm_F, 1.0e-14);
+		ColumnVector d (n, 0.0);
+		ColumnVector res (n);
+		ColumnVector z (n);
+		ColumnVector p (n);
+		double rz = 0.0;
+		for (octave_idx_type ii = 0; ii < n; ++ii)
+		{
+			res(ii) = -Fy(ii);
+			z(ii) = res(ii) / c(ii);
+			p(ii) = z(ii);
+			rz += res(ii) * z(ii);
+		}
+		for (int kk = 0; kk < maxit_cg; ++kk)
+		{
+			ColumnVector w = get_jacobian_product(Pa, Pb, tau, p);
+			double pw = 0.0;
+			for (octave_idx_type ii = 0; ii < n; ++ii)
+				pw += p(ii) * w(ii);
+			if ( pw <= 0.0 )
+				break;
+			const double alpha = rz / pw;
+			double norm_res = 0.0;
+			for (octave_idx_type ii = 0; ii < n; ++ii)
+			{
+				d(ii) += alpha * p(ii);
+				res(ii) -= alpha * w(ii);
+				norm_res += res(ii) * res(ii);
+			}
+			if ( std::sqrt(norm_res) <= tol_cg )
+				break;
+			double rz_new = 0.0;
+			for (octave_idx_type ii = 0; ii < n; ++ii)
+			{
+				z(ii) = res(ii) / c(ii);
+				rz_new += res(ii) * z(ii);
+			}
+			const double beta = rz_new / rz;
+			rz = rz_new;
+			for (octave_idx_type ii = 0; ii < n; ++ii)
+				p(ii) = z(ii) + beta * p(ii);
+		}
+
+		// Armijo line search on dual objective
+		double Fd = 0.0;
+		for (octave_idx_type ii = 0; ii < n; ++ii)
+			Fd += Fy(ii) * d(ii);
+		double step = 1.0;
+		bool accepted = false;
+		ColumnVector y_new (n);
+		for (int kk = 0; kk < maxit_ls; ++kk)
+		{
+			X = G;
+			double theta_new = 0.0;
+			for (octave_idx_type ii = 0; ii < n; ++ii)
+			{
+				y_new(ii) = y(ii) + step * d(ii);
+				X(ii,ii) += y_new(ii);
+				theta_new -= y_new(ii);
+			}
+			get_sorted_eig(X, lambda, P);
+			for (octave_idx_type ii = 0; ii < n; ++ii)
+				if ( lambda(ii) > 0.0 )
+					theta_new += 0.5 * lambda(ii) * lambda(ii);
+			if ( theta_new <= theta + mu * step * Fd )
+			{
+				accepted = true;
+				break;
+			}
+			step *= 0.5;
+		}
+		y = y_new;
+		if ( accepted == false )
+		{
+			retcode = 2;
+			break;
+		}
+	}
+
+	// projection onto positive semidefinite matrices and rescaling to unit diagonal
+	octave_idx_type r = 0;
+	while ( r < n && lambda(r) > 0.0 )
+		++r;
+	X = Matrix (n, n, 0.0);
+	if ( r > 0 )
+	{
+		Matrix Pa = P.extract(0, 0, n - 1, r - 1);
+		Matrix Pa_scaled (Pa);
+		for (octave_idx_type kk = 0; kk < r; ++kk)
+			for (octave_idx_type ii = 0; ii < n; ++ii)
+				Pa_scaled(ii,kk) *= lambda(kk);
+		X = Pa_scaled * Pa.transpose ();
+	}
+	ColumnVector scale (n);
+	for (octave_idx_type ii = 0; ii < n; ++ii)
+		scale(ii) = (X(ii,ii) > 0.0) ? 1.0 / std::sqrt(X(ii,ii)) : 1.0;
+	for (octave_idx_type ii = 0; ii < n; ++ii)
+	{
+		for (octave_idx_type jj = ii + 1; jj < n; ++jj)
+		{
+			const double tmp = 0.5 * (X(ii,jj) + X(jj,ii)) * scale(ii) * scale(jj);
+			X(ii,jj) = tmp;
+			X(jj,ii) = tmp;
+		}
+		X(ii,ii) = 1.0;
+	}
+
+  // return values
+	octave_value_list option_outargs;
+	option_outargs(0) = X;
+	option_outargs(1) = y;
+	option_outargs(2) = iter;
+	option_outargs(3) = retcode;
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+//#########################    STATIC FUNCTIONS    #############################
+
+// eigendecomposition of symmetric matrix, eigenvalues in descending order
+void get_sorted_eig(const Matrix& A, ColumnVector& lambda, Matrix& P)
+{
+	const octave_idx_type n = A.rows ();
+	EIG eig (A);
+	ColumnVector tmp_lambda = real (eig.eigenvalues ());
+	Matrix tmp_P = real (eig.right_eigenvectors ());
+	std::vector<octave_idx_type> idx (n);
+	std::iota(idx.begin(), idx.end(), 0);
+	std::sort(idx.begin(), idx.end(), [&tmp_lambda] (octave_idx_type a, octave_idx_type b)
+				{ return tmp_lambda(a) > tmp_lambda(b); });
+	for (octave_idx_type kk = 0; kk < n; ++kk)
+	{
+		lambda(kk) = tmp_lambda(idx[kk]);
+		for (octave_idx_type ii = 0; ii < n; ++ii)
+			P(ii,kk) = tmp_P(ii,idx[kk]);
+	}
+}
+
+// product of generalized Jacobian V of diag(P_S(G + diag(y))) with vector h:
+// V h = diag(P (Omega o (P' diag(h) P)) P'), Omega is one on the block of
+// positive eigenvalues, tau on the mixed blocks and zero otherwise
+ColumnVector get_jacobian_product(const Matrix& Pa, const Matrix& Pb,
+            const Matrix& tau, const ColumnVector& h)
+{
+	const octave_idx_type n = Pa.rows ();
+	const octave_idx_type r = Pa.cols ();
+	ColumnVector v (n, 0.0);
+	for (octave_idx_type ii = 0; ii < n; ++ii)
+		v(ii) = 1.0e-10 * h(ii);
+	if ( r == 0 )
+		return v;
+
+	Matrix Wa (Pa);
+	for (octave_idx_type kk = 0; kk < r; ++kk)
+		for (octave_idx_type ii = 0; ii < n; ++ii)
+			Wa(ii,kk) *= h(ii);
+	Matrix Wa_t = Wa.transpose ();
+	Matrix Ma = Pa * (Wa_t * Pa);
+	for (octave_idx_type kk = 0; kk < r; ++kk)
+		for (octave_idx_type ii = 0; ii < n; ++ii)
+			v(ii) += Ma(ii,kk) * Pa(ii,kk);
+
+	if ( Pb.cols () > 0 )
+	{
+		Matrix Hab = Wa_t * Pb;
+		for (octave_idx_type ll = 0; ll < Pb.cols (); ++ll)
+			for (octave_idx_type kk = 0; kk < r; ++kk)
+				Hab(kk,ll) *= tau(kk,ll);
+		Matrix Mb = Pa * Hab;
+		for (octave_idx_type ll = 0; ll < Pb.cols (); ++ll)
+			for (octave_idx_type ii = 0; ii < n; ++ii)
+				v(ii) += 2.0 * Mb(ii,ll) * Pb(ii,ll);
+	}
+	return v;
+}
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    if (!args(0).isnumeric () || args(0).rows () != args(0).columns ())
+    {
+        error("nearest_correlation_cpp: expecting G to be a numeric square matrix");
+        return true;
+    }
+
+    if (args.length () > 1 && !args(1).isnumeric ())
+    {
+        error("nearest_correlation_cpp: expecting y0 to be numeric");
+        return true;
+    }
+
+    if (args.length () > 2 && (args(2).numel () != 1 || args(2).double_value () <= 0.0))
+    {
+        error("nearest_correlation_cpp: expecting tol to be a positive scalar");
+        return true;
+    }
+
+    if (args.length () > 3 && (args(3).numel () != 1 || args(3).int_value () < 0))
+    {
+        error("nearest_correlation_cpp: expecting maxit to be a non-negative integer");
+        return true;
+    }
+
+    return false;
+}
+
+/*
+%!test
+%! [X y iter retcode] = nearest_correlation_cpp([1,1,0;1,1,1;0,1,1]);
+%! assert(retcode,0)
+%! assert(X,[1,0.760689853,0.157298106;0.760689853,1,0.760689853;0.157298106,0.760689853,1],0.000001)
+%! assert(min(eig(X)) > -sqrt(eps))
+%! [X2 y2 iter2] = nearest_correlation_cpp([1,1,0;1,1,1;0,1,1],y);
+%! assert(X2,X,0.000001)
+%! assert(iter2 <= 1)
+%!test
+%! A = [1,0.5;0.5,1];
+%! [X y iter retcode] = nearest_correlation_cpp(A);
+%! assert(X,A,sqrt(eps))
+%! assert(iter,0)
+*/
@@ -0,0 +1,257 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <cmath>
+#include <vector>
+#include <limits>
+#include "thread_helpers.h"
+
+static bool any_bad_argument(const octave_value_list& args);
+
+static double norminv_as241(const double& p);
+
+DEFUN_DLD (pearson_marginal_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {[@var{R}]} = pearson_marginal_cpp(@var{Z}, @var{X_tab}, @var{z_min}, @var{dz})\n\
+\n\
+Transform uniform random numbers into marginal distributions given by\n\
+inverse CDF lookup tables.\n\
+\n\
+This function should be called from Octave script get_marginal_distr_pearson.m.\n\
+Column jj of @var{X_tab} contains the quantiles of the marginal distribution\n\
+of risk factor jj at probabilities normcdf(z_k) with equally spaced normal\n\
+scores z_k = @var{z_min} + k * @var{dz} (k = 0 ... rows(X_tab) - 1).\n\
+Each uniform random number is mapped to its normal score (algorithm AS241)\n\
+and the quantile is interpolated by monotone piecewise cubic Hermite\n\
+interpolation (Fritsch-Butland slopes) on the normal score grid. The\n\
+interpolation in normal scores resolves the tails of the distributions.\n\
+Outside of the table the quantiles are extrapolated linearly.\n\
+The risk factor columns are split across worker threads (number of threads\n\
+set by environment variable OCTARISK_THREADS, default: all hardware threads).\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{Z}: Double: uniform random numbers (scenarios x risk factors)\n\
+@item @var{X_tab}: Double: monotone quantile table (nodes x risk factors)\n\
+@item @var{z_min}: Double: normal score of first table node\n\
+@item @var{dz}: Double: normal score distance of table nodes\n\
+@item @var{R}: Double: OUTPUT: marginal distributed random numbers (scenarios x risk factors)\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+z = (-8:0.01:8)';\n\
+R = pearson_marginal_cpp([0.5;0.975],[z,2.*z],-8,0.01)\n\
+R =\n\
+   0.0000   0.0000\n\
+   1.9600   3.9199\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  if (nargin != 4 )
+  {
+    print_usage ();
+	error("Expecting 4 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	Matrix Z        = args(0).matrix_value ();
+	Matrix X_tab    = args(1).matrix_value ();
+	double z_min    = args(2).double_value ();
+	double dz       = args(3).double_value ();
+
+	const octave_idx_type mc = Z.rows ();
+	const octave_idx_type dim = Z.cols ();
+	const octave_idx_type no_nodes = X_tab.rows ();
+	if ( X_tab.cols () != dim )
+		error("pearson_marginal_cpp: expecting %d columns of X_tab", (int) dim);
+	if ( no_nodes < 2 )
+		error("pearson_marginal_cpp: expecting at least 2 table nodes");
+
+	Matrix R (mc, dim);
+	const double z_max = z_min + (no_nodes - 1) * dz;
+	const double* Z_ptr = Z.data ();
+	const double* X_ptr = X_tab.data ();
+	double* R_ptr = R.fortran_vec ();
+
+	// risk factors are independent: split columns across worker threads
+	const octave_idx_type min_cols = std::max(static_cast<octave_idx_type>(1),
+					static_cast<octave_idx_type>(20000) / std::max(mc,
+					static_cast<octave_idx_type>(1)));
+	parallel_blocks(dim, min_cols,
+		[&](const octave_idx_type col_start, const octave_idx_type col_end)
+	{
+		std::vector<double> secant (no_nodes - 1);
+		std::vector<double> slope (no_nodes);
+		for (octave_idx_type jj = col_start; jj < col_end; ++jj)
+		{
+			const double* x_col = X_ptr + jj * no_nodes;
+			const double* z_col = Z_ptr + jj * mc;
+			double* r_col = R_ptr + jj * mc;
+			// monotone slopes of quantile function (Fritsch-Butland)
+			for (octave_idx_type kk = 0; kk < no_nodes - 1; ++kk)
+				secant[kk] = (x_col[kk+1] - x_col[kk]) / dz;
+			slope[0] = secant[0];
+			slope[no_nodes-1] = secant[no_nodes-2];
+			for (octave_idx_type kk = 1; kk < no_nodes - 1; ++kk)
+			{
+				if ( secant[kk-1] * secant[kk] <= 0.0 )
+					slope[kk] = 0.0;
+				else
+					slope[kk] = 2.0 * secant[kk-1] * secant[kk]
+											/ (secant[kk-1] + secant[kk]);
+			}
+			// interpolate quantiles of all scenarios at their normal scores
+			for (octave_idx_type ii = 0; ii < mc; ++ii)
+			{
+				const double s = norminv_as241(z_col[ii]);
+				if ( std::isnan(s) )
+					r_col[ii] = s;
+				else if ( s <= z_min )
+					r_col[ii] = std::isinf(s) ? x_col[0]
+									: x_col[0] + slope[0] * (s - z_min);
+				else if ( s >= z_max )
+					r_col[ii] = std::isinf(s) ? x_col[no_nodes-1]
+									: x_col[no_nodes-1] + slope[no_nodes-1] * (s - z_max);
+				else
+				{
+					octave_idx_type kk = static_cast<octave_idx_type> ((s - z_min) / dz);
+					if ( kk > no_nodes - 2 )
+						kk = no_nodes - 2;
+					const double t = (s - z_min) / dz - kk;
+					const double t2 = t * t;
+					const double t3 = t2 * t;
+					r_col[ii] = (2.0 * t3 - 3.0 * t2 + 1.0) * x_col[kk]
+								+ (t3 - 2.0 * t2 + t) * dz * slope[kk]
+								+ (-2.0 * t3 + 3.0 * t2) * x_col[kk+1]
+								+ (t3 - t2) * dz * slope[kk+1];
+				}
+			}
+		}
+	});
+
+  // return values
+	octave_value_list option_outargs;
+	option_outargs(0) = R;
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+// inverse of standard normal distribution (Wichura, algorithm AS241,
+// relative accuracy about 1e-16)
+double norminv_as241(const double& p)
+{
+	if ( std::isnan(p) || p < 0.0 || p > 1.0 )
+		return std::numeric_limits<double>::quiet_NaN();
+	if ( p == 0.0 )
+		return -std::numeric_limits<double>::infinity();
+	if ( p == 1.0 )
+		return std::numeric_limits<double>::infinity();
+	const double q = p - 0.5;
+	double r, val;
+	if ( std::fabs(q) <= 0.425 )
+	{
+		r = 0.180625 - q * q;
+		return q * (((((((r * 2509.0809287301226727 +
+				33430.575583588128105) * r + 67265.770927008700853) * r +
+				45921.953931549871457) * r + 13731.693765509461125) * r +
+				1971.5909503065514427) * r + 133.14166789178437745) * r +
+				3.387132872796366608)
+			/ (((((((r * 5226.495278852545925 +
+				28729.085735721942674) * r + 39307.89580009271061) * r +
+				21213.794301586595867) * r + 5394.1960214247511077) * r +
+				687.1870074920579083) * r + 42.313330701600911252) * r + 1.0);
+	}
+	r = (q < 0.0) ? p : 1.0 - p;
+	r = std::sqrt(-std::log(r));
+	if ( r <= 5.0 )
+	{
+		r -= 1.6;
+		val = (((((((r * 7.7454501427834140764e-4 +
+				0.0227238449892691845833) * r + 0.24178072517745061177) * r +
+				1.27045825245236838258) * r + 3.64784832476320460504) * r +
+				5.7694972214606914055) * r + 4.6303378461565452959) * r +
+				1.42343711074968357734)
+			/ (((((((r * 1.05075007164441684324e-9 +
+				5.475938084995344946e-4) * r + 0.0151986665636164571966) * r +
+				0.14810397642748007459) * r + 0.68976733498510000455) * r +
+				1.6763848301838038494) * r + 2.05319162663775882187) * r + 1.0);
+	}
+	else
+	{
+		r -= 5.0;
+		val = (((((((r * 2.01033439929228813265e-7 +
+				2.71155556874348757815e-5) * r + 0.0012426609473880784386) * r +
+				0.026532189526576123093) * r + 0.29656057182850489123) * r +
+				1.7848265399172913358) * r + 5.4637849111641143699) * r +
+				6.6579046435011037772)
+			/ (((((((r * 2.04426310338993978564e-15 +
+				1.4215117583164458887e-7)* r + 1.8463183175100546818e-5) * r +
+				7.868691311456132591e-4) * r + 0.0148753612908506148525) * r +
+				0.13692988092273580531) * r + 0.59983220655588793769) * r + 1.0);
+	}
+	return (q < 0.0) ? -val : val;
+}
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    for (int ii = 0; ii < 4; ++ii)
+    {
+        if (!args(ii).isnumeric ())
+        {
+            error("pearson_marginal_cpp: expecting argument %d to be numeric",ii + 1);
+            return true;
+        }
+    }
+
+    if (args(2).numel () != 1 || args(3).numel () != 1 || args(3).double_value () <= 0.0)
+    {
+        error("pearson_marginal_cpp: expecting scalar z_min and positive scalar dz");
+        return true;
+    }
+
+    return false;
+}
+
+/*
+%!test
+%! z = (-8:0.01:8)';
+%! R = pearson_marginal_cpp([0.5;0.975],[z,2.*z],-8,0.01);
+%! assert(R,[0,0;norminv(0.975),2*norminv(0.975)],sqrt(eps))
+%!test
+%! % quantiles of exponential and t distribution
+%! z = (-8:0.01:8)';
+%! U = [1e-10;0.001;0.1;0.3;0.5;0.77;0.9;0.999;1-1e-10];
+%! X_tab = [-log(1 - normcdf(z)),tinv(normcdf(z),4)];
+%! R = pearson_marginal_cpp([U,U],X_tab,-8,0.01);
+%! assert(R(:,1),-log(1 - U),0.00001)
+%! assert(R(:,2),tinv(U,4),0.0001)
+%!test
+%! % columns split across 3 worker threads
+%! tmp_threads = getenv('OCTARISK_THREADS');
+%! setenv('OCTARISK_THREADS','3');
+%! z = (-8:0.01:8)';
+%! U = repmat([0.001;0.3;0.5;0.9;0.999],2000,7);
+%! R = pearson_marginal_cpp(U,repmat(z,1,7) .* (1:7),-8,0.01);
+%! setenv('OCTARISK_THREADS',tmp_threads);
+%! assert(R,norminv(U) .* (1:7),sqrt(eps))
+*/
@@ -32,6 +32,17 @@ static octave_value_list get_american_option_price(const bool& call_flag,
                     const double& K, const Matrix& B, const int& jMax, 
                     const int& MatIndex, const Matrix& d, const Matrix& pu, 
                     const Matrix& pm, const Matrix& pd, const NDArray& accr_int);
+static double get_tree_expectation(const Matrix& V, const octave_idx_type& i,
+                    const octave_idx_type& j, const int& jMax, const Matrix& pu,
+                    const Matrix& pm, const Matrix& pd);
+static octave_value_list get_option_rate_sensitivity(const bool& call_flag,
+                    const bool& american, const double& K, const Matrix& B,
+                    const NDArray& cf_values_B, const Matrix& V, 
+                    const Matrix& EX, const Matrix& Q, const int& jMax, 
+                    const int& N, const int& MatIndex, const Matrix& d, 
+                    const Matrix& pu, const Matrix& pm, const Matrix& pd, 
+                    const NDArray& dt, const NDArray& Timevec,
+                    const NDArray& accr_int);
 
 DEFUN_DLD (pricing_callable_bond_cpp, args, nargout, "-*- texinfo -*-\n\
 @deftypefn{Loadable Function} {@var{Put} @var{Call}} = pricing_callable_bond_cpp(@var{T}, \n\
@@ -68,7 +79,16 @@ Input and output variables:\n\
 @item @var{american}: Boolean (true: american option, false: european option\n\
 @item @var{Put}: OUTPUT: Putprices (vector)\n\
 @item @var{Call}: OUTPUT: Callprices (vector)\n\
+@item @var{dOption}: OUTPUT (8th, optional): first derivative of the option \n\
+price to a parallel shift of the rates R_matrix (vector)\n\
+@item @var{d2Option}: OUTPUT (9th, optional): second derivative of the option \n\
+price to a parallel shift of the rates R_matrix (vector)\n\
 @end itemize\n\
+A parallel shift h of the rates shifts the calibrated short rates of each\n\
+tree column uniformly, so every discount factor d(:,j) is scaled by\n\
+exp(-h * (Timevec(j) - Timevec(j-1))). The derivatives are propagated\n\
+backwards through the bond and option trees alongside the prices, with the\n\
+exercise decisions held fixed. They are calculated only if requested.\n\
 @end deftypefn")
 {
   octave_value retval;
@@ -116,7 +136,12 @@ Input and output variables:\n\
         NDArray OptionVec (dim_scen);
         NDArray PutVec (dim_scen);
         NDArray CallVec (dim_scen);
+        NDArray dOptionVec (dim_scen);
+        NDArray d2OptionVec (dim_scen);
         OptionVec.fill(0.0);
+        dOptionVec.fill(0.0);
+        d2OptionVec.fill(0.0);
+        bool calc_sensi = (nargout > 7);
         PutVec.fill(0.0);
         CallVec.fill(0.0);
 
@@ -202,6 +227,8 @@ Input and output variables:\n\
             Matrix B = retval_buildB(0).matrix_value ();
             
             // Calculate Option prices
+            Matrix V;
+            Matrix EX;
             if (american == true)
             {
                 // Get American Option Prices
@@ -209,6 +236,8 @@ Input and output variables:\n\
                 retval_AmOpt  = get_american_option_price(call_flag, K, B, jMax,  
                                               MatIndex, d, pu, pm, pd, accr_int);
                 OptionVec(ii)  = retval_AmOpt(0).double_value ();
+                V  = retval_AmOpt(1).matrix_value ();
+                EX = retval_AmOpt(2).matrix_value ();
             } else {
                 // Get European Option payoffs and prices
                 double OptVal = 0.0;
@@ -234,6 +263,19 @@ Input and output variables:\n\
                 }
             }
             
+            // Calculate option price sensitivities to parallel rate shift
+            if (calc_sensi == true)
+            {
+                NDArray cf_values_B = retval_buildB(1).array_value ();
+                octave_value_list retval_sensi;
+                retval_sensi = get_option_rate_sensitivity(call_flag, american,
+                                    K, B, cf_values_B, V, EX, Q, jMax, N,
+                                    MatIndex, d, pu, pm, pd, dt, Timevec,
+                                    accr_int);
+                dOptionVec(ii)  = retval_sensi(0).double_value ();
+                d2OptionVec(ii) = retval_sensi(1).double_value ();
+            }
+            
             // store trees for first scenario only
             if ( ii == 0 ) 
             {
@@ -253,6 +295,8 @@ Input and output variables:\n\
         option_outargs(4) = pd;
         option_outargs(5) = r_first;
         option_outargs(6) = Q_first;
+        option_outargs(7) = dOptionVec;
+        option_outargs(8) = d2OptionVec;
         
        return octave_value (option_outargs);
     }
@@ -275,11 +319,15 @@ octave_value_list get_american_option_price(const bool& call_flag, const double&
     if (call_flag == false) {                           // Option is Put
         // Initialize the American puts trees
         Matrix AP (dv);
+        Matrix EX (dv);
         AP.fill(0.0);
+        EX.fill(0.0);
 
         // Intrinsic value at maturity
         for (octave_idx_type mm = 0; mm < 2*jMax+1; mm++) {
             AP(mm,MatIndex) = std::max(K-B(mm,MatIndex) + accr_int(MatIndex - 1),0.0);
+            if (AP(mm,MatIndex) > 0.0)
+                EX(mm,MatIndex) = 1.0;
         }
         
         Matrix EP = AP; 
@@ -298,26 +346,36 @@ octave_value_list get_american_option_price(const bool& call_flag, const double&
                         EP(i-1,j-1) = d(i-1,j-1)*(EP(i-2,j)*pu(i-1,j-1) + EP(i-1,j)*pm(i-1,j-1) + EP(i,j)*pd(i-1,j-1));
                     }
                     AP(i-1,j-1) = std::max(EP(i-1,j-1), K - B(i-1,j-1) + accr_int(j-2));
+                    if (AP(i-1,j-1) > EP(i-1,j-1))
+                        EX(i-1,j-1) = 1.0;  // store exercise decision
                     EP(i-1,j-1) = AP(i-1,j-1);  // store new values for discounting
                 }
             } else {
                 for (octave_idx_type i=jMax-(j-2); i <= jMax+j; i++) {
                     EP(i-1,j-1) = d(i-1,j-1)*(EP(i-2,j)*pu(i-1,j-1) + EP(i-1,j)*pm(i-1,j-1) + EP(i,j)*pd(i-1,j-1));
                     AP(i-1,j-1) = std::max(EP(i-1,j-1), K - B(i-1,j-1) + accr_int(j-2));
+                    if (AP(i-1,j-1) > EP(i-1,j-1))
+                        EX(i-1,j-1) = 1.0;
                     EP(i-1,j-1) = AP(i-1,j-1);
                 }
             } 
         }
-        // set American Put Price
+        // set American Put Price, option tree and exercise decisions
         outargs(0) = AP(jMax,0);
+        outargs(1) = AP;
+        outargs(2) = EX;
     } else {                                        // Option is Call
         // Initialize the American call trees
         Matrix AC (dv);
+        Matrix EX (dv);
         AC.fill(0.0);
+        EX.fill(0.0);
 
         // Intrinsic value at maturity
         for (octave_idx_type mm = 0; mm < 2*jMax+1; mm++) {
             AC(mm,MatIndex) = std::max(B(mm,MatIndex)-K - accr_int(MatIndex - 1),0.0);
+            if (AC(mm,MatIndex) > 0.0)
+                EX(mm,MatIndex) = 1.0;
         }
         
         Matrix EC = AC;
@@ -336,18 +394,24 @@ octave_value_list get_american_option_price(const bool& call_flag, const double&
                         EC(i-1,j-1) = d(i-1,j-1)*(EC(i-2,j)*pu(i-1,j-1) + EC(i-1,j)*pm(i-1,j-1) + EC(i,j)*pd(i-1,j-1));
                     }
                     AC(i-1,j-1) = std::max(EC(i-1,j-1), B(i-1,j-1) - K  - accr_int(j-2));
+                    if (AC(i-1,j-1) > EC(i-1,j-1))
+                        EX(i-1,j-1) = 1.0;
                     EC(i-1,j-1) = AC(i-1,j-1);
                 }
             } else {
                 for (octave_idx_type i=jMax-(j-2); i <= jMax+j; i++) {
                     EC(i-1,j-1) = d(i-1,j-1)*(EC(i-2,j)*pu(i-1,j-1) + EC(i-1,j)*pm(i-1,j-1) + EC(i,j)*pd(i-1,j-1));
                     AC(i-1,j-1) = std::max(EC(i-1,j-1), B(i-1,j-1) - K - accr_int(j-2));
+                    if (AC(i-1,j-1) > EC(i-1,j-1))
+                        EX(i-1,j-1) = 1.0;
                     EC(i-1,j-1) = AC(i-1,j-1);
                 }
             } 
         }
-        // set American Call Price
+        // set American Call Price, option tree and exercise decisions
         outargs(0) = AC(jMax,0);
+        outargs(1) = AC;
+        outargs(2) = EX;
     }
     
     // return American Option Price
@@ -355,6 +419,129 @@ octave_value_list get_american_option_price(const bool& call_flag, const double&
 }
 
 
+// static function for the expected value of tree column j at node (i,j-1)
+// (1-based indices as in the backward induction loops)
+double get_tree_expectation(const Matrix& V, const octave_idx_type& i,
+                    const octave_idx_type& j, const int& jMax, const Matrix& pu,
+                    const Matrix& pm, const Matrix& pd)
+{
+    if (j>jMax && i==1) {
+        return V(i-1,j)*pu(i-1,j-1) + V(i,j)*pm(i-1,j-1) + V(i+1,j)*pd(i-1,j-1);
+    } else if (j>jMax && i==2*jMax+1) {
+        return V(i-1,j)*pd(i-1,j-1) + V(i-2,j)*pm(i-1,j-1) + V(i-3,j)*pu(i-1,j-1);
+    }
+    return V(i-2,j)*pu(i-1,j-1) + V(i-1,j)*pm(i-1,j-1) + V(i,j)*pd(i-1,j-1);
+}
+
+
+// static function for the first and second derivative of the option price
+// to a parallel shift h of the rates R. The tree calibration shifts all short
+// rates of column j by the same amount, so d(:,j) has derivative 
+// -gamma(j) * d(:,j) and the Arrow-Debreu prices Q(:,j) have derivative
+// -cum(j-1) * Q(:,j). Derivatives are rolled back with fixed exercise decisions.
+octave_value_list get_option_rate_sensitivity(const bool& call_flag,
+                    const bool& american, const double& K, const Matrix& B,
+                    const NDArray& cf_values_B, const Matrix& V, 
+                    const Matrix& EX, const Matrix& Q, const int& jMax, 
+                    const int& N, const int& MatIndex, const Matrix& d, 
+                    const Matrix& pu, const Matrix& pm, const Matrix& pd, 
+                    const NDArray& dt, const NDArray& Timevec,
+                    const NDArray& accr_int)
+{
+    // cumulative rate shift sensitivity cum(j) = sum_k<=j gamma(k)
+    // (root discount factor is set from Rate(0) and dt(0))
+    dim_vector dcum (N+1,1);
+    NDArray cum (dcum);
+    NDArray gamma (dcum);
+    cum(0) = dt(0);
+    gamma(0) = dt(0);
+    for (octave_idx_type j = 1; j <= N; j++) {
+        cum(j) = Timevec(j);
+        gamma(j) = cum(j) - cum(j-1);
+    }
+    
+    // payoff is sign * (B - K - accrued interest)
+    double sign = (call_flag == true) ? 1.0 : -1.0;
+    
+    // first and second derivative of the bond price tree
+    dim_vector dv (2*jMax+1,N+1);  // span Matrix
+    Matrix dB (dv);
+    Matrix d2B (dv);
+    dB.fill(0.0);
+    d2B.fill(0.0);
+    double e, de, d2e, g;
+    for (octave_idx_type j=N; j >= 1; j--) {
+        octave_idx_type i_start = (j>jMax) ? 1 : jMax-(j-2);
+        octave_idx_type i_end = (j>jMax) ? 2*jMax+1 : jMax+j;
+        g = gamma(j-1);
+        for (octave_idx_type i=i_start; i <= i_end; i++) {
+            // expectation of bond price: (B - cf) / d
+            e   = (B(i-1,j-1) - cf_values_B(j-1)) / d(i-1,j-1);
+            de  = get_tree_expectation(dB, i, j, jMax, pu, pm, pd);
+            d2e = get_tree_expectation(d2B, i, j, jMax, pu, pm, pd);
+            dB(i-1,j-1)  = d(i-1,j-1)*(de - g*e);
+            d2B(i-1,j-1) = d(i-1,j-1)*(d2e - 2*g*de + g*g*e);
+        }
+    }
+    
+    double dOpt = 0.0;
+    double d2Opt = 0.0;
+    if (american == false) {
+        // European option: sum of Arrow-Debreu prices times payoffs
+        double c = cum(MatIndex-1);
+        double Payoff;
+        for (octave_idx_type mm = 0; mm < 2*jMax+1; mm++) {
+            Payoff = sign * (B(mm,MatIndex) - K - accr_int(MatIndex - 1));
+            if (Payoff > 0.0) {
+                dOpt  += Q(mm,MatIndex) * (sign*dB(mm,MatIndex) - c*Payoff);
+                d2Opt += Q(mm,MatIndex) * (sign*d2B(mm,MatIndex) 
+                                    - 2*c*sign*dB(mm,MatIndex) + c*c*Payoff);
+            }
+        }
+    } else {
+        // American option: roll back derivatives of the option tree V
+        dim_vector dvo (2*jMax+1,MatIndex+1);
+        Matrix dV (dvo);
+        Matrix d2V (dvo);
+        dV.fill(0.0);
+        d2V.fill(0.0);
+        for (octave_idx_type mm = 0; mm < 2*jMax+1; mm++) {
+            if (EX(mm,MatIndex) > 0.0) {
+                dV(mm,MatIndex)  = sign*dB(mm,MatIndex);
+                d2V(mm,MatIndex) = sign*d2B(mm,MatIndex);
+            }
+        }
+        for (octave_idx_type j=MatIndex; j >= 1; j--) {
+            // catch ctrl + c
+            OCTAVE_QUIT;
+            octave_idx_type i_start = (j>jMax) ? 1 : jMax-(j-2);
+            octave_idx_type i_end = (j>jMax) ? 2*jMax+1 : jMax+j;
+            g = gamma(j-1);
+            for (octave_idx_type i=i_start; i <= i_end; i++) {
+                if (EX(i-1,j-1) > 0.0) {
+                    dV(i-1,j-1)  = sign*dB(i-1,j-1);
+                    d2V(i-1,j-1) = sign*d2B(i-1,j-1);
+                } else {
+                    e   = get_tree_expectation(V, i, j, jMax, pu, pm, pd);
+                    de  = get_tree_expectation(dV, i, j, jMax, pu, pm, pd);
+                    d2e = get_tree_expectation(d2V, i, j, jMax, pu, pm, pd);
+                    dV(i-1,j-1)  = d(i-1,j-1)*(de - g*e);
+                    d2V(i-1,j-1) = d(i-1,j-1)*(d2e - 2*g*de + g*g*e);
+                }
+            }
+        }
+        dOpt  = dV(jMax,0);
+        d2Opt = d2V(jMax,0);
+    }
+    
+    // return option price sensitivities
+    octave_value_list outargs;
+    outargs(0) = dOpt;
+    outargs(1) = d2Opt;
+    return outargs;
+}
+
+
 // static function for building HW Tree
 octave_value_list get_bond_price(const NDArray& cf_values, const int& jMax, 
                     const int& N, const Matrix& d, const Matrix& pu,
@@ -34,14 +34,24 @@ static ColumnVector get_AM_option_price_CRR(const bool& call_flag, const NDArray
             const NDArray& X, const NDArray& T, const NDArray& r, 
             const NDArray& sigma, const NDArray& q, const octave_idx_type& len, 
 			const int& n);
+
+static Matrix get_AM_option_greeks_CRR(const bool& call_flag, const NDArray& S, 
+            const NDArray& X, const NDArray& T, const NDArray& r, 
+            const NDArray& sigma, const NDArray& q, const octave_idx_type& len, 
+			const int& n);
 			
 DEFUN_DLD (pricing_option_cpp, args, nargout, "-*- texinfo -*-\n\
-@deftypefn{Loadable Function} {@var{OptionVec}} = pricing_option_cpp(@var{option_type}, @var{call_flag}, @var{S_vec}, @var{X_vec}, @var{T_vec}, @var{r_vec}, @var{sigma_vec}, @var{divrate_vec}, @var{n}) \n\
+@deftypefn{Loadable Function} {[@var{OptionVec} @var{delta} @var{gamma} @var{vega} @var{theta} @var{rho}]} = pricing_option_cpp(@var{option_type}, @var{call_flag}, @var{S_vec}, @var{X_vec}, @var{T_vec}, @var{r_vec}, @var{sigma_vec}, @var{divrate_vec}, @var{n}) \n\
 \n\
 Compute the put or call value of different equity options.\n\
 \n\
 This function should be called from Option class\n\
 which handles all input and ouput data.\n\
+If more than one output argument is requested for American options (CRR),\n\
+vega, theta and rho are calculated by one adjoint (reverse) sweep through\n\
+the tree instead of repricing the tree with shocked input parameters (exact\n\
+derivatives of the tree price, vega and rho per 1 percent shock, theta per\n\
+day). Delta and gamma are taken from the first and second tree level.\n\
 \n\
 Input and output variables:\n\
 @itemize @bullet\n\
@@ -55,6 +65,8 @@ Input and output variables:\n\
 @item @var{divrate_vec}: Double: dividend yield (cont,act/365) (either scalar or vector of length m)\n\
 @item @var{n}: Integer: number of tree steps (AM) or number of MC scenarios (ASIAN)\n\
 @item @var{OptionVec}: Double: OUTPUT: Option prices (columnn vector)\n\
+@item @var{delta}, @var{gamma}, @var{vega}, @var{theta}, @var{rho}: Double:\n\
+OUTPUT: greeks of American options (column vectors, option_type 2 only)\n\
 @end itemize\n\
 Example Call:\n\
 @example\n\
@@ -64,6 +76,9 @@ retvec =\n\
    1351.5596280726359\n\
    1890.5481712408509\n\
      83.4751762658461\n\
+[value delta] = pricing_option_cpp(2,false,100,100,365,0.01,0.25,0.0,800)\n\
+value = 9.4804\n\
+delta = -0.43935\n\
 @end group\n\
 @end example\n\
 @end deftypefn")
@@ -172,7 +187,21 @@ retvec =\n\
 		sigma = sigma_vec;
 	
 	
-	// Calculate Option prices
+	// Calculate Option prices and greeks (adjoint tree sweep)
+	if ( nargout > 1 )
+	{
+		if ( option_type != 2 )
+			error("pricing_option_cpp: greeks only available for American options (option_type 2)");
+		if ( n < 2 )
+			error("pricing_option_cpp: greeks need at least 2 tree steps");
+		Matrix greeks = get_AM_option_greeks_CRR(call_flag, S, 
+							 X, T, r, sigma, divrate, len, n);
+		octave_value_list option_outargs;
+		for (int kk = 0; kk < 6; ++kk)
+			option_outargs(kk) = ColumnVector (greeks.column (kk));
+		return octave_value (option_outargs);
+	}
+
 	switch(option_type) {
 		case 1: // European Option
 				OptionVec = get_EU_option_price_BS(call_flag, S, 
@@ -343,6 +372,121 @@ ColumnVector get_AM_option_price_CRR(const bool& call_flag, const NDArray& S,
 	return OptionVec;
 }
 
+// #############################################################################
+// static function for calculation of American Option Prices and greeks with
+// CRR model: value tree is rolled back as in get_AM_option_price_CRR,
+// vega, theta and rho are accumulated in one reverse sweep (adjoint of the
+// backward recursion with fixed exercise decisions). Delta and gamma are
+// taken from the first and second tree level (the pathwise spot derivative
+// is not smooth if the strike coincides with a tree node).
+// Returns len x 6 matrix [value delta gamma vega theta rho].
+Matrix get_AM_option_greeks_CRR(const bool& call_flag, const NDArray& S, 
+            const NDArray& X, const NDArray& T, const NDArray& r, 
+            const NDArray& sigma, const NDArray& q, const octave_idx_type& len, 
+			const int& n)
+{
+	dim_vector dim_tree (n+1, n+1);
+	Matrix greeks (len, 6, 0.0);
+	
+	NDArray Smat(dim_tree);
+	NDArray Omat(dim_tree);
+	NDArray Amat(dim_tree);		// adjoints of tree node values
+	double dt,sqrdt,u,d,g,p,DF;
+	double ubar,pbar,DFbar,a,cont;
+	int i,j;
+	double timesteps = static_cast<double> ( n );
+	double eta = 1.0;
+	if (call_flag == false)   // Option is Put
+				eta = -1.0;
+				
+	// loop via all scenarios
+	for (octave_idx_type ii = 0; ii < len; ++ii) 
+	{
+		// catch ctrl + c
+		OCTAVE_QUIT;
+		
+		// Set up tree parameter
+		dt = T(ii) / 365.0 / timesteps;
+		sqrdt = std::sqrt(dt);
+		u = exp(sigma(ii)*sqrdt);
+		d = 1.0/u;
+		g = exp((r(ii) - q(ii))*dt);
+		p = (g-d) / (u-d);
+		DF = exp(-r(ii)*dt);
+		
+		// Build CRR tree and roll back option values
+		for (j=0; j<=n; ++j)
+			for (i=0; i<=j; ++i)
+				 Smat(i,j) = S(ii)*std::pow(u,j-i)*std::pow(d,i);
+		for (i=0; i<=n; ++i)
+			Omat(i,n) = std::max(eta*(Smat(i,n) - X(ii)), 0.0);
+		for (j=n-1; j>=0; --j) 
+		{
+			for (i=0; i<=j; ++i) 
+			{
+				cont = DF*(p*(Omat(i,j+1)) + (1.0-p)*(Omat(i+1,j+1)));
+				Omat(i,j) = std::max(eta*(Smat(i,j) - X(ii)), cont);
+			}
+		}
+
+		// Reverse sweep: propagate adjoints from root to leaves
+		Amat.fill(0.0);
+		Amat(0,0) = 1.0;
+		ubar = 0.0;
+		pbar = 0.0;
+		DFbar = 0.0;
+		for (j=0; j<n; ++j) 
+		{
+			for (i=0; i<=j; ++i) 
+			{
+				a = Amat(i,j);
+				if ( a == 0.0 )
+					continue;
+				cont = DF*(p*(Omat(i,j+1)) + (1.0-p)*(Omat(i+1,j+1)));
+				if ( !(eta*(Smat(i,j) - X(ii)) < cont) )
+				{	// early exercise: node value = eta * (S u^(j-2i) - X)
+					ubar += a * eta * Smat(i,j) * (j - 2*i) / u;
+				}
+				else
+				{	// continuation value
+					DFbar += a * (p*(Omat(i,j+1)) + (1.0-p)*(Omat(i+1,j+1)));
+					pbar += a * DF * (Omat(i,j+1) - Omat(i+1,j+1));
+					Amat(i,j+1) += a * DF * p;
+					Amat(i+1,j+1) += a * DF * (1.0-p);
+				}
+			}
+		}
+		for (i=0; i<=n; ++i) 
+		{
+			a = Amat(i,n);
+			if ( a != 0.0 && eta*(Smat(i,n) - X(ii)) > 0.0 )
+			{
+				ubar += a * eta * Smat(i,n) * (n - 2*i) / u;
+			}
+		}
+
+		// chain rule through tree parameters p(u,g), u(sigma,dt), g(r,dt), DF(r,dt)
+		ubar += pbar * ((u-d)/(u*u) - (g-d)*(1.0 + 1.0/(u*u))) / ((u-d)*(u-d));
+		const double gbar = pbar / (u-d);
+		const double sigmabar = ubar * u * sqrdt;
+		const double rbar = gbar * g * dt - DFbar * dt * DF;
+		const double dtbar = ubar * u * sigma(ii) / (2.0 * sqrdt)
+							+ gbar * g * (r(ii) - q(ii)) - DFbar * r(ii) * DF;
+
+		// delta and gamma from option values at first and second tree level
+		const double delta_up = (Omat(0,2) - Omat(1,2)) / (Smat(0,2) - Smat(1,2));
+		const double delta_down = (Omat(1,2) - Omat(2,2)) / (Smat(1,2) - Smat(2,2));
+
+		greeks(ii,0) = Omat(0,0);
+		greeks(ii,1) = (Omat(0,1) - Omat(1,1)) / (Smat(0,1) - Smat(1,1));
+		greeks(ii,2) = (delta_up - delta_down) / (0.5 * (Smat(0,2) - Smat(2,2)));
+		greeks(ii,3) = 0.01 * sigmabar;						// vega per 1 pct
+		greeks(ii,4) = - dtbar / timesteps / 365.0;			// theta per day
+		greeks(ii,5) = 0.01 * rbar;							// rho per 1 pct
+	}
+	return greeks;
+}
+
 // #############################################################################
 // static function for calculation of analytic European option prices 
 ColumnVector get_EU_option_price_BS(const bool& call_flag, const NDArray& S, 
@@ -442,4 +586,18 @@ bool any_bad_argument(const octave_value_list& args)
 %!assert(pricing_option_cpp(1,true,100,[105;95;100],100,0.01,0.25,0.0),[3.30997203255466;8.13568335943751;5.34747873832626],sqrt(eps))
 %!assert(pricing_option_cpp(2,false,100,[105;95;100],100,0.01,0.25,0.0,800),[8.0540226787;2.8849734334;5.0887319016],sqrt(eps))
 %!assert(pricing_option_cpp(1,false,100,[105;95;100],100,0.01,0.25,0.0),[8.02269451022488;2.87576560113914;5.07388109801220],sqrt(eps))
+%!test
+%! [value delta gamma vega theta rho] = pricing_option_cpp(2,true,100,100,365,0.01,0.25,0.0,800);
+%! [value_bs delta_bs gamma_bs vega_bs theta_bs rho_bs] = option_bs(1,100,100,365,0.01,0.25,0.0);
+%! assert(value,pricing_option_cpp(2,true,100,100,365,0.01,0.25,0.0,800),sqrt(eps))
+%! assert([delta gamma vega theta rho],[delta_bs gamma_bs vega_bs theta_bs rho_bs],0.001)
+%!test
+%! [value delta gamma vega theta rho] = pricing_option_cpp(2,false,[100;110],105,180,0.05,0.2,0.0,800);
+%! h = 0.000001;
+%! vega_fd = (pricing_option_cpp(2,false,[100;110],105,180,0.05,0.2+h,0.0,800) - pricing_option_cpp(2,false,[100;110],105,180,0.05,0.2-h,0.0,800)) ./ (200*h);
+%! rho_fd = (pricing_option_cpp(2,false,[100;110],105,180,0.05+h,0.2,0.0,800) - pricing_option_cpp(2,false,[100;110],105,180,0.05-h,0.2,0.0,800)) ./ (200*h);
+%! theta_fd = -(pricing_option_cpp(2,false,[100;110],105,180.01,0.05,0.2,0.0,800) - pricing_option_cpp(2,false,[100;110],105,179.99,0.05,0.2,0.0,800)) ./ 0.02;
+%! assert(vega,vega_fd,0.0001)
+%! assert(rho,rho_fd,0.0001)
+%! assert(theta,theta_fd,0.000001)
 */
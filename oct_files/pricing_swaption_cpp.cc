@@ -0,0 +1,277 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <cmath>
+#include <algorithm>
+#include <octave/parse.h>
+
+static bool any_bad_argument(const octave_value_list& args);
+
+static inline double normcdf (const double& x)
+{
+    return 0.5 * (1.0 + std::erf(x / std::sqrt(2.0)));
+}
+
+static inline double normpdf (const double& x)
+{
+    return std::exp(-x * x / 2.0) / std::sqrt(2.0 * M_PI);
+}
+
+static bool any_negative (const NDArray& x)
+{
+    for (octave_idx_type ii = 0; ii < x.numel (); ++ii)
+        if ( x(ii) < 0.0 )
+            return true;
+    return false;
+}
+
+// value of scalar or vector input at position ii
+static inline double lane (const NDArray& x, const octave_idx_type& ii)
+{
+    return (x.numel () == 1) ? x(0) : x(ii);
+}
+
+DEFUN_DLD (pricing_swaption_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {[@var{SwaptionVec} @var{delta} @var{gamma} @var{vega} @var{theta} @var{rho}]} = pricing_swaption_cpp(@var{model}, @var{call_flag}, @var{F}, @var{X}, @var{T}, @var{r}, @var{sigma}, @var{m}, @var{tau}, @var{annuity})\n\
+\n\
+Compute the value of payer or receiver swaptions for all scenarios.\n\
+\n\
+This function should be called from Octave script calc_value.m (class\n\
+Swaption), which handles all input and output data. The formulas are\n\
+equivalent to swaption_black76.m and swaption_bachelier.m.\n\
+All input parameters (except @var{model} and @var{call_flag}) can be scalars\n\
+or vectors of equal length.\n\
+If more than one output argument is requested, the greeks are calculated\n\
+with analytic derivatives of the pricing formulas (no repricing with shocked\n\
+input parameters). Units are equal to the numerical greeks of\n\
+Swaption.calc_greeks: delta and gamma with respect to the forward swap rate,\n\
+vega and rho per 1 percent shock (rho is zero for Bachelier model, where the\n\
+annuity is given), theta per day.\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{model}: Integer: pricing model (1=Black76, 2=Bachelier)\n\
+@item @var{call_flag}: Boolean: true (payer swaption), false (receiver swaption)\n\
+@item @var{F}: Double: forward swap rate\n\
+@item @var{X}: Double: strike rate\n\
+@item @var{T}: Double: time to maturity (days, act/365)\n\
+@item @var{r}: Double: riskfree rate (cont, act/365) (Black76 only)\n\
+@item @var{sigma}: Double: implied volatility (lognormal for Black76,\n\
+normal for Bachelier)\n\
+@item @var{m}: Double: number of payments per year (Black76 only)\n\
+@item @var{tau}: Double: tenor of underlying swap in years (Black76 only)\n\
+@item @var{annuity}: Double: annuity of underlying swap (Bachelier only)\n\
+@item @var{SwaptionVec}: Double: OUTPUT: swaption values (column vector)\n\
+@item @var{delta}, @var{gamma}, @var{vega}, @var{theta}, @var{rho}: Double:\n\
+OUTPUT: swaption greeks (column vectors)\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+retvec = pricing_swaption_cpp(1,true,0.0609090679070339,0.062,1825,0.06,0.2,2,3,0)\n\
+retvec = 0.020710\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  if (nargin != 10 )
+  {
+    print_usage ();
+	error("Expecting 10 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	int model             = args(0).int_value ();
+	bool call_flag        = args(1).bool_value ();
+	NDArray F             = args(2).array_value ();
+	NDArray X             = args(3).array_value ();
+	NDArray T             = args(4).array_value ();
+	NDArray r             = args(5).array_value ();
+	NDArray sigma         = args(6).array_value ();
+	NDArray m             = args(7).array_value ();
+	NDArray tau           = args(8).array_value ();
+	NDArray annuity       = args(9).array_value ();
+
+	// get output length
+	octave_idx_type len = 1;
+	for (int ii = 2; ii < 10; ++ii)
+	{
+		const octave_idx_type tmp_len = args(ii).numel ();
+		if ( tmp_len != 1 )
+		{
+			if ( len != 1 && tmp_len != len )
+				error("pricing_swaption_cpp: all input vectors need equal length");
+			len = tmp_len;
+		}
+	}
+
+	const double eta = (call_flag == true) ? 1.0 : -1.0;
+	ColumnVector value (len);
+	const bool greeks_flag = (nargout > 1);
+	Matrix greeks (greeks_flag ? len : 0, 5);
+
+	// loop over all scenarios
+	for (octave_idx_type ii = 0; ii < len; ++ii)
+	{
+		// catch ctrl + c
+		OCTAVE_QUIT;
+		const double tmp_F = lane(F, ii);
+		const double tmp_X = lane(X, ii);
+		const double tmp_T = lane(T, ii) / 365.0;
+		const double tmp_sigma = lane(sigma, ii);
+		const double sqrt_T = std::sqrt(tmp_T);
+		if ( model == 1 )   // Black76
+		{
+			const double tmp_m = lane(m, ii);
+			const double d1 = (std::log(tmp_F / tmp_X) + (0.5 * tmp_sigma * tmp_sigma) * tmp_T)
+						/ (tmp_sigma * sqrt_T);
+			const double d2 = d1 - tmp_sigma * sqrt_T;
+			const double tmp_value = eta * (tmp_F * normcdf(eta * d1) - tmp_X * normcdf(eta * d2))
+						* std::exp(-lane(r, ii) * tmp_T);
+			const double multi = (1.0 - (1.0 / std::pow(1.0 + tmp_F / tmp_m, lane(tau, ii) * tmp_m)))
+						/ tmp_F;
+			value(ii) = tmp_value * multi;
+			if ( greeks_flag )
+			{
+				// V = DF * M(F) * B(F), M = (1 - P) / F, P = (1 + F/m)^(-tau m)
+				const double tmp_r = lane(r, ii);
+				const double tmp_tau = lane(tau, ii);
+				const double DF = std::exp(-tmp_r * tmp_T);
+				const double B = eta * (tmp_F * normcdf(eta * d1) - tmp_X * normcdf(eta * d2));
+				const double B_F = eta * normcdf(eta * d1);
+				const double B_FF = normpdf(d1) / (tmp_F * tmp_sigma * sqrt_T);
+				const double base = 1.0 + tmp_F / tmp_m;
+				const double P = std::pow(base, -tmp_tau * tmp_m);
+				const double P_F = -tmp_tau * P / base;
+				const double P_FF = tmp_tau * (tmp_tau * tmp_m + 1.0) / tmp_m * P / (base * base);
+				const double M_F = -P_F / tmp_F - multi / tmp_F;
+				const double M_FF = -P_FF / tmp_F + 2.0 * P_F / (tmp_F * tmp_F)
+							+ 2.0 * multi / (tmp_F * tmp_F);
+				greeks(ii,0) = DF * (B_F * multi + B * M_F);
+				greeks(ii,1) = DF * (B_FF * multi + 2.0 * B_F * M_F + B * M_FF);
+				greeks(ii,2) = DF * multi * tmp_F * normpdf(d1) * sqrt_T / 100.0;
+				greeks(ii,3) = -(DF * multi * tmp_F * normpdf(d1) * tmp_sigma / (2.0 * sqrt_T)
+							- tmp_r * value(ii)) / 365.0;
+				greeks(ii,4) = -tmp_T * value(ii) / 100.0;
+			}
+		}
+		else                // Bachelier
+		{
+			const double d1 = (tmp_F - tmp_X) / (tmp_sigma * sqrt_T);
+			value(ii) = tmp_sigma * sqrt_T * lane(annuity, ii)
+						* (eta * d1 * normcdf(eta * d1) + normpdf(d1));
+			if ( greeks_flag )
+			{
+				const double tmp_annuity = lane(annuity, ii);
+				greeks(ii,0) = tmp_annuity * eta * normcdf(eta * d1);
+				greeks(ii,1) = tmp_annuity * normpdf(d1) / (tmp_sigma * sqrt_T);
+				greeks(ii,2) = tmp_annuity * sqrt_T * normpdf(d1) / 100.0;
+				greeks(ii,3) = -tmp_annuity * tmp_sigma * normpdf(d1) / (2.0 * sqrt_T) / 365.0;
+				greeks(ii,4) = 0.0;
+			}
+		}
+	}
+
+  // return values
+	octave_value_list option_outargs;
+	option_outargs(0) = value;
+	if ( greeks_flag )
+		for (int kk = 0; kk < 5; ++kk)
+			option_outargs(kk+1) = ColumnVector (greeks.column (kk));
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    if (!args(0).isnumeric () || args(0).numel () != 1
+        || (args(0).int_value () != 1 && args(0).int_value () != 2))
+    {
+        error("pricing_swaption_cpp: expecting model to be 1 (Black76) or 2 (Bachelier)");
+        return true;
+    }
+
+    if (args(1).numel () != 1)
+    {
+        error("pricing_swaption_cpp: expecting call_flag to be a scalar");
+        return true;
+    }
+
+    for (int ii = 2; ii < 10; ++ii)
+    {
+        if (!args(ii).isnumeric ())
+        {
+            error("pricing_swaption_cpp: expecting argument %d to be numeric",ii + 1);
+            return true;
+        }
+    }
+
+    if (any_negative(args(4).array_value ()))
+    {
+        error("pricing_swaption_cpp: expecting T to be positive");
+        return true;
+    }
+
+    if (any_negative(args(6).array_value ()))
+    {
+        error("pricing_swaption_cpp: expecting sigma to be positive");
+        return true;
+    }
+
+    if (args(0).int_value () == 1 && (any_negative(args(2).array_value ())
+        || any_negative(args(3).array_value ())))
+    {
+        error("pricing_swaption_cpp: expecting F and X to be positive for Black76 model");
+        return true;
+    }
+
+    return false;
+}
+
+/*
+%!assert(pricing_swaption_cpp(1,true,0.0609090679070339,0.062,1825,0.06,0.2,2,3,0),swaption_black76(1,0.0609090679070339,0.062,1825,0.06,0.2,2,3),sqrt(eps))
+%!test
+%! F = [0.0609090679070339;0.05;0.07];
+%! assert(pricing_swaption_cpp(1,false,F,0.062,1825,0.06,[0.2;0.25;0.3],2,3,0),swaption_black76(0,F,0.062,1825,0.06,[0.2;0.25;0.3],2,3),sqrt(eps))
+%!test
+%! F = [1.954904222037591e-002;0.025;0.035];
+%! assert(pricing_swaption_cpp(2,false,F,0.03,3650,0.0,0.006656276,0,0,8.2844976761307),swaption_bachelier(0,F,0.03,3650,0.006656276,8.2844976761307),sqrt(eps))
+%! assert(pricing_swaption_cpp(2,true,F,0.03,3650,0.0,0.006656276,0,0,8.2844976761307),swaption_bachelier(1,F,0.03,3650,0.006656276,8.2844976761307),sqrt(eps))
+%!test
+%! F = 0.0609090679070339;
+%! h = 0.000001;
+%! [value delta gamma vega theta rho] = pricing_swaption_cpp(1,true,F,0.062,1825,0.06,0.2,2,3,0);
+%! assert(value,swaption_black76(1,F,0.062,1825,0.06,0.2,2,3),sqrt(eps))
+%! assert(delta,(swaption_black76(1,F+h,0.062,1825,0.06,0.2,2,3) - swaption_black76(1,F-h,0.062,1825,0.06,0.2,2,3)) / (2*h),0.000001)
+%! assert(gamma,(swaption_black76(1,F+10*h,0.062,1825,0.06,0.2,2,3) + swaption_black76(1,F-10*h,0.062,1825,0.06,0.2,2,3) - 2*value) / (100*h^2),0.001)
+%! assert(vega,(swaption_black76(1,F,0.062,1825,0.06,0.2+h,2,3) - swaption_black76(1,F,0.062,1825,0.06,0.2-h,2,3)) / (200*h),0.00000001)
+%! assert(theta,-(swaption_black76(1,F,0.062,1826,0.06,0.2,2,3) - swaption_black76(1,F,0.062,1824,0.06,0.2,2,3)) / 2,0.00000001)
+%! assert(rho,(swaption_black76(1,F,0.062,1825,0.06+h,0.2,2,3) - swaption_black76(1,F,0.062,1825,0.06-h,0.2,2,3)) / (200*h),0.00000001)
+%!test
+%! [value delta gamma vega theta rho] = pricing_swaption_cpp(2,false,[0.025;0.035],0.03,3650,0.0,0.0066,0,0,8.28);
+%! d = ([0.025;0.035] - 0.03) ./ (0.0066 * sqrt(10));
+%! assert(delta,-8.28 .* normcdf(-d),sqrt(eps))
+%! assert(gamma,8.28 .* normpdf(d) ./ (0.0066 * sqrt(10)),sqrt(eps))
+%! assert(vega,8.28 .* sqrt(10) .* normpdf(d) ./ 100,sqrt(eps))
+%! assert(theta,-8.28 .* 0.0066 .* normpdf(d) ./ (2 * sqrt(10)) ./ 365,sqrt(eps))
+%! assert(rho,[0;0])
+*/
@@ -0,0 +1,588 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+
+#include <octave/oct.h>
+#include <cmath>
+#include <map>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <octave/parse.h>
+#include <octave/ov-struct.h>
+
+static bool any_bad_argument(const octave_value_list& args);
+
+static ColumnVector get_z_vector(const int& z_method);
+
+static NDArray get_transition_matrix(const int& N, const double& dk, 
+            const ColumnVector& z, const std::string& path_static, 
+            int& cache_flag);
+
+static NDArray optimize_transition_matrix(const int& N, 
+            const ColumnVector& z);
+
+static bool load_transition_matrix(const std::string& filename, const int& N,
+            const int& n, const double& dk, NDArray& Transition_matrix);
+
+static void save_transition_matrix(const std::string& filename, const int& N,
+            const int& n, const double& dk, const NDArray& Transition_matrix);
+
+// in-process cache of all transition matrices (key: timesteps, nodes, dk).
+// The cache lives as long as the oct-file is loaded (flush with
+// 'clear pricing_willowtree_cpp').
+static std::map<std::string, NDArray> transition_matrix_cache;
+
+// z-vectors optimized by Currans method (qi' * z_i^2 = 1)
+static const double z_10[10] = {
+    -1.818408193, -1.036433389, -0.67448975, -0.385320466, -0.125661347,
+    0.125661347, 0.385320466, 0.67448975, 1.036433389, 1.818408193
+};
+static const double z_15[16] = {
+    -2.019979732, -1.318010897, -1.009990169, -0.776421761, -0.579132162,
+    -0.402250065, -0.237202109, -0.078412413, 0.078412413, 0.237202109,
+    0.402250065, 0.579132162, 0.776421761, 1.009990169, 1.318010897,
+    2.019979732
+};
+static const double z_20[20] = {
+    -2.110897894, -1.439531471, -1.15034938, -0.934589291, -0.755415026,
+    -0.597760126, -0.45376219, -0.318639364, -0.189118426, -0.062706778,
+    0.062706778, 0.189118426, 0.318639364, 0.45376219, 0.597760126,
+    0.755415026, 0.934589291, 1.15034938, 1.439531471, 2.110897894
+};
+static const double z_30[30] = {
+    -2.269187459, -1.644853627, -1.382994127, -1.191816172, -1.036433389,
+    -0.902734792, -0.783500375, -0.67448975, -0.572967548, -0.477040428,
+    -0.385320466, -0.296737838, -0.210428394, -0.125661347, -0.041789298,
+    0.041789298, 0.125661347, 0.210428394, 0.296737838, 0.385320466,
+    0.477040428, 0.572967548, 0.67448975, 0.783500375, 0.902734792,
+    1.036433389, 1.191816172, 1.382994127, 1.644853627, 2.269187459
+};
+static const double z_40[40] = {
+    -2.518840503, -1.780464342, -1.534120544, -1.356311745, -1.213339622,
+    -1.091620367, -0.98423496, -0.887146559, -0.797776846, -0.71436744,
+    -0.635657014, -0.560703032, -0.488776411, -0.419295753, -0.351784345,
+    -0.285840875, -0.221118713, -0.157310685, -0.094137414, -0.031337982,
+    0.031337982, 0.094137414, 0.157310685, 0.221118713, 0.285840875,
+    0.351784345, 0.419295753, 0.488776411, 0.560703032, 0.635657014,
+    0.71436744, 0.797776846, 0.887146559, 0.98423496, 1.091620367,
+    0.98423496, 1.213339622, 1.356311745, 1.780464342, 2.518840503
+};
+static const double z_50[50] = {
+    -2.510808322, -1.880793608, -1.644853627, -1.475791028, -1.340755034,
+    -1.22652812, -1.126391129, -1.036433389, -0.954165253, -0.877896295,
+    -0.806421247, -0.738846849, -0.67448975, -0.612812991, -0.55338472,
+    -0.495850347, -0.439913166, -0.385320466, -0.331853346, -0.279319034,
+    -0.227544977, -0.176374165, -0.125661347, -0.075269862, -0.025068908,
+    0.025068908, 0.075269862, 0.125661347, 0.176374165, 0.227544977,
+    0.279319034, 0.331853346, 0.385320466, 0.439913166, 0.495850347,
+    0.55338472, 0.612812991, 0.67448975, 0.738846849, 0.806421247,
+    0.738846849, 0.877896295, 0.954165253, 1.126391129, 1.22652812,
+    1.340755034, 1.475791028, 1.644853627, 1.880793608, 2.510808322
+};
+
+DEFUN_DLD (pricing_willowtree_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {[@var{OptionVec} @var{EuOptionVec} @var{cache_flag}]} = pricing_willowtree_cpp(@var{call_flag}, @var{american_flag}, @var{S_vec}, @var{X_vec}, @var{T}, @var{r_vec}, @var{sigma_vec}, @var{divrate_vec}, @var{dk}, @var{z_method}, @var{path_static}) \n\
+\n\
+Compute the put or call value of european or american equity options\n\
+with the willow tree model.\n\
+\n\
+This function should be called from Octave script option_willowtree.m\n\
+which handles all input and ouput data.\n\
+The willow tree (transition matrizes of all timesteps) depends on the\n\
+number of timesteps, the number of nodes and the timestep size only.\n\
+Each tree is optimized once (linear program solved by glpk) and stored in\n\
+an in-process cache. If @var{path_static} is not empty, the tree is\n\
+additionally stored in a binary file in @var{path_static} and loaded from\n\
+there in later sessions.\n\
+The backward induction is performed for all scenarios at once\n\
+(nodes x scenarios matrix).\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{call_flag}: Boolean: (true: call option, false: put option)\n\
+@item @var{american_flag}: Boolean: (true: american option, false: european option)\n\
+@item @var{S_vec}: Double: Spot prices (either scalar or vector of length m)\n\
+@item @var{X_vec}: Double: Strike prices (either scalar or vector of length m)\n\
+@item @var{T}: Double: Time to maturity (days, act/365) (scalar)\n\
+@item @var{r_vec}: Double: riskfree rate (cont, act/365) (either scalar or vector of length m)\n\
+@item @var{sigma_vec}: Double: volatility (annualized,act/365) (either scalar or vector of length m)\n\
+@item @var{divrate_vec}: Double: dividend yield (cont,act/365) (either scalar or vector of length m)\n\
+@item @var{dk}: Double: size of timesteps in days\n\
+@item @var{z_method}: Integer: number of nodes [10,15,20,30,40,50]\n\
+@item @var{path_static}: String: OPTIONAL: path for binary tree files (empty: no disk cache)\n\
+@item @var{OptionVec}: Double: OUTPUT: Option prices (column vector)\n\
+@item @var{EuOptionVec}: Double: OUTPUT: European option prices (column vector)\n\
+@item @var{cache_flag}: Integer: OUTPUT: 0: tree optimized, 1: taken from\n\
+in-process cache, 2: loaded from disk cache\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+retvec = pricing_willowtree_cpp(true,true,[7;8;9],8,365,0.06,0.2,0.05,5,20)\n\
+retvec =\n\
+   0.2329429\n\
+   0.6444019\n\
+   1.2907739\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  octave_value retval;
+  int nargin = args.length ();
+
+  if (nargin < 10 || nargin > 11 )
+  {
+    print_usage ();
+	error("Expecting either 10 or 11 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	bool call_flag      = args(0).bool_value(); // call or put option
+	bool american_flag  = args(1).bool_value(); // american or european option
+	NDArray S_vec       = args(2).array_value (); // spot price
+	NDArray X_vec       = args(3).array_value (); // Strike
+	double T_input      = args(4).double_value (); // time to maturity (days)
+	NDArray r_vec       = args(5).array_value (); // riskfree rate
+	NDArray sigma_vec   = args(6).array_value (); // annualized volatility
+	NDArray divrate_vec = args(7).array_value (); // dividend rate
+	double dk           = args(8).double_value (); // timestep size (days)
+	int z_method        = args(9).int_value (); // number of nodes
+	std::string path_static = "";
+	if ( nargin == 11 )
+		path_static = args(10).string_value ();
+	
+	// total number of scenarios: get maximum of length of all vectors
+	int len_S = S_vec.numel ();
+	int len_X = X_vec.numel ();
+	int len_r = r_vec.numel ();
+	int len_sigma = sigma_vec.numel ();
+	int len_divrate = divrate_vec.numel ();
+	int len = std::max(std::max(std::max(std::max(len_S,len_X), 
+									len_r),len_sigma),len_divrate);
+
+	// input checks
+	if (len_S > 1 && len_S != len)
+		error("pricing_willowtree_cpp: expecting S to be of length 1 or %d",len);
+	if (len_X > 1 && len_X != len)
+		error("pricing_willowtree_cpp: expecting X to be of length 1 or %d",len);
+	if (len_r > 1 && len_r != len)
+		error("pricing_willowtree_cpp: expecting r to be of length 1 or %d",len);
+	if (len_sigma > 1 && len_sigma != len)
+		error("pricing_willowtree_cpp: expecting sigma to be of length 1 or %d",len);
+	if (len_divrate > 1 && len_divrate != len)
+		error("pricing_willowtree_cpp: expecting divrate to be of length 1 or %d",len);
+	if ( T_input < 0.0 )
+		error("pricing_willowtree_cpp: Time T must be positive");
+	if ( dk <= 0.0 )
+		error("pricing_willowtree_cpp: stepsize in days (dk) must be positive");
+	for (octave_idx_type ii = 0; ii < len_sigma; ++ii) 
+	{
+		if ( sigma_vec(ii) < 0 )
+			error("Volatility sigma must be positive!");
+	}
+	
+	// Rounding Time according to timesteps dt and number of nodes
+	int N = rint(T_input / dk);	// total number of timesteps
+	if ( N < 2 )	// in case of days to maturity <= dk -> adjust dk
+	{
+		N = 2;
+		dk = dk / 2.0;
+	}
+	double T_years = T_input / 365.0;
+	double dt = (dk * N) / (N * 365.0);	// timestep between valuation points
+	
+	// get willow tree (cached)
+	ColumnVector z = get_z_vector(z_method);
+	int n = z.numel ();
+	double q = 1.0 / n;
+	int cache_flag = 0;
+	NDArray Transition_matrix = get_transition_matrix(N, dk, z, path_static,
+														cache_flag);
+	
+	// scenario dependent input values (idx either 0 or jj)
+	double eta = 1.0;
+	if (call_flag == false)   // Option is Put
+		eta = -1.0;
+	double am = 0.0;
+	if (american_flag == true)
+		am = 1.0;
+	ColumnVector S (len);
+	ColumnVector X (len);
+	ColumnVector r (len);
+	ColumnVector sigma (len);
+	ColumnVector drift (len);
+	ColumnVector df (len);
+	for (octave_idx_type jj = 0; jj < len; ++jj) 
+	{
+		S(jj)     = S_vec(len_S > 1 ? jj : 0);
+		X(jj)     = X_vec(len_X > 1 ? jj : 0);
+		r(jj)     = r_vec(len_r > 1 ? jj : 0);
+		sigma(jj) = sigma_vec(len_sigma > 1 ? jj : 0);
+		drift(jj) = r(jj) - divrate_vec(len_divrate > 1 ? jj : 0)
+							- 0.5 * sigma(jj) * sigma(jj);
+		df(jj)    = exp(-r(jj) * dt);
+	}
+	
+	// Setting tree at final timestep with payoff (nodes x scenarios)
+	// Assuming geometric brownian motion:
+	Matrix V (n, len);
+	ColumnVector EuOptionVec (len);
+	double sqrt_T = std::sqrt(T_years);
+	for (octave_idx_type jj = 0; jj < len; ++jj) 
+	{
+		double eu_value = 0.0;
+		for (octave_idx_type ii = 0; ii < n; ++ii) 
+		{
+			double S_T = S(jj) * exp(drift(jj) * T_years 
+									+ sigma(jj) * sqrt_T * z(ii));
+			V(ii,jj) = std::max(eta * (S_T - X(jj)), 0.0);
+			eu_value += q * V(ii,jj);
+		}
+		EuOptionVec(jj) = eu_value * exp(-r(jj) * T_years);
+	}
+	
+	// iterating through timesteps and discounting expected values
+	Matrix P (n, n);
+	for (octave_idx_type tt = N - 1; tt > 0; --tt) 
+	{
+		// catch ctrl + c
+		OCTAVE_QUIT;
+		
+		for (octave_idx_type kk = 0; kk < n; ++kk) 
+			for (octave_idx_type ii = 0; ii < n; ++ii) 
+				P(ii,kk) = Transition_matrix(ii,kk,tt-1);
+		// expected values of all scenarios in one matrix multiplication
+		V = P * V;
+		double t_act = dt * tt;
+		double sqrt_t_act = std::sqrt(t_act);
+		for (octave_idx_type jj = 0; jj < len; ++jj) 
+		{
+			for (octave_idx_type ii = 0; ii < n; ++ii) 
+			{
+				double S_act = S(jj) * exp(drift(jj) * t_act 
+									+ sigma(jj) * sqrt_t_act * z(ii));
+				V(ii,jj) = std::max(V(ii,jj) * df(jj), 
+									am * eta * (S_act - X(jj)));
+			}
+		}
+	}
+	
+	// option value at valuation date
+	ColumnVector OptionVec (len);
+	for (octave_idx_type jj = 0; jj < len; ++jj) 
+	{
+		double tmp_value = 0.0;
+		for (octave_idx_type ii = 0; ii < n; ++ii) 
+			tmp_value += q * V(ii,jj);
+		OptionVec(jj) = std::max(tmp_value * df(jj), 
+									am * eta * (S(jj) - X(jj)));
+	}
+		
+	// return Option price
+	octave_value_list option_outargs;
+	option_outargs(0) = OptionVec;
+	option_outargs(1) = EuOptionVec;
+	option_outargs(2) = cache_flag;
+	
+   return octave_value (option_outargs);
+
+} // end of DEFUN_DLD
+
+//#########################    STATIC FUNCTIONS    #############################
+
+// #############################################################################
+// static function for getting the z-vector of the given number of nodes
+ColumnVector get_z_vector(const int& z_method)
+{
+	const double* z_ptr;
+	int n;
+	switch(z_method) {
+		case 10: z_ptr = z_10; n = 10; break;
+		case 15: z_ptr = z_15; n = 16; break;
+		case 30: z_ptr = z_30; n = 30; break;
+		case 40: z_ptr = z_40; n = 40; break;
+		case 50: z_ptr = z_50; n = 50; break;
+		default: z_ptr = z_20; n = 20; break;	// default 20 nodes
+	}
+	ColumnVector z (n);
+	for (octave_idx_type ii = 0; ii < n; ++ii) 
+		z(ii) = z_ptr[ii];
+	return z;
+}
+
+// #############################################################################
+// static function for getting transition matrizes: 1) in-process cache, 
+// 2) binary file in path_static, 3) optimization of new tree
+NDArray get_transition_matrix(const int& N, const double& dk, 
+            const ColumnVector& z, const std::string& path_static, 
+            int& cache_flag)
+{
+	int n = z.numel ();
+	std::ostringstream key;
+	key << N << "_" << n << "_" << dk;
+	
+	// 1) in-process cache
+	std::map<std::string, NDArray>::const_iterator it = 
+										transition_matrix_cache.find(key.str());
+	if ( it != transition_matrix_cache.end() )
+	{
+		cache_flag = 1;
+		return it->second;
+	}
+	
+	// 2) binary file
+	NDArray Transition_matrix;
+	std::string filename = "";
+	if ( path_static != "" )
+	{
+		filename = path_static + "/wt_transition_" + key.str() + ".bin";
+		if ( load_transition_matrix(filename, N, n, dk, Transition_matrix) )
+		{
+			cache_flag = 2;
+			transition_matrix_cache[key.str()] = Transition_matrix;
+			return Transition_matrix;
+		}
+	}
+	
+	// 3) optimize transition matrizes
+	cache_flag = 0;
+	Transition_matrix = optimize_transition_matrix(N, z);
+	transition_matrix_cache[key.str()] = Transition_matrix;
+	if ( filename != "" )
+		save_transition_matrix(filename, N, n, dk, Transition_matrix);
+	return Transition_matrix;
+}
+
+// #############################################################################
+// static function for optimization of transition probabilities for all 
+// timesteps: min trace(PF) subject to moment matching constraints.
+// The linear programs are solved by glpk.
+NDArray optimize_transition_matrix(const int& N, 
+            const ColumnVector& z)
+{
+	int n = z.numel ();
+	int nn = n * n;
+	double q = 1.0 / n;
+	dim_vector dim_tree (n, n, N - 1);
+	NDArray Transition_matrix (dim_tree);
+	Transition_matrix.fill(0.0);
+	
+	// scenario independent constraints (4n x n^2 matrix A):
+	// 1) Pu = u, 2) Pz = bz, 3) Pr = b^2r + (1-b^2)u, 4) q'P = q'
+	Matrix A (4 * n, nn);
+	A.fill(0.0);
+	for (octave_idx_type ii = 0; ii < n; ++ii) 
+	{
+		for (octave_idx_type jj = 0; jj < n; ++jj) 
+		{
+			A(ii, ii * n + jj)         = 1.0;
+			A(n + ii, ii * n + jj)     = z(jj);
+			A(2 * n + ii, ii * n + jj) = z(jj) * z(jj);
+			A(3 * n + ii, ii * n + jj) = q;
+		}
+	}
+	ColumnVector lb (nn);
+	lb.fill(0.0);
+	std::string ctype (4 * n, 'S');	// equality constraints
+	std::string vartype (nn, 'C');	// continuous variables
+	octave_scalar_map param;
+	param.assign("msglev", 1);
+	param.assign("itlim", 100000);
+	
+	// loop through all timesteps and optimize transition probabilities
+	for (octave_idx_type tt = 1; tt < N; ++tt) 
+	{
+		// catch ctrl + c
+		OCTAVE_QUIT;
+		
+		double alpha = 1.0 / tt;	// constant time steps only: h / tk
+		double beta = 1.0 / std::sqrt(1.0 + alpha);
+		Matrix c (1, nn);
+		ColumnVector b (4 * n);
+		for (octave_idx_type ii = 0; ii < n; ++ii) 
+		{
+			for (octave_idx_type jj = 0; jj < n; ++jj) 
+			{
+				double tmp_dist = std::fabs(z(jj) - beta * z(ii));
+				c(0, ii * n + jj) = tmp_dist * tmp_dist * tmp_dist;
+			}
+			b(ii)         = 1.0;
+			b(n + ii)     = beta * z(ii);
+			b(2 * n + ii) = beta * beta * z(ii) * z(ii) + (1.0 - beta * beta);
+			b(3 * n + ii) = q;
+		}
+		octave_value_list glpk_args;
+		glpk_args(0) = c;
+		glpk_args(1) = A;
+		glpk_args(2) = b;
+		glpk_args(3) = lb;
+		glpk_args(4) = Matrix ();
+		glpk_args(5) = ctype;
+		glpk_args(6) = vartype;
+		glpk_args(7) = 1;	// minimization problem
+		glpk_args(8) = param;
+		octave_value_list glpk_out = octave::feval ("glpk", glpk_args, 3);
+		if ( glpk_out(2).int_value () != 0 )
+			error("pricing_willowtree_cpp: glpk failed with error code %d for timestep %d",
+							glpk_out(2).int_value (), static_cast<int>(tt));
+		NDArray xmin = glpk_out(0).array_value ();
+		// transition probabilities from node ii (rows) to node jj (columns)
+		for (octave_idx_type ii = 0; ii < n; ++ii) 
+			for (octave_idx_type jj = 0; jj < n; ++jj) 
+				Transition_matrix(ii,jj,tt-1) = xmin(ii * n + jj);
+	}
+	return Transition_matrix;
+}
+
+// #############################################################################
+// static functions for binary tree files (header: tag, N, n, dk; followed by 
+// all transition probabilities in column major order)
+static const char wt_file_tag[8] = {'O','C','T','R','W','T','0','1'};
+
+bool load_transition_matrix(const std::string& filename, const int& N,
+            const int& n, const double& dk, NDArray& Transition_matrix)
+{
+	std::ifstream infile (filename.c_str(), std::ios::in | std::ios::binary);
+	if ( !infile.is_open() )
+		return false;
+	char tag[8];
+	int N_file, n_file;
+	double dk_file;
+	infile.read(tag, sizeof(tag));
+	infile.read(reinterpret_cast<char*>(&N_file), sizeof(int));
+	infile.read(reinterpret_cast<char*>(&n_file), sizeof(int));
+	infile.read(reinterpret_cast<char*>(&dk_file), sizeof(double));
+	if ( !infile.good() || std::string(tag, 8) != std::string(wt_file_tag, 8)
+				|| N_file != N || n_file != n || dk_file != dk )
+		return false;
+	dim_vector dim_tree (n, n, N - 1);
+	NDArray tmp_matrix (dim_tree);
+	infile.read(reinterpret_cast<char*>(tmp_matrix.fortran_vec()),
+					sizeof(double) * tmp_matrix.numel());
+	if ( !infile.good() )
+		return false;
+	Transition_matrix = tmp_matrix;
+	return true;
+}
+
+void save_transition_matrix(const std::string& filename, const int& N,
+            const int& n, const double& dk, const NDArray& Transition_matrix)
+{
+	std::ofstream outfile (filename.c_str(), std::ios::out | std::ios::binary);
+	if ( !outfile.is_open() )
+	{
+		warning("pricing_willowtree_cpp: cannot write Willowtree file >>%s<<",
+															filename.c_str());
+		return;
+	}
+	octave_stdout << "Save Willowtree transition matrix to >>" << filename 
+																<< "<< \n";
+	outfile.write(wt_file_tag, sizeof(wt_file_tag));
+	outfile.write(reinterpret_cast<const char*>(&N), sizeof(int));
+	outfile.write(reinterpret_cast<const char*>(&n), sizeof(int));
+	outfile.write(reinterpret_cast<const char*>(&dk), sizeof(double));
+	outfile.write(reinterpret_cast<const char*>(Transition_matrix.data()),
+					sizeof(double) * Transition_matrix.numel());
+}
+
+// #############################################################################
+// static function for checking input arguments
+static bool any_bad_argument(const octave_value_list& args)
+{
+    
+    if (!args(0).islogical())
+    {
+        error("pricing_willowtree_cpp: expecting callflag to be a bool");
+        return true;
+    }
+    
+    if (!args(1).islogical())
+    {
+        error("pricing_willowtree_cpp: expecting americanflag to be a bool");
+        return true;
+    }
+    
+    if (!args(2).isnumeric ())
+    {
+        error("pricing_willowtree_cpp: expecting S to be a numeric");
+        return true;
+    }
+    
+    if (!args(3).isnumeric ())
+    {
+        error("pricing_willowtree_cpp: expecting X to be a numeric");
+        return true;
+    }
+    
+    if (!args(4).isnumeric () || args(4).numel () != 1)
+    {
+        error("pricing_willowtree_cpp: expecting T to be a numeric scalar");
+        return true;
+    }
+    
+    if (!args(5).isnumeric ())
+    {
+        error("pricing_willowtree_cpp: expecting r to be a numeric");
+        return true;
+    }
+    
+    if (!args(6).isnumeric ())
+    {
+        error("pricing_willowtree_cpp: expecting sigma to be a numeric");
+        return true;
+    }
+    
+    if (!args(7).isnumeric ())
+    {
+        error("pricing_willowtree_cpp: expecting divrate to be a numeric");
+        return true;
+    }
+    
+    if (!args(8).isnumeric ())
+    {
+        error("pricing_willowtree_cpp: expecting dk to be a numeric");
+        return true;
+    }
+    
+    if (!args(9).isnumeric ())
+    {
+        error("pricing_willowtree_cpp: expecting z_method to be a numeric");
+        return true;
+    }
+    
+    if (args.length () == 11 && !args(10).is_string ())
+    {
+        error("pricing_willowtree_cpp: expecting path_static to be a string");
+        return true;
+    }
+    
+    return false;
+}
+
+/*
+
+%!assert(pricing_willowtree_cpp(true,true,[7;8;9;7;8;9],8,365,0.06,[0.2;0.2;0.2;0.3;0.3;0.3],0.05,5,20),[0.2329429;0.6444019;1.2907739;0.4810619;0.9480669;1.5731179 ],0.00001)
+%!assert(pricing_willowtree_cpp(false,false,[7;8;9;7;8;9],10,90,0.06,[0.2;0.2;0.2;0.3;0.3;0.3],0.05,1,30),[2.9389219;1.9511749;1.0359799;2.9389429;1.9929989;1.1649079],0.00001)
+%!test
+%! [V1 V1_eur] = pricing_willowtree_cpp(true,true,100,100,180,0.01,0.2,0.0,5,20);
+%! [V2 V2_eur cache_flag] = pricing_willowtree_cpp(true,true,100,100,180,0.01,0.2,0.0,5,20);
+%! assert(cache_flag,1)
+%! assert(V2,V1,sqrt(eps))
+%! assert(V1_eur,option_bs(1,100,100,180,0.01,0.2,0.0),0.05)
+*/
@@ -0,0 +1,182 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <cmath>
+#include <vector>
+#include "thread_helpers.h"
+
+static bool any_bad_argument(const octave_value_list& args);
+
+DEFUN_DLD (riskfactor_scenarios_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {[@var{delta}]} = riskfactor_scenarios_cpp(@var{Y}, @var{rf_para}, @var{ts})\n\
+\n\
+Compute MC scenario shock values of all risk factors in one pass.\n\
+\n\
+This function should be called from Octave script load_riskfactor_scenarios.m.\n\
+Each row of the parameter table @var{rf_para} contains the process parameters\n\
+of one risk factor (column of @var{Y}):\n\
+[model_id, drift, sigma, start, mr_level, mr_rate]\n\
+with model_id 1 (GBM, SLN), 2 (BM), 3 (BKM), 4 (OU), 5 (SRD) or 0 (risk factor\n\
+not part of shred, no shock). The drift is given per day, the volatility p.a.\n\
+The shock values for timestep @var{ts} (in days) are given by\n\
+@itemize @bullet\n\
+@item GBM, SLN: Y + (drift - 0.5 * (sigma / sqrt(250))^2) * ts\n\
+@item BM: Y + drift * ts\n\
+@item BKM, OU: Y + mr_rate * (mr_level - start) * ts\n\
+@item SRD: sqrt(start) * Y + mr_rate * (mr_level - start) * ts\n\
+@end itemize\n\
+The shock values of each risk factor are stored in one contiguous column.\n\
+The risk factor columns are split across worker threads (number of threads\n\
+set by environment variable OCTARISK_THREADS, default: all hardware threads).\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{Y}: Double: correlated random numbers (scenarios x risk factors)\n\
+@item @var{rf_para}: Double: process parameter table (risk factors x 6)\n\
+@item @var{ts}: Double: timestep in days\n\
+@item @var{delta}: Double: OUTPUT: scenario shock values (scenarios x risk factors)\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+delta = riskfactor_scenarios_cpp([0.1,0.1;-0.1,-0.1],[2,0.001,0.2,0,0,0;5,0,0.01,0.04,0.03,0.1],10)\n\
+delta =\n\
+   0.1100   0.0100\n\
+  -0.0900  -0.0300\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  if (nargin != 3 )
+  {
+    print_usage ();
+	error("Expecting 3 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	Matrix Y        = args(0).matrix_value ();
+	Matrix rf_para  = args(1).matrix_value ();
+	double ts       = args(2).double_value ();
+
+	const octave_idx_type mc = Y.rows ();
+	const octave_idx_type no_rf = Y.cols ();
+	if ( rf_para.rows () != no_rf || rf_para.cols () != 6 )
+		error("riskfactor_scenarios_cpp: expecting parameter table of size %d x 6", (int) no_rf);
+
+	Matrix delta (mc, no_rf, 0.0);
+	const double * y_ptr = Y.data ();
+	double * delta_ptr = delta.fortran_vec ();
+
+	// scale and offset of all risk factors (model checks before threads)
+	std::vector<double> scale_vec (no_rf, 0.0);
+	std::vector<double> offset_vec (no_rf, 0.0);
+	std::vector<char> shock_flag (no_rf, 0);
+	for (octave_idx_type jj = 0; jj < no_rf; ++jj)
+	{
+		const int model_id = static_cast<int> (rf_para(jj,0));
+		const double drift    = rf_para(jj,1);
+		const double sigma    = rf_para(jj,2);
+		const double start    = rf_para(jj,3);
+		const double mr_level = rf_para(jj,4);
+		const double mr_rate  = rf_para(jj,5);
+		// all models: delta = scale * Y + offset
+		double scale = 1.0;
+		double offset = 0.0;
+		if ( model_id == 1 )        // GBM, SLN
+			offset = (drift - 0.5 * sigma * sigma / 250.0) * ts;
+		else if ( model_id == 2 )   // BM
+			offset = drift * ts;
+		else if ( model_id == 3 || model_id == 4 )  // BKM, OU
+			offset = mr_rate * (mr_level - start) * ts;
+		else if ( model_id == 5 )   // SRD
+		{
+			scale = std::sqrt(start);
+			offset = mr_rate * (mr_level - start) * ts;
+		}
+		else if ( model_id == 0 )   // not part of shred
+			continue;
+		else
+			error("riskfactor_scenarios_cpp: unknown model_id %d of risk factor %d",
+											model_id, (int) jj + 1);
+
+		scale_vec[jj] = scale;
+		offset_vec[jj] = offset;
+		shock_flag[jj] = 1;
+	}
+
+	// all risk factor columns, split across worker threads (risk factors
+	// not part of shred keep zero shocks)
+	// (at least 100000 entries per thread)
+	const octave_idx_type min_cols = std::max(static_cast<octave_idx_type>(1),
+				static_cast<octave_idx_type>(100000) / std::max(mc, static_cast<octave_idx_type>(1)));
+	parallel_blocks(no_rf, min_cols, [&] (octave_idx_type start, octave_idx_type end)
+	{
+		for (octave_idx_type jj = start; jj < end; ++jj)
+		{
+			if ( shock_flag[jj] == 0 )
+				continue;
+			const double * y_col = y_ptr + jj * mc;
+			double * delta_col = delta_ptr + jj * mc;
+			for (octave_idx_type ii = 0; ii < mc; ++ii)
+				delta_col[ii] = scale_vec[jj] * y_col[ii] + offset_vec[jj];
+		}
+	});
+
+  // return values
+	octave_value_list option_outargs;
+	option_outargs(0) = delta;
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    for (int ii = 0; ii < 3; ++ii)
+    {
+        if (!args(ii).isnumeric ())
+        {
+            error("riskfactor_scenarios_cpp: expecting argument %d to be numeric",ii + 1);
+            return true;
+        }
+    }
+
+    if (args(2).numel () != 1)
+    {
+        error("riskfactor_scenarios_cpp: expecting timestep to be a scalar");
+        return true;
+    }
+
+    return false;
+}
+
+/*
+%!test
+%! delta = riskfactor_scenarios_cpp([0.1,0.1;-0.1,-0.1],[2,0.001,0.2,0,0,0;5,0,0.01,0.04,0.03,0.1],10);
+%! assert(delta,[0.11,0.2*0.1 - 0.01;-0.09,-0.2*0.1 - 0.01],sqrt(eps))
+%!test
+%! Y = [0.05;-0.02;0.01];
+%! delta = riskfactor_scenarios_cpp([Y,Y,Y,Y],[1,0.0004,0.2,0,0,0;3,0,0.1,0.02,0.03,0.5;4,0,0.1,0.02,0.03,0.5;0,0,0,0,0,0],250);
+%! assert(delta(:,1),Y + (0.0004 - 0.5*0.2^2/250)*250,sqrt(eps))
+%! assert(delta(:,2),Y + 0.5*0.01*250,sqrt(eps))
+%! assert(delta(:,3),delta(:,2),sqrt(eps))
+%! assert(delta(:,4),zeros(3,1))
+*/
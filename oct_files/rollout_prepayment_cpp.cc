@@ -0,0 +1,257 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <octave/parse.h>
+#include "curve_helpers.h"
+
+static bool any_bad_argument(const octave_value_list& args);
+
+// (1 / discount factor - 1) of annualized rate for given time factor
+static inline double get_lambda(const double& rate, const double& tf,
+                                const int& comp_type, const double& comp_freq)
+{
+    if (comp_type == 1)         // simple
+        return rate * tf;
+    else if (comp_type == 2)    // discrete
+        return std::pow(1.0 + rate / comp_freq, comp_freq * tf) - 1.0;
+    else                        // continuous
+        return std::exp(rate * tf) - 1.0;
+}
+
+DEFUN_DLD (rollout_prepayment_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {[@var{cf_principal_pp} @var{cf_interest_pp}]} = rollout_prepayment_cpp(@var{mode}, @var{pp_rates}, @var{weights}, @var{prepayment_factor}, @var{tf_curve}, @var{comp_type}, @var{comp_freq}, @var{x1}, @var{x2}, @var{x3})\n\
+\n\
+Compute prepayment adjusted principal and interest cash flows of fixed\n\
+amortizing bonds for all scenarios in one time stepped pass.\n\
+\n\
+This function should be called from get_cfvalues_FAB of Octave script\n\
+rollout_structured_cashflows.m.\n\
+The prepayment rate of scenario s and cash flow period p is given by\n\
+prepayment_factor(s) * sum_n pp_rates(s,n) * weights(n,p), where weights\n\
+are the precomputed interpolation weights of the prepayment curve nodes\n\
+at all cash flow terms. The annualized rate is converted into the period\n\
+prepayment rate lambda = 1 / df - 1 (with curve compounding and time factors).\n\
+\n\
+Mode 0 (full prepayment from issue date): principal and interest cash flows\n\
+of the amortizing bond are scaled with Q_p = prod_(i<p) (1 - lambda_i):\n\
+cf_principal_pp = Q_p * (cf_principal + lambda_p * (outstanding - cf_principal)),\n\
+cf_interest_pp = Q_p * cf_interest.\n\
+\n\
+Mode 1 (use outstanding balance): annuity cash flows are recalculated for all\n\
+future cash flow dates starting from outstanding balance. Output has one\n\
+column more than cash flow periods (first column for issue date).\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{mode}: Integer: 0 (full prepayment) or 1 (use outstanding balance)\n\
+@item @var{pp_rates}: Double: prepayment curve values (1xN or SxN)\n\
+@item @var{weights}: Double: curve weights at cash flow periods (NxP)\n\
+@item @var{prepayment_factor}: Double: PSA factor (scalar or Sx1)\n\
+@item @var{tf_curve}: Double: time factors of periods in curve basis (1xP)\n\
+@item @var{comp_type}: String: compounding type of curve [simple,disc,cont]\n\
+@item @var{comp_freq}: Double or String: compounding frequency of curve\n\
+@item @var{x1}: Double: mode 0: principal cash flows (1xP), mode 1: effective\n\
+coupon rates (coupon rate times time factor) of all periods (1xP)\n\
+@item @var{x2}: Double: mode 0: interest cash flows (1xP), mode 1: flag for\n\
+future cash flow dates (1x(P+1))\n\
+@item @var{x3}: Double: mode 0: outstanding amount (1xP), mode 1: outstanding\n\
+balance (scalar)\n\
+@item @var{cf_principal_pp}: Double: OUTPUT: principal cash flows (SxP or Sx(P+1))\n\
+@item @var{cf_interest_pp}: Double: OUTPUT: interest cash flows (SxP or Sx(P+1))\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+[p i] = rollout_prepayment_cpp(0,[0.1;0.2],[1,1],1,[1,1],'simple',1,[50,50],[5,2.5],[100,50])\n\
+p =\n\
+   55.000   45.000\n\
+   60.000   40.000\n\
+i =\n\
+   5.0000   2.2500\n\
+   5.0000   2.0000\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  if (nargin != 10 )
+  {
+    print_usage ();
+	error("Expecting 10 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	int mode                = args(0).int_value ();
+	Matrix pp_rates         = args(1).matrix_value ();
+	Matrix weights          = args(2).matrix_value ();
+	NDArray pp_factor       = args(3).array_value ();
+	NDArray tf_curve        = args(4).array_value ();
+	int comp_type           = get_compounding_type(args(5).string_value (), "rollout_prepayment_cpp");
+	double comp_freq        = get_compounding_freq(args(6), "rollout_prepayment_cpp");
+	NDArray x1              = args(7).array_value ();
+	NDArray x2              = args(8).array_value ();
+	NDArray x3              = args(9).array_value ();
+
+	const octave_idx_type no_nodes   = pp_rates.cols ();
+	const octave_idx_type no_periods = weights.cols ();
+	const octave_idx_type rows_rates  = pp_rates.rows ();
+	const octave_idx_type rows_factor = pp_factor.numel ();
+	const octave_idx_type no_scen = std::max(rows_rates, rows_factor);
+
+	if ( weights.rows () != no_nodes )
+		error("rollout_prepayment_cpp: weights need %d rows (number of curve nodes)", (int) no_nodes);
+	if ( (rows_rates != 1 && rows_rates != no_scen) || (rows_factor != 1 && rows_factor != no_scen) )
+		error("rollout_prepayment_cpp: pp_rates and prepayment_factor need 1 or equal number of rows");
+	if ( tf_curve.numel () != no_periods || x1.numel () != no_periods )
+		error("rollout_prepayment_cpp: tf_curve and x1 need %d columns (number of periods)", (int) no_periods);
+	if ( mode == 0 && (x2.numel () != no_periods || x3.numel () != no_periods) )
+		error("rollout_prepayment_cpp: x2 and x3 need %d columns (number of periods)", (int) no_periods);
+	if ( mode == 1 && (x2.numel () != no_periods + 1 || x3.numel () != 1) )
+		error("rollout_prepayment_cpp: x2 needs %d columns and x3 has to be scalar", (int) no_periods + 1);
+	if ( mode == 1 && x2(0) != 0.0 )
+		error("rollout_prepayment_cpp: first cash flow date has to be in the past");
+
+	// non-zero curve weights of all periods (usually two nodes)
+	std::vector<octave_idx_type> nz_ptr, nz_node;
+	std::vector<double> nz_weight;
+	get_nonzero_weights(weights, nz_ptr, nz_node, nz_weight);
+
+	const octave_idx_type no_cols = (mode == 0) ? no_periods : no_periods + 1;
+	Matrix cf_principal_pp (no_scen, no_cols, 0.0);
+	Matrix cf_interest_pp (no_scen, no_cols, 0.0);
+
+	// loop over all scenarios: time stepped recursion of outstanding amount
+	for (octave_idx_type ss = 0; ss < no_scen; ++ss)
+	{
+		// catch ctrl + c
+		OCTAVE_QUIT;
+		const octave_idx_type sr = (rows_rates == 1) ? 0 : ss;
+		const double factor = pp_factor((rows_factor == 1) ? 0 : ss);
+		double Q_scaling = 1.0;
+		double eff_notional = (mode == 1) ? x3(0) : 0.0;
+		for (octave_idx_type pp = 0; pp < no_periods; ++pp)
+		{
+			// annualized prepayment rate at term of cash flow and PSA factor
+			double rate = 0.0;
+			for (octave_idx_type kk = nz_ptr[pp]; kk < nz_ptr[pp+1]; ++kk)
+				rate += pp_rates(sr,nz_node[kk]) * nz_weight[kk];
+			const double lambda = get_lambda(rate * factor, tf_curve(pp), comp_type, comp_freq);
+
+			if ( mode == 0 )
+			{
+				cf_principal_pp(ss,pp) = Q_scaling * ( x1(pp) + lambda * ( x3(pp) - x1(pp) ) );
+				cf_interest_pp(ss,pp) = x2(pp) * Q_scaling;
+				Q_scaling = Q_scaling * (1.0 - lambda);
+			}
+			else if ( x2(pp+1) != 0.0 )
+			{
+				// interest and annuity of remaining cash flows
+				const double eff_rate = x1(pp);
+				const double rem_cf = static_cast<double>(no_periods - pp);
+				const double tmp_interest = eff_rate * eff_notional;
+				const double cf_annuity = tmp_interest / (1.0 - std::pow(1.0 + eff_rate, -rem_cf)) - tmp_interest;
+				const double cf_principal = (1.0 - lambda) * cf_annuity + eff_notional * lambda;
+				cf_interest_pp(ss,pp+1) = tmp_interest;
+				cf_principal_pp(ss,pp+1) = cf_principal;
+				eff_notional = std::max(0.0, eff_notional - cf_principal);
+			}
+		}
+	}
+
+  // return values
+	octave_value_list option_outargs;
+	option_outargs(0) = cf_principal_pp;
+	option_outargs(1) = cf_interest_pp;
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    if (!args(0).isnumeric () || args(0).numel () != 1
+        || (args(0).int_value () != 0 && args(0).int_value () != 1))
+    {
+        error("rollout_prepayment_cpp: expecting mode to be 0 or 1");
+        return true;
+    }
+
+    if (!args(1).isnumeric ())
+    {
+        error("rollout_prepayment_cpp: expecting pp_rates to be a numeric matrix");
+        return true;
+    }
+
+    if (!args(2).isnumeric ())
+    {
+        error("rollout_prepayment_cpp: expecting weights to be a numeric matrix");
+        return true;
+    }
+
+    if (!args(3).isnumeric ())
+    {
+        error("rollout_prepayment_cpp: expecting prepayment_factor to be numeric");
+        return true;
+    }
+
+    if (!args(4).isnumeric ())
+    {
+        error("rollout_prepayment_cpp: expecting tf_curve to be numeric");
+        return true;
+    }
+
+    if (!args(5).is_string ())
+    {
+        error("rollout_prepayment_cpp: expecting comp_type to be a string");
+        return true;
+    }
+
+    if (!(args(6).isnumeric () || args(6).is_string ()))
+    {
+        error("rollout_prepayment_cpp: expecting comp_freq to be numeric or a string");
+        return true;
+    }
+
+    for (int ii = 7; ii < 10; ++ii)
+    {
+        if (!(args(ii).isnumeric () || args(ii).islogical ()))
+        {
+            error("rollout_prepayment_cpp: expecting argument %d to be numeric",ii + 1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+%!test
+%! [p i] = rollout_prepayment_cpp(0,[0.1;0.2],[1,1],1,[1,1],'simple',1,[50,50],[5,2.5],[100,50]);
+%! assert(p,[55,45;60,40],sqrt(eps))
+%! assert(i,[5,2.25;5,2],sqrt(eps))
+%!test
+%! [p i] = rollout_prepayment_cpp(1,[0.0,0.0],[0.5,0.5;0.5,0.5],1,[1,1],'cont','annual',[0.1,0.1],[0,1,1],100);
+%! assert(i,[0,10,5.238095238095],0.00000001)
+%! assert(p(end),52.380952380952,0.00000001)
+*/
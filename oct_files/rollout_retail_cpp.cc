@@ -0,0 +1,326 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <octave/parse.h>
+#include "curve_helpers.h"
+#include "thread_helpers.h"
+
+static bool any_bad_argument(const octave_value_list& args);
+
+// cumulative survival probabilities from age at valuation date to age at
+// payment dates start ... end - 1: product of all probs with
+// age_valdate < year <= age_cf
+static void get_cum_survival (const NDArray& age_cf,
+                    const octave_idx_type& start, const octave_idx_type& end,
+                    const NDArray& years, const NDArray& probs,
+                    const double& age_valdate, std::vector<double>& cum_survival)
+{
+    for (octave_idx_type dd = start; dd < end; ++dd)
+    {
+        double tmp_prod = 1.0;
+        for (octave_idx_type kk = 0; kk < years.numel (); ++kk)
+        {
+            if ( years(kk) > age_valdate && years(kk) <= age_cf(dd) )
+                tmp_prod *= probs(kk);
+        }
+        cum_survival[dd] = tmp_prod;
+    }
+}
+
+DEFUN_DLD (rollout_retail_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {[@var{ret_values} @var{cum_survival}]} = rollout_retail_cpp(@var{rates}, @var{weights}, @var{tf}, @var{comp_type}, @var{comp_freq}, @var{values}, @var{age_cf}, @var{survival_years}, @var{survival_probs}, @var{age_valdate}, @var{widow_rate}, @var{age_cf_widow}, @var{survival_years_widow}, @var{survival_probs_widow}, @var{age_valdate_widow}, @var{row_ptr})\n\
+\n\
+Compute inflation and mortality adjusted cash flows of retail pension and\n\
+expense products for all scenarios and payment dates in one call.\n\
+\n\
+This function should be called from Octave script rollout_retail_cashflows.m\n\
+(types GOVPEN and RETEXP). The inflation expectation rates at all payment\n\
+dates of scenario s are given by rates(s,:) * weights. Each cash flow value\n\
+is scaled by the inflation factor 1 / df (with compounding type, frequency\n\
+and time factors of the inflation expectation curve) and the cumulative\n\
+survival probability until the age at payment date. If weights are empty,\n\
+rates(s,:) are the rates at all payment dates.\n\
+If the widow parameters are given, the widow pension\n\
+widow_rate * (1 - cum_survival) * cum_survival_widow * inflation factor * value\n\
+is added.\n\
+If row_ptr is given, the payment dates of many contracts are packed in\n\
+compressed sparse row format: the payments of contract c are stored at\n\
+positions row_ptr(c)+1 ... row_ptr(c+1) of all payment date vectors and\n\
+in the same columns of the returned cash flow values. The ages at valuation\n\
+date and the widow rates are given per contract (a widow rate of zero\n\
+switches off the widow pension), the longevity tables are shared.\n\
+The payment dates are split across worker threads (number of threads set by\n\
+environment variable OCTARISK_THREADS, default: all hardware threads).\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{rates}: Double: inflation expectation rates of all scenarios (S x N matrix)\n\
+@item @var{weights}: Double: interpolation weights of curve nodes at all\n\
+payment dates (N x D matrix or empty)\n\
+@item @var{tf}: Double: time factors of all payment dates (D x 1)\n\
+@item @var{comp_type}: String: compounding type of inflation expectation curve\n\
+@item @var{comp_freq}: Double or String: compounding frequency of curve\n\
+@item @var{values}: Double: cash flow values at all payment dates (D x 1)\n\
+@item @var{age_cf}: Double: age at all payment dates (D x 1)\n\
+@item @var{survival_years}: Double: ages of longevity table\n\
+@item @var{survival_probs}: Double: yearly survival probabilities\n\
+@item @var{age_valdate}: Double: age at valuation date (scalar or C x 1)\n\
+@item @var{widow_rate}: Double: widow pension rate (optional, scalar or C x 1)\n\
+@item @var{age_cf_widow}: Double: age of widow at all payment dates (optional)\n\
+@item @var{survival_years_widow}: Double: ages of widow longevity table (optional)\n\
+@item @var{survival_probs_widow}: Double: widow survival probabilities (optional)\n\
+@item @var{age_valdate_widow}: Double: age of widow at valuation date\n\
+(optional, scalar or C x 1)\n\
+@item @var{row_ptr}: Integer: offsets of payment dates of all contracts\n\
+(optional, C+1 x 1)\n\
+@item @var{ret_values}: Double: OUTPUT: cash flow values (S x D matrix)\n\
+@item @var{cum_survival}: Double: OUTPUT: cumulative survival probabilities (1 x D)\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+ret_values = rollout_retail_cpp([0.02,0.02],[1,0;0,1],[1;2],'cont',1,[100;100],[66;67],[66,67],[0.9,0.8],65)\n\
+ret_values =\n\
+   91.818   74.938\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  if (nargin != 10 && nargin != 15 && nargin != 16 )
+  {
+    print_usage ();
+	error("Expecting 10, 15 or 16 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	Matrix rates             = args(0).matrix_value ();
+	Matrix weights           = args(1).matrix_value ();
+	NDArray tf               = args(2).array_value ();
+	int comp_type            = get_compounding_type(args(3).string_value (), "rollout_retail_cpp");
+	double comp_freq         = get_compounding_freq(args(4), "rollout_retail_cpp");
+	NDArray values           = args(5).array_value ();
+	NDArray age_cf           = args(6).array_value ();
+	NDArray survival_years   = args(7).array_value ();
+	NDArray survival_probs   = args(8).array_value ();
+	NDArray age_valdate      = args(9).array_value ();
+	const bool widow_flag    = (nargin >= 15);
+	const bool weights_flag  = !weights.isempty ();
+
+	const octave_idx_type no_scen = rates.rows ();
+	const octave_idx_type no_nodes = rates.cols ();
+	const octave_idx_type no_dates = tf.numel ();
+	if ( weights_flag && (weights.rows () != no_nodes || weights.cols () != no_dates) )
+		error("rollout_retail_cpp: weights need %d rows (number of curve nodes) and %d columns", (int) no_nodes, (int) no_dates);
+	if ( !weights_flag && no_nodes != no_dates )
+		error("rollout_retail_cpp: rates need %d columns, if weights are empty", (int) no_dates);
+	if ( values.numel () != no_dates || age_cf.numel () != no_dates )
+		error("rollout_retail_cpp: tf, values and age_cf need %d entries", (int) no_dates);
+	if ( survival_years.numel () != survival_probs.numel () )
+		error("rollout_retail_cpp: survival_years and survival_probs need equal length");
+
+	// payment dates of all contracts (one contract without row_ptr)
+	ColumnVector row_ptr (2, 0.0);
+	row_ptr(1) = no_dates;
+	if ( nargin == 16 )
+		row_ptr = ColumnVector (args(15).array_value ());
+	const octave_idx_type no_contracts = row_ptr.numel () - 1;
+	if ( no_contracts < 0 || row_ptr(0) != 0 || row_ptr(no_contracts) != no_dates )
+		error("rollout_retail_cpp: row_ptr has to start with 0 and end with number of payment dates");
+	for (octave_idx_type cc = 0; cc < no_contracts; ++cc)
+		if ( row_ptr(cc+1) < row_ptr(cc) )
+			error("rollout_retail_cpp: row_ptr has to be non-decreasing");
+	if ( age_valdate.numel () != 1 && age_valdate.numel () != no_contracts )
+		error("rollout_retail_cpp: age_valdate needs 1 or %d entries", (int) no_contracts);
+
+	// scenario independent mortality adjustment of all payment dates
+	std::vector<double> cum_survival (no_dates, 1.0);
+	std::vector<double> widow_factor (no_dates, 0.0);
+	for (octave_idx_type cc = 0; cc < no_contracts; ++cc)
+	{
+		const octave_idx_type start = static_cast<octave_idx_type>(row_ptr(cc));
+		const octave_idx_type end = static_cast<octave_idx_type>(row_ptr(cc+1));
+		get_cum_survival(age_cf, start, end, survival_years, survival_probs,
+				age_valdate((age_valdate.numel () == 1) ? 0 : cc), cum_survival);
+	}
+	if ( widow_flag )
+	{
+		NDArray widow_rate            = args(10).array_value ();
+		NDArray age_cf_widow          = args(11).array_value ();
+		NDArray survival_years_widow  = args(12).array_value ();
+		NDArray survival_probs_widow  = args(13).array_value ();
+		NDArray age_valdate_widow     = args(14).array_value ();
+		if ( age_cf_widow.numel () != no_dates )
+			error("rollout_retail_cpp: age_cf_widow needs %d entries", (int) no_dates);
+		if ( survival_years_widow.numel () != survival_probs_widow.numel () )
+			error("rollout_retail_cpp: widow survival_years and survival_probs need equal length");
+		if ( (widow_rate.numel () != 1 && widow_rate.numel () != no_contracts)
+				|| (age_valdate_widow.numel () != 1 && age_valdate_widow.numel () != no_contracts) )
+			error("rollout_retail_cpp: widow_rate and age_valdate_widow need 1 or %d entries", (int) no_contracts);
+		std::vector<double> cum_survival_widow (no_dates, 1.0);
+		for (octave_idx_type cc = 0; cc < no_contracts; ++cc)
+		{
+			const double tmp_widow_rate = widow_rate((widow_rate.numel () == 1) ? 0 : cc);
+			if ( tmp_widow_rate == 0.0 )
+				continue;
+			const octave_idx_type start = static_cast<octave_idx_type>(row_ptr(cc));
+			const octave_idx_type end = static_cast<octave_idx_type>(row_ptr(cc+1));
+			get_cum_survival(age_cf_widow, start, end, survival_years_widow,
+					survival_probs_widow,
+					age_valdate_widow((age_valdate_widow.numel () == 1) ? 0 : cc),
+					cum_survival_widow);
+			for (octave_idx_type dd = start; dd < end; ++dd)
+				widow_factor[dd] = tmp_widow_rate * (1.0 - cum_survival[dd])
+									* cum_survival_widow[dd];
+		}
+	}
+
+	// non-zero interpolation weights of all payment dates (usually two nodes)
+	std::vector<octave_idx_type> nz_ptr, nz_node;
+	std::vector<double> nz_weight;
+	if ( weights_flag )
+		get_nonzero_weights(weights, nz_ptr, nz_node, nz_weight);
+
+	Matrix ret_values (no_scen, no_dates);
+	RowVector cum_survival_out (no_dates);
+	std::vector<double> adj_values (no_dates);
+	for (octave_idx_type dd = 0; dd < no_dates; ++dd)
+	{
+		adj_values[dd] = values(dd) * (cum_survival[dd] + widow_factor[dd]);
+		cum_survival_out(dd) = cum_survival[dd];
+	}
+	const double* rates_ptr = rates.data ();
+	const double* tf_ptr = tf.data ();
+	double* ret_ptr = ret_values.fortran_vec ();
+
+	// payment dates are split across worker threads (all scenarios per date)
+	const octave_idx_type min_dates = std::max(static_cast<octave_idx_type>(1),
+					static_cast<octave_idx_type>(20000) / std::max(no_scen,
+					static_cast<octave_idx_type>(1)));
+	parallel_blocks(no_dates, min_dates,
+		[&](const octave_idx_type date_start, const octave_idx_type date_end)
+	{
+		for (octave_idx_type dd = date_start; dd < date_end; ++dd)
+		{
+			const double tmp_tf = tf_ptr[dd];
+			const double tmp_value = adj_values[dd];
+			double* ret_col = ret_ptr + dd * no_scen;
+			for (octave_idx_type ss = 0; ss < no_scen; ++ss)
+			{
+				double rate = 0.0;
+				if ( weights_flag )
+				{
+					for (octave_idx_type kk = nz_ptr[dd]; kk < nz_ptr[dd+1]; ++kk)
+						rate += rates_ptr[nz_node[kk] * no_scen + ss] * nz_weight[kk];
+				}
+				else
+					rate = rates_ptr[dd * no_scen + ss];
+				// inflation factor (inverse discount factor)
+				double infl_factor;
+				if (comp_type == 1)         // simple
+					infl_factor = 1.0 + rate * tmp_tf;
+				else if (comp_type == 2)    // discrete
+					infl_factor = std::pow(1.0 + rate / comp_freq, comp_freq * tmp_tf);
+				else                        // continuous
+					infl_factor = std::exp(rate * tmp_tf);
+				ret_col[ss] = infl_factor * tmp_value;
+			}
+		}
+	});
+
+  // return values
+	octave_value_list option_outargs;
+	option_outargs(0) = ret_values;
+	option_outargs(1) = cum_survival_out;
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    for (int ii = 0; ii < args.length (); ++ii)
+    {
+        if ( ii == 3 || ii == 4 || ii == 1 )
+            continue;
+        if (!args(ii).isnumeric ())
+        {
+            error("rollout_retail_cpp: expecting argument %d to be numeric",ii + 1);
+            return true;
+        }
+    }
+
+    if (!args(1).isnumeric () && !args(1).isempty ())
+    {
+        error("rollout_retail_cpp: expecting weights to be numeric or empty");
+        return true;
+    }
+
+    if (!args(3).is_string ())
+    {
+        error("rollout_retail_cpp: expecting comp_type to be a string");
+        return true;
+    }
+
+    if (!args(4).is_string () && (args(4).numel () != 1 || args(4).double_value () <= 0.0))
+    {
+        error("rollout_retail_cpp: expecting comp_freq to be a string or a positive scalar");
+        return true;
+    }
+
+    if (args.length () < 16 && (args(9).numel () != 1 || (args.length () == 15
+        && (args(10).numel () != 1 || args(14).numel () != 1))))
+    {
+        error("rollout_retail_cpp: expecting age_valdate, widow_rate and age_valdate_widow to be scalars");
+        return true;
+    }
+
+    return false;
+}
+
+/*
+%!test
+%! ret_values = rollout_retail_cpp([0.02,0.02;0.03,0.03],[1,0;0,1],[1;2],'cont',1,[100;100],[66;67],[66,67],[0.9,0.8],65);
+%! assert(ret_values,[100*0.9*exp(0.02),100*0.72*exp(0.04);100*0.9*exp(0.03),100*0.72*exp(0.06)],sqrt(eps))
+%!test
+%! [ret_values cum_survival] = rollout_retail_cpp([0.02,0.02],[1,0;0,1],[1;2],'disc',1,[100;100],[66;67],[66,67],[0.9,0.8],65,0.6,[61;62],[61,62],[0.95,0.9],60);
+%! assert(cum_survival,[0.9,0.72],sqrt(eps))
+%! widow = 0.6 .* (1 - [0.9,0.72]) .* [0.95,0.855];
+%! assert(ret_values,100 .* ([0.9,0.72] + widow) .* [1.02,1.02^2],sqrt(eps))
+%!test
+%! [ret_values cum_survival] = rollout_retail_cpp([0.02,0.02,0.02],[],[1;2;1],'disc',1,[100;100;50],[66;67;67],[66,67],[0.9,0.8],[65;66],[0.6;0],[61;62;0],[61,62],[0.95,0.9],[60;0],[0;2;3]);
+%! assert(cum_survival,[0.9,0.72,0.8],sqrt(eps))
+%! widow = 0.6 .* (1 - [0.9,0.72]) .* [0.95,0.855];
+%! assert(ret_values,[100 .* ([0.9,0.72] + widow) .* [1.02,1.02^2],50 * 0.8 * 1.02],sqrt(eps))
+%!test
+%! % payment dates split across 4 worker threads
+%! tmp_threads = getenv('OCTARISK_THREADS');
+%! setenv('OCTARISK_THREADS','4');
+%! rates = repmat([0.01,0.03],5000,1) + (0:4999)' .* 1e-6;
+%! weights = [linspace(1,0,40);linspace(0,1,40)];
+%! tf = (1:40)';
+%! ret_values = rollout_retail_cpp(rates,weights,tf,'cont',1,ones(40,1),repmat(66,40,1),[66,67],[0.9,0.8],65);
+%! setenv('OCTARISK_THREADS',tmp_threads);
+%! assert(ret_values,0.9 .* exp((rates * weights) .* tf'),sqrt(eps))
+*/
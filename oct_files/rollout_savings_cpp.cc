@@ -0,0 +1,192 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <cmath>
+#include <octave/parse.h>
+
+static bool any_bad_argument(const octave_value_list& args);
+
+// compounded interest factor (inverse discount factor)
+static inline double get_growth_factor(const double& rate, const double& tf,
+                          const int& comp_type, const double& comp_freq)
+{
+    if (comp_type == 1)         // simple
+        return 1.0 + rate * tf;
+    else if (comp_type == 2)    // discrete
+        return std::pow(1.0 + rate / comp_freq, comp_freq * tf);
+    else                        // continuous
+        return std::exp(rate * tf);
+}
+
+DEFUN_DLD (rollout_savings_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {[@var{cf_interest} @var{cf_principal} @var{cf_interest_putable}]} = rollout_savings_cpp(@var{row_ptr}, @var{pay_values}, @var{tf_maturity}, @var{tf_redemption}, @var{coupon_rate}, @var{comp_type}, @var{comp_freq}, @var{bonus_current}, @var{bonus_redemption})\n\
+\n\
+Compute the future values of all savings payments of many savings plans\n\
+(types SAVPLAN and DCP) at once.\n\
+\n\
+This function should be called from Octave script rollout_retail_cashflows.m.\n\
+Savings payments of all contracts are packed in compressed sparse row\n\
+format: the payments of contract c are stored at positions\n\
+row_ptr(c)+1 ... row_ptr(c+1) of all payment vectors. Each payment earns\n\
+interest at the contract coupon rate until the maturity date (interest)\n\
+and until the redemption date (putable interest). The sum of all interests\n\
+is scaled by the bonus factors 1 + bonus_current and 1 + bonus_redemption.\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{row_ptr}: Integer: offsets of payments of all contracts (C+1 x 1)\n\
+@item @var{pay_values}: Double: savings payment values (N x 1)\n\
+@item @var{tf_maturity}: Double: time factors from payment to maturity date (N x 1)\n\
+@item @var{tf_redemption}: Double: time factors from payment to redemption date (N x 1)\n\
+@item @var{coupon_rate}: Double: coupon rates (scalar or C x 1)\n\
+@item @var{comp_type}: Integer: compounding type 1 (simple), 2 (discrete),\n\
+3 (continuous) (scalar or C x 1)\n\
+@item @var{comp_freq}: Double: compounding frequency (scalar or C x 1)\n\
+@item @var{bonus_current}: Double: bonus rate on interest at maturity (scalar or C x 1)\n\
+@item @var{bonus_redemption}: Double: bonus rate on interest at redemption (scalar or C x 1)\n\
+@item @var{cf_interest}: Double: OUTPUT: interest at maturity date (C x 1)\n\
+@item @var{cf_principal}: Double: OUTPUT: sum of all payments (C x 1)\n\
+@item @var{cf_interest_putable}: Double: OUTPUT: interest at redemption date (C x 1)\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+[cf_interest cf_principal] = rollout_savings_cpp([0;2],[100;100],[2;1],[0;0],0.02,2,1,0,0)\n\
+cf_interest = 6.0400\n\
+cf_principal = 200\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  if (nargin != 9 )
+  {
+    print_usage ();
+	error("Expecting 9 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	ColumnVector row_ptr          = ColumnVector (args(0).array_value ());
+	ColumnVector pay_values       = ColumnVector (args(1).array_value ());
+	ColumnVector tf_maturity      = ColumnVector (args(2).array_value ());
+	ColumnVector tf_redemption    = ColumnVector (args(3).array_value ());
+	ColumnVector coupon_rate      = ColumnVector (args(4).array_value ());
+	ColumnVector comp_type        = ColumnVector (args(5).array_value ());
+	ColumnVector comp_freq        = ColumnVector (args(6).array_value ());
+	ColumnVector bonus_current    = ColumnVector (args(7).array_value ());
+	ColumnVector bonus_redemption = ColumnVector (args(8).array_value ());
+
+	const octave_idx_type no_contracts = row_ptr.numel () - 1;
+	const octave_idx_type no_pay = pay_values.numel ();
+	if ( no_contracts < 0 )
+		error("rollout_savings_cpp: row_ptr needs at least one entry");
+	if ( tf_maturity.numel () != no_pay || tf_redemption.numel () != no_pay )
+		error("rollout_savings_cpp: tf_maturity and tf_redemption need %d entries", (int) no_pay);
+	if ( row_ptr(0) != 0 || row_ptr(no_contracts) != no_pay )
+		error("rollout_savings_cpp: row_ptr has to start with 0 and end with number of payments");
+	for (octave_idx_type cc = 0; cc < no_contracts; ++cc)
+		if ( row_ptr(cc+1) < row_ptr(cc) )
+			error("rollout_savings_cpp: row_ptr has to be non-decreasing");
+	if ( (coupon_rate.numel () != 1 && coupon_rate.numel () != no_contracts)
+			|| (comp_type.numel () != 1 && comp_type.numel () != no_contracts)
+			|| (comp_freq.numel () != 1 && comp_freq.numel () != no_contracts)
+			|| (bonus_current.numel () != 1 && bonus_current.numel () != no_contracts)
+			|| (bonus_redemption.numel () != 1 && bonus_redemption.numel () != no_contracts) )
+		error("rollout_savings_cpp: coupon_rate, comp_type, comp_freq and bonus rates need 1 or %d entries", (int) no_contracts);
+
+	ColumnVector cf_interest (no_contracts, 0.0);
+	ColumnVector cf_principal (no_contracts, 0.0);
+	ColumnVector cf_interest_putable (no_contracts, 0.0);
+
+	// loop over all contracts
+	for (octave_idx_type cc = 0; cc < no_contracts; ++cc)
+	{
+		// catch ctrl + c
+		OCTAVE_QUIT;
+		const octave_idx_type start = static_cast<octave_idx_type>(row_ptr(cc));
+		const octave_idx_type end = static_cast<octave_idx_type>(row_ptr(cc+1));
+		const double tmp_rate = coupon_rate((coupon_rate.numel () == 1) ? 0 : cc);
+		const int tmp_comp_type = static_cast<int>(comp_type((comp_type.numel () == 1) ? 0 : cc));
+		const double tmp_comp_freq = comp_freq((comp_freq.numel () == 1) ? 0 : cc);
+		double tmp_interest = 0.0;
+		double tmp_principal = 0.0;
+		double tmp_interest_putable = 0.0;
+		for (octave_idx_type kk = start; kk < end; ++kk)
+		{
+			tmp_interest += (get_growth_factor(tmp_rate, tf_maturity(kk),
+						tmp_comp_type, tmp_comp_freq) - 1.0) * pay_values(kk);
+			tmp_interest_putable += (get_growth_factor(tmp_rate, tf_redemption(kk),
+						tmp_comp_type, tmp_comp_freq) - 1.0) * pay_values(kk);
+			tmp_principal += pay_values(kk);
+		}
+		// pay out bonus interests
+		cf_interest(cc) = tmp_interest + tmp_interest
+					* bonus_current((bonus_current.numel () == 1) ? 0 : cc);
+		cf_interest_putable(cc) = tmp_interest_putable + tmp_interest_putable
+					* bonus_redemption((bonus_redemption.numel () == 1) ? 0 : cc);
+		cf_principal(cc) = tmp_principal;
+	}
+
+  // return values
+	octave_value_list option_outargs;
+	option_outargs(0) = cf_interest;
+	option_outargs(1) = cf_principal;
+	option_outargs(2) = cf_interest_putable;
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    for (int ii = 0; ii < 9; ++ii)
+    {
+        if (!args(ii).isnumeric ())
+        {
+            error("rollout_savings_cpp: expecting argument %d to be numeric",ii + 1);
+            return true;
+        }
+    }
+
+    const NDArray comp_type = args(5).array_value ();
+    for (octave_idx_type ii = 0; ii < comp_type.numel (); ++ii)
+    {
+        if (comp_type(ii) != 1.0 && comp_type(ii) != 2.0 && comp_type(ii) != 3.0)
+        {
+            error("rollout_savings_cpp: expecting comp_type to be 1, 2 or 3");
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+%!test
+%! [cf_interest cf_principal] = rollout_savings_cpp([0;2],[100;100],[2;1],[0;0],0.02,2,1,0,0);
+%! assert(cf_interest,100 * (1.02^2 - 1) + 100 * 0.02,sqrt(eps))
+%! assert(cf_principal,200)
+%!test
+%! [cf_interest cf_principal cf_interest_putable] = rollout_savings_cpp([0;2;2;3],[100;50;200], ...
+%!                  [2;1;0.5],[1;0;0.25],[0.02;0.03;0.04],[1;2;3],[1;1;2],[0.1;0;0.5],[0;0;0.2]);
+%! assert(cf_interest,[(100 * 0.04 + 50 * 0.02) * 1.1;0;200 * (exp(0.02) - 1) * 1.5],sqrt(eps))
+%! assert(cf_principal,[150;0;200])
+%! assert(cf_interest_putable,[100 * 0.02;0;200 * (exp(0.01) - 1) * 1.2],sqrt(eps))
+*/
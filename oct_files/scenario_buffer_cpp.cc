@@ -0,0 +1,151 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <map>
+#include <string>
+
+static bool any_bad_argument(const octave_value_list& args);
+
+// buffer pool: scenario data addressed by handle
+static std::map<octave_idx_type, NDArray> buffer_pool;
+static octave_idx_type next_handle = 1;
+
+DEFUN_DLD (scenario_buffer_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {[@var{retval}]} = scenario_buffer_cpp(@var{mode}, @var{input})\n\
+\n\
+Shared pool of scenario buffers addressed by handle.\n\
+\n\
+This function should be called from the Curve class methods store_rates_mc\n\
+and getValue only. Scenario data is stored once in the pool, while objects\n\
+only carry the handle of the buffer. Objects are copied by value, so a\n\
+buffer may be referenced by any number of object copies. Buffers are\n\
+therefore never freed by objects, but only all at once with mode clear at\n\
+the start of a new run. The data is shared with the returned Octave values\n\
+and not copied until it is modified.\n\
+The function is locked in memory, so that the buffers are not lost by\n\
+clear functions or clear all.\n\
+The following modes are available:\n\
+@itemize @bullet\n\
+@item store: store scenario data @var{input} and return new handle\n\
+@item get: return scenario data of handle @var{input}\n\
+@item clear: free all buffers. Handles of all former buffers are invalid afterwards.\n\
+@item info: return number of buffers and total size of all buffers in bytes\n\
+@end itemize\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{mode}: String: store, get, clear or info\n\
+@item @var{input}: Double: scenario data (store) or handle (get)\n\
+@item @var{retval}: Double: OUTPUT: handle or scenario data\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+h = scenario_buffer_cpp('store',[0.01,0.02;0.03,0.04]);\n\
+rates = scenario_buffer_cpp('get',h)\n\
+rates =\n\
+   0.010000   0.020000\n\
+   0.030000   0.040000\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  // keep buffer pool alive on clear functions / clear all
+  mlock ();
+
+  if (nargin < 1 || nargin > 2 )
+  {
+    print_usage ();
+	error("Expecting 1 or 2 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	std::string mode = args(0).string_value ();
+	octave_value_list option_outargs;
+
+	if ( mode == "clear" )
+	{
+		buffer_pool.clear ();
+		option_outargs(0) = 0.0;
+	}
+	else if ( mode == "info" )
+	{
+		double total_bytes = 0.0;
+		for (std::map<octave_idx_type, NDArray>::const_iterator it = buffer_pool.begin ();
+				it != buffer_pool.end (); ++it)
+			total_bytes += it->second.numel () * sizeof (double);
+		option_outargs(0) = static_cast<double> (buffer_pool.size ());
+		option_outargs(1) = total_bytes;
+	}
+	else
+	{
+		if ( nargin != 2 )
+			error("scenario_buffer_cpp: mode >>%s<< requires a second input", mode.c_str ());
+		if ( mode == "store" )
+		{
+			const octave_idx_type handle = next_handle++;
+			buffer_pool[handle] = args(1).array_value ();
+			option_outargs(0) = static_cast<double> (handle);
+		}
+		else if ( mode == "get" )
+		{
+			const octave_idx_type handle = args(1).idx_type_value ();
+			std::map<octave_idx_type, NDArray>::const_iterator it = buffer_pool.find (handle);
+			if ( it == buffer_pool.end () )
+				error("scenario_buffer_cpp: no buffer found for handle %d (buffers are freed at the start of each run)", (int) handle);
+			option_outargs(0) = it->second;
+		}
+		else
+			error("scenario_buffer_cpp: unknown mode >>%s<<", mode.c_str ());
+	}
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    if (!args(0).is_string ())
+    {
+        error("scenario_buffer_cpp: expecting mode to be a string");
+        return true;
+    }
+
+    if (args.length () > 1 && !args(1).isnumeric ())
+    {
+        error("scenario_buffer_cpp: expecting argument 2 to be numeric");
+        return true;
+    }
+
+    return false;
+}
+
+/*
+%!test
+%! scenario_buffer_cpp('clear');
+%! h = scenario_buffer_cpp('store',[0.01,0.02;0.03,0.04]);
+%! assert(scenario_buffer_cpp('get',h),[0.01,0.02;0.03,0.04])
+%! [no_buffers no_bytes] = scenario_buffer_cpp('info');
+%! assert([no_buffers no_bytes],[1,32])
+%! assert(scenario_buffer_cpp('clear'),0)
+%! assert(scenario_buffer_cpp('info'),0)
+%!error scenario_buffer_cpp('get',-1)
+*/
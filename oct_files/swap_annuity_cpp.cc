@@ -0,0 +1,180 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <octave/parse.h>
+#include "curve_helpers.h"
+
+static bool any_bad_argument(const octave_value_list& args);
+
+DEFUN_DLD (swap_annuity_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {[@var{annuity} @var{forward} @var{df}]} = swap_annuity_cpp(@var{rates}, @var{weights}, @var{tf}, @var{comp_type}, @var{comp_freq}, @var{annuity_weights})\n\
+\n\
+Compute annuities and forward swap rates of an annuity schedule for all scenarios.\n\
+\n\
+This function should be called from Octave scripts calc_value.m (class\n\
+Swaption) and get_cms_rate_hagan.m. The annuity schedule (interpolation\n\
+weights of all curve nodes and time factors at all schedule dates) is set up\n\
+once. All discount factors of all scenarios are then calculated in one pass:\n\
+the rates at the schedule dates are given by rates * weights.\n\
+The annuity is the sum of all discount factors (except the first one)\n\
+weighted by @var{annuity_weights}, the forward swap rate is given by\n\
+(df(first date) - df(last date)) / annuity.\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{rates}: Double: curve rates of all scenarios (S x N matrix)\n\
+@item @var{weights}: Double: interpolation weights of curve nodes at all\n\
+schedule dates (N x D matrix)\n\
+@item @var{tf}: Double: time factors of all schedule dates (D x 1)\n\
+@item @var{comp_type}: String: compounding type (simple, disc, cont)\n\
+@item @var{comp_freq}: Double or String: compounding frequency\n\
+@item @var{annuity_weights}: Double: weights of discount factors of dates\n\
+2 ... D in annuity (D-1 x 1 or scalar)\n\
+@item @var{annuity}: Double: OUTPUT: annuity of all scenarios (S x 1)\n\
+@item @var{forward}: Double: OUTPUT: forward swap rate of all scenarios (S x 1)\n\
+@item @var{df}: Double: OUTPUT: discount factors (S x D matrix)\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+[annuity forward] = swap_annuity_cpp([0.01,0.02],[1,0.5,0;0,0.5,1],[1;2;3],'cont',1,1)\n\
+annuity = 1.9122\n\
+forward = 0.025251\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  if (nargin != 6 )
+  {
+    print_usage ();
+	error("Expecting 6 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	Matrix rates                  = args(0).matrix_value ();
+	Matrix weights                = args(1).matrix_value ();
+	ColumnVector tf               = ColumnVector (args(2).array_value ());
+	int comp_type                 = get_compounding_type(args(3).string_value (), "swap_annuity_cpp");
+	double comp_freq              = get_compounding_freq(args(4), "swap_annuity_cpp");
+	ColumnVector annuity_weights  = ColumnVector (args(5).array_value ());
+
+	const octave_idx_type no_scen = rates.rows ();
+	const octave_idx_type no_nodes = rates.cols ();
+	const octave_idx_type no_dates = weights.cols ();
+	if ( weights.rows () != no_nodes )
+		error("swap_annuity_cpp: weights need %d rows (number of curve nodes)", (int) no_nodes);
+	if ( no_dates < 2 )
+		error("swap_annuity_cpp: annuity schedule needs at least two dates");
+	if ( tf.numel () != no_dates )
+		error("swap_annuity_cpp: tf needs %d entries (number of schedule dates)", (int) no_dates);
+	if ( annuity_weights.numel () != 1 && annuity_weights.numel () != no_dates - 1 )
+		error("swap_annuity_cpp: annuity_weights needs 1 or %d entries", (int) no_dates - 1);
+
+	// non-zero interpolation weights of all schedule dates (usually two nodes)
+	std::vector<octave_idx_type> nz_ptr, nz_node;
+	std::vector<double> nz_weight;
+	get_nonzero_weights(weights, nz_ptr, nz_node, nz_weight);
+
+	Matrix df (no_scen, no_dates);
+	ColumnVector annuity (no_scen, 0.0);
+	ColumnVector forward (no_scen);
+
+	// loop over all schedule dates and scenarios
+	for (octave_idx_type dd = 0; dd < no_dates; ++dd)
+	{
+		// catch ctrl + c
+		OCTAVE_QUIT;
+		const double tmp_tf = tf(dd);
+		const double aw = (dd == 0) ? 0.0 :
+				annuity_weights((annuity_weights.numel () == 1) ? 0 : dd - 1);
+		for (octave_idx_type ss = 0; ss < no_scen; ++ss)
+		{
+			double rate = 0.0;
+			for (octave_idx_type kk = nz_ptr[dd]; kk < nz_ptr[dd+1]; ++kk)
+				rate += rates(ss,nz_node[kk]) * nz_weight[kk];
+			double tmp_df;
+			if (comp_type == 1)         // simple
+				tmp_df = 1.0 / (1.0 + rate * tmp_tf);
+			else if (comp_type == 2)    // discrete
+				tmp_df = std::pow(1.0 + rate / comp_freq, -comp_freq * tmp_tf);
+			else                        // continuous
+				tmp_df = std::exp(-rate * tmp_tf);
+			df(ss,dd) = tmp_df;
+			annuity(ss) += aw * tmp_df;
+		}
+	}
+	for (octave_idx_type ss = 0; ss < no_scen; ++ss)
+		forward(ss) = (df(ss,0) - df(ss,no_dates - 1)) / annuity(ss);
+
+  // return values
+	octave_value_list option_outargs;
+	option_outargs(0) = annuity;
+	option_outargs(1) = forward;
+	option_outargs(2) = df;
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    for (int ii = 0; ii < 3; ++ii)
+    {
+        if (!args(ii).isnumeric ())
+        {
+            error("swap_annuity_cpp: expecting argument %d to be numeric",ii + 1);
+            return true;
+        }
+    }
+
+    if (!args(3).is_string ())
+    {
+        error("swap_annuity_cpp: expecting comp_type to be a string");
+        return true;
+    }
+
+    if (!args(4).is_string () && (args(4).numel () != 1 || args(4).double_value () <= 0.0))
+    {
+        error("swap_annuity_cpp: expecting comp_freq to be a string or a positive scalar");
+        return true;
+    }
+
+    if (!args(5).isnumeric ())
+    {
+        error("swap_annuity_cpp: expecting annuity_weights to be numeric");
+        return true;
+    }
+
+    return false;
+}
+
+/*
+%!test
+%! [annuity forward df] = swap_annuity_cpp([0.01,0.02;0.02,0.03],[1,0.5,0;0,0.5,1],[1;2;3],'cont','annual',1);
+%! df_exp = exp(-[0.01,0.015,0.02;0.02,0.025,0.03] .* [1,2,3]);
+%! assert(df,df_exp,sqrt(eps))
+%! assert(annuity,sum(df_exp(:,2:3),2),sqrt(eps))
+%! assert(forward,(df_exp(:,1) - df_exp(:,3)) ./ sum(df_exp(:,2:3),2),sqrt(eps))
+*/
@@ -0,0 +1,75 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+// Shared helper functions of the multithreaded oct files
+// (riskfactor_scenarios_cpp, pearson_marginal_cpp, calibrate_gpd_cpp and
+// rollout_retail_cpp). Header only, compiled with -pthread in
+// compile_oct_files.m.
+// Worker threads must not call the Octave API (error, OCTAVE_QUIT, creating
+// or resizing Octave arrays): they only read and write raw data pointers of
+// arrays allocated before the workers are started. Input checks are done
+// before and error messages are raised after all workers have joined.
+
+#ifndef OCTARISK_THREAD_HELPERS_H
+#define OCTARISK_THREAD_HELPERS_H
+
+#include <octave/oct.h>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+
+// number of worker threads for no_tasks independent tasks: environment
+// variable OCTARISK_THREADS or number of hardware threads, at most one
+// thread per min_tasks tasks
+static inline octave_idx_type get_no_threads(const octave_idx_type& no_tasks,
+                                        const octave_idx_type& min_tasks)
+{
+    octave_idx_type no_threads = static_cast<octave_idx_type>(
+                                    std::thread::hardware_concurrency ());
+    const char* env_threads = std::getenv ("OCTARISK_THREADS");
+    if ( env_threads != NULL && std::atoi (env_threads) > 0 )
+        no_threads = std::atoi (env_threads);
+    no_threads = std::min(no_threads, no_tasks / std::max(min_tasks,
+                                        static_cast<octave_idx_type>(1)));
+    return std::max(no_threads, static_cast<octave_idx_type>(1));
+}
+
+// call func(start, end) for contiguous blocks of tasks 0 ... no_tasks - 1
+// on all worker threads (in the calling thread, if only one block)
+template <typename F>
+static void parallel_blocks(const octave_idx_type& no_tasks,
+                            const octave_idx_type& min_tasks, F func)
+{
+    const octave_idx_type no_threads = get_no_threads(no_tasks, min_tasks);
+    if ( no_threads < 2 )
+    {
+        func(static_cast<octave_idx_type>(0), no_tasks);
+        return;
+    }
+    const octave_idx_type block = (no_tasks + no_threads - 1) / no_threads;
+    std::vector<std::thread> workers;
+    for (octave_idx_type tt = 0; tt < no_threads; ++tt)
+    {
+        const octave_idx_type start = tt * block;
+        const octave_idx_type end = std::min(no_tasks, start + block);
+        if ( start >= end )
+            break;
+        workers.push_back(std::thread(func, start, end));
+    }
+    for (size_t tt = 0; tt < workers.size (); ++tt)
+        workers[tt].join ();
+}
+
+#endif
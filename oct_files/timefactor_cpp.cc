@@ -0,0 +1,322 @@
+/*
+Copyright (C) 2026 Schinzilord <schinzilord@octarisk.com>
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License as published by the Free Software
+Foundation; either version 3 of the License, or (at your option) any later
+version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+details.
+*/
+
+#include <octave/oct.h>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <octave/parse.h>
+
+static bool any_bad_argument(const octave_value_list& args);
+
+// Octave datenum of 01-Jan-1970
+static const long datenum_epoch = 719529;
+
+// days since 01-Jan-1970 for proleptic gregorian calendar
+static long days_from_civil(long y, long m, long d)
+{
+    y -= m <= 2;
+    const long era = (y >= 0 ? y : y - 399) / 400;
+    const long yoe = y - era * 400;
+    const long doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+static void civil_from_days(long z, long& y, long& m, long& d)
+{
+    z += 719468;
+    const long era = (z >= 0 ? z : z - 146096) / 146097;
+    const long doe = z - era * 146097;
+    const long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const long mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = yoe + era * 400 + (m <= 2);
+}
+
+static inline long datenum_from_civil(long y, long m, long d)
+{
+    return days_from_civil(y, m, d) + datenum_epoch;
+}
+
+static inline void civil_from_datenum(double dn, long& y, long& m, long& d)
+{
+    civil_from_days(static_cast<long>(std::floor(dn)) - datenum_epoch, y, m, d);
+}
+
+static inline double yeardays_actual(long y)
+{
+    const bool leap = (y % 4 == 0 && y % 100 != 0) || (y % 400 == 0);
+    return leap ? 366.0 : 365.0;
+}
+
+// last day of february of given year (datenum)
+static inline long eom_february(long y)
+{
+    return datenum_from_civil(y, 3, 1) - 1;
+}
+
+// saturday and sunday (datenum modulo 7 equals 1 or 2)
+static inline bool is_weekend(long dn)
+{
+    const long wd = ((dn % 7) + 7) % 7;
+    return (wd == 1 || wd == 2);
+}
+
+// number of business days in [d1,d2] (weekends and holidays excluded)
+static double business_days(long d1, long d2, const std::vector<long>& hol)
+{
+    if (d2 < d1)
+        return 0.0;
+    const long total = d2 - d1 + 1;
+    long count = (total / 7) * 5;
+    for (long dd = d1 + (total / 7) * 7; dd <= d2; ++dd)
+        if (!is_weekend(dd))
+            ++count;
+    std::vector<long>::const_iterator lo = std::lower_bound(hol.begin(), hol.end(), d1);
+    std::vector<long>::const_iterator hi = std::upper_bound(hol.begin(), hol.end(), d2);
+    for (std::vector<long>::const_iterator it = lo; it != hi; ++it)
+        if (!is_weekend(*it))
+            --count;
+    return static_cast<double>(count);
+}
+
+DEFUN_DLD (timefactor_cpp, args, nargout, "-*- texinfo -*-\n\
+@deftypefn{Loadable Function} {[@var{tf} @var{dip} @var{dib}]} = timefactor_cpp(@var{d1}, @var{d2}, @var{basis}, @var{holidays})\n\
+\n\
+Compute the time factor for all periods between dates @var{d1} and\n\
+@var{d2} for a day count basis in one pass.\n\
+\n\
+This function should be called from Octave script timefactor.m\n\
+which handles all input conversions and checks. All basis codes\n\
+of get_basis are supported (0-11, 13-15). Scalar or singleton dimensions\n\
+of @var{d1} and @var{d2} are broadcasted.\n\
+\n\
+Input and output variables:\n\
+@itemize @bullet\n\
+@item @var{d1}: Double: first dates (datenum, scalar, vector or matrix)\n\
+@item @var{d2}: Double: second dates (datenum, scalar, vector or matrix)\n\
+@item @var{basis}: Integer: day count basis (scalar)\n\
+@item @var{holidays}: Double: OPTIONAL: holiday dates (datenum) for basis 14\n\
+(business/252). Weekends are always excluded.\n\
+@item @var{tf}: Double: OUTPUT: time factor (days in period / days in base)\n\
+@item @var{dip}: Double: OUTPUT: days in period\n\
+@item @var{dib}: Double: OUTPUT: days in base\n\
+@end itemize\n\
+Example Call:\n\
+@example\n\
+@group\n\
+tf = timefactor_cpp(736329,736329 + [95;365],3)\n\
+tf =\n\
+   0.26027\n\
+   1.00000\n\
+@end group\n\
+@end example\n\
+@end deftypefn")
+{
+  int nargin = args.length ();
+
+  if (nargin < 3 || nargin > 4 )
+  {
+    print_usage ();
+	error("Expecting either 3 or 4 input parameters");
+  }
+
+	// Input parameter checks
+	if (any_bad_argument(args))
+	  return octave_value_list();
+
+	// Input parameter
+	Matrix d1_mat   = args(0).matrix_value (); // first dates
+	Matrix d2_mat   = args(1).matrix_value (); // second dates
+	int basis       = args(2).int_value (); // day count basis
+	std::vector<long> hol;
+	if ( nargin == 4 )
+	{
+		NDArray hol_vec = args(3).array_value ();
+		for (octave_idx_type ii = 0; ii < hol_vec.numel (); ++ii)
+			hol.push_back(static_cast<long>(std::floor(hol_vec(ii))));
+		std::sort(hol.begin(), hol.end());
+		hol.erase(std::unique(hol.begin(), hol.end()), hol.end());
+	}
+
+	if ( basis < 0 || basis > 15 || basis == 12 )
+		error("timefactor_cpp: unsupported basis >>%d<<",basis);
+
+	// broadcast dimensions
+	octave_idx_type r1 = d1_mat.rows (), c1 = d1_mat.cols ();
+	octave_idx_type r2 = d2_mat.rows (), c2 = d2_mat.cols ();
+	if ( (r1 != r2 && r1 != 1 && r2 != 1) || (c1 != c2 && c1 != 1 && c2 != 1) )
+		error("timefactor_cpp: nonconformant dimensions of d1 (%dx%d) and d2 (%dx%d)",
+				(int) r1, (int) c1, (int) r2, (int) c2);
+	octave_idx_type rows = std::max(r1,r2);
+	octave_idx_type cols = std::max(c1,c2);
+	if ( d1_mat.numel () == 0 || d2_mat.numel () == 0 )
+	{
+		rows = 0;
+		cols = 0;
+	}
+
+	Matrix tf (rows, cols);
+	Matrix dip (rows, cols);
+	Matrix dib (rows, cols);
+
+	for (octave_idx_type jj = 0; jj < cols; ++jj)
+	{
+		// catch ctrl + c
+		OCTAVE_QUIT;
+		for (octave_idx_type ii = 0; ii < rows; ++ii)
+		{
+			const double d1 = d1_mat(r1 == 1 ? 0 : ii, c1 == 1 ? 0 : jj);
+			const double d2 = d2_mat(r2 == 1 ? 0 : ii, c2 == 1 ? 0 : jj);
+			long y1, m1, t1, y2, m2, t2;
+			civil_from_datenum(d1, y1, m1, t1);
+			civil_from_datenum(d2, y2, m2, t2);
+			double tmp_dip = 0.0;
+			double tmp_dib = 1.0;
+
+			// a) days in period
+			switch (basis)
+			{
+			case 0: case 2: case 3: case 7: case 8: case 9: case 10: case 15:
+				tmp_dip = d2 - d1;                        // act/XXX
+				break;
+			case 1:                                       // 30/360 SIA
+				if ( d2 == eom_february(y2) && d1 == eom_february(y1) )
+					t2 = 30;
+				tmp_dip = (y2 - y1) * 360.0 + (m2 - m1) * 30.0 + (t2 - t1);
+				break;
+			case 13:                                      // 30/360
+			{
+				if ( d2 == eom_february(y2) && d1 == eom_february(y1) )
+					t2 = 30;
+				bool step2_adjusted = false;
+				if ( d1 == eom_february(y1) && t1 != 30 )
+				{
+					t1 = 30;
+					step2_adjusted = true;
+				}
+				if ( t2 == 31 && step2_adjusted )
+					t2 = 30;
+				if ( t1 == 31 )
+					t1 = 30;
+				tmp_dip = (y2 - y1) * 360.0 + (m2 - m1) * 30.0 + (t2 - t1);
+				break;
+			}
+			case 4: case 5: case 6: case 11:              // 30/XXX
+				if ( basis == 6 || basis == 11 )
+				{
+					t1 = std::min(t1,30L);
+					t2 = std::min(t2,30L);
+				}
+				tmp_dip = (y2 - y1) * 360.0 + (m2 - m1) * 30.0 + (t2 - t1);
+				break;
+			case 14:                                      // business/252
+				tmp_dip = business_days(static_cast<long>(std::floor(d1)),
+								static_cast<long>(std::floor(d2)), hol);
+				break;
+			}
+
+			// b) days in base
+			switch (basis)
+			{
+			case 1: case 2: case 4: case 5: case 6: case 9: case 11: case 13:
+				tmp_dib = 360.0;
+				break;
+			case 3: case 7: case 10:
+				tmp_dib = 365.0;
+				break;
+			case 14:
+				tmp_dib = 252.0;
+				break;
+			case 15:
+				tmp_dib = 364.0;
+				break;
+			case 0: case 8:                               // act/act
+				if ( y1 == y2 )
+				{
+					tmp_dip = d2 - d1;
+					tmp_dib = yeardays_actual(y1);
+				}
+				else if ( y2 > y1 )
+				{
+					const double days_period1 = datenum_from_civil(y1, 12, 31) - d1;
+					const double days_period2 = d2 - datenum_from_civil(y2, 1, 1) + 1;
+					tmp_dip = days_period1 / yeardays_actual(y1)
+							+ days_period2 / yeardays_actual(y2) + (y2 - y1 - 1);
+					tmp_dib = 1.0;
+				}
+				else
+				{
+					tmp_dip = 0.0;
+					tmp_dib = 1.0;
+				}
+				break;
+			}
+			dip(ii,jj) = tmp_dip;
+			dib(ii,jj) = tmp_dib;
+			tf(ii,jj) = tmp_dip / tmp_dib;
+		}
+	}
+
+  // return values
+	octave_value_list option_outargs;
+	option_outargs(0) = tf;
+	option_outargs(1) = dip;
+	option_outargs(2) = dib;
+
+   return octave_value (option_outargs);
+} // end of DEFUN_DLD
+
+// static function for input parameter checks
+bool any_bad_argument(const octave_value_list& args)
+{
+    if (!args(0).isnumeric ())
+    {
+        error("timefactor_cpp: expecting d1 to be a numeric");
+        return true;
+    }
+
+    if (!args(1).isnumeric ())
+    {
+        error("timefactor_cpp: expecting d2 to be a numeric");
+        return true;
+    }
+
+    if (!args(2).isnumeric () || args(2).numel () != 1)
+    {
+        error("timefactor_cpp: expecting basis to be a numeric scalar");
+        return true;
+    }
+
+    if (args.length () == 4 && !args(3).isnumeric ())
+    {
+        error("timefactor_cpp: expecting holidays to be a numeric");
+        return true;
+    }
+
+    return false;
+}
+
+/*
+%!assert(timefactor_cpp(736329,736329 + [95;245;365;730;3650],0),[0.259562841530055;0.669398907103825;0.997267759562842;1.997260273972603;9.991780821917809],0.00000001)
+%!assert(timefactor_cpp(736329,736329 + [95;245;365;730;3650],1),[0.258333333333333;0.666666666666667;0.997222222222222;1.997222222222222;9.991666666666667],0.00000001)
+%!assert(timefactor_cpp(736329,736329 + [95;245;365;730;3650],11),[0.261111111111111;0.669444444444444;1.000000000000000;2.000000000000000;9.994444444444444],0.00000001)
+%!assert(timefactor_cpp(736389,736389 + [95; 245; 364; 365; 366; 730; 3650],13),[0.258333333333333;0.666666666666667;0.991666666666667;1.000000000000000;1.002777777777778;2.000000000000000;9.988888888888889],0.0000000001)
+%!assert(timefactor_cpp(736329 + [94;243;362;731;3651],736329 + [95;245;365;730;3650],0),[0.00273224043715847;0.00546448087431694;0.00819672131147541;-0.00273972602739726;-0.00273972602739726],0.00000001)
+%!assert(timefactor_cpp(736330,736336,14),5/252,sqrt(eps))
+%!assert(timefactor_cpp(736330,736336,14,736333),4/252,sqrt(eps))
+*/
@@ -261,15 +261,28 @@ if (iscell(mc_timestep))
 	error('octarisk: only one mc_timestep can be specified');
 end
 
-if ( strcmpi(mc_timestep(end),'d') )
-	mc_timestep_days = str2num(mc_timestep(1:end-1));  % get timestep days
-	para_object.mc_timestep_days = mc_timestep_days;
-elseif ( strcmp(to_lower(mc_timestep(end)),'y'))
-	mc_timestep_days = 365 * str2num(mc_timestep(1:end-1));  % get timestep days
-	para_object.mc_timestep_days = mc_timestep_days;
-else
+mc_timestep_days = get_timestep_days(mc_timestep);  % get timestep days
+if ( isnan(mc_timestep_days) )
 	error('Unknown number of days in timestep: %s\n',mc_timestep);
 end
+para_object.mc_timestep_days = mc_timestep_days;
+% intermediate path steps (Brownian bridge paths up to mc_timestep)
+mc_path_days = mc_timestep_days;
+mc_path_timesteps = para_object.mc_path_timesteps;
+if ( ischar(mc_path_timesteps) )
+	mc_path_timesteps = {mc_path_timesteps};
+end
+for kk = 1 : 1 : numel(mc_path_timesteps)
+	tmp_ts = mc_path_timesteps{kk};
+	tmp_days = get_timestep_days(tmp_ts);
+	if ( isnan(tmp_days) )
+		error('Unknown number of days in path timestep: %s\n',tmp_ts);
+	end
+	if ( tmp_days > 0 && tmp_days < mc_timestep_days )
+		mc_path_days = [mc_path_days, tmp_days];
+	end
+end
+mc_path_days = unique(mc_path_days);
 
 if (run_mc == true)
     scenario_ts_days = [mc_timestep_days; 0];
@@ -302,6 +315,8 @@ stresstest_struct=struct();
             path_archive,timestamp,archive_flag);
 no_stresstests = length(stresstest_struct);
 para_object.no_stresstests = no_stresstests;
+% compile all stresstests into one sparse shock matrix (objects x stresses)
+stress_engine = compile_stresstests(stresstest_struct);
 
 % 5. Processing Market Data objects (Indizes and Marketcurves)
 mktdata_struct=struct();
@@ -330,7 +345,22 @@ if (run_mc == true)
 
     %corr_matrix = load(input_filename_corr_matrix); % path to correlation matrix
 
-    [corr_matrix riskfactor_cell] = load_correlation_matrix(path_mktdata,input_filename_corr_matrix,path_archive,timestamp,archive_flag);
+    if ( para_object.use_corr_factors == false )
+        [corr_matrix riskfactor_cell] = load_correlation_matrix(path_mktdata,input_filename_corr_matrix,path_archive,timestamp,archive_flag);
+        corr_input = corr_matrix;
+    else
+        % factor model: load factor loadings or fit factors to correlation matrix
+        if ( ~isempty(para_object.input_filename_corr_factors) )
+            [L D riskfactor_cell] = load_correlation_factors(path_mktdata, ...
+                                    para_object.input_filename_corr_factors);
+        else
+            [corr_matrix riskfactor_cell] = load_correlation_matrix(path_mktdata,input_filename_corr_matrix,path_archive,timestamp,archive_flag);
+            [L D] = get_correlation_factors(corr_matrix,para_object.no_corr_factors);
+            clear corr_matrix;
+        end
+        % full correlation matrix is never set up in factor mode
+        corr_input = struct('L',L,'D',D);
+    end
 
     %corr_matrix = eye(length(riskfactor_struct));  % for test cases
 
@@ -350,7 +380,13 @@ if (run_mc == true)
     end
     % c) call MC scenario generation (Copula approach, Pearson distribution types 1-7 according four moments of distribution parameters)
     %    returns matrix R with a mc_scenarios x 1 vector with correlated random variables fulfilling skewness and kurtosis
-    [R_250 distr_type] = scenario_generation_MC(corr_matrix,rf_para_distributions,mc,copulatype,nu,256,path_static,para_object);
+    if ( numel(mc_path_days) > 1 )
+        % path mode: Brownian bridge paths at intermediate steps
+        [R_250 distr_type Z R_path] = scenario_generation_MC(corr_input,rf_para_distributions,mc,copulatype,nu,256,path_static,para_object,mc_path_days ./ mc_timestep_days);
+    else
+        [R_250 distr_type] = scenario_generation_MC(corr_input,rf_para_distributions,mc,copulatype,nu,256,path_static,para_object);
+        R_path = [];
+    end
     %[R_1 distr_type] = scenario_generation_MC(corr_matrix,rf_para_distributions,mc,copulatype,nu,1); % only needed if independent random numbers are desired
 
     % variable for switching statistical analysis on and off
@@ -360,12 +396,15 @@ if (run_mc == true)
     % Generate Structure with Risk factor scenario values: scale values according to timestep
     M_struct = struct();
     M_struct( 1 ).matrix = R_250 ./ sqrt(250/mc_timestep_days);
+    M_struct( 1 ).path = R_path ./ sqrt(250/mc_timestep_days);
+    M_struct( 1 ).path_days = mc_path_days;
+    clear R_path;
     % --------------------------------------------------------------------------------------------------------------------
     % 2.) Monte Carlo Riskfactor Simulation for all timesteps
     [riskfactor_struct rf_failed_cell ] = load_riskfactor_scenarios(riskfactor_struct,M_struct,riskfactor_cell,mc_timestep,mc_timestep_days,para_object);
 
     if (strcmpi(para_object.shred_type,'TOTAL'))	% only plot realized correlations for TOTAL Shred and for core risk factors (without mapped RF)
-        retcode = calc_rlzd_corr(riskfactor_cell,riskfactor_struct,corr_matrix,para_object,mc_timestep,path_reports,true);
+        retcode = calc_rlzd_corr(riskfactor_cell,riskfactor_struct,corr_input,para_object,mc_timestep,path_reports,true);
     end
     
     % map risk factors 
@@ -376,7 +415,7 @@ if (run_mc == true)
 end
 
 % update riskfactor with stresses
-[riskfactor_struct rf_failed_cell ] = load_riskfactor_stresses(riskfactor_struct,stresstest_struct);
+[riskfactor_struct rf_failed_cell ] = load_riskfactor_stresses(riskfactor_struct,stress_engine);
 
 scengen = toc;
 
@@ -398,21 +437,25 @@ tic;
 
 % a) Processing yield curves
 
+% free shared scenario buffers of previous runs
+if ( run_mc == true && para_object.use_scenario_buffer == true )
+    scenario_buffer_cpp('clear');
+end
 curve_struct=struct();
-[rf_ir_cur_cell curve_struct curve_failed_cell] = load_yieldcurves(curve_struct,riskfactor_struct,mc_timestep,path_output,saving,run_mc);
+[rf_ir_cur_cell curve_struct curve_failed_cell] = load_yieldcurves(curve_struct,riskfactor_struct,mc_timestep,path_output,saving,run_mc,para_object);
 
         
 % b) Updating Marketdata Curves and Indizes with scenario dependent risk factor values
 index_struct=struct();
 surface_struct=struct();
-[index_struct curve_struct surface_struct id_failed_cell] = update_mktdata_objects(valuation_date,instrument_struct,mktdata_struct,index_struct,riskfactor_struct,curve_struct,surface_struct,mc_timestep,mc,no_stresstests,run_mc,stresstest_struct);   
+[index_struct curve_struct surface_struct id_failed_cell] = update_mktdata_objects(valuation_date,instrument_struct,mktdata_struct,index_struct,riskfactor_struct,curve_struct,surface_struct,mc_timestep,mc,no_stresstests,run_mc,stress_engine,para_object);   
 %~ c = get_sub_object(index_struct,'FX_EURCAD')
 %~ c = get_sub_object(index_struct,'FX_EURCHF')
 %~ c = get_sub_object(riskfactor_struct,'RF_IR_EUR_1Y')
 %~ c = get_sub_object(curve_struct,'IR_EUR')
 %~ c = get_sub_object(curve_struct,'RF_IR_EUR')
 % c) Processing Vola surfaces: Load in all vola marketdata and fill Surface object with values
-[surface_struct vola_failed_cell] = load_volacubes(surface_struct,path_mktdata,input_filename_vola_index,input_filename_vola_ir,input_filename_surf_stoch,stresstest_struct,riskfactor_struct,run_mc);
+[surface_struct vola_failed_cell] = load_volacubes(surface_struct,path_mktdata,input_filename_vola_index,input_filename_vola_ir,input_filename_surf_stoch,stress_engine,riskfactor_struct,run_mc);
 
 
 % e) Loading matrix objects
@@ -427,33 +470,35 @@ curve_gen_time = toc;
 %   Total Loop over all Instruments and type dependent valuation
 fulvia = 0.0;
 fulvia_performance = {};
-instrument_valuation_failed_cell = {}; 
+approx_performance = {};
+instrument_valuation_failed_cell = {};
 number_instruments =  length( instrument_struct );
-for kk = 1 : 1 : length( scenario_set )      % loop via all MC time steps and other scenarios
-  tmp_scenario  = scenario_set{ kk };    % get scenario from scenario_set
-  tmp_ts        = scenario_ts_days(kk);  % get timestep days
-  if ( strcmpi(tmp_scenario,'stress'))
-      scen_number = no_stresstests;
-  elseif ( strcmpi(tmp_scenario,'base'))
-      scen_number = 1;
-  else
-      scen_number = mc;
-  end
-  % store current scenario number in object
-  para_object.scen_number = scen_number;
-        
-  fprintf('== Full valuation | scenario set %s | number of scenarios %d | timestep in days %d ==\n',tmp_scenario, scen_number,tmp_ts);
+% load scenario independent cash flow schedules of previous runs
+if ( para_object.use_cf_cache_file == true )
+    cf_cache_file = strcat(path_static,'/cf_schedule_cache.mat');
+    fprintf('Loaded %d cash flow schedules from cache file\n',cashflow_cache('load',cf_cache_file));
+end
+% calibrate vola spreads of all options and swaptions in one batch
+[instrument_struct no_calibrated] = calibrate_vola_spreads(valuation_date, ...
+                    instrument_struct, curve_struct, index_struct, ...
+                    surface_struct, para_object);
+fprintf('Calibrated vola spreads of %d instruments in batch\n',no_calibrated);
+if ( para_object.use_approx_valuation == false )
+  % cash flow rollout of all retail instruments per scenario set in batches
+  [instrument_struct no_rolled_out] = rollout_retail_batch(valuation_date, ...
+                    instrument_struct, curve_struct, scenario_set);
+  fprintf('Rolled out cash flows of %d retail instruments in batch\n',no_rolled_out);
+  % batch valuation of all scenario sets per instrument: rollout, base values
+  % and sensitivities are calculated only once per instrument
+  fprintf('== Full valuation | scenario sets %s | timesteps in days %s ==\n',strjoin(scenario_set,','),any2str(scenario_ts_days));
   for ii = 1 : 1 : length( instrument_struct )
     try
-    % TODO: loop via positions_cell -> get id from instrument struct -> valuate these instruments only
-    % store in special valuated_instruments struct -> aggregate from these struct only
     tmp_id = instrument_struct( ii ).id;
     tic;
         % =================    Full valuation    ===============================
-        
-        tmp_instr_obj = get_sub_object(instrument_struct, tmp_id); 
-        % Call instrument object method valuate
-        tmp_instr_obj = tmp_instr_obj.valuate(valuation_date, tmp_scenario, ...
+        tmp_instr_obj = get_sub_object(instrument_struct, tmp_id);
+        [tmp_instr_obj scen_number_total] = valuate_scenario_sets( ...
+                                tmp_instr_obj, valuation_date, scenario_set, ...
                                 instrument_struct, surface_struct, ...
                                 matrix_struct, curve_struct, index_struct, ...
                                 riskfactor_struct, para_object);
@@ -461,34 +506,81 @@ for kk = 1 : 1 : length( scenario_set )      % loop via all MC time steps and ot
         instrument_struct( ii ).object = tmp_instr_obj;
         % print status message:
         if ( mod(ii,round(number_instruments/10)) == 0 )
-            %fprintf('%s Pct. processed. Continuing...\n',any2str(round((ii/number_instruments)*100)));
             fprintf('|%s %s|\n',any2str(char(repmat(61,1,round((ii/number_instruments)*10)))),any2str(char(repmat(95,1,10-round((ii/number_instruments)*10)))));
         end
         % =================  End Full valuation  ===============================
-        
      % store performance data into cell array
-     fulvia_performance{end + 1} = strcat(tmp_instr_obj.get('type'),'|',tmp_instr_obj.get('sub_type'),'|',tmp_id,'|',num2str(scen_number),'|',num2str(toc),'|s');
+     fulvia_performance{end + 1} = strcat(tmp_instr_obj.get('type'),'|',tmp_instr_obj.get('sub_type'),'|',tmp_id,'|',num2str(scen_number_total),'|',num2str(toc),'|s');
      fulvia = fulvia + toc ;  
     catch   % catch error in instrument valuation
         fprintf('octarisk:Instrument valuation for %s failed. There was an error: >>%s<< File: >>%s<< Line: >>%d<<\n',tmp_id,lasterr,lasterror.stack.file,lasterror.stack.line);
         instrument_valuation_failed_cell{ length(instrument_valuation_failed_cell) + 1 } =  tmp_id;
-        % FALLBACK: store instrument as Cash instrument with fixed value_base for all scenarios (use different variable for scen_number to avoid collisions)
-        cc = Cash();
-        cc = cc.set('id',tmp_instr_obj.get('id'),'name',tmp_instr_obj.get('name'),'asset_class',tmp_instr_obj.get('asset_class'),'currency',tmp_instr_obj.get('currency'),'value_base',tmp_instr_obj.get('value_base'));
-        for pp = 1 : 1 : length(scenario_set);
-            if ( strcmp(scenario_set{pp},'stress'))
-                scen_number_catch = no_stresstests;
-            else
-                scen_number_catch = mc;
-            end
-            cc = cc.calc_value(scenario_set{pp},scen_number_catch);   % repeat base value in all MC timesteps and stress scenarios -> riskfree
-        end
-        instrument_struct( ii ).object = cc;
+        instrument_struct( ii ).object = get_fallback_instrument(tmp_instr_obj, ...
+                                scenario_set,no_stresstests,mc);
     end
-  end 
+  end
   para_object.first_eval = 0;
+else
+  % sensitivity based approximation: one pass per scenario set
+  for kk = 1 : 1 : length( scenario_set )      % loop via all MC time steps and other scenarios
+    tmp_scenario  = scenario_set{ kk };    % get scenario from scenario_set
+    tmp_ts        = scenario_ts_days(kk);  % get timestep days
+    if ( strcmpi(tmp_scenario,'stress'))
+        scen_number = no_stresstests;
+    elseif ( strcmpi(tmp_scenario,'base'))
+        scen_number = 1;
+    else
+        scen_number = mc;
+    end
+    % store current scenario number in object
+    para_object.scen_number = scen_number;
+        
+    fprintf('== Full valuation | scenario set %s | number of scenarios %d | timestep in days %d ==\n',tmp_scenario, scen_number,tmp_ts);
+    for ii = 1 : 1 : length( instrument_struct )
+      try
+      % TODO: loop via positions_cell -> get id from instrument struct -> valuate these instruments only
+      % store in special valuated_instruments struct -> aggregate from these struct only
+      tmp_id = instrument_struct( ii ).id;
+      tic;
+          % =================    Full valuation    ===============================
+        
+          tmp_instr_obj = get_sub_object(instrument_struct, tmp_id);
+          % sensitivity based approximation with fallback to full valuation
+          [tmp_instr_obj approx_flag approx_error] = instrument_approximation( ...
+                              tmp_instr_obj, valuation_date, tmp_scenario, ...
+                              instrument_struct, surface_struct, ...
+                              matrix_struct, curve_struct, index_struct, ...
+                              riskfactor_struct, para_object);
+          if ( ~isnan(approx_error) )
+              approx_performance{end + 1} = strcat(tmp_id,'|',tmp_scenario, ...
+                              '|',num2str(approx_error),'|',num2str(approx_flag));
+          end
+          % store valuated instrument in struct
+          instrument_struct( ii ).object = tmp_instr_obj;
+          % print status message:
+          if ( mod(ii,round(number_instruments/10)) == 0 )
+              %fprintf('%s Pct. processed. Continuing...\n',any2str(round((ii/number_instruments)*100)));
+              fprintf('|%s %s|\n',any2str(char(repmat(61,1,round((ii/number_instruments)*10)))),any2str(char(repmat(95,1,10-round((ii/number_instruments)*10)))));
+          end
+          % =================  End Full valuation  ===============================
+        
+       % store performance data into cell array
+       fulvia_performance{end + 1} = strcat(tmp_instr_obj.get('type'),'|',tmp_instr_obj.get('sub_type'),'|',tmp_id,'|',num2str(scen_number),'|',num2str(toc),'|s');
+       fulvia = fulvia + toc ;  
+      catch   % catch error in instrument valuation
+          fprintf('octarisk:Instrument valuation for %s failed. There was an error: >>%s<< File: >>%s<< Line: >>%d<<\n',tmp_id,lasterr,lasterror.stack.file,lasterror.stack.line);
+          instrument_valuation_failed_cell{ length(instrument_valuation_failed_cell) + 1 } =  tmp_id;
+          instrument_struct( ii ).object = get_fallback_instrument(tmp_instr_obj, ...
+                                  scenario_set,no_stresstests,mc);
+      end
+    end 
+    para_object.first_eval = 0;
   
-end      % end eval mc timesteps and stress loops
+  end      % end eval mc timesteps and stress loops
+end
+if ( para_object.use_cf_cache_file == true )
+    cashflow_cache('save',cf_cache_file);
+end
 
 tic;
 
@@ -512,6 +604,15 @@ else
     fprintf('SUCCESS: All instruments valuated.\n');
 end
 
+% print approximation errors (ID|scenario set|error|approximation used)
+if ( length(approx_performance) > 0 )
+    fprintf('Instrument approximation errors (error limit %s): \n',any2str(para_object.approx_error_limit));
+    fprintf('ID|Scenario|Error|Approximated\n');
+    for kk = 1:1:length(approx_performance)
+        fprintf('%s\n',approx_performance{kk});
+    end
+end
+
 % print all base values
 fprintf('Instrument Base and stress Values: \n');
 fprintf('ID,Base,StressBase,%s,%s,%s,Currency\n',stresstest_struct(2).name,stresstest_struct(3).name,stresstest_struct(11).name);
@@ -708,3 +809,19 @@ fprintf('\n');
 
 end     % ending MAIN function octarisk
 
+% ------------------------------------------------------------------------------
+% FALLBACK: store instrument as Cash instrument with fixed value_base for all
+% scenarios (use different variable for scen_number to avoid collisions)
+function cc = get_fallback_instrument(tmp_instr_obj,scenario_set,no_stresstests,mc)
+    cc = Cash();
+    cc = cc.set('id',tmp_instr_obj.get('id'),'name',tmp_instr_obj.get('name'),'asset_class',tmp_instr_obj.get('asset_class'),'currency',tmp_instr_obj.get('currency'),'value_base',tmp_instr_obj.get('value_base'));
+    for pp = 1 : 1 : length(scenario_set);
+        if ( strcmp(scenario_set{pp},'stress'))
+            scen_number_catch = no_stresstests;
+        else
+            scen_number_catch = mc;
+        end
+        cc = cc.calc_value(scenario_set{pp},scen_number_catch);   % repeat base value in all MC timesteps and stress scenarios -> riskfree
+    end
+end
+
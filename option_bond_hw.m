@@ -11,13 +11,16 @@
 %# details.
 
 %# -*- texinfo -*-
-%# @deftypefn {Function File} {[@var{value}] =} option_bond_hw (@var{value_type},@var{bond},@var{curve},@var{callschedule},@var{putschedule})
+%# @deftypefn {Function File} {[@var{value} @var{value_put} @var{value_call} @var{dvalue} @var{d2value}] =} option_bond_hw (@var{value_type},@var{bond},@var{curve},@var{callschedule},@var{putschedule})
 %#
 %# Compute the value of a put or call bond option using Hull-White Tree model.
 %# 
 %# This script is a wrapper for the function pricing_callable_bond_cpp
 %# and handles all input and ouput data. Input data: value type,
 %# bond instrument, curve instrument, call and put schedule.
+%# If requested, the first and second derivative of the option value
+%# (@var{dvalue}, @var{d2value}) to a parallel shift of the curve rates are
+%# calculated in the same tree sweep (exercise decisions held fixed).
 %# References:
 %# @itemize @bullet
 %# @item Hull, Options, Futures and other derivatives, 7th Edition
@@ -26,7 +29,7 @@
 %# @seealso{pricing_callable_bond_cpp}
 %# @end deftypefn
 
-function [OptionValue OptionValuePut OptionValueCall] = option_bond_hw(value_type,bond,curve,callschedule,putschedule)
+function [OptionValue OptionValuePut OptionValueCall dOptionValue d2OptionValue] = option_bond_hw(value_type,bond,curve,callschedule,putschedule)
  
  if nargin < 5 || nargin > 5
      print_usage ();
@@ -194,6 +197,9 @@ global number_parallel_cores;
 
 OptionValueCall = 0.0;
 OptionValuePut = 0.0;
+dOptionValue = 0.0;
+d2OptionValue = 0.0;
+calc_sensi = ( nargout > 3 );
 if ( length(call_dates) > 0 )   % only if call schedule has some dates
     for mm = 1 : 1 : length(call_dates)
         % get index of nearest neighbour of call maturity and cash flow dates
@@ -207,7 +213,13 @@ if ( length(call_dates) > 0 )   % only if call schedule has some dates
         call_flag = true;
         
         % ##########     use ndpar package   ###################################
-		if use_parallel_pkg == true
+		if calc_sensi == true
+			[Call tmp_B tmp_pu tmp_pm tmp_pd tmp_r tmp_Q dCall d2Call] = ...
+                    pricing_callable_bond_cpp(call_flag,T,N,alpha,sigma,tree_dates, ...
+                    tree_cf,R_matrix,dt,Timevec,notional,Mat,K,accr_int,american_flag);
+            dOptionValue  -= dCall;
+            d2OptionValue -= d2Call;
+		elseif use_parallel_pkg == true
 			[Call]  = ndpar_arrayfun(number_parallel_cores,@pricing_callable_bond_cpp, ...
 						call_flag,T,N,alpha,sigma,tree_dates, ...
 						tree_cf,R_matrix,dt,Timevec,notional,Mat,K,accr_int,american_flag, ...
@@ -233,7 +245,13 @@ if ( length(put_dates) > 0 )   % only if put schedule has some dates
         american_flag = putschedule.american_flag;
         call_flag = false;   
         % ##########     use ndpar package   ###################################
-        if use_parallel_pkg == true
+        if calc_sensi == true
+			[Put tmp_B tmp_pu tmp_pm tmp_pd tmp_r tmp_Q dPut d2Put] = ...
+                    pricing_callable_bond_cpp(call_flag,T,N,alpha,sigma,tree_dates, ...
+                    tree_cf,R_matrix,dt,Timevec,notional,Mat,K,accr_int,american_flag);
+            dOptionValue  += dPut;
+            d2OptionValue += d2Put;
+        elseif use_parallel_pkg == true
 			[Put]  = ndpar_arrayfun(number_parallel_cores,@pricing_callable_bond_cpp, ...
 						call_flag,T,N,alpha,sigma,tree_dates, ...
 						tree_cf,R_matrix,dt,Timevec,notional,Mat,K,accr_int,american_flag, ...
@@ -47,7 +47,11 @@
 %# @item @var{path_static}: Optional: path to static files 
 %# (required for saving Willowtree transition probabilities) 
 %# @end itemize
-%# @seealso{option_binomial, option_bs, option_exotic_mc}
+%# The willow tree is optimized once per set of timesteps, nodes and timestep
+%# size and kept in an in-process cache of the oct-file pricing_willowtree_cpp.
+%# If @var{path_static} is set, the tree is also stored in a binary file
+%# and reused in later sessions.
+%# @seealso{option_binomial, option_bs, option_exotic_mc, pricing_willowtree_cpp}
 %# @end deftypefn
 
 function [option_willowtree V_eur_option] = option_willowtree(CallFlag,AmericanFlag,S0,K,T,rf,sigma,dividend,dk,nodes,path_static)
@@ -98,110 +102,19 @@ else
     end
     z_method = nodes_possible(lookup(nodes_possible,nodes));
 end 
-% set load and save path for optimized willowtree
-willowtree_save_flag = 1;
-if (nargin < 11 || strcmp(path_static,'') )
-   path_static = pwd;
-   willowtree_save_flag = 0;   
+% set load and save path for optimized willowtree (empty: in-process cache only)
+if (nargin < 11 )
+   path_static = '';
 end
 
 %-------------------------------------------------------------------------
-%           Setup of input parameters
+%           Valuation of all scenarios via Willow Tree (oct-file)
 %-------------------------------------------------------------------------
-
-divyield = dividend;
-if AmericanFlag==1,
-    AmericanOptionFlag = 1; 
-else
-    AmericanOptionFlag = 0; 
-end
-        
-if CallFlag==1,
-    callputflag=1;
-else
-    callputflag=-1;
-end
-rf_input = rf;
-
-% checking for consistency between S0 and K (either equal size, or S0 has fixed 
-% value while K is a vector)
-if (rows(S0) < rows(K))
-    if (rows(S0) > 1 )
-        error ('Number of rows of spot (S0) and strike (K) does not match')
-    else
-        S0 = repmat(S0,rows(K),1);
-    end
-end
-
-% applying multidimensionality (shifting all variables to 3rd dimension 
-% (1st (time) and 2nd (nodes) dimensions are used for building tree)
-S0      = reshape(S0,1,1,rows(S0));
-K       = reshape(K,1,1,rows(K));
-T       = reshape(T,1,1,rows(T));
-rf      = reshape(rf,1,1,rows(rf));
-sigma   = reshape(sigma,1,1,rows(sigma));
-divyield   = reshape(divyield,1,1,rows(divyield));
-T_years = T ./ 365;
-
-% Rounding Time according to timesteps dt and number of nodes
-N = round(T/dk); % total number of timesteps
-if ( N < 2 )     % in case of days to maturity <= dk -> adjust dk
-    N = 2;
-    dk = dk / 2;
-end
-T   = dk * N;
-dt  = T / (N.*365);  % timestep between two valuation points in years
-
-% generate Willowtree according to timesteps and number of nodes
-[Transition_matrix z] = generate_willowtree(N,dk,z_method,willowtree_save_flag,path_static);
-n = length(z);
-q = ones(n,1) ./n;
-
-%-------------------------------------------------------------------------
-%           Discounting values through the Willow Tree
-%-------------------------------------------------------------------------
-
-% Setting tree at final timestep with underlying asset prices
-
-% Assuming geometric brownian motion:
-
-S_T = S0 .* (exp( (rf  - divyield - (sigma.^2 ./ 2)) .* T_years + ...
-        sigma .* sqrt(T_years) .* z));
-
-[a b c] = size(S0);
-% getting payoff of option at time T
-V_T = max(callputflag.*(S_T - K ),0);
-% discounting iteratively
-discount_factor = exp(-rf_input'.*dt);
-
-% matrix rows(rf_input) x n is needed for discounting timestep values
-discount_factor_mat = exp(-rf_input'.*dt);
-discount_factor_mat = repmat(discount_factor_mat,n,1);
-present_value = V_T;
-
-
-tmp_drift = rf  - divyield;
-
-% ######## iterating through timesteps and discounting expected values  ########
-for ii = (N-1) : -1 : 1  
-    timestep_value  = (Transition_matrix(:,:,ii) * present_value) .* ...
-                                        discount_factor_mat ;
-    timestep_value  = reshape(timestep_value,n,1,c);
-    % Assuming geometric brownian motion:
-    S_act       = S0 .* exp( ((tmp_drift - (sigma.^2 ./ 2)) .* dt .* ii) + ...
-                            sigma .* sqrt(dt .* ii) .* z);
-    immediate_val   = callputflag.*(S_act - K);
-    present_value   = max(timestep_value,AmericanOptionFlag.*immediate_val) ;
-end
-
-immediate_val   = callputflag.*(S0 - K);
-present_value   = q' * (present_value) .* discount_factor;
-present_value   = reshape(present_value,1,1,c);
-V_option        =  max(present_value,AmericanOptionFlag.*immediate_val) ;
-V_option        = reshape(V_option,c,1,1);
-V_eur_option    = (q' * ( exp(-rf*T_years) .* V_T))';
-
-option_willowtree = V_option;
+% The tree is cached in-process and (if path_static is given) on disk,
+% backward induction is performed for all scenarios at once
+[option_willowtree V_eur_option] = pricing_willowtree_cpp(logical(CallFlag == 1), ...
+                        logical(AmericanFlag == 1), S0, K, T, rf, sigma, ...
+                        dividend, dk, z_method, path_static);
 
 end
   
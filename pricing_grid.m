@@ -0,0 +1,230 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{value} @var{grid_struct}] =} pricing_grid (@var{pricing_func}, @var{state}, @var{tolerance}, @var{max_nodes}, @var{method})
+%#
+%# Grid based pricing of expensive instruments for a large number of scenarios.
+%# The instrument is priced on a grid over its one to three driving risk factor
+%# states only. All scenario values are interpolated from the grid values.
+%# @*
+%# The grid is refined adaptively: starting with 5 nodes per dimension, the
+%# number of nodes is increased (n -> 2n - 1) until the maximum interpolation
+%# error at all cell midpoints relative to the maximum absolute grid value is
+%# below @var{tolerance} or until the refined grid would exceed @var{max_nodes}
+%# per dimension. All previous nodes and cell midpoints are nodes of the refined
+%# grid, their values are kept and each point is priced only once.
+%# State dimensions which are constant across all scenarios are not gridded.
+%# If the pricing function evaluations of the grid including the next
+%# refinement would exceed the number of scenarios, all scenarios are
+%# priced directly.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{pricing_func}: function handle, which returns a column vector of
+%# values for a matrix of states (one state per row, columns as in @var{state})
+%# @item @var{state}: matrix with scenario states (scenarios x dimensions,
+%# maximum three dimensions), e.g. [spot, volatility, interest rate]
+%# @item @var{tolerance}: OPTIONAL: relative pricing error tolerance
+%# (default: 1e-4)
+%# @item @var{max_nodes}: OPTIONAL: maximum number of nodes per dimension
+%# (default: 33)
+%# @item @var{method}: OPTIONAL: interpolation method [linear, spline]
+%# (default: linear). Spline interpolation is used for one dimensional grids only.
+%# @item @var{value}: RETURN: column vector with scenario values
+%# @item @var{grid_struct}: RETURN: structure with grid axis, grid values,
+%# number of pricing function evaluations and achieved error
+%# @end itemize
+%# @seealso{option_willowtree, pricing_option_cpp}
+%# @end deftypefn
+
+function [value grid_struct] = pricing_grid(pricing_func, state, tolerance, max_nodes, method)
+
+if ( nargin < 2 || nargin > 5 )
+    print_usage();
+end
+if ( nargin < 3 || isempty(tolerance) )
+    tolerance = 1e-4;
+end
+if ( nargin < 4 || isempty(max_nodes) )
+    max_nodes = 33;
+end
+if ( nargin < 5 || isempty(method) )
+    method = 'linear';
+end
+if ~( is_function_handle(pricing_func) )
+    error('pricing_grid: pricing_func has to be a function handle');
+end
+if ( columns(state) > 3 )
+    error('pricing_grid: at most three state dimensions supported');
+end
+if ~( any(strcmpi(method,{'linear','spline'})) )
+    error('pricing_grid: unknown interpolation method >>%s<<',method);
+end
+
+scen_number = rows(state);
+grid_struct = struct();
+grid_struct.evaluations = 0;
+grid_struct.error = 0.0;
+
+% get gridded (non-constant) dimensions
+state_min = min(state,[],1);
+state_max = max(state,[],1);
+grid_dims = find(state_max > state_min);
+dim = length(grid_dims);
+
+% direct pricing, if no grid is required or grid is too large
+if ( dim == 0 || (5^dim + 4^dim) >= scen_number )
+    value = pricing_func(state);
+    grid_struct.evaluations = scen_number;
+    grid_struct.axis = {};
+    grid_struct.values = value;
+    return;
+end
+
+% initial grid
+nodes = 5;
+[axis_cell grid_state] = build_grid(state_min,state_max,grid_dims,nodes);
+V = reshape(pricing_func(grid_state),grid_size(nodes,dim));
+grid_struct.evaluations = rows(grid_state);
+% adaptive refinement of grid
+while ( true )
+    % error estimate at cell midpoints
+    mid_cell = cell(1,dim);
+    for ii = 1 : 1 : dim
+        tmp_axis = axis_cell{ii};
+        mid_cell{ii} = 0.5 .* (tmp_axis(1:end-1) + tmp_axis(2:end));
+    end
+    [mid_grid mid_state] = expand_grid(mid_cell,state_min,grid_dims);
+    mid_values = pricing_func(mid_state);
+    grid_struct.evaluations = grid_struct.evaluations + rows(mid_state);
+    mid_interp = interpolate_grid(axis_cell,V,mid_grid,method);
+    scale = max(max(abs(V(:))),eps);
+    grid_struct.error = max(abs(mid_values - mid_interp)) / scale;
+    new_nodes = 2 * nodes - 1;
+    if ( grid_struct.error <= tolerance || new_nodes > max_nodes )
+        break;
+    end
+    % pricings of refined grid: nodes which are neither previous nodes nor
+    % cell midpoints and all cell midpoints of refined grid
+    next_evaluations = new_nodes^dim - nodes^dim - (nodes - 1)^dim ...
+                                                    + (new_nodes - 1)^dim;
+    if ( grid_struct.evaluations + next_evaluations >= scen_number )
+        % refinement is more expensive than direct pricing
+        value = pricing_func(state);
+        grid_struct.evaluations = grid_struct.evaluations + scen_number;
+        grid_struct.axis = {};
+        grid_struct.values = value;
+        return;
+    end
+    % refined grid: previous nodes (odd indizes) and cell midpoints (even
+    % indizes in all dimensions) are kept, all other nodes are priced
+    [axis_cell grid_state] = build_grid(state_min,state_max,grid_dims,new_nodes);
+    V_new = zeros(grid_size(new_nodes,dim));
+    priced = false(size(V_new));
+    idx_node = repmat({1:2:new_nodes},1,dim);
+    idx_mid = repmat({2:2:new_nodes-1},1,dim);
+    V_new(idx_node{:}) = V;
+    priced(idx_node{:}) = true;
+    V_new(idx_mid{:}) = reshape(mid_values,grid_size(nodes - 1,dim));
+    priced(idx_mid{:}) = true;
+    V_new(~priced) = pricing_func(grid_state(~priced(:),:));
+    grid_struct.evaluations = grid_struct.evaluations + sum(~priced(:));
+    V = V_new;
+    nodes = new_nodes;
+end
+
+% interpolate all scenario values
+scen_grid = cell(1,dim);
+for ii = 1 : 1 : dim
+    scen_grid{ii} = state(:,grid_dims(ii));
+end
+value = interpolate_grid(axis_cell,V,scen_grid,method);
+
+grid_struct.axis = axis_cell;
+grid_struct.values = V;
+grid_struct.nodes = nodes;
+
+end
+
+% ------------------------------------------------------------------------------
+% helper functions
+function retval = grid_size(nodes,dim)
+    if ( dim == 1 )
+        retval = [nodes,1];
+    else
+        retval = repmat(nodes,1,dim);
+    end
+end
+
+function [axis_cell grid_state] = build_grid(state_min,state_max,grid_dims,nodes)
+    axis_cell = cell(1,length(grid_dims));
+    for ii = 1 : 1 : length(grid_dims)
+        jj = grid_dims(ii);
+        axis_cell{ii} = linspace(state_min(jj),state_max(jj),nodes)';
+    end
+    [tmp grid_state] = expand_grid(axis_cell,state_min,grid_dims);
+end
+
+% expand axis to full tensor grid and set constant dimensions to state_min
+function [point_cell point_state] = expand_grid(axis_cell,state_min,grid_dims)
+    dim = length(axis_cell);
+    point_cell = cell(1,dim);
+    if ( dim == 1 )
+        point_cell{1} = axis_cell{1}(:);
+    else
+        [point_cell{:}] = ndgrid(axis_cell{:});
+        for ii = 1 : 1 : dim
+            point_cell{ii} = point_cell{ii}(:);
+        end
+    end
+    point_state = repmat(state_min,numel(point_cell{1}),1);
+    for ii = 1 : 1 : dim
+        point_state(:,grid_dims(ii)) = point_cell{ii};
+    end
+end
+
+function value = interpolate_grid(axis_cell,V,point_cell,method)
+    if ( length(axis_cell) == 1 )
+        value = interp1(axis_cell{1},V,point_cell{1},method);
+    else
+        value = interpn(axis_cell{:},V,point_cell{:},'linear');
+    end
+    value = value(:);
+end
+
+%!test
+%! f = @(x) x(:,1).^2;
+%! S = linspace(80,120,1000)';
+%! [value grid_struct] = pricing_grid(f,S,1e-5,129);
+%! assert(value,S.^2,0.15)
+%! assert(grid_struct.evaluations < 500)
+%! % every grid node and final midpoint is priced once
+%! assert(grid_struct.evaluations,2 * grid_struct.nodes - 1)
+%!test
+%! f = @(x) option_bs(1,x(:,1),100,365,0.01,x(:,2),0.0);
+%! state = [linspace(80,120,2000)',linspace(0.15,0.25,2000)'];
+%! [value grid_struct] = pricing_grid(f,state,1e-5,65);
+%! assert(value,f(state),5e-2)
+%!test
+%! f = @(x) x(:,1) + x(:,2);
+%! state = [linspace(1,2,100)',0.5 .* ones(100,1)];
+%! [value grid_struct] = pricing_grid(f,state);
+%! assert(value,f(state),sqrt(eps))
+%!test
+%! f = @(x) sin(5 .* x(:,1)) .* x(:,2) + x(:,3).^2;
+%! rand('state',1);
+%! state = rand(5000,3);
+%! [value grid_struct] = pricing_grid(f,state,1e-10,129);
+%! % refinement stops before exceeding direct pricing, scenarios priced directly
+%! assert(value,f(state),sqrt(eps))
+%! assert(grid_struct.evaluations < 2 * 5000)
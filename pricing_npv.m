@@ -11,7 +11,7 @@
 %# details.
 
 %# -*- texinfo -*-
-%# @deftypefn {Function File} {[@var{npv} @var{MacDur} @var{Convexity} @var{MonDur} @var{Convexity_alt}] =} pricing_npv(@var{valuation_date}, @var{cashflow_dates}, @var{cashflow_values}, @var{spread_constant}, @var{discount_nodes}, @var{discount_rates}, @var{basis}, @var{comp_type}, @var{comp_freq}, @var{interp_discount}, @var{comp_type_curve}, @var{basis_curve}, @var{comp_freq_curve}, @var{sensi_flag})
+%# @deftypefn {Function File} {[@var{npv} @var{MacDur} @var{Convexity} @var{MonDur} @var{Convexity_alt} @var{dnpv} @var{d2npv}] =} pricing_npv(@var{valuation_date}, @var{cashflow_dates}, @var{cashflow_values}, @var{spread_constant}, @var{discount_nodes}, @var{discount_rates}, @var{basis}, @var{comp_type}, @var{comp_freq}, @var{interp_discount}, @var{comp_type_curve}, @var{basis_curve}, @var{comp_freq_curve}, @var{sensi_flag})
 %#
 %# Compute the net present value, Macaulay Duration, Convexity and Monetary
 %# duration of a given cash flow pattern according to a given discount curve 
@@ -55,11 +55,17 @@
 %# @item @var{MonDur}:  returns a Mx1 vector with all Monetary durations
 %# @item @var{Convexity_alt}:  returns a Mx1 vector with Convexity (alternative 
 %# method)
+%# @item @var{dnpv}:  returns a Mx1 vector with the first derivative of the npv
+%# to a parallel shift of the discount curve rates (analytic derivative of the
+%# discount factors in curve compounding convention, calculated only if
+%# requested)
+%# @item @var{d2npv}:  returns a Mx1 vector with the second derivative of the
+%# npv to a parallel shift of the discount curve rates
 %# @end itemize
 %# @seealso{timefactor, discount_factor, interpolate_curve, convert_curve_rates}
 %# @end deftypefn
 
-function [npv MacDur Convexity MonDur Convexity_alt] = pricing_npv(valuation_date, ...
+function [npv MacDur Convexity MonDur Convexity_alt dnpv d2npv] = pricing_npv(valuation_date, ...
             cashflow_dates, cashflow_values, spread_constant, discount_nodes, ...
             discount_rates, basis, comp_type, comp_freq, interp_discount, ...
             comp_type_curve, basis_curve, comp_freq_curve, sensi_flag)
@@ -143,6 +149,8 @@ MacDur = 0;
 Convexity = 0;
 Convexity_alt = 0;
 MonDur = 0.0;
+dnpv = 0.0;
+d2npv = 0.0;
 
 % get rid of past cashflows
 cashflow_values(cashflow_dates<0) = [];
@@ -168,6 +176,8 @@ else
         end
     end
 end 
+% floored rates are insensitive to a curve shift
+shift_mask = ( rate_curve_vec > -0.99999 );
 rate_curve_vec = max(rate_curve_vec,-0.99999);
 yield_total = rate_curve_vec'  + spread_constant_vec ;
 
@@ -208,7 +218,44 @@ if (sensi_flag == true && npv(1) > 0.0)
     Convexity = Convexity ./ npv;    
     Convexity_alt = Convexity_alt ./ npv;
 end
-              
+
+% analytic derivatives of the npv to a parallel shift of the curve rates:
+% derivatives of the discount factors in the curve compounding convention
+if ( nargout > 5 )
+    tf_curve = timefactor(valuation_date,valuation_date + cashflow_dates,basis_curve);
+    if ( regexpi(comp_type_curve,'simp'))
+        ddf_vec  = - tf_curve .* df_vec.^2;
+        d2df_vec = 2 .* tf_curve.^2 .* df_vec.^3;
+    elseif ( regexpi(comp_type_curve,'disc'))
+        if ischar(comp_freq_curve)
+            if ( regexpi(comp_freq_curve,'^da'))
+                comp_freq_curve = 365;
+            elseif ( regexpi(comp_freq_curve,'^week'))
+                comp_freq_curve = 52;
+            elseif ( regexpi(comp_freq_curve,'^month'))
+                comp_freq_curve = 12;
+            elseif ( regexpi(comp_freq_curve,'^quarter'))
+                comp_freq_curve = 4;
+            elseif ( regexpi(comp_freq_curve,'^semi-annual'))
+                comp_freq_curve = 2;
+            elseif ( regexpi(comp_freq_curve,'^annual'))
+                comp_freq_curve = 1;       
+            else
+                error('pricing_npv:Need valid compounding frequency. Unknown >>%s<<',comp_freq_curve)
+            end
+        end
+        yield_factor = 1 + yield_total' ./ comp_freq_curve;
+        ddf_vec  = - tf_curve .* df_vec ./ yield_factor;
+        d2df_vec = tf_curve .* (tf_curve + 1 / comp_freq_curve) ...
+                                        .* df_vec ./ yield_factor.^2;
+    else    % continuous compounding
+        ddf_vec  = - tf_curve .* df_vec;
+        d2df_vec = tf_curve.^2 .* df_vec;
+    end
+    dnpv  = sum(cashflow_values .* ddf_vec .* shift_mask,2);
+    d2npv = sum(cashflow_values .* d2df_vec .* shift_mask,2);
+end
+
 end
  
 
@@ -233,3 +280,16 @@ end
 %! assert(npv,105.619895059963,0.0000001)
 %! assert(MacDur,10.0933391311109,0.0000001)
 %! assert(Convexity,106.724246965361,0.0000001)
+
+%!test
+%! cf_dates = [314,679,1044,1409,1775,2140,2505,2870,3236,3601,3966];
+%! cf_values = [1.504109589,1.5,1.5,1.5,1.504109589,1.5,1.5,1.5,1.504109589,1.5,101.5];
+%! nodes = [365,3650];
+%! rates = [0.01,0.02];
+%! comp_type_cell = {'simple','disc','cont'};
+%! for kk = 1 : 1 : length(comp_type_cell)
+%!   [npv tmp1 tmp2 tmp3 tmp4 dnpv d2npv] = pricing_npv(datenum('31-Dec-2015'),cf_dates,cf_values,0.001,nodes,rates,3,'simple','annual','linear',comp_type_cell{kk},0,'semi-annual');
+%!   npv_shift = pricing_npv(datenum('31-Dec-2015'),cf_dates,cf_values,0.001,nodes,[rates - 0.0001;rates + 0.0001],3,'simple','annual','linear',comp_type_cell{kk},0,'semi-annual');
+%!   assert(dnpv,(npv_shift(2) - npv_shift(1)) / 0.0002,0.01)
+%!   assert(d2npv,(npv_shift(2) + npv_shift(1) - 2 * npv) / 0.0001^2,0.1)
+%! end
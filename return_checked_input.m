@@ -32,11 +32,12 @@ if ( strcmpi(type,'special'))
 % Special treatment for scenario_mc, timestep_mc and scenario_stress required
     % ====================== set scenario_mc: if isvector -> append to 
     %           existing vector / matrix, if ismatrix -> replace existing value
+    %           (one column per MC timestep)
     if (ischar (prop) && strcmp (prop, 'scenario_mc'))   
-	  if (isvector (val) && isreal (val))
+	  if (ismatrix (val) && isnumeric (val) && isreal (val))
 		 retval = val;
 	  else
-		error ('set: expecting scenario_mc to be a real vector');
+		error ('set: expecting scenario_mc to be a real vector or matrix');
       end
         
      % ====================== set rates_mc: if isvector -> append to existing 
@@ -282,6 +283,8 @@ end
 %! assert(retval,'30-Sep-2016')
 %! retval = return_checked_input(obj,[1;2;3;4],'scenario_mc','special');
 %! assert(retval,[1;2;3;4])
+%! retval = return_checked_input(obj,[1,5;2,6],'scenario_mc','special');
+%! assert(retval,[1,5;2,6])
 %! retval = return_checked_input(obj,[5;6;7;8],'cf_values_mc','special');
 %! assert(retval,[5;6;7;8])
 %! retval = return_checked_input(obj,[12;23;145;15],'scenario_stress','special');
@@ -0,0 +1,207 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{instrument_struct} @var{no_rolled_out}] =} rollout_retail_batch (@var{valuation_date}, @var{instrument_struct}, @var{curve_struct}, @var{scenario_set})
+%#
+%# Roll out the cash flows of all retail instruments (savings plans SAVPLAN
+%# and DCP, retirement expenses RETEXP and government pensions GOVPEN) in
+%# batches before the instrument valuation.
+%# Instruments of one sub_type sharing all curves (discount curve, inflation
+%# expectation curve and longevity tables) are rolled out together in one call
+%# of rollout_retail_cashflows per scenario set. Savings plans SAVPLAN have
+%# scenario independent cash flows and are rolled out for the base scenario
+%# only, all other types for base and all scenario sets.
+%# The cash flows are stored in the instruments and the rolled out scenario
+%# sets in property cf_batch_scenarios, so that instrument_valuation skips the
+%# rollout for these scenario sets. Instruments with scenario dependent cash
+%# flow dates and groups with rollout errors are rolled out during instrument
+%# valuation as before.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{valuation_date}: valuation date
+%# @item @var{instrument_struct}: structure with all instruments
+%# @item @var{curve_struct}: structure with all curves
+%# @item @var{scenario_set}: cell with scenario sets ['base','stress', MC timesteps]
+%# @item @var{instrument_struct}: OUTPUT: structure with rolled out instruments
+%# @item @var{no_rolled_out}: OUTPUT: number of rolled out instruments
+%# @end itemize
+%# @seealso{rollout_retail_cashflows, instrument_valuation}
+%# @end deftypefn
+
+function [instrument_struct no_rolled_out] = rollout_retail_batch(valuation_date, ...
+                instrument_struct, curve_struct, scenario_set)
+
+if ( nargin < 4 )
+    print_usage();
+end
+no_rolled_out = 0;
+if ( ischar(valuation_date) )
+    valuation_date = datenum(valuation_date,1);
+end
+if ( ischar(scenario_set) )
+    scenario_set = {scenario_set};
+end
+scenario_set = reshape(scenario_set,1,numel(scenario_set));
+scenario_set = [{'base'},scenario_set(~strcmpi(scenario_set,'base'))];
+
+% group retail instruments by sub_type and curves
+group_keys = {};
+group_curves = {};
+group_idx = {};
+for ii = 1 : 1 : length(instrument_struct)
+    obj = instrument_struct(ii).object;
+    if ~( strcmpi(class(obj),'Retail') )
+        continue;
+    end
+    % reset scenarios of previous batch rollout
+    if ~( isempty(obj.cf_batch_scenarios) )
+        instrument_struct(ii).object = obj.set('cf_batch_scenarios',{});
+    end
+    switch ( upper(obj.sub_type) )
+    case 'SAVPLAN'
+        curve_ids = {};
+    case 'DCP'
+        curve_ids = {obj.discount_curve};
+    case 'RETEXP'
+        curve_ids = {obj.infl_exp_curve,obj.longevity_table};
+    case 'GOVPEN'
+        curve_ids = {obj.infl_exp_curve,obj.longevity_table};
+        if ( obj.widow_pension_flag == true )
+            curve_ids{end+1} = obj.longevity_table_widow;
+        end
+    otherwise
+        continue;   % no cash flow rollout (e.g. HC)
+    end
+    tmp_key = strjoin([{upper(obj.sub_type)},curve_ids],'|');
+    kk = find(strcmp(group_keys,tmp_key));
+    if ( isempty(kk) )
+        group_keys{end+1} = tmp_key;
+        group_curves{end+1} = curve_ids;
+        group_idx{end+1} = [];
+        kk = length(group_keys);
+    end
+    group_idx{kk}(end+1) = ii;
+end
+
+% rollout all scenario sets of all instruments per group
+for gg = 1 : 1 : length(group_keys)
+    curve_objects = cell(1,length(group_curves{gg}));
+    curves_found = true;
+    for jj = 1 : 1 : length(group_curves{gg})
+        [curve_objects{jj} ret_code] = get_sub_object(curve_struct,group_curves{gg}{jj});
+        curves_found = curves_found && ( ret_code == 1 );
+    end
+    if ~( curves_found )
+        continue;   % warnings are given during instrument valuation
+    end
+    instr_idx = group_idx{gg};
+    instruments = {instrument_struct(instr_idx).object};
+    if ( strncmpi(group_keys{gg},'SAVPLAN',7) )
+        group_scenarios = {'base'};
+    else
+        group_scenarios = scenario_set;
+    end
+    try
+        no_scen = length(group_scenarios);
+        ret_dates = cell(1,no_scen);
+        ret_values = cell(1,no_scen);
+        for kk = 1 : 1 : no_scen
+            [ret_dates{kk} ret_values{kk} tmp_int tmp_principal accr_int ...
+                    last_coupon_date] = rollout_retail_cashflows( ...
+                    valuation_date, group_scenarios{kk}, instruments, ...
+                    curve_objects{:});
+            if ( kk == 1 )
+                base_accr_int = accr_int;
+                base_last_coupon_date = last_coupon_date;
+            end
+        end
+    catch
+        fprintf('WARNING: rollout_retail_batch: batch rollout of >>%s<< failed: >>%s<<. Rolling out during instrument valuation.\n', ...
+                    group_keys{gg},lasterr);
+        continue;
+    end
+
+    % store cash flows of instruments with scenario independent dates
+    mc_idx = find(~strcmpi(group_scenarios,'base') & ~strcmpi(group_scenarios,'stress'));
+    for cc = 1 : 1 : length(instr_idx)
+        dates_equal = true;
+        for kk = 2 : 1 : no_scen
+            dates_equal = dates_equal && isequal(ret_dates{kk}{cc},ret_dates{1}{cc}) ...
+                    && columns(ret_values{kk}{cc}) == columns(ret_values{1}{cc});
+        end
+        for kk = mc_idx(2:end)
+            dates_equal = dates_equal && rows(ret_values{kk}{cc}) == rows(ret_values{mc_idx(1)}{cc});
+        end
+        if ~( dates_equal )
+            continue;
+        end
+        obj = instruments{cc};
+        obj = obj.set('cf_dates',ret_dates{1}{cc}, ...
+                    'accrued_interest',base_accr_int{cc}, ...
+                    'last_coupon_date',base_last_coupon_date{cc}, ...
+                    'cf_values',ret_values{1}{cc});
+        stress_idx = find(strcmpi(group_scenarios,'stress'));
+        if ~( isempty(stress_idx) )
+            obj = obj.set('cf_values_stress',ret_values{stress_idx}{cc});
+        end
+        if ~( isempty(mc_idx) )
+            mc_values = cellfun(@(x) x{cc},ret_values(mc_idx),'UniformOutput',false);
+            obj = obj.set('cf_values_mc',cat(3,mc_values{:}), ...
+                    'timestep_mc_cf',group_scenarios(mc_idx));
+        end
+        obj = obj.set('cf_batch_scenarios',group_scenarios);
+        instrument_struct(instr_idx(cc)).object = obj;
+        no_rolled_out = no_rolled_out + 1;
+    end
+end
+
+end
+
+%!test
+%! valuation_date = datenum('31-Mar-2020');
+%! longev = Curve();
+%! longev = longev.set('id','LONGEV','nodes',0:1:100,'type','Longevity Table');
+%! longev = longev.set('rates_base',repmat(0.99,1,101),'method_interpolation','linear','compounding_type','simple');
+%! i = Curve();
+%! i = i.set('id','INFL_EXP_CURVE','nodes',[365,7300],'type','Inflation Expectation Curve');
+%! i = i.set('rates_base',[0.015,0.015],'rates_stress',[0.015,0.015;0.005,0.005;0.03,0.03]);
+%! i = i.set('method_interpolation','linear','method_extrapolation','constant','compounding_type','continuous','compounding_freq','annual');
+%! r = Retail();
+%! r = r.set('id','GOVPEN_A','sub_type','GOVPEN','term',1,'term_unit','years');
+%! r = r.set('compounding_type','simple','year_of_birth',1983);
+%! r = r.set('retirement_startdate','31-May-2051','retirement_enddate','31-May-2100');
+%! r = r.set('pension_scores',75.318,'value_per_score',33.05,'tax_rate',0.27);
+%! r = r.set('infl_exp_curve','INFL_EXP_CURVE','longevity_table','LONGEV');
+%! r2 = r.set('id','GOVPEN_B','year_of_birth',1960,'pension_scores',40);
+%! h = Retail();
+%! h = h.set('id','HC','sub_type','HC');
+%! instrument_struct = struct('id',{r.id,r2.id,h.id},'object',{r,r2,h});
+%! curve_struct = struct('id',{i.id,longev.id},'object',{i,longev});
+%! [instrument_struct no_rolled_out] = rollout_retail_batch(valuation_date, ...
+%!                  instrument_struct,curve_struct,{'stress','base'});
+%! assert(no_rolled_out,2)
+%! assert(instrument_struct(3).object.cf_batch_scenarios,{})
+%! for ii = 1 : 1 : 2
+%!     b = instrument_struct(ii).object;
+%!     assert(b.cf_batch_scenarios,{'base','stress'})
+%!     ref = instrument_struct(ii).object.rollout('base',valuation_date,i,longev);
+%!     ref = ref.rollout('stress',valuation_date,i,longev);
+%!     assert(b.get('cf_dates'),ref.get('cf_dates'))
+%!     assert(b.getCF('base'),ref.getCF('base'),1e-8)
+%!     assert(b.getCF('stress'),ref.getCF('stress'),1e-8)
+%! end
+%! [instrument_struct no_rolled_out] = rollout_retail_batch(valuation_date, ...
+%!                  instrument_struct,struct('id',{i.id},'object',{i}),{'stress'});
+%! assert(no_rolled_out,0)
+%! assert(instrument_struct(1).object.cf_batch_scenarios,{})
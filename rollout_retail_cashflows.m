@@ -12,11 +12,19 @@
 %# details.
 
 %# -*- texinfo -*-
-%# @deftypefn {Function File} {[@var{ret_dates} @var{ret_values} @var{accrued_interest}] =} rollout_retail_cashflows (@var{valuation_date}, @var{value_type}, @var{instrument}, @var{ref_curve}, @var{surface}, @var{riskfactor})
+%# @deftypefn {Function File} {[@var{ret_dates} @var{ret_values} @var{ret_interest_values} @var{ret_principal_values} @var{accrued_interest} @var{last_coupon_date}] =} rollout_retail_cashflows (@var{valuation_date}, @var{value_type}, @var{instrument}, @var{ref_curve}, @var{surface}, @var{riskfactor})
 %#
 %# Compute cash flow dates and cash flows values,
 %# accrued interests and last coupon date for retail products.
 %#
+%# @var{instrument} is either a single retail instrument or a cell array of
+%# retail instruments of one sub_type (sharing all curve and longevity objects).
+%# Savings plans (SAVPLAN, DCP) of all contracts are rolled out in one call of
+%# compiled function rollout_savings_cpp, pension and expense products
+%# (GOVPEN, RETEXP) in one call of rollout_retail_cpp. For a cell array of
+%# instruments all return values are cell arrays with one entry per contract.
+%# The batches are built by rollout_retail_batch before instrument valuation.
+%#
 %# @seealso{timefactor, discount_factor, get_forward_rate, interpolate_curve}
 %# @end deftypefn
 
@@ -42,51 +50,84 @@ if nargin < 6
     obj3 = [];
 end  
 
-% ######################   Initial fill of para structure ###################### 
-para = fill_para_struct(nargin,valuation_date, value_type, ...
-                    instrument, obj1, obj2, obj3);
+% a single instrument is rolled out as batch of one contract
+batch_flag = iscell(instrument);
+if ~( batch_flag )
+    instrument = {instrument};
+end
+no_contracts = numel(instrument);
+if ( no_contracts == 0 )
+    error('rollout_retail_cashflows: no instruments given');
+end
 
+% ######################   Initial fill of para structure ###################### 
 % ######################   Calculate Cash Flow dates  ##########################   
-para = get_cf_dates(para);
-    
+para = cell(no_contracts,1);
+for cc = 1:1:no_contracts
+    para{cc} = fill_para_struct(nargin,valuation_date, value_type, ...
+                    instrument{cc}, obj1, obj2, obj3);
+    para{cc} = get_cf_dates(para{cc});
+    if ~( strcmpi(para{cc}.type,para{1}.type) )
+        error('rollout_retail_cashflows: all instruments need sub_type >>%s<<, found >>%s<<',para{1}.type,para{cc}.type);
+    end
+end
 
 % ############   Calculate Cash Flow values depending on type   ################     
-switch (para.type)
+switch (para{1}.type)
 
 % Type Retail instruments
 case {'SAVPLAN' 'DCP'}
-    para = get_cfvalues_RETAIL(para.valuation_date, value_type, para, instrument);
+    para = get_cfvalues_RETAIL(para{1}.valuation_date, value_type, para, instrument);
 
 case {'RETEXP' }
-    para = get_cfvalues_RETEXP(para.valuation_date, value_type, para, ...
+    para = get_cfvalues_RETEXP(para{1}.valuation_date, value_type, para, ...
 		instrument, obj1, obj2);
 		
 case {'GOVPEN' }
-    para = get_cfvalues_GOVPEN(para.valuation_date, value_type, para, ...
+    para = get_cfvalues_GOVPEN(para{1}.valuation_date, value_type, para, ...
 		instrument, obj1, obj2, obj3); 
 
 case {'HC' }
-    para = get_cfvalues_HC(para.valuation_date, value_type, para, ...
-		instrument, obj1, obj2, obj3); 
+    for cc = 1:1:no_contracts
+        para{cc} = get_cfvalues_HC(para{cc}.valuation_date, value_type, para{cc}, ...
+		instrument{cc}, obj1, obj2, obj3); 
+    end
 				       
 otherwise
-    error('rollout_retail_cashflows: Unknown instrument type >>%s<<',any2str(para.type));
+    error('rollout_retail_cashflows: Unknown instrument type >>%s<<',any2str(para{1}.type));
 end
 
-% ####################   Calculate Final Cash Flow values  #####################   
-para    = get_final_cf_values(para);
-
-% ######################   Calculate Accrued Interest  #########################   
-para.accrued_interest  = para.ret_interest_values(:,end);
-para.last_coupon_date = 0;
+ret_dates               = cell(no_contracts,1);
+ret_values              = cell(no_contracts,1);
+ret_interest_values     = cell(no_contracts,1);
+ret_principal_values    = cell(no_contracts,1);
+accrued_interest        = cell(no_contracts,1);
+last_coupon_date        = cell(no_contracts,1);
+for cc = 1:1:no_contracts
+    % ####################   Calculate Final Cash Flow values  #################   
+    tmp_para = get_final_cf_values(para{cc});
+
+    % ######################   Calculate Accrued Interest  #####################   
+    tmp_para.accrued_interest  = tmp_para.ret_interest_values(:,end);
+    tmp_para.last_coupon_date = 0;
+
+    % #################   prepare main function return values  #################   
+    ret_dates{cc}               = tmp_para.ret_dates;
+    ret_values{cc}              = tmp_para.ret_values;
+    ret_interest_values{cc}     = tmp_para.ret_interest_values;
+    ret_principal_values{cc}    = tmp_para.ret_principal_values;
+    last_coupon_date{cc}        = tmp_para.last_coupon_date;
+    accrued_interest{cc}        = tmp_para.accrued_interest;
+end
 
-% ###################   prepare main function return values  ###################   
-ret_dates               = para.ret_dates;
-ret_values              = para.ret_values;
-ret_interest_values     = para.ret_interest_values;
-ret_principal_values    = para.ret_principal_values;
-last_coupon_date        = para.last_coupon_date;
-accrued_interest        = para.accrued_interest;
+if ~( batch_flag )
+    ret_dates               = ret_dates{1};
+    ret_values              = ret_values{1};
+    ret_interest_values     = ret_interest_values{1};
+    ret_principal_values    = ret_principal_values{1};
+    last_coupon_date        = last_coupon_date{1};
+    accrued_interest        = accrued_interest{1};
+end
 
 end % end of main function
 
@@ -100,80 +141,24 @@ end % end of main function
 % final cash flow date rollout function
 function para = get_cf_dates(para)
     
-% Cash flow date calculation:
+% Cash flow date calculation (backward, forward or zero coupon generation,
+% long / short first and last period and business day adjustment are
+% done in compiled function cf_dates_cpp):
     issuevec = datevec_fast(para.issuedatenum);
-    todayvec = datevec_fast(para.valuation_date);
     matvec = datevec_fast(para.maturitydatenum);
-    % cashflow rollout: method backwards
-    if ( strcmpi(para.coupon_generation_method,'backward') )
-        cf_date = matvec;
-        cf_dates = cf_date;
-        cfdatenum = para.maturitydatenum;
-        mult = 0;
-        while cfdatenum >= para.issuedatenum
-            mult += 1;
-            [cfdatenum cf_date] = addtodatefinancial(para.maturitydatenum, -para.term * mult, para.term_unit);
-            if cfdatenum >= para.issuedatenum
-                cf_dates = [cf_dates ; cf_date];
-            end
-        end % end coupon generation backward
-        % flip cf_date vector (since backward has reverse order)
-        cf_dates = flipud(cf_dates);
-
-    % cashflow rollout: method forward
-    elseif ( strcmpi(para.coupon_generation_method,'forward') )
-        cf_date = issuevec;
-        cf_dates = cf_date;
-        cfdatenum = para.issuedatenum;
-        mult = 0;
-        while cfdatenum <= para.maturitydatenum
-            mult += 1;
-            [cfdatenum cf_date] = addtodatefinancial(para.issuedatenum, para.term * mult, para.term_unit);
-            if ( cfdatenum <= para.maturitydatenum)
-                cf_dates = [cf_dates ; cf_date];
-            end
-        end        % end coupon generation forward
-
-    % cashflow rollout: method zero
-    elseif ( strcmpi(para.coupon_generation_method,'zero'))
-        % rollout for zero coupon bonds -> just one cashflow at maturity
-            cf_dates = [issuevec ; matvec];
-    end 
-
-    % Adjust first and last coupon period to implement issue date:
-    if (para.long_first_period == true)
-        if ( datenum(cf_dates(1,:)) > para.issuedatenum )
-            cf_dates(1,:) = issuevec;
-        end
-    else
-        if ( datenum(cf_dates(1,:)) > para.issuedatenum )
-            cf_dates = [issuevec;cf_dates];
-        end
-    end
-    if (para.long_last_period == true)
-        if ( datenum(cf_dates(rows(cf_dates),:)) < para.maturitydatenum )
-            cf_dates(rows(cf_dates),:) = matvec;
-        end
-    else
-        if ( datenum(cf_dates(rows(cf_dates),:)) < para.maturitydatenum )
-            cf_dates = [cf_dates;matvec];
-        end
-    end
-    %special case: long_last_period == long_first_period == true || only one cashflow (e.g. monthly term):
-    if (rows(cf_dates) == 1)
-       cf_dates = [issuevec;matvec];
-    end
-
-    % one time and forever: get datenum of cf_dates
-    cf_datesnum = datenum_fast(cf_dates);
     if ( para.enable_business_day_rule == true)
-        cf_business_datesnum = busdate(cf_datesnum-1 + para.business_day_rule, ...
-                                            para.business_day_direction);
-        cf_business_dates = datevec(cf_business_datesnum);
+        hol = holidays(para.issuedatenum - 10, para.maturitydatenum + 10);
     else
-        cf_business_datesnum = cf_datesnum;
-        cf_business_dates = cf_dates;
+        hol = [];
     end
+    [cf_datesnum cf_dates cf_business_datesnum cf_business_dates] = ...
+                    cf_dates_cpp(para.issuedatenum, para.maturitydatenum, ...
+                            para.term, para.term_unit, ...
+                            para.coupon_generation_method, ...
+                            para.long_first_period, para.long_last_period, ...
+                            para.enable_business_day_rule, ...
+                            para.business_day_rule, ...
+                            para.business_day_direction, hol);
 
     % store return values in para struct
     para.cf_dates               = cf_dates;
@@ -367,29 +352,9 @@ end
 % ##############################################################################
 function para = get_cfvalues_GOVPEN(valuation_date, value_type, para, instrument, iec, longev, longev_widow)
 
-    d1 = para.cf_datesnum(1:length(para.cf_datesnum)-1);
-    d2 = para.cf_datesnum(2:length(para.cf_datesnum));
-
+	no_contracts = numel(para);
 	year_valdate = datevec(valuation_date)(1);
-	birthyear = instrument.year_of_birth - instrument.mortality_shift_years;
-	age_valdate = year_valdate - birthyear;
-	
-	if instrument.widow_pension_flag == true
-		birthyear_widow = instrument.year_of_birth_widow - instrument.mortality_shift_years_widow;
-		age_valdate_widow = year_valdate - birthyear_widow;
-	end
-	
-	% get expense payment dates only in the past up to age 120:
-	pensiondates = para.cf_datesnum(para.cf_datesnum >= valuation_date);
 	[yy tmp_mm tmp_dd] = datevec(valuation_date);
-    new_yy = birthyear + 120;
-    max_date =   datenum([new_yy tmp_mm tmp_dd]);
-    pensiondates = pensiondates(para.cf_datesnum <= max_date);
-        	
-	% calculate expense values per expdate
-	yearly_pension_value = instrument.pension_scores * ...
-				instrument.value_per_score * (1 - instrument.tax_rate) * 12;
-	pension_values = ones(1,length(pensiondates)) * yearly_pension_value;
 	
 	% get survival probabilities and extend until age 120
 	survival_probs = longev.get('rates_base');
@@ -401,8 +366,11 @@ function para = get_cfvalues_GOVPEN(valuation_date, value_type, para, instrument
 		survival_years = [survival_years,delta_years];
 	end
 	
-	
-	if instrument.widow_pension_flag == true	% widow
+	% contracts without widow pension are calculated with widow rate zero
+	survival_probs_widow = survival_probs;
+	survival_years_widow = survival_years;
+	widow_flags = cellfun(@(x) x.widow_pension_flag == true, instrument);
+	if any(widow_flags)	% widow
 		% get survival probabilities and extend until age 120
 		survival_probs_widow = longev_widow.get('rates_base');
 		survival_years_widow = longev_widow.get('nodes');
@@ -415,78 +383,74 @@ function para = get_cfvalues_GOVPEN(valuation_date, value_type, para, instrument
 		
 	end
 	
-	ier = iec.getRate(value_type,1);
-	ret_values = zeros(rows(ier),length(pensiondates));
-	for ii=1:1:length(pensiondates)
-		% adjust expense values for inflation
-		term_days = pensiondates(ii) - valuation_date;
-		ier = iec.getRate(value_type,term_days);
-		infl_factor = 1 ./ discount_factor(valuation_date, pensiondates(ii), ier, ...
-                                iec.compounding_type, iec.day_count_convention, ...
-                                iec.compounding_freq);
-        % adjust expense values for mortality
-        year_cf = datevec(pensiondates(ii))(1);
-        age_cf = year_cf - birthyear;
-        survival_years_tmp = survival_years(survival_years>age_valdate);
-        survival_probs_tmp = survival_probs(survival_years>age_valdate);
-        survival_years_tmp = survival_years_tmp(survival_years_tmp<=age_cf);
-        survival_probs_tmp = survival_probs_tmp(survival_years_tmp<=age_cf);
-        cum_survival = prod(survival_probs_tmp,2) ;                              
-		ret_values(:,ii) = cum_survival .* infl_factor .* pension_values(ii);
+	% pension dates, values and ages of all contracts
+	pensiondates = cell(no_contracts,1);
+	pension_values = cell(no_contracts,1);
+	age_cf = cell(no_contracts,1);
+	age_cf_widow = cell(no_contracts,1);
+	age_valdate = zeros(no_contracts,1);
+	age_valdate_widow = zeros(no_contracts,1);
+	widow_rate = zeros(no_contracts,1);
+	for cc = 1:1:no_contracts
+		tmp_instr = instrument{cc};
+		cf_datesnum = para{cc}.cf_datesnum;
+		birthyear = tmp_instr.year_of_birth - tmp_instr.mortality_shift_years;
+		age_valdate(cc) = year_valdate - birthyear;
 		
-		% adjust for widow pension:
-		if instrument.widow_pension_flag == true
-			age_cf_widow = year_cf - birthyear_widow;
-			survival_years_tmp = survival_years_widow(survival_years_widow>age_valdate_widow);
-			survival_probs_tmp = survival_probs_widow(survival_years_widow>age_valdate_widow);
-			survival_years_tmp = survival_years_tmp(survival_years_tmp<=age_cf_widow);
-			survival_probs_tmp = survival_probs_tmp(survival_years_tmp<=age_cf_widow);
-			cum_survival_widow = prod(survival_probs_tmp,2);
-			widow_pension = instrument.widow_pension_rate .* (1-cum_survival) ...
-						.* cum_survival_widow .* infl_factor .* pension_values(ii);
-			ret_values(:,ii) = 	ret_values(:,ii) + 	widow_pension;	
+		% get expense payment dates only in the past up to age 120:
+		tmp_dates = cf_datesnum(cf_datesnum >= valuation_date);
+		new_yy = birthyear + 120;
+		max_date =   datenum([new_yy tmp_mm tmp_dd]);
+		tmp_dates = tmp_dates(cf_datesnum <= max_date);
+		pensiondates{cc} = tmp_dates(:);
+		
+		% calculate expense values per expdate
+		yearly_pension_value = tmp_instr.pension_scores * ...
+					tmp_instr.value_per_score * (1 - tmp_instr.tax_rate) * 12;
+		pension_values{cc} = ones(length(tmp_dates),1) * yearly_pension_value;
+		age_cf{cc} = datevec(tmp_dates)(:,1) - birthyear;
+		age_cf_widow{cc} = age_cf{cc};
+		age_valdate_widow(cc) = age_valdate(cc);
+		if tmp_instr.widow_pension_flag == true
+			birthyear_widow = tmp_instr.year_of_birth_widow - tmp_instr.mortality_shift_years_widow;
+			age_valdate_widow(cc) = year_valdate - birthyear_widow;
+			age_cf_widow{cc} = age_cf{cc} + birthyear - birthyear_widow;
+			widow_rate(cc) = tmp_instr.widow_pension_rate;
 		end
 	end
-
-	cf_interest = zeros(rows(ret_values),columns(ret_values));
-    cf_principal = ret_values;
-    
-    % return struct
-    para.ret_values     = ret_values;
-    para.cf_interest    = cf_interest;
-    para.cf_principal   = cf_principal;
+	row_ptr = [0;cumsum(cellfun(@numel,pensiondates))];
+	pensiondates = vertcat(pensiondates{:});
+	
+	% adjust pension values for inflation and mortality (and widow pension)
+	% for all contracts, scenarios and pension dates in one call
+	[infl_rates infl_weights] = get_infl_weights(iec, value_type, ...
+								pensiondates - valuation_date);
+	tf_infl = timefactor(valuation_date, pensiondates, ...
+								get_basis(iec.day_count_convention));
+	ret_values = rollout_retail_cpp(infl_rates, infl_weights, tf_infl, ...
+				iec.compounding_type, iec.compounding_freq, ...
+				vertcat(pension_values{:}), vertcat(age_cf{:}), ...
+				survival_years, survival_probs, age_valdate, widow_rate, ...
+				vertcat(age_cf_widow{:}), survival_years_widow, ...
+				survival_probs_widow, age_valdate_widow, row_ptr);
+
+	% return struct
+	for cc = 1:1:no_contracts
+		tmp_values = ret_values(:,row_ptr(cc)+1:row_ptr(cc+1));
+		para{cc}.ret_values     = tmp_values;
+		para{cc}.cf_interest    = zeros(rows(tmp_values),columns(tmp_values));
+		para{cc}.cf_principal   = tmp_values;
+	end
 	
 end       
         
 % ##############################################################################
 function para = get_cfvalues_RETEXP(valuation_date, value_type, para, instrument, iec, longev)
 
-    d1 = para.cf_datesnum(1:length(para.cf_datesnum)-1);
-    d2 = para.cf_datesnum(2:length(para.cf_datesnum));
-
+	no_contracts = numel(para);
 	year_valdate = datevec(valuation_date)(1);
-	birthyear = instrument.year_of_birth - instrument.mortality_shift_years;
-	age_valdate = year_valdate - birthyear;
-	infl_exp_adj_factor = 1.0; % TODO: infl_exp_adj_factor = instrument.infl_exp_adj_factor;
-    
-	% get expense payment dates only in the past:
-	expdates = para.cf_datesnum(para.cf_datesnum >= valuation_date);
 	[yy tmp_mm tmp_dd] = datevec(valuation_date);
-	new_yy = birthyear + 120;
-    max_date =   datenum([new_yy tmp_mm tmp_dd]);
-    expdates = expdates(para.cf_datesnum <= max_date);
-    
-	% calculate expense values per expdate
-	if isempty(instrument.expense_values)
-		error('rollout_retail_cashflows: no expenses set.');
-	else
-		expense_values = zeros(rows(expdates),1);
-		exp_change_dates = datenum(instrument.expense_dates);
-		for kk=1:1:length(exp_change_dates)
-			exp_chg_date = exp_change_dates(kk);
-			expense_values(expdates>=exp_chg_date) = instrument.expense_values(kk);
-		end
-	end
+	infl_exp_adj_factor = 1.0; % TODO: infl_exp_adj_factor = instrument.infl_exp_adj_factor;
 	
 	% get survival probabilities and extend until age 120
 	survival_probs = longev.get('rates_base');
@@ -498,175 +462,264 @@ function para = get_cfvalues_RETEXP(valuation_date, value_type, para, instrument
 	survival_probs = [survival_probs,delta_probs];
 	survival_years = [survival_years,delta_years];
 	
+	% expense dates, values and ages of all contracts
+	expdates = cell(no_contracts,1);
+	expense_values = cell(no_contracts,1);
+	age_cf = cell(no_contracts,1);
+	age_valdate = zeros(no_contracts,1);
+	for cc = 1:1:no_contracts
+		tmp_instr = instrument{cc};
+		cf_datesnum = para{cc}.cf_datesnum;
+		birthyear = tmp_instr.year_of_birth - tmp_instr.mortality_shift_years;
+		age_valdate(cc) = year_valdate - birthyear;
+    
+		% get expense payment dates only in the past:
+		tmp_dates = cf_datesnum(cf_datesnum >= valuation_date);
+		new_yy = birthyear + 120;
+		max_date =   datenum([new_yy tmp_mm tmp_dd]);
+		tmp_dates = tmp_dates(cf_datesnum <= max_date);
+		expdates{cc} = tmp_dates(:);
+    
+		% calculate expense values per expdate
+		if isempty(tmp_instr.expense_values)
+			error('rollout_retail_cashflows: no expenses set.');
+		else
+			tmp_values = zeros(rows(tmp_dates),1);
+			exp_change_dates = datenum(tmp_instr.expense_dates);
+			for kk=1:1:length(exp_change_dates)
+				exp_chg_date = exp_change_dates(kk);
+				tmp_values(tmp_dates>=exp_chg_date) = tmp_instr.expense_values(kk);
+			end
+			expense_values{cc} = tmp_values;
+		end
+		age_cf{cc} = datevec(tmp_dates)(:,1) - birthyear;
+	end
+	row_ptr = [0;cumsum(cellfun(@numel,expdates))];
+	expdates = vertcat(expdates{:});
 	
-	
-	ier = iec.getRate(value_type,1);
-	ret_values = zeros(rows(ier),length(expdates));
-	for ii=1:1:length(expdates)
-		% adjust expense values for inflation
-		term_days = expdates(ii) - valuation_date;
-		ier = iec.getRate(value_type,term_days) .* infl_exp_adj_factor; % TODO: give possibility to adjust / scale inflation rates of expenses relative to inflation expectation curve (for e.g. account for differences in personal expense inflation vs.consumer price index development 
-		infl_factor = 1 ./ discount_factor(valuation_date, expdates(ii), ier, ...
-                                iec.compounding_type, iec.day_count_convention, ...
-                                iec.compounding_freq);
-        % adjust expense values for mortality
-        year_cf = datevec(expdates(ii))(1);
-        age_cf = year_cf - birthyear;
-        survival_years_tmp = survival_years(survival_years>age_valdate);
-        survival_probs_tmp = survival_probs(survival_years>age_valdate);
-        survival_years_tmp = survival_years_tmp(survival_years_tmp<=age_cf);
-        survival_probs_tmp = survival_probs_tmp(survival_years_tmp<=age_cf);
-        cum_survival = prod(survival_probs_tmp,2);                                
-		ret_values(:,ii) = cum_survival .* infl_factor .* expense_values(ii);
+	% adjust expense values for inflation and mortality for all contracts,
+	% scenarios and expense dates in one call
+	% TODO: give possibility to adjust / scale inflation rates of expenses 
+	% relative to inflation expectation curve (for e.g. account for differences
+	% in personal expense inflation vs.consumer price index development 
+	[infl_rates infl_weights] = get_infl_weights(iec, value_type, ...
+								expdates - valuation_date);
+	infl_rates = infl_rates .* infl_exp_adj_factor;
+	tf_infl = timefactor(valuation_date, expdates, ...
+								get_basis(iec.day_count_convention));
+	age_cf = vertcat(age_cf{:});
+	ret_values = rollout_retail_cpp(infl_rates, infl_weights, tf_infl, ...
+				iec.compounding_type, iec.compounding_freq, ...
+				vertcat(expense_values{:}), age_cf, survival_years, ...
+				survival_probs, age_valdate, 0.0, age_cf, survival_years, ...
+				survival_probs, age_valdate, row_ptr);
+
+	% return struct
+	for cc = 1:1:no_contracts
+		tmp_values = ret_values(:,row_ptr(cc)+1:row_ptr(cc+1));
+		para{cc}.ret_values     = tmp_values;
+		para{cc}.cf_interest    = zeros(rows(tmp_values),columns(tmp_values));
+		para{cc}.cf_principal   = tmp_values;
 	end
-
-	cf_interest = zeros(rows(ret_values),columns(ret_values));
-    cf_principal = ret_values;
-    
-    % return struct
-    para.ret_values     = ret_values;
-    para.cf_interest    = cf_interest;
-    para.cf_principal   = cf_principal;
 	
 end
 % ##############################################################################
 function para = get_cfvalues_RETAIL(valuation_date, value_type, para, instrument)
 
-    d1 = para.cf_datesnum(1:length(para.cf_datesnum)-1);
-    d2 = para.cf_datesnum(2:length(para.cf_datesnum));
-
-	% get savings payment dates only in the past:
-	savdates = para.cf_datesnum(para.cf_datesnum <= valuation_date);
-	
-	% calculate savings rate vec
-	if isempty(instrument.savings_change_values)
-		savings_rate = instrument.savings_rate;
-	else
-		savings_rate = zeros(rows(savdates),1);
-		sav_change_dates = datenum(instrument.savings_change_dates);
-		for kk=1:1:length(sav_change_dates)
-			sav_chg_date = sav_change_dates(kk);
-			savings_rate(savdates>=sav_chg_date) = instrument.savings_change_values(kk);
+	no_contracts = numel(para);
+	% savings payments of all contracts (packed with row_ptr)
+	pay_dates = cell(no_contracts,1);
+	pay_values = cell(no_contracts,1);
+	maturity_dates = cell(no_contracts,1);
+	redemption_dates_put = cell(no_contracts,1);
+	savings_rates = cell(no_contracts,1);
+	redemption_date = zeros(no_contracts,1);
+	coupon_rate = zeros(no_contracts,1);
+	comp_type = zeros(no_contracts,1);
+	comp_freq = zeros(no_contracts,1);
+	basis = zeros(no_contracts,1);
+	bonus_current = zeros(no_contracts,1);
+	bonus_redemption = zeros(no_contracts,1);
+	for cc = 1:1:no_contracts
+		tmp_instr = instrument{cc};
+		cf_datesnum = para{cc}.cf_datesnum;
+		
+		% get savings payment dates only in the past:
+		savdates = cf_datesnum(cf_datesnum <= valuation_date);
+		
+		% calculate savings rate vec
+		if isempty(tmp_instr.savings_change_values)
+			savings_rate = tmp_instr.savings_rate;
+		else
+			savings_rate = zeros(rows(savdates),1);
+			sav_change_dates = datenum(tmp_instr.savings_change_dates);
+			for kk=1:1:length(sav_change_dates)
+				sav_chg_date = sav_change_dates(kk);
+				savings_rate(savdates>=sav_chg_date) = tmp_instr.savings_change_values(kk);
+			end
 		end
+		savings_rates{cc} = savings_rate;
+		tmp_dates = savdates(:);
+		tmp_values = ones(length(tmp_dates),1) .* savings_rate(:);
+		
+		% take into account extra payments and redemption option
+		redemption_date(cc) = valuation_date;
+		if strcmpi(tmp_instr.sub_type,'SAVPLAN')
+			redemption_date(cc) = addtodatefinancial(valuation_date, ...
+						tmp_instr.notice_period, tmp_instr.notice_period_unit);
+			% take into account extra payments:
+			extra_dates = datenum(tmp_instr.extra_payment_dates);
+			if ~(length(extra_dates) == length(tmp_instr.extra_payment_values) )
+				error('rollout_structured_cashflows: length of extra payments and dates dont match for >>%s<<',tmp_instr.id);
+			end
+			extra_dates = reshape(extra_dates,numel(extra_dates),1);
+			extra_values = reshape(tmp_instr.extra_payment_values,numel(extra_dates),1);
+			tmp_dates = [tmp_dates;extra_dates(extra_dates <= valuation_date)];
+			tmp_values = [tmp_values;extra_values(extra_dates <= valuation_date)];
+			bonus_current(cc) = tmp_instr.bonus_value_current;
+			bonus_redemption(cc) = tmp_instr.bonus_value_redemption;
+		end
+		pay_dates{cc} = tmp_dates;
+		pay_values{cc} = tmp_values;
+		maturity_date = tmp_instr.maturity_date;
+		if ( ischar(maturity_date) )
+			maturity_date = datenum(maturity_date,1);
+		end
+		maturity_dates{cc} = repmat(maturity_date,length(tmp_dates),1);
+		redemption_dates_put{cc} = repmat(redemption_date(cc),length(tmp_dates),1);
+		coupon_rate(cc) = para{cc}.coupon_rate;
+		comp_type(cc) = get_convention_num('compounding_type',para{cc}.compounding_type);
+		comp_freq(cc) = get_convention_num('compounding_freq',para{cc}.compounding_freq);
+		basis(cc) = get_convention_num('basis',para{cc}.dcc);
 	end
-	% calculate interest an principal cf values
-	int_cf_values = ((1 ./ discount_factor(savdates, instrument.maturity_date, para.coupon_rate, ...
-                                para.compounding_type, para.dcc, ...
-                                para.compounding_freq))-1) .* savings_rate;
-	princ_cf_values = ones(length(int_cf_values),1) .* savings_rate;
+	no_pay = cellfun(@numel,pay_dates);
+	row_ptr = [0;cumsum(no_pay)];
+	pay_dates = vertcat(pay_dates{:});
+	maturity_dates = vertcat(maturity_dates{:});
+	redemption_dates_put = vertcat(redemption_dates_put{:});
 	
-	% sum up all future values of cash flows
-	cf_interest = sum(int_cf_values);
-	cf_principal = sum(princ_cf_values);
+	% time factors from payment dates until maturity and redemption date
+	basis_pay = zeros(row_ptr(end),1);
+	for cc = 1:1:no_contracts
+		basis_pay(row_ptr(cc)+1:row_ptr(cc+1)) = basis(cc);
+	end
+	tf_maturity = zeros(row_ptr(end),1);
+	tf_redemption = zeros(row_ptr(end),1);
+	for bb = unique(basis_pay)'
+		idx = (basis_pay == bb);
+		tf_maturity(idx) = timefactor(pay_dates(idx),maturity_dates(idx),bb);
+		tf_redemption(idx) = timefactor(pay_dates(idx),redemption_dates_put(idx),bb);
+	end
 	
-	% take into account extra payments and redemption option
-	if strcmpi(instrument.sub_type,'SAVPLAN')
-		% calculate interest an principal cf values
-		[redemption_date] = addtodatefinancial(valuation_date, ...
-						instrument.notice_period, instrument.notice_period_unit);
-		% putable cashflows
-		int_cf_values_putable = ((1 ./ discount_factor(savdates, redemption_date, para.coupon_rate, ...
-									para.compounding_type, para.dcc, ...
-									para.compounding_freq))-1) .* savings_rate;
-		
-		% sum up all future values of cash flows
-		cf_interest_putable = sum(int_cf_values_putable);
-		
-		% take into account extra payments:
-		extra_dates = datenum(instrument.extra_payment_dates);
-		if ~(length(extra_dates) == length(instrument.extra_payment_values) )
-			error('rollout_structured_cashflows: length of extra payments and dates dont match for >>%s<<',instrument.id);
-		end
-
-		for kk=1:1:length(extra_dates)
-			tmp_date = extra_dates(kk);
-			if (tmp_date <= valuation_date)
-				tmp_val = instrument.extra_payment_values(kk);
-				cf_interest = cf_interest + ((1 ./ discount_factor(tmp_date, ...
-									instrument.maturity_date,  ...
-									para.coupon_rate,para.compounding_type, para.dcc, ...
-									para.compounding_freq))-1) .* tmp_val;
-				cf_principal = cf_principal + tmp_val;   
-				% putable cashflows
-				cf_interest_putable = cf_interest_putable + ((1 ./ discount_factor(tmp_date, redemption_date,  ...
-									para.coupon_rate,para.compounding_type, para.dcc, ...
-									para.compounding_freq))-1) .* tmp_val;
-			end             
+	% interest and principal of all savings payments of all contracts
+	[cf_interest_all cf_principal_all cf_interest_putable_all] = ...
+				rollout_savings_cpp(row_ptr, vertcat(pay_values{:}), ...
+				tf_maturity, tf_redemption, coupon_rate, comp_type, comp_freq, ...
+				bonus_current, bonus_redemption);
+	
+	for cc = 1:1:no_contracts
+		tmp_instr = instrument{cc};
+		cf_interest = cf_interest_all(cc);
+		cf_principal = cf_principal_all(cc);
+		if strcmpi(tmp_instr.sub_type,'SAVPLAN')
+			cf_interest_putable = cf_interest_putable_all(cc);
+			cf_principal_putable = cf_principal;
+			tmp_redemption_date = redemption_date(cc);
+		elseif strcmpi(tmp_instr.sub_type,'DCP')
+			[tmp_redemption_date cf_principal_putable] = get_dcp_redemption_value( ...
+					valuation_date, para{cc}, tmp_instr, savings_rates{cc});
+			cf_interest_putable = 0.0;
 		end
+		ret_values_putable = cf_interest_putable + cf_principal_putable;
+		ret_values = ones(rows(ret_values_putable),1) .* (cf_interest + cf_principal);
+		cf_principal =  ones(rows(ret_values_putable),1)  .* cf_principal;
 		
-		% pay out bonus interests
-		cf_interest = cf_interest + cf_interest * instrument.bonus_value_current;
-		cf_interest_putable = cf_interest_putable + cf_interest_putable * instrument.bonus_value_redemption;
-		cf_principal_putable = cf_principal;
-	elseif strcmpi(instrument.sub_type,'DCP')
-		% take into account redemption values at next redemption date
-		if ~isempty(instrument.redemption_dates)
-		  redemption_dates 	= datenum(instrument.redemption_dates) - valuation_date;
-		  redemption_values 	= instrument.redemption_values;
-		  redemption_date_future = redemption_dates(redemption_dates>0);
-		  if ~isempty(redemption_date_future)		
-			redemption_date = valuation_date + redemption_date_future(1); 
-			redemption_dates(redemption_dates<0)=0;
-			redemption_value = interpolate_curve(redemption_dates', ...
-							redemption_values,1,'next');
-			% get PV of future savings and deduct FV from redemption value 
-			future_payment_days = para.cf_datesnum(para.cf_datesnum>valuation_date);
-			future_payment_days = future_payment_days(future_payment_days<=redemption_date);
-			% FV discount factor
-			fv_rate = interpolate_curve(para.tmp_nodes,para.tmp_rates, ...
-						redemption_date-valuation_date,para.method_interpolation);
-			fv_df = (1 ./ discount_factor(valuation_date, redemption_date, fv_rate, ...
-									para.compounding_type, para.dcc, ...
-									para.compounding_freq));
-			% get DF of	future_payment_days	
-			adj_red_value = 0;
-			for kk=1:1:length(future_payment_days)
-				tmp_date = future_payment_days(kk);
-				tmp_node = tmp_date-valuation_date;
-				pv_rate = interpolate_curve(para.tmp_nodes,para.tmp_rates, ...
-						tmp_node,para.method_interpolation);
-                    
-				pv_df = (discount_factor(valuation_date, tmp_date, pv_rate, ...
-									para.compounding_type, para.dcc, ...
-									para.compounding_freq)) ;										
-				adj_red_value = adj_red_value + pv_df .* fv_df .* savings_rate(end);
-			end
-		  end		
+		% only final cash flow at maturity date
+		tmp_para = para{cc};
+		tmp_para.cf_dates    = [tmp_para.issuevec;datevec(tmp_redemption_date);datevec(tmp_instr.maturity_date)];
+		tmp_para.cf_datesnum = datenum(tmp_para.cf_dates);
+		% update business date
+		if ( tmp_para.enable_business_day_rule == true)
+			tmp_para.cf_business_dates = datevec(busdate(tmp_para.cf_datesnum-1 + tmp_para.business_day_rule, ...
+										tmp_para.business_day_direction));
+			tmp_para.cf_business_datesnum = datenum(tmp_para.cf_business_dates);   
 		else
-			% floor: value of instrument cannot be negative
-			redemption_date  = valuation_date;
-			redemption_value = 0.0;
-			adj_red_value = 0.0;
+			tmp_para.cf_business_datesnum = tmp_para.cf_datesnum;
+			tmp_para.cf_business_dates = tmp_para.cf_dates;
 		end
-				
-		% sum up all future values of cash flows
-		cf_interest_putable = 0.0;
-		cf_principal_putable = redemption_value - adj_red_value;
+		
+		% return struct: first column cashflows at redemption date, second column at maturity date
+		tmp_para.ret_values     = [ret_values_putable,ret_values];
+		tmp_para.cf_interest    = [cf_interest_putable,cf_interest];
+		tmp_para.cf_principal   = [cf_principal_putable,cf_principal];
+		para{cc} = tmp_para;
 	end
-	ret_values_putable = cf_interest_putable + cf_principal_putable;
-	ret_values = ones(rows(ret_values_putable),1) .* (cf_interest + cf_principal);
-	cf_principal =  ones(rows(ret_values_putable),1)  .* cf_principal;
-	
-    % only final cash flow at maturity date
-    para.cf_dates    = [para.issuevec;datevec(redemption_date);datevec(instrument.maturity_date)];
-    para.cf_datesnum = datenum(para.cf_dates);
-    % update business date
-    if ( para.enable_business_day_rule == true)
-        para.cf_business_dates = datevec(busdate(para.cf_datesnum-1 + para.business_day_rule, ...
-                                    para.business_day_direction));
-        para.cf_business_datesnum = datenum(para.cf_business_dates);   
-    else
-        para.cf_business_datesnum = para.cf_datesnum;
-        para.cf_business_dates = para.cf_dates;
-    end
-    
-    % return struct: first column cashflows at redemption date, second column at maturity date
-    para.ret_values     = [ret_values_putable,ret_values];
-    para.cf_interest    = [cf_interest_putable,cf_interest];
-    para.cf_principal   = [cf_principal_putable,cf_principal];
 end % end get_cfvalues_RETAIL
 
+% ##############################################################################
+% DCP: redemption value at next redemption date less future value of all
+% savings payments until the redemption date
+function [redemption_date cf_principal_putable] = get_dcp_redemption_value( ...
+					valuation_date, para, instrument, savings_rate)
+	% take into account redemption values at next redemption date
+	if ~isempty(instrument.redemption_dates)
+	  redemption_dates 	= datenum(instrument.redemption_dates) - valuation_date;
+	  redemption_values 	= instrument.redemption_values;
+	  redemption_date_future = redemption_dates(redemption_dates>0);
+	  if ~isempty(redemption_date_future)		
+		redemption_date = valuation_date + redemption_date_future(1); 
+		redemption_dates(redemption_dates<0)=0;
+		redemption_value = interpolate_curve(redemption_dates', ...
+						redemption_values,1,'next');
+		% get PV of future savings and deduct FV from redemption value 
+		future_payment_days = para.cf_datesnum(para.cf_datesnum>valuation_date);
+		future_payment_days = future_payment_days(future_payment_days<=redemption_date);
+		% get DF of redemption date (FV discount factor) and sum of DF of
+		% future_payment_days (PV) for all scenarios in one call
+		adj_red_value = 0;
+		if ~isempty(future_payment_days)
+			schedule_dates = [redemption_date; future_payment_days(:)];
+			[rates_sched weights_sched] = get_curve_weights(para.tmp_nodes, ...
+					para.tmp_rates,(schedule_dates - valuation_date)', ...
+					para.method_interpolation);
+			tf_sched = timefactor(valuation_date, schedule_dates, para.dcc);
+			[pv_annuity tmp_fwd df_sched] = swap_annuity_cpp(rates_sched, ...
+					weights_sched,tf_sched,para.compounding_type, ...
+					para.compounding_freq,1);
+			fv_df = 1 ./ df_sched(:,1);
+			adj_red_value = pv_annuity .* fv_df .* savings_rate(end);
+		end
+	  end		
+	else
+		% floor: value of instrument cannot be negative
+		redemption_date  = valuation_date;
+		redemption_value = 0.0;
+		adj_red_value = 0.0;
+	end
+	cf_principal_putable = redemption_value - adj_red_value;
+end
 
+% ##############################################################################
+% get inflation expectation rates and interpolation weights of curve nodes at
+% all payment dates (rates * weights are the interpolated rates). Without
+% weights (empty) the rates are given at all payment dates.
+function [infl_rates infl_weights] = get_infl_weights(iec, value_type, term_days)
+	interp_method = iec.get('method_interpolation');
+	term_days = reshape(term_days,1,numel(term_days));
+	if ( any(strcmpi(interp_method,{'linear','mm','constant','previous','next'})) ...
+			&& ~strcmpi(iec.get('method_extrapolation'),'linear') )
+		[infl_rates infl_weights] = get_curve_weights(iec.get('nodes'), ...
+					iec.getValue(value_type),term_days,interp_method);
+	else % conventional loop through all distinct payment dates
+		[unique_days tmp_idx idx_days] = unique(term_days);
+		unique_rates = zeros(rows(iec.getValue(value_type)),length(unique_days));
+		for ii = 1 : 1 : length(unique_days)
+			unique_rates(:,ii) = iec.getRate(value_type,unique_days(ii));
+		end
+		infl_rates = unique_rates(:,idx_days);
+		infl_weights = [];
+	end
+end
 
 %-------------------------------------------------------------------------------
 %            Custom datenum and datevec Functions 
@@ -19,7 +19,12 @@
 %# structured products like caps and floors, CM Swaps, capitalized or averaging
 %# CMS floaters or inflation linked bonds.
 %#
-%# @seealso{timefactor, discount_factor, get_forward_rate, interpolate_curve}
+%# Cash flow schedules of fixed rate bonds, zero coupon bonds and fixed
+%# amortizing bonds without prepayment do not depend on the scenario. They are
+%# stored in a cache keyed by a hash of the instrument terms and the valuation
+%# date and are reused for all further scenario sets and runs.
+%#
+%# @seealso{timefactor, discount_factor, get_forward_rate, interpolate_curve, cashflow_cache}
 %# @end deftypefn
 
 function [ret_dates ret_values ret_interest_values ret_principal_values ...
@@ -44,6 +49,26 @@ if nargin < 6
     riskfactor = [];
 end  
 
+% ######################   Get scenario independent schedules from cache  ######
+use_cache = is_scenario_independent(instrument);
+if ( use_cache == true )
+    cache_key = get_cache_key(valuation_date, instrument);
+    % terms, which can not be hashed: roll out without cache
+    use_cache = ~isempty(cache_key);
+end
+if ( use_cache == true )
+    [cache_hit entry] = cashflow_cache('get',cache_key);
+    if ( cache_hit == true )
+        ret_dates               = entry.ret_dates;
+        ret_values              = entry.ret_values;
+        ret_interest_values     = entry.ret_interest_values;
+        ret_principal_values    = entry.ret_principal_values;
+        last_coupon_date        = entry.last_coupon_date;
+        accrued_interest        = entry.accrued_interest;
+        return;
+    end
+end
+
 % ######################   Initial fill of para structure ###################### 
 para = fill_para_struct(nargin,valuation_date, value_type, ...
                     instrument, ref_curve, surface,riskfactor);
@@ -127,8 +152,82 @@ ret_principal_values    = para.ret_principal_values;
 last_coupon_date        = para.last_coupon_date;
 accrued_interest        = para.accrued_interest;
 
+if ( use_cache == true )
+    entry = struct();
+    entry.ret_dates             = ret_dates;
+    entry.ret_values            = ret_values;
+    entry.ret_interest_values   = ret_interest_values;
+    entry.ret_principal_values  = ret_principal_values;
+    entry.last_coupon_date      = last_coupon_date;
+    entry.accrued_interest      = accrued_interest;
+    cashflow_cache('set',cache_key,entry);
+end
+
 end % end of main function
 
+% ##############################################################################
+% cash flows of fixed rate bonds, zero coupon bonds and fixed amortizing bonds
+% without prepayment are equal for all scenarios
+function retval = is_scenario_independent(instrument)
+    retval = false;
+    if ~( isobject(instrument) || isstruct(instrument) )
+        return;
+    end
+    if ( any(strcmpi(instrument.sub_type,{'FRB','SWAP_FIXED','ZCB'})) )
+        retval = true;
+    elseif ( strcmpi(instrument.sub_type,'FAB') ...
+            && ~( has_term(instrument,'prepayment_flag') ...
+                    && instrument.prepayment_flag == true ) )
+        retval = true;
+    end
+end
+
+% ##############################################################################
+% instrument structs do not contain all attributes of instrument objects
+function retval = has_term(instrument, term_field)
+    if ( isstruct(instrument) )
+        retval = isfield(instrument,term_field);
+    else
+        retval = isprop(instrument,term_field);
+    end
+end
+
+% ##############################################################################
+% hash of all instrument terms, which are used in the cash flow rollout
+function cache_key = get_cache_key(valuation_date, instrument)
+    persistent term_fields = {'sub_type','issue_date','maturity_date', ...
+            'compounding_type','compounding_freq','day_count_convention', ...
+            'basis','coupon_rate','coupon_generation_method', ...
+            'notional_at_start','notional_at_end','business_day_rule', ...
+            'business_day_direction','enable_business_day_rule', ...
+            'long_first_period','long_last_period','spread','in_arrears', ...
+            'notional','term','term_unit','prorated','fixed_annuity', ...
+            'use_principal_pmt','use_annuity_amount','annuity_amount', ...
+            'principal_payment','outstanding_balance', ...
+            'use_outstanding_balance','prepayment_flag'};
+    if ( ischar(valuation_date) )
+        valuation_date = datenum(valuation_date,1);
+    end
+    terms = sprintf('%.17g',valuation_date);
+    for ii = 1 : 1 : length(term_fields)
+        % missing terms are marked separately from empty terms
+        if ~( has_term(instrument,term_fields{ii}) )
+            terms = [terms,'|#'];
+            continue;
+        end
+        tmp_value = instrument.(term_fields{ii});
+        if ( ischar(tmp_value) )
+            terms = [terms,'|',tmp_value];
+        elseif ( isnumeric(tmp_value) || islogical(tmp_value) )
+            terms = [terms,'|',sprintf('%.17g,',double(tmp_value))];
+        else
+            cache_key = '';
+            return;
+        end
+    end
+    cache_key = hash('md5',terms);
+end
+
 % ##############################################################################
 % ##############################################################################
 
@@ -597,10 +696,6 @@ function para = get_cfvalues_FAB(valuation_date, value_type, para, instrument, r
             pp = surface;
         end
         
-        % preallocate memory
-        cf_principal_pp = zeros(rows(pp_curve_values),number_payments);
-        cf_interest_pp = zeros(rows(pp_curve_values),number_payments);
-        
         % calculate absolute IR shock from provided riskfactor curve
         if (nargin < 6 ||  ~isobject(riskfactor)) 
             abs_ir_shock = 0.0;
@@ -621,81 +716,41 @@ function para = get_cfvalues_FAB(valuation_date, value_type, para, instrument, r
         % case 1: full prepayment with rate from prepayment curve or 
         %           constant rate
         if ( strcmpi(pp_type,'full'))
-            Q_scaling = ones(rows(pp_curve_values),1);
+            % The outstanding amount recursion is done for all scenarios in
+            % compiled function rollout_prepayment_cpp. Prepayment rates
+            % are interpolated with precomputed curve weights at all terms.
             % if outstanding balance should not be used, the prepayment from
             % all cash flows since issue date are recalculated
             if ( use_outstanding_balance == 0 )
-                for ii = 1 : 1 : number_payments 
-                     % get prepayment rate at days to cashflow
-                    tmp_timestep = d2(ii) - d2(1); 
-                    % extract PSA factor from prepayment procedure               
-                    prepayment_rate = interpolate_curve(pp_curve_nodes, ...
-                                    pp_curve_values,tmp_timestep,pp_curve_interp);
-                    prepayment_rate = prepayment_rate .* prepayment_factor;
-                    % convert annualized prepayment rate
-                    lambda = ((1 ./ discount_factor (d1(ii), d2(ii), ...
-                    prepayment_rate, para.comp_type_curve, ...
-                    para.basis_curve, para.comp_freq_curve)) - 1);  
-
-                    %       (cf_principal_pp will be matrix (:,ii))
-                    cf_principal_pp(:,ii) = Q_scaling .* ( cf_principal(ii) ...
-                                        + lambda .* ( amount_outstanding_vec(ii) ...
-                                        -  cf_principal(ii ) ));
-                    cf_interest_pp(:,ii) = cf_interest(ii) .* Q_scaling;
-                    % calculate new scaling Factor
-                    Q_scaling = Q_scaling .* (1 - lambda);
-                end
+                % get prepayment rate at days to cashflow
+                [pp_rates pp_weights] = get_curve_weights(pp_curve_nodes, ...
+                                pp_curve_values, d2 - d2(1), pp_curve_interp);
+                tf_curve = timefactor(d1, d2, para.basis_curve);
+                [cf_principal_pp cf_interest_pp] = rollout_prepayment_cpp(0, ...
+                                pp_rates, pp_weights, prepayment_factor, ...
+                                tf_curve, para.comp_type_curve, ...
+                                para.comp_freq_curve, cf_principal, ...
+                                cf_interest, amount_outstanding_vec);
             % use_outstanding_balance = true: recalculate cash flow values from
             % valuation date (notional = outstanding_balance) until maturity
             % with current prepayment rates and psa factors
             else
                 out_balance = instrument.outstanding_balance;
-                % use only payment dates > valuation date  
-                original_payments = length(para.cf_dates);
-                number_payments = length(para.cf_datesnum);
                 d1 = para.cf_datesnum(1:length(para.cf_datesnum)-1);
                 d2 = para.cf_datesnum(2:length(para.cf_datesnum));
-                % preallocate memory
-                amount_outstanding_vec = zeros(rows(prepayment_factor),number_payments) ...
-                                                                + out_balance;              
-                cf_interest_pp = zeros(rows(prepayment_factor),number_payments);
-                cf_principal_pp = zeros(rows(prepayment_factor),number_payments); 
-                cf_annuity = zeros(rows(prepayment_factor),number_payments);                
+                % get prepayment rate at days to cashflow
+                [pp_rates pp_weights] = get_curve_weights(pp_curve_nodes, ...
+                                pp_curve_values, d2 - para.issuedatenum, pp_curve_interp);
+                tf_curve = timefactor(d1, d2, para.basis_curve);
+                % effective interest rate of all periods
+                eff_rate = para.coupon_rate .* timefactor(d1, d2, para.dcc);
                 % calculate all principal and interest cash flows including
                 % prepayment cashflows. use future cash flows only
-                for ii = 1 : 1 : number_payments
-                    if ( para.cf_datesnum(ii) > valuation_date)
-                        eff_notional = amount_outstanding_vec(:,ii-1);
-                         % get prepayment rate at days to cashflow
-                        tmp_timestep = d2(ii-1) - para.issuedatenum;
-                        % extract PSA factor from prepayment procedure               
-                        prepayment_rate = interpolate_curve(pp_curve_nodes, ...
-                                        pp_curve_values,tmp_timestep,pp_curve_interp);
-                        prepayment_rate = prepayment_rate .* prepayment_factor;
-                        % convert annualized prepayment rate
-                        lambda = ((1 ./ discount_factor (d1(ii-1), d2(ii-1), ...
-                                            prepayment_rate, para.comp_type_curve, ...
-                                            para.basis_curve, para.comp_freq_curve)) - 1);
-                        % calculate interest cashflow
-                        [tf dip dib] = timefactor (d1(ii-1), d2(ii-1), para.dcc);
-                        eff_rate = para.coupon_rate .* tf; 
-                        cf_interest_pp(:,ii) = eff_rate .* eff_notional;
-                        
-                        % annuity principal
-                        rem_cf = 1 + number_payments - ii;  %remaining cash flows
-                        tmp_interest = cf_interest_pp(:,ii);
-                        tmp_divisor = (1 - (1 + eff_rate) .^ (-rem_cf));
-                        cf_annuity(:,ii) = tmp_interest ./ tmp_divisor - tmp_interest;
-                        
-                        %cf_scaled_annuity = (1 - lambda) .* cf_annuity(:,ii);
-                        cf_prepayment = eff_notional .* lambda;
-                        cf_principal_pp(:,ii) = (1 - lambda) .* cf_annuity(:,ii) + cf_prepayment;
-                        %tmp_annuity = cf_annuity(:,ii)
-                        %tmp_scaled_annuity = (1 - lambda) .* tmp_annuity
-                        % calculate new amount outstanding (remaining amount >0)
-                        amount_outstanding_vec(:,ii) = max(0,eff_notional-cf_principal_pp(:,ii));
-                    end
-                end
+                [cf_principal_pp cf_interest_pp] = rollout_prepayment_cpp(1, ...
+                                pp_rates, pp_weights, prepayment_factor, ...
+                                tf_curve, para.comp_type_curve, ...
+                                para.comp_freq_curve, eff_rate, ...
+                                para.cf_datesnum > valuation_date, out_balance);
             end
         % case 2: TODO implementation
         elseif ( strcmpi(pp_type,'default'))
@@ -1303,42 +1358,54 @@ function para = get_cfvalues_FRNCAPFLOOR(valuation_date, value_type, para, instr
     d2 = para.cf_datesnum(2:length(para.cf_datesnum));
     notvec = zeros(1,length(d1));
     notvec(length(notvec)) = 1;
-    cf_values = zeros(rows(para.tmp_rates),length(d1));
-    cf_principal = zeros(rows(para.tmp_rates),length(d1));
+    no_scen = rows(para.tmp_rates);
+    cf_values = zeros(no_scen,length(d1));
+    cf_principal = zeros(no_scen,length(d1));
     [tf dip dib] = timefactor (d1, d2, para.dcc);
-    for ii = 1 : 1 : length(d1)
-        % convert dates into years from valuation date with timefactor
-        t1 = (d1(ii) - valuation_date);
-        t2 = (d2(ii) - valuation_date);
-  
-        if ( t1 >= 0 && t2 >= t1 )        % for future cash flows use forward rate
-            payment_date        = t2;
-            % adjust forward start and end date for in fine vs. in arrears
-            % TODO: Coupon_Prepay = "discount" not implemented 
-            %       (discount CF value from CF end date to CF start date)
-            if ( instrument.in_arrears == 0)    % in fine
-                fsd  = t1;
-                fed  = t2;
-                timing_adjustment = 1; % no timing adjustment required for in fine
-            else    % in arrears
-                fsd  = t2;
-                fed  = t2 + (t2 - t1);
-            end
-             % get forward rate from provided curve
-            forward_rate_curve = get_forward_rate(para.tmp_nodes,para.tmp_rates, ...
-                    fsd,fed-fsd,para.compounding_type,para.method_interpolation, ...
+    % convert dates into days from valuation date
+    t1_vec = d1 - valuation_date;
+    t2_vec = d2 - valuation_date;
+    % adjust forward start and end date for in fine vs. in arrears
+    % TODO: Coupon_Prepay = "discount" not implemented 
+    %       (discount CF value from CF end date to CF start date)
+    if ( instrument.in_arrears == 0)    % in fine
+        fsd_vec = t1_vec;
+        fed_vec = t2_vec;
+    else    % in arrears
+        fsd_vec = t2_vec;
+        fed_vec = t2_vec + (t2_vec - t1_vec);
+    end
+    % get forward rates of all future periods from provided curve in one call
+    future = ( t1_vec >= 0 & t2_vec >= t1_vec );
+    forward_rates = zeros(no_scen,length(d1));
+    if ( any(future) )
+        forward_rates(:,future) = get_forward_rate(para.tmp_nodes,para.tmp_rates, ...
+                    fsd_vec(future),fed_vec(future)-fsd_vec(future), ...
+                    para.compounding_type,para.method_interpolation, ...
                     para.compounding_freq, para.dcc, valuation_date, ...
                     para.comp_type_curve, para.basis_curve, para.comp_freq_curve,para.floor_flag);
+    end
+    capfloor_flag = (strcmpi(para.type,'CAP') || strcmpi(para.type,'FLOOR'));
+    if ( capfloor_flag )
+        % caplet / floorlet input parameters of all future periods
+        adj_rates = zeros(no_scen,length(d1));
+        sigmas = zeros(no_scen,length(d1));
+        tf_fsd = timefactor (valuation_date, valuation_date + fsd_vec, para.dcc);
+    end
+    for ii = 1 : 1 : length(d1)
+        t1 = t1_vec(ii);
+        t2 = t2_vec(ii);
+  
+        if ( future(ii) )        % for future cash flows use forward rate
+            fsd = fsd_vec(ii);
+            fed = fed_vec(ii);
+            forward_rate_curve = forward_rates(:,ii);
                         
             % calculate timing adjustment
             timing_adjustment = 1;
             if ( instrument.in_arrears == 0)    % in fine
-                fsd  = t1;
-                fed  = t2;
                 timing_adjustment = 1; % no timing adjustment required for in fine
             else    % in arrears
-                fsd  = t2;
-                fed  = t2 + (t2 - t1);
                 % for in arrears, a timing adjustment is required:
                 if ( isobject(surface))
                     % get volatility according to moneyness and term
@@ -1361,11 +1428,8 @@ function para = get_cfvalues_FRNCAPFLOOR(valuation_date, value_type, para, instr
             % adjust forward rate by timing adjustment
             forward_rate_curve = forward_rate_curve .* timing_adjustment;
             % calculate final floating cash flows
-            if (strcmpi(para.type,'CAP') || strcmpi(para.type,'FLOOR'))
-                % call function to calculate probability weighted forward rate
+            if ( capfloor_flag )
                 X = instrument.strike;  % get from strike curve ?!?
-                % calculate timefactor of forward start date
-                tf_fsd = timefactor (valuation_date, valuation_date + fsd, para.dcc);
                 % calculate moneyness 
                 if (instrument.CapFlag == true)
                     moneyness_exponent = 1;
@@ -1389,17 +1453,16 @@ function para = get_cfvalues_FRNCAPFLOOR(valuation_date, value_type, para, instr
                 else
                     adj_rate = forward_rate_curve;
                 end
-                % calculate forward rate according to CAP/FLOOR model
-                forward_rate = getCapFloorRate(instrument.CapFlag, ...
-                        adj_rate, X, tf_fsd, sigma, instrument.model);
-                % adjust forward rate to term of caplet / floorlet
-                forward_rate = forward_rate .* tf(ii);
+                % caplet / floorlet rates of all periods are calculated below
+                adj_rates(:,ii) = adj_rate;
+                sigmas(:,ii) = sigma;
+                forward_rate = 0.0;
             else % all other floating swap legs and floater
                 forward_rate = (para.spread + forward_rate_curve) .* tf(ii);
             end
         elseif ( t1 < 0 && t2 > 0 )     % if last cf date is in the past, while
                                         % next is in future, use last reset rate
-            if (strcmpi(para.type,'CAP') || strcmpi(para.type,'FLOOR'))
+            if ( capfloor_flag )
                 if instrument.CapFlag == true
                     forward_rate = max(para.last_reset_rate - instrument.strike,0) .* tf(ii);
                 else
@@ -1413,6 +1476,13 @@ function para = get_cfvalues_FRNCAPFLOOR(valuation_date, value_type, para, instr
         end
         cf_values(:,ii) = forward_rate;
     end
+    % calculate forward rates of all caplets / floorlets according to 
+    % CAP/FLOOR model and adjust to term of caplet / floorlet
+    if ( capfloor_flag && any(future) )
+        cf_values(:,future) = getCapFloorRate(instrument.CapFlag, ...
+                        adj_rates(:,future), instrument.strike, tf_fsd(future), ...
+                        sigmas(:,future), instrument.model) .* tf(future);
+    end
     ret_values = cf_values .* para.notional;
     cf_interest = ret_values;
     % Add notional payments
@@ -1756,80 +1826,24 @@ end % end function get_cfvalues_CMS_FLOATING_CAPFLOOR
 % final cash flow date rollout function
 function para = get_cf_dates(para)
     
-% Cash flow date calculation:
+% Cash flow date calculation (backward, forward or zero coupon generation,
+% long / short first and last period and business day adjustment are
+% done in compiled function cf_dates_cpp):
     issuevec = datevec_fast(para.issuedatenum);
-    todayvec = datevec_fast(para.valuation_date);
     matvec = datevec_fast(para.maturitydatenum);
-    % cashflow rollout: method backwards
-    if ( strcmpi(para.coupon_generation_method,'backward') )
-        cf_date = matvec;
-        cf_dates = cf_date;
-        cfdatenum = para.maturitydatenum;
-        mult = 0;
-        while cfdatenum >= para.issuedatenum
-            mult += 1;
-            [cfdatenum cf_date] = addtodatefinancial(para.maturitydatenum, -para.term * mult, para.term_unit);
-            if cfdatenum >= para.issuedatenum
-                cf_dates = [cf_dates ; cf_date];
-            end
-        end % end coupon generation backward
-        % flip cf_date vector (since backward has reverse order)
-        cf_dates = flipud(cf_dates);
-
-    % cashflow rollout: method forward
-    elseif ( strcmpi(para.coupon_generation_method,'forward') )
-        cf_date = issuevec;
-        cf_dates = cf_date;
-        cfdatenum = para.issuedatenum;
-        mult = 0;
-        while cfdatenum <= para.maturitydatenum
-            mult += 1;
-            [cfdatenum cf_date] = addtodatefinancial(para.issuedatenum, para.term * mult, para.term_unit);
-            if ( cfdatenum <= para.maturitydatenum)
-                cf_dates = [cf_dates ; cf_date];
-            end
-        end        % end coupon generation forward
-
-    % cashflow rollout: method zero
-    elseif ( strcmpi(para.coupon_generation_method,'zero'))
-        % rollout for zero coupon bonds -> just one cashflow at maturity
-            cf_dates = [issuevec ; matvec];
-    end 
-
-    % Adjust first and last coupon period to implement issue date:
-    if (para.long_first_period == true)
-        if ( datenum(cf_dates(1,:)) > para.issuedatenum )
-            cf_dates(1,:) = issuevec;
-        end
-    else
-        if ( datenum(cf_dates(1,:)) > para.issuedatenum )
-            cf_dates = [issuevec;cf_dates];
-        end
-    end
-    if (para.long_last_period == true)
-        if ( datenum(cf_dates(rows(cf_dates),:)) < para.maturitydatenum )
-            cf_dates(rows(cf_dates),:) = matvec;
-        end
-    else
-        if ( datenum(cf_dates(rows(cf_dates),:)) < para.maturitydatenum )
-            cf_dates = [cf_dates;matvec];
-        end
-    end
-    %special case: long_last_period == long_first_period == true || only one cashflow (e.g. monthly term):
-    if (rows(cf_dates) == 1)
-       cf_dates = [issuevec;matvec];
-    end
-
-    % one time and forever: get datenum of cf_dates
-    cf_datesnum = datenum_fast(cf_dates);
     if ( para.enable_business_day_rule == true)
-        cf_business_datesnum = busdate(cf_datesnum-1 + para.business_day_rule, ...
-                                            para.business_day_direction);
-        cf_business_dates = datevec(cf_business_datesnum);
+        hol = holidays(para.issuedatenum - 10, para.maturitydatenum + 10);
     else
-        cf_business_datesnum = cf_datesnum;
-        cf_business_dates = cf_dates;
+        hol = [];
     end
+    [cf_datesnum cf_dates cf_business_datesnum cf_business_dates] = ...
+                    cf_dates_cpp(para.issuedatenum, para.maturitydatenum, ...
+                            para.term, para.term_unit, ...
+                            para.coupon_generation_method, ...
+                            para.long_first_period, para.long_last_period, ...
+                            para.enable_business_day_rule, ...
+                            para.business_day_rule, ...
+                            para.business_day_direction, hol);
 
     % store return values in para struct
     para.cf_dates               = cf_dates;
@@ -11,14 +11,19 @@
 %# details.
 
 %# -*- texinfo -*-
-%# @deftypefn {Function File} {[@var{R} @var{distr_type} @var{Z}] =} scenario_generation_MC (@var{corr_matrix}, @var{P}, @var{mc}, @var{copulatype}, @var{nu}, @var{time_horizon}, @var{path_static}, @var{para_object})
+%# @deftypefn {Function File} {[@var{R} @var{distr_type} @var{Z} @var{R_path}] =} scenario_generation_MC (@var{corr_matrix}, @var{P}, @var{mc}, @var{copulatype}, @var{nu}, @var{time_horizon}, @var{path_static}, @var{para_object}, @var{path_grid})
 %#
 %# Compute correlated random numbers according to Gaussian or Student-t copulas and
 %# arbitrary marginal distributions within the Pearson distribution system.@*
 %# @*
 %# Variables:
 %# @itemize @bullet
-%# @item @var{corr_matrix}:   Correlation matrix
+%# @item @var{corr_matrix}:   Correlation matrix or struct with factor loadings
+%# L (risk factors x factors) and idiosyncratic standard deviations D of a
+%# factor model (correlation L * L' + diag(D.^2)). In factor mode the
+%# correlated normal random numbers are given by F * L' + E .* D' with
+%# independent factors F and residuals E, so neither the full correlation
+%# matrix nor its Cholesky decomposition is required.
 %# @item @var{P}:   matrix with statistical parameter (columns: risk factors, 
 %# rows: four moments of distribution (mean, std, skew, kurt)
 %# @item @var{mc}:   number of MC scenarios
@@ -28,25 +33,61 @@
 %# @item @var{path_static}:   path to static files (e.g. random numbers)
 %# @item @var{para_object}:   object with parameters (stable_seed, use_sobol, 
 %# sobol_seed, path_working_folder, path_sobol_direction_number, 
-%# filename_sobol_direction_number,frob_norm_limit)
+%# filename_sobol_direction_number,frob_norm_limit, optional: 
+%# marginal_distr_mode (exact, table or validate, see get_marginal_distr_pearson))
 %# @item @var{R}:    OUTPUT: scenario matrix (rows: scenarios, cols: risk factors)
 %# @item @var{distr_type}:    OUTPUT: cell with marginal distribution types 
 %# @item @var{Z}:    OUTPUT: copula dependence (uniform marginal distributions)
 %# according to Pearson
+%# @item @var{path_grid}:   optional: path time grid as fraction of time horizon
+%# (ascending, last value 1). If given, consistent paths are generated by
+%# Brownian bridge construction between zero and the terminal scenarios R.
+%# @item @var{R_path}:    OUTPUT: path scenarios (scenarios x path steps x 
+%# risk factors). Last path step equals R.
 %# @end itemize
+%# The Brownian bridge values at intermediate steps are given by
+%# tau * R + sigma * B(tau) with the terminal standard deviation sigma of each
+%# risk factor and correlated standard Brownian bridges B (variance 
+%# tau * (1 - tau)). Therefore the variance of each path step is 
+%# tau * sigma^2 and the terminal distribution and copula are preserved.
+%# The bridge points are constructed in bisection order. The random numbers
+%# are taken from the dimensions following the terminal random numbers, so 
+%# that Sobol numbers with low dimensions determine terminal values and 
+%# midpoints. If stable_seed is set, the bridge random numbers are stored 
+%# with Z in the random number file and reused in subsequent runs.
 %# @seealso{get_marginal_distr_pearson, mvnrnd, normcdf, mvtrnd ,tcdf}
 %# @end deftypefn
 
-function [R distr_type Z] = scenario_generation_MC(corr_matrix,P,mc, ...
-                            copulatype,nu,time_horizon,path_static,para_object)
+function [R distr_type Z R_path] = scenario_generation_MC(corr_matrix,P,mc, ...
+                copulatype,nu,time_horizon,path_static,para_object,path_grid)
 % A) Input checks
     % 1) Arguments checks
     if nargin < 8
         print_usage ();
     end
+    if nargin < 9 || isempty(path_grid)
+        path_grid = 1;
+    end
+    path_grid = path_grid(:)';
+    if ( abs(path_grid(end) - 1) > sqrt(eps) || any(diff(path_grid) <= 0) ...
+                                            || path_grid(1) <= 0 )
+        error('scenario_generation_MC: path_grid has to be ascending in (0,1] with last value 1');
+    end
+    no_steps = numel(path_grid);
                                 
     % A) input data checks
-    [rr_c cc_c] = size(corr_matrix);
+    use_factors = isstruct(corr_matrix);
+    if ( use_factors )
+        L = corr_matrix.L;
+        D = corr_matrix.D(:);
+        no_factors = columns(L);
+        cc_c = rows(L);
+        if ( rows(D) ~= cc_c )
+            error('scenario_generation_MC: Numbers of factor loadings and idiosyncratic volatilities does not match!');
+        end
+    else
+        [rr_c cc_c] = size(corr_matrix);
+    end
     [pp_p cc_p] = size(P);
     if ( cc_c ~= cc_p )
         error('scenario_generation_MC: Numbers of risk factors and parameters does not match!');
@@ -58,6 +99,11 @@ function [R distr_type Z] = scenario_generation_MC(corr_matrix,P,mc, ...
     use_sobol  = para_object.use_sobol;
     sobol_seed = para_object.sobol_seed;
     frob_norm_limit = para_object.frob_norm_limit;
+    if ( isstruct(para_object) && ~isfield(para_object,'marginal_distr_mode') )
+        marginal_distr_mode = 'exact';
+    else
+        marginal_distr_mode = para_object.marginal_distr_mode;
+    end
     filepath_sobol_direction_number = strcat(para_object.path_working_folder,...
                                 '/',para_object.path_sobol_direction_number, ...
                                 '/',para_object.filename_sobol_direction_number);
@@ -65,22 +111,58 @@ function [R distr_type Z] = scenario_generation_MC(corr_matrix,P,mc, ...
     % 2) Time horizon check
     factor_time_horizon = 256 / time_horizon;
 
-    % 3) Test for positive semi-definiteness
-    fprintf('Testing correlation matrix for positive semi-definiteness:\n');
-    corr_matrix = correct_correlation_matrix(corr_matrix);
+    % 3) Test for positive semi-definiteness (warm start with previous
+    %    repaired correlation matrix, if available). Factor model
+    %    correlation matrices are positive semi-definite by construction.
+    corr_chol = [];
+    if ( use_factors )
+        fprintf('scenario_generation_MC: Using factor model with %d factors for %d risk factors.\n',no_factors,cc_c);
+    else
+        fprintf('Testing correlation matrix for positive semi-definiteness:\n');
+        warm_start = struct();
+        tmp_filename_corr = strcat(path_static,'/nearest_correlation_', ...
+                                    num2str(rows(corr_matrix)),'.mat');
+        if ( ~isempty(path_static) && exist(tmp_filename_corr,'file') )
+            warm_start_struct = load(tmp_filename_corr);
+            warm_start = warm_start_struct.warm_start;
+        end
+        [corr_matrix pos_sem_def_bool warm_start] = correct_correlation_matrix( ...
+                                                    corr_matrix,warm_start);
+        if ( stable_seed == 1 && ~isempty(path_static) )
+            save ('-v7',tmp_filename_corr,'warm_start');
+        end
+        % Cholesky factor of (repaired) matrix is reused for all random numbers
+        if ( isfield(warm_start,'chol') )
+            corr_chol = warm_start.chol;
+        end
+    end
     new_corr = false;
     
 % B.1) Generating multivariate random variables if stable_seed is 0
-tmp_number_rf = rows(corr_matrix);  % get number of risk factors
-tmp_filename = strcat(path_static,'/random_numbers_',num2str(mc),'_', ...
+tmp_number_rf = cc_c;  % get number of risk factors
+if ( use_factors )
+    tmp_filename = strcat(path_static,'/random_numbers_',num2str(mc),'_', ...
+                        num2str(tmp_number_rf),'_',copulatype,'_factor', ...
+                        num2str(no_factors),'.mat');
+else
+    tmp_filename = strcat(path_static,'/random_numbers_',num2str(mc),'_', ...
                         num2str(tmp_number_rf),'_',copulatype,'.mat');
+end
 % use existing correlated random numbers                        
+Z_struct = struct();
 if ( exist(tmp_filename,'file') && (stable_seed == 1))
     fprintf('scenario_generation_MC: Taking file >>%s<< with random numbers from static folder\n',tmp_filename);
     Z_struct = load(tmp_filename);  % read in from stored file
     Z = Z_struct.Z;
-    % test random numbers for matching correlation settings
-    frob_norm = norm(abs(corr(Z) - corr_matrix));
+    % test random numbers for matching correlation settings (factor model:
+    % test subset of risk factors only, full matrix is never set up)
+    if ( use_factors )
+        idx_test = 1:min(tmp_number_rf,500);
+        corr_target = L(idx_test,:) * L(idx_test,:)' + diag(D(idx_test).^2);
+        frob_norm = norm(abs(corr(Z(:,idx_test)) - corr_target));
+    else
+        frob_norm = norm(abs(corr(Z) - corr_matrix));
+    end
     if (frob_norm > frob_norm_limit)
         fprintf('scenario_generation_MC: WARNING: Frobenius norm %s of correlation matrix drawn from random numbers minus correlation settings > %s. New random numbers will be drawn.\n',any2str(frob_norm),any2str(frob_norm_limit));
         new_corr = true;
@@ -93,19 +175,39 @@ else
 end
 
 % B.2) draw new random numbers and apply copula
-if ( new_corr == true)
-    dim = length(corr_matrix);
+dim = tmp_number_rf;
+% factor model: independent factors and idiosyncratic residuals
+if ( use_factors )
+    dim_rn = dim + no_factors;
+else
+    dim_rn = dim;
+end
+% path mode: additional random numbers for Brownian bridge points in 
+% subsequent dimensions. With stable seed the bridge random numbers are
+% stored together with Z, so that paths are reproducible
+randn_bridge = [];
+if ( no_steps > 1 && new_corr == false && isfield(Z_struct,'randn_bridge') ...
+        && isequal(size(Z_struct.randn_bridge),[mc, dim_rn * (no_steps - 1)]) )
+    fprintf('scenario_generation_MC: Taking Brownian bridge random numbers for %d path steps from file >>%s<<\n',no_steps,tmp_filename);
+    randn_bridge = Z_struct.randn_bridge;
+end
+new_bridge = ( no_steps > 1 && isempty(randn_bridge) );
+if ( new_corr == true || new_bridge == true )
     if ( use_sobol == false)
-        fprintf('scenario_generation_MC: New random numbers are drawn for %d MC scenarios and Copulatype %s.\n',mc,copulatype);
-        randn_matrix = randn(mc,dim);
+        if ( new_corr == true )
+            fprintf('scenario_generation_MC: New random numbers are drawn for %d MC scenarios and Copulatype %s.\n',mc,copulatype);
+        else
+            fprintf('scenario_generation_MC: New Brownian bridge random numbers are drawn for %d MC scenarios and %d path steps.\n',mc,no_steps);
+        end
+        randn_matrix = randn(mc,dim_rn * no_steps);
     else
         % generate Sobol numbers
         sobol_seed = max(sobol_seed,1); % minimum Sobol seed = 1: first Sobol numbers 0.5
         fprintf('scenario_generation_MC: Use Sobol numbers with seed %d for %d MC scenarios and Copulatype %s.\n',sobol_seed,mc,copulatype);
-        if ( dim > 21201)
+        if ( dim_rn * no_steps > 21201)
             error('scenario_generation_MC: Sobol numbers only support up to 21201 dimensions. Use different Sobol generator or MC instead.');
         end
-        sobol_matrix = calc_sobol_cpp(mc+sobol_seed,dim,filepath_sobol_direction_number);
+        sobol_matrix = calc_sobol_cpp(mc+sobol_seed,dim_rn * no_steps,filepath_sobol_direction_number);
         % remove all rows < seed
         sobol_matrix(1:sobol_seed,:) = [];
         % get standard normal distributed random numbers
@@ -113,23 +215,42 @@ if ( new_corr == true)
         % scale randn_matrix to get 0,1 normally distributed numbers
         randn_matrix = randn_matrix ./ std(randn_matrix);
     end
-    
+    if ( new_bridge == true )
+        randn_bridge = randn_matrix(:,dim_rn+1:end);
+    end
+    randn_matrix = randn_matrix(:,1:dim_rn);
+end
+
+if ( new_corr == true)
     % ############    apply Copula    ######################################
     if ( strcmpi(copulatype, 'Gaussian') ) % Gaussian copula   
         % draw random variables from multivariate normal distribution
-        Y   =   mvnrnd_custom(zeros(1,dim),corr_matrix,mc,randn_matrix);  
+        if ( use_factors )
+            Y   =   factor_rnd_custom(L,D,randn_matrix);
+        else
+            Y   =   mvnrnd_custom(zeros(1,dim),corr_matrix,mc,randn_matrix,corr_chol);
+        end
         Z   =   normcdf(Y,0,1); 
         
     elseif ( strcmpi(copulatype, 't')) % t-copula 
         % draw random variables from multivariate student-t distribution
-        Y   =   mvtrnd_custom(corr_matrix,nu,mc,randn_matrix);    
+        if ( use_factors )
+            Y   =   factor_rnd_custom(L,D,randn_matrix) ...
+                                    .* sqrt(nu ./ chi2rnd(nu,mc,1));
+        else
+            Y   =   mvtrnd_custom(corr_matrix,nu,mc,randn_matrix,corr_chol);
+        end
         Z   =   tcdf(Y,nu);
         
     elseif ( strcmpi(copulatype, 'Clayton') || strcmpi(copulatype, 'Gumbel') 
                                                 || strcmpi(copulatype, 'Frank')) 
         % draw uniform distributed correlated random numbers 
         % for n scenarios and d risk factors
-        Y   =   normcdf(mvnrnd_custom(zeros(1,dim),corr_matrix,mc,randn_matrix));
+        if ( use_factors )
+            Y   =   normcdf(factor_rnd_custom(L,D,randn_matrix));
+        else
+            Y   =   normcdf(mvnrnd_custom(zeros(1,dim),corr_matrix,mc,randn_matrix,corr_chol));
+        end
         % apply copula
         Z   =   mvarchcop (copulatype,Y,nu);  
         
@@ -137,30 +258,63 @@ if ( new_corr == true)
         error('scenario_generation_MC: unknown Copula type >>%s<<. Must be >>t<< or >>Gaussian<<.\n',copulatype);
     end
     
-    if (stable_seed == 1)
+end
+% store random numbers for next run (bridge random numbers along with Z)
+if ( stable_seed == 1 && (new_corr == true || new_bridge == true) )
+    if ( no_steps > 1 )
+        save ('-v7',tmp_filename,'Z','randn_bridge');
+    else
         save ('-v7',tmp_filename,'Z');
     end
-    
 end
     
 
 % C) Apply marginal distributions to uniform distributed multivariate random numbers
-R = zeros(mc,columns(corr_matrix));
-distr_type = zeros(1,columns(Z));
-% now loop via all columns of Z and apply individual marginal distribution
-for ii = 1 : 1 : columns(Z);
-    % mu needs geometric compounding adjustment
-    tmp_mu      = P(1,ii) .^(1/factor_time_horizon);
-    % volatility needs adjustment with sqr(t)-rule 
-    tmp_sigma   = P(2,ii) ./ sqrt(factor_time_horizon);
-    tmp_skew    = P(3,ii);
-    tmp_kurt    = P(4,ii);
-    tmp_ucr = Z(:,ii);
-    %generate distribution based on Pearson System (Type 1-7)
-    [ret_vec type]= get_marginal_distr_pearson(tmp_mu,tmp_sigma, ...
-                                                tmp_skew,tmp_kurt,tmp_ucr); 
-    distr_type(ii) = type;
-    R(:,ii) = ret_vec;
+% mu needs geometric compounding adjustment, volatility needs adjustment 
+% with sqr(t)-rule
+if ( ~strcmpi(marginal_distr_mode,'exact') )
+    % all risk factors at once via inverse CDF lookup tables
+    [R distr_type] = get_marginal_distr_pearson(P(1,:) .^(1/factor_time_horizon), ...
+                        P(2,:) ./ sqrt(factor_time_horizon),P(3,:),P(4,:), ...
+                        Z,marginal_distr_mode);
+else
+    R = zeros(mc,tmp_number_rf);
+    distr_type = zeros(1,columns(Z));
+    % now loop via all columns of Z and apply individual marginal distribution
+    for ii = 1 : 1 : columns(Z);
+        % mu needs geometric compounding adjustment
+        tmp_mu      = P(1,ii) .^(1/factor_time_horizon);
+        % volatility needs adjustment with sqr(t)-rule 
+        tmp_sigma   = P(2,ii) ./ sqrt(factor_time_horizon);
+        tmp_skew    = P(3,ii);
+        tmp_kurt    = P(4,ii);
+        tmp_ucr = Z(:,ii);
+        %generate distribution based on Pearson System (Type 1-7)
+        [ret_vec type]= get_marginal_distr_pearson(tmp_mu,tmp_sigma, ...
+                                                    tmp_skew,tmp_kurt,tmp_ucr); 
+        distr_type(ii) = type;
+        R(:,ii) = ret_vec;
+    end
+end
+
+% D) Path mode: Brownian bridge between zero and terminal scenarios
+if ( nargout > 3 )
+    R_path = reshape(R,mc,1,dim);
+    if ( no_steps > 1 )
+        fprintf('scenario_generation_MC: Brownian bridge construction of %d path steps.\n',no_steps);
+        % correlated standard normal random numbers for all bridge points
+        Y_bridge = zeros(mc,dim,no_steps - 1);
+        for kk = 1 : 1 : no_steps - 1
+            tmp_randn = randn_bridge(:,(kk-1)*dim_rn+1:kk*dim_rn);
+            if ( use_factors )
+                Y_bridge(:,:,kk) = factor_rnd_custom(L,D,tmp_randn);
+            else
+                Y_bridge(:,:,kk) = mvnrnd_custom(zeros(1,dim),corr_matrix,mc,tmp_randn,corr_chol);
+            end
+        end
+        sigma_T = P(2,:) ./ sqrt(factor_time_horizon);
+        R_path = get_bridge_paths(R,sigma_T,path_grid,Y_bridge);
+    end
 end
 
 end
@@ -171,12 +325,17 @@ end
 % custom functions 
 %# Copyright (C) 2003 Iain Murray
 %# taken and modified from Octave's statistical package
-function s = mvnrnd_custom(mu,sigma,n,randn_matrix);  
+function s = mvnrnd_custom(mu,sigma,n,randn_matrix,U = []);  
 
     mu = zeros(1,length(sigma));
     d = columns(sigma);
     tol=eps*norm (sigma, "fro");
     
+    % given upper Cholesky factor of sigma (e.g. of correlation warm start)
+    if ( ~isempty(U) && isequal(size(U),[d,d]) )
+        s = randn_matrix*U + mu;
+        return;
+    end
     try
         U = chol (sigma + tol*eye (d),"upper");
     catch
@@ -197,10 +356,55 @@ function s = mvnrnd_custom(mu,sigma,n,randn_matrix);
 
 end
 
+% ##############################################################################
+% Brownian bridge paths (scenarios x steps x risk factors) between zero and
+% terminal values R: R_path = tau * R + sigma * B(tau), bridge points in 
+% bisection order with random numbers Y_bridge (scenarios x risk factors x 
+% bridge points)
+function R_path = get_bridge_paths(R,sigma,path_grid,Y_bridge)
+    [mc dim] = size(R);
+    no_steps = numel(path_grid);
+    tau = [0, path_grid];
+    B = zeros(mc,no_steps,dim);   % standard Brownian bridge, B(0) = B(1) = 0
+    intervals = [0, no_steps];
+    kk = 0;
+    while ( ~isempty(intervals) )
+        ll = intervals(1,1);
+        rr = intervals(1,2);
+        intervals(1,:) = [];
+        if ( rr - ll < 2 )
+            continue;
+        end
+        mm = floor((ll + rr) / 2);
+        kk = kk + 1;
+        t_l = tau(ll+1);
+        t_m = tau(mm+1);
+        t_r = tau(rr+1);
+        if ( ll == 0 )
+            B_l = 0;
+        else
+            B_l = B(:,ll,:);
+        end
+        B(:,mm,:) = ((t_r - t_m) .* B_l + (t_m - t_l) .* B(:,rr,:)) ./ (t_r - t_l) ...
+                    + sqrt((t_m - t_l) * (t_r - t_m) / (t_r - t_l)) ...
+                    .* reshape(Y_bridge(:,:,kk),mc,1,dim);
+        intervals = [intervals; ll, mm; mm, rr];
+    end
+    R_path = B .* reshape(sigma,1,1,dim) + path_grid .* reshape(R,mc,1,dim);
+end
+
+% ##############################################################################
+% correlated standard normal random numbers of factor model:
+% first columns of randn_matrix are factors, remaining columns residuals
+function s = factor_rnd_custom(L,D,randn_matrix)
+    k = columns(L);
+    s = randn_matrix(:,1:k) * L' + randn_matrix(:,k+1:end) .* D(:)';
+end
+
 % ##############################################################################
 %# Copyright (C) 2012  Arno Onken <asnelt@asnelt.org>, Iñigo Urteaga
 %# taken and modified from Octave's statistical package
-function x = mvtrnd_custom (sigma, nu, n,randn_matrix)
+function x = mvtrnd_custom (sigma, nu, n,randn_matrix,U = [])
 
 
   if (!isvector (nu) || any (nu <= 0))
@@ -226,12 +430,13 @@ function x = mvtrnd_custom (sigma, nu, n,randn_matrix)
   # Normalize sigma
   if (any (diag (sigma) != 1))
     sigma = sigma ./ sqrt (diag (sigma) * diag (sigma)');
+    U = [];
   endif
 
   # Dimension
   d = size (sigma, 1);
   # Draw samples
-  y = mvnrnd_custom (zeros (1, d), sigma, n, randn_matrix);
+  y = mvnrnd_custom (zeros (1, d), sigma, n, randn_matrix, U);
   u = repmat (chi2rnd (nu), 1, d);
   x = y .* sqrt (repmat (nu, 1, d) ./ u);
 end
@@ -332,6 +537,102 @@ end
 %! kurt_act = kurtosis(R(:,3));
 %! assert(kurt_act,kurt_target,0.03)
 
+%!test 
+%! fprintf('\tscenario_generation_MC:\tGenerating MC scenarios with factor model and t Copula\n');
+%! L = [0.8,0.1;0.7,-0.2;0.6,0.3;0.5,0.5];
+%! D = sqrt(1 - sum(L.^2,2));
+%! P = [0,0,0,0;0.2,0.5,0.4,0.3;0,0,0,0;3,3,3,3];
+%! mc = 100000;
+%! para_object.stable_seed = 0;
+%! para_object.use_sobol = false;
+%! para_object.sobol_seed = 1;
+%! para_object.path_working_folder = pwd;
+%! para_object.path_sobol_direction_number = '';
+%! para_object.filename_sobol_direction_number = '';    
+%! para_object.frob_norm_limit = 0.05;                 
+%! rand('state',666 .*ones(625,1)); % set seed
+%! randn('state',666 .*ones(625,1));    % set seed
+%! [R distr_type Z] = scenario_generation_MC(struct('L',L,'D',D),P,mc,'Gaussian',4,256,[],para_object);
+%! assert(size(R),[mc,4])
+%! assert(corr(R),L * L' + diag(D.^2),0.02)
+%! assert(std(R),P(2,:),0.01)
+%! [R distr_type Z] = scenario_generation_MC(struct('L',L,'D',D),P,mc,'t',10,256,[],para_object);
+%! assert(corr(tinv(Z,10)),L * L' + diag(D.^2),0.02)
+
+%!test 
+%! fprintf('\tscenario_generation_MC:\tGenerating MC scenarios with inverse CDF lookup tables\n');
+%! corr_matrix = [1,0.2,-0.3;0.2,1,0;-0.3,0.0,1];
+%! P = [0,0,0;0.2,0.5,0.4;-0.3,0,0.3;3,1.5,4.5];
+%! para_object.stable_seed = 0;
+%! para_object.use_sobol = false;
+%! para_object.sobol_seed = 1;
+%! para_object.path_working_folder = pwd;
+%! para_object.path_sobol_direction_number = '';
+%! para_object.filename_sobol_direction_number = '';    
+%! para_object.frob_norm_limit = 0.05;                 
+%! rand('state',666 .*ones(625,1)); % set seed
+%! randn('state',666 .*ones(625,1));    % set seed
+%! para_object.marginal_distr_mode = 'exact';
+%! [R_exact distr_type_exact Z] = scenario_generation_MC(corr_matrix,P,10000,'Gaussian',4,256,[],para_object);
+%! rand('state',666 .*ones(625,1)); % set seed
+%! randn('state',666 .*ones(625,1));    % set seed
+%! para_object.marginal_distr_mode = 'table';
+%! [R distr_type] = scenario_generation_MC(corr_matrix,P,10000,'Gaussian',4,256,[],para_object);
+%! assert(distr_type,distr_type_exact)
+%! assert(R(:,1:2),R_exact(:,1:2),0.00001)
+%! % Pearson type IV: quantiles instead of empirical distribution
+%! assert(std(R(:,3)),P(2,3),0.02)
+%! assert(mean(R(:,3)),P(1,3),0.02)
+
+%!test 
+%! fprintf('\tscenario_generation_MC:\tGenerating MC paths with Brownian bridge\n');
+%! corr_matrix = [1,0.5;0.5,1];
+%! P = [0,0;0.2,0.4;0,0;3,3];
+%! para_object.stable_seed = 0;
+%! para_object.use_sobol = false;
+%! para_object.sobol_seed = 1;
+%! para_object.path_working_folder = pwd;
+%! para_object.path_sobol_direction_number = '';
+%! para_object.filename_sobol_direction_number = '';    
+%! para_object.frob_norm_limit = 0.05;                 
+%! para_object.marginal_distr_mode = 'exact';
+%! rand('state',666 .*ones(625,1)); % set seed
+%! randn('state',666 .*ones(625,1));    % set seed
+%! path_grid = [0.1,0.25,0.5,0.75,1];
+%! [R distr_type Z R_path] = scenario_generation_MC(corr_matrix,P,50000,'Gaussian',4,256,[],para_object,path_grid);
+%! assert(size(R_path),[50000,5,2])
+%! assert(R_path(:,end,:),reshape(R,50000,1,2),sqrt(eps))
+%! % Brownian motion: variance proportional to time, independent increments
+%! assert(std(R_path(:,:,1)),0.2 .* sqrt(path_grid),0.005)
+%! assert(std(R_path(:,:,2)),0.4 .* sqrt(path_grid),0.01)
+%! incr = diff(R_path(:,:,1),1,2);
+%! assert(corr(incr(:,1),incr(:,3)),0,0.02)
+%! assert(corr(R_path(:,2,1),R_path(:,2,2)),0.5,0.02)
+
+%!test 
+%! fprintf('\tscenario_generation_MC:\tReproducible MC paths with stable seed\n');
+%! corr_matrix = [1,0.5;0.5,1];
+%! P = [0,0;0.2,0.4;0,0;3,3];
+%! para_object.stable_seed = 1;
+%! para_object.use_sobol = false;
+%! para_object.sobol_seed = 1;
+%! para_object.path_working_folder = pwd;
+%! para_object.path_sobol_direction_number = '';
+%! para_object.filename_sobol_direction_number = '';    
+%! para_object.frob_norm_limit = 0.05;                 
+%! para_object.marginal_distr_mode = 'exact';
+%! path_static = tempname();
+%! mkdir(path_static);
+%! path_grid = [0.25,0.5,1];
+%! randn('state',666 .*ones(625,1));
+%! [R1 distr_type Z1 R_path1] = scenario_generation_MC(corr_matrix,P,5000,'Gaussian',4,256,path_static,para_object,path_grid);
+%! randn('state',42 .*ones(625,1));
+%! [R2 distr_type Z2 R_path2] = scenario_generation_MC(corr_matrix,P,5000,'Gaussian',4,256,path_static,para_object,path_grid);
+%! confirm_recursive_rmdir(false,'local');
+%! rmdir(path_static,'s');
+%! assert(Z2,Z1)
+%! assert(R_path2,R_path1)
+
 
 
 %###############################################################################
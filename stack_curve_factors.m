@@ -0,0 +1,57 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{loadings} @var{scores}] =} stack_curve_factors (@var{loadings_cell}, @var{scores_cell})
+%#
+%# Stack the factor representations of all MC timesteps of a curve (see
+%# compress_curve_scenarios) into one page per timestep. Pages with less
+%# factors are padded with zero loadings and zero scores, which do not
+%# change the reconstructed rates
+%# loadings(1,:,kk) + scores(:,:,kk) * loadings(2:end,:,kk).
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{loadings_cell}: cell with mean curve and factor loadings ((k+1) x nodes) per timestep
+%# @item @var{scores_cell}: cell with factor scores (scenarios x k) per timestep
+%# @item @var{loadings}: OUTPUT: mean curve and factor loadings ((k+1) x nodes x timesteps)
+%# @item @var{scores}: OUTPUT: factor scores (scenarios x k x timesteps)
+%# @end itemize
+%# @seealso{compress_curve_scenarios, load_yieldcurves}
+%# @end deftypefn
+
+function [loadings scores] = stack_curve_factors(loadings_cell, scores_cell)
+    if ( nargin < 2 )
+        print_usage ();
+    end
+    no_pages = numel(loadings_cell);
+    if ( numel(scores_cell) ~= no_pages || no_pages == 0 )
+        error('stack_curve_factors: need loadings and scores for each timestep');
+    end
+    no_factors = max(cellfun(@(x) rows(x) - 1,loadings_cell));
+    no_nodes = columns(loadings_cell{1});
+    no_scen = rows(scores_cell{1});
+    loadings = zeros(no_factors + 1,no_nodes,no_pages);
+    scores = zeros(no_scen,no_factors,no_pages);
+    for kk = 1 : 1 : no_pages
+        tmp_k = rows(loadings_cell{kk}) - 1;
+        loadings(1:tmp_k + 1,:,kk) = loadings_cell{kk};
+        scores(:,1:tmp_k,kk) = scores_cell{kk};
+    end
+end
+
+%!test
+%! [loadings scores] = stack_curve_factors({[0.01,0.02;1,1],[0.02,0.03]},{[0.1;-0.1],zeros(2,0)});
+%! assert(size(loadings),[2,2,2])
+%! assert(size(scores),[2,1,2])
+%! assert(loadings(1,:,2) + scores(:,:,2) * loadings(2:end,:,2),[0.02,0.03;0.02,0.03])
+%! assert(loadings(1,:,1) + scores(:,:,1) * loadings(2:end,:,1),[0.11,0.12;-0.09,-0.08],sqrt(eps))
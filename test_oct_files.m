@@ -11,6 +11,119 @@ end
 %! fprintf('HOLD ON...\n');
 %! fprintf('\ttest_oct_files:\tcalculate_npv_cpp\n');
 %! assert(calculate_npv_cpp ([0.9,0.95,0.99;0.9,0.95,0.99],[3,3,103]),[ 107.52;107.52],0.01)
+%!test 
+%! fprintf('\ttest_oct_files:\tpricing_willowtree_cpp\n');
+%! [V1 V1_eur] = pricing_willowtree_cpp(true,true,[7;8;9],8,365,0.06,0.2,0.05,5,20);
+%! assert(V1,[0.2329429;0.6444019;1.2907739],0.00001)
+%! [V2 V2_eur cache_flag] = pricing_willowtree_cpp(true,true,[7;8;9],8,365,0.06,0.2,0.05,5,20);
+%! assert(cache_flag,1)
+%! assert(V2,V1,sqrt(eps))
+%! assert(V2_eur,V1_eur,sqrt(eps))
 
 
 
+%!test 
+%! fprintf('\ttest_oct_files:\ttimefactor_cpp\n');
+%! assert(timefactor_cpp(736329,736329 + [95;245;365;730;3650],0),[0.259562841530055;0.669398907103825;0.997267759562842;1.997260273972603;9.991780821917809],0.00000001)
+%! assert(timefactor_cpp(datenum('25-Oct-1996'),datenum('31-Dec-1996'),1),0.183333333333333,0.0000000001)
+%! [tf dip dib] = timefactor_cpp(736330,736336,14,736333);
+%! assert([tf dip dib],[4/252,4,252],sqrt(eps))
+%!test 
+%! fprintf('\ttest_oct_files:\tcf_dates_cpp\n');
+%! [cf_datesnum cf_dates] = cf_dates_cpp(736330,736695,6,'months','backward',0,0,0,0,1);
+%! assert(cf_datesnum,[736330;736511;736695])
+%! assert(cf_dates(:,1:3),[2016,1,1;2016,6,30;2016,12,31])
+%!test 
+%! fprintf('\ttest_oct_files:\trollout_prepayment_cpp\n');
+%! [cf_principal cf_interest] = rollout_prepayment_cpp(0,[0.1;0.2],[1,1],1,[1,1],'simple',1,[50,50],[5,2.5],[100,50]);
+%! assert(cf_principal,[55,45;60,40],sqrt(eps))
+%! assert(cf_interest,[5,2.25;5,2],sqrt(eps))
+%!test 
+%! fprintf('\ttest_oct_files:\tcalibrate_bond_yield_cpp\n');
+%! [x retcode] = calibrate_bond_yield_cpp(0,[0;2;3],[5;105;110],[1;2;1],[1;2;1],[0;0;0],2,1,[100;100],0.01,-1,1);
+%! assert(x,[0.05;0.10],0.0000001)
+%! assert(retcode,[0;0])
+%!test 
+%! fprintf('\ttest_oct_files:\tswap_annuity_cpp\n');
+%! [annuity forward] = swap_annuity_cpp([0.01,0.02],[1,0.5,0;0,0.5,1],[1;2;3],'cont',1,1);
+%! assert(annuity,exp(-0.03) + exp(-0.06),sqrt(eps))
+%! assert(forward,(exp(-0.01) - exp(-0.06)) ./ annuity,sqrt(eps))
+%!test 
+%! fprintf('\ttest_oct_files:\tpricing_swaption_cpp\n');
+%! assert(pricing_swaption_cpp(1,true,0.0609090679070339,0.062,1825,0.06,0.2,2,3,0),0.0207098170368683,0.00000001)
+%! assert(pricing_swaption_cpp(2,false,1.954904222037591e-002,0.03,3650,0.0,0.006656276,0,0,8.2844976761307),swaption_bachelier(0,1.954904222037591e-002,0.03,3650,0.006656276,8.2844976761307),sqrt(eps))
+%! [value delta gamma vega theta rho] = pricing_swaption_cpp(1,true,0.0609090679070339,0.062,1825,0.06,0.2,2,3,0);
+%! assert([delta vega theta rho],[1.113663148,0.001070370685,-2.460691362e-06,-0.001035490852],0.0000000001)
+%!test 
+%! fprintf('\ttest_oct_files:\tpricing_option_cpp\n');
+%! [value delta gamma vega theta rho] = pricing_option_cpp(2,false,100,100,365,0.01,0.25,0.0,800);
+%! assert([value delta gamma vega theta rho],[9.480431483,-0.4393536584,0.016058593,0.3933386219,-0.01227088594,-0.4378594077],0.0000001)
+%!test 
+%! fprintf('\ttest_oct_files:\tpricing_callable_bond_cpp\n');
+%! R = 0.03 + 0.002 .* (1:6);
+%! h = 0.000001;
+%! for american = [false,true]
+%!   [V tmp_B tmp_pu tmp_pm tmp_pd tmp_r tmp_Q dV d2V] = pricing_callable_bond_cpp(false,5,5,0.1,repmat(0.01,3,1),365 .* (1:5), ...
+%!                   repmat([3,3,3,3,103],3,1),[R;R - h;R + h],ones(1,6),1:6,100,3,100,repmat(3,3,5),american);
+%!   assert(V(1) > 0)
+%!   assert(dV(1),(V(3) - V(2)) / (2 * h),abs(dV(1)) * 0.001)
+%!   assert(d2V(1),(dV(3) - dV(2)) / (2 * h),abs(d2V(1)) * 0.001)
+%! end
+%!test 
+%! fprintf('\ttest_oct_files:\tcms_convexity_cpp\n');
+%! assert(cms_convexity_cpp(2,0,0.02,4.5,0.95,0.008,1,1,5,1,0),0.000121191951486,0.0000000001)
+%!test 
+%! fprintf('\ttest_oct_files:\tforward_rate_cpp\n');
+%! assert(forward_rate_cpp([0.06,0.06],[1,0;0,1],[1;2],[1;2],'cont',1,'cont',true),0.06,0.0000001)
+%! assert(forward_rate_cpp([0.05,0.06],[1,0;0,1],[1;2],[1;2],'disc','annual','simple',false),1.06^2/1.05 - 1,sqrt(eps))
+%!test 
+%! fprintf('\ttest_oct_files:\trollout_retail_cpp\n');
+%! [ret_values cum_survival] = rollout_retail_cpp([0.02,0.02],[1,0;0,1],[1;2],'cont',1,[100;100],[66;67],[66,67],[0.9,0.8],65);
+%! assert(cum_survival,[0.9,0.72],sqrt(eps))
+%! assert(ret_values,[90*exp(0.02),72*exp(0.04)],sqrt(eps))
+%!test 
+%! fprintf('\ttest_oct_files:\trollout_savings_cpp\n');
+%! [cf_interest cf_principal cf_interest_putable] = rollout_savings_cpp([0;2;3],[100;100;50],[2;1;1],[1;0;0],0.02,[2;3],1,[0.5;0],0.1);
+%! assert(cf_interest,[(100 * (1.02^2 - 1) + 2) * 1.5;50 * (exp(0.02) - 1)],sqrt(eps))
+%! assert(cf_principal,[200;50])
+%! assert(cf_interest_putable,[2.2;0],sqrt(eps))
+%!test 
+%! fprintf('\ttest_oct_files:\tkey_rates_cpp\n');
+%! [value_down value_up dv01] = key_rates_cpp([0;2],[365;730],[5;105],[0.01;0.01],[0;0],[1;2],[1;2],'cont',1,[365,730],0.01,365);
+%! assert(value_down,[5 + 105*exp(-0.02),5*exp(-0.01) + 105],sqrt(eps))
+%! assert(dv01,0.0001 .* [5*exp(-0.01),2*105*exp(-0.02)],sqrt(eps))
+%!test 
+%! fprintf('\ttest_oct_files:\tnearest_correlation_cpp\n');
+%! [X y iter retcode] = nearest_correlation_cpp([1,1,0;1,1,1;0,1,1]);
+%! assert(X(1,2:3),[0.760689853,0.157298106],0.000001)
+%! assert(retcode,0)
+%!test 
+%! fprintf('\ttest_oct_files:\tpearson_marginal_cpp\n');
+%! z = (-8:0.01:8)';
+%! R = pearson_marginal_cpp([0.5;0.975],[z,2.*z],-8,0.01);
+%! assert(R,[0,0;norminv(0.975),2*norminv(0.975)],sqrt(eps))
+%!test 
+%! fprintf('\ttest_oct_files:\triskfactor_scenarios_cpp\n');
+%! delta = riskfactor_scenarios_cpp([0.1,0.1;-0.1,-0.1],[2,0.001,0.2,0,0,0;5,0,0.01,0.04,0.03,0.1],10);
+%! assert(delta,[0.11,0.2*0.1 - 0.01;-0.09,-0.2*0.1 - 0.01],sqrt(eps))
+%! % columns split across 4 worker threads
+%! tmp_threads = getenv('OCTARISK_THREADS');
+%! setenv('OCTARISK_THREADS','4');
+%! Y = reshape(mod((1:400000)' * 0.618034,1) - 0.5,1000,400);
+%! rf_para = [repmat([2,0.001,0.2,0,0,0],200,1);repmat([5,0,0.01,0.04,0.03,0.1],200,1)];
+%! delta = riskfactor_scenarios_cpp(Y,rf_para,10);
+%! setenv('OCTARISK_THREADS',tmp_threads);
+%! assert(delta(:,1:200),Y(:,1:200) + 0.01,sqrt(eps))
+%! assert(delta(:,201:400),0.2 .* Y(:,201:400) - 0.01,sqrt(eps))
+%!test 
+%! fprintf('\ttest_oct_files:\tscenario_buffer_cpp\n');
+%! h = scenario_buffer_cpp('store',[0.01,0.02;0.03,0.04]);
+%! assert(scenario_buffer_cpp('get',h),[0.01,0.02;0.03,0.04])
+%! assert(scenario_buffer_cpp('clear'),0)
+%!test 
+%! fprintf('\ttest_oct_files:\tcalibrate_gpd_cpp\n');
+%! p = ((1:1000)' - 0.5) ./ 1000;
+%! y = 100 ./ 0.2 .* ((1 - p).^(-0.2) - 1);
+%! pnl_sorted = -[sort(y,'descend') + 500; linspace(500,0,9000)'];
+%! [chi sigma u] = calibrate_gpd_cpp(pnl_sorted,1000);
+%! assert([chi sigma u],[0.2,100,500],[0.01,1,0])
@@ -62,154 +62,14 @@ if d1 > d2
     error('timefactor: d1 >>%s<< is greater than d2 >>%s<<.',any2str(d1),any2str(d2))
 end
 
-% calculate nominator: days in period (dip)
-if (any(basis == [0,2,3,7,8,9,10,15]))     % act/XXX
-    %actual days in period
-    dip = d2 - d1;
-elseif (basis == 1)                    % 30/360 SIA
-    dvec1 = datevec(d1);
-    dvec2 = datevec(d2);
-    days1 = dvec1(:,3);
-    months1 = dvec1(:,2);
-    years1 = dvec1(:,1);
-    days2 = dvec2(:,3);
-    months2 = dvec2(:,2);
-    years2 = dvec2(:,1);
-    % adjustments
-   % 1. If the last date of the accrual period is the last day of February 
-    %    and the first date of the period is the last day of February, then the 
-    %    last date of the period will be changed to the 30th.
-    days2(d2 == eomdate(years2,2) & d1 == eomdate(years1,2)) = 30;
-
-    % 2. If the first date of the accrual period falls on the 31st of a month 
-    %    or is the last day of February, that date will be changed to the 
-    %    30th of the month.   
-    days1_orig = days1;
-    days1(31 == days1 & d1 == eomdate(years1,2)) = 30;
-    step2_adjusted = ~(days1_orig == days1);
-    
-    % 3. If the first date of the accrual period falls on the 30th of a month 
-    %    after applying (2) above, and the last date of the period falls on 
-    %    the 31st of a month, the last date will be changed to the 30th of 
-    %    the month.
-    days2(days1 == 30 & days2 == 31 & step2_adjusted) = 30;
-    
-    % calculation
-    dip = (years2 - years1) .* 360 + ( months2 - months1 ) .* 30 + ( days2 - days1 );
-
-elseif (basis == 13)                    % 30/360
-    dvec1 = datevec(d1);
-    dvec2 = datevec(d2);
-    days1 = dvec1(:,3);
-    months1 = dvec1(:,2);
-    years1 = dvec1(:,1);
-    days2 = dvec2(:,3);
-    months2 = dvec2(:,2);
-    years2 = dvec2(:,1);
-    % adjustments
-
-    % 1. If the last date of the accrual period is the last day of February 
-    %    and the first date of the period is the last day of February, then the 
-    %    last date of the period will be changed to the 30th.
-    days2(d2 == eomdate(years2,2) .* ( d1 == eomdate(years1,2))) = 30;
-
-     % 2. If days1 is the last day of February, change days1 to 30. 
-    days1_step2_unadjusted = days1;
-    days1(d1 == eomdate(years1,2)) = 30;
-
-    % 3. If days2 is 31, change it to 30 only if days1 (after the possible 
-    %    adjustment at step (ii)) is 30 or 31.
-    days2(days2 == 31 .* any(days1 == [30,31]) .* (~(days1_step2_unadjusted == days1))) = 30;
-
-    % 4. If days1 is 31, change it to 30.
-    days1(days1 == 31) = 30;
-
-    % calculation
-    dip = (years2 - years1) .* 360 + ( months2 - months1 ) .* 30 + ( days2 - days1 );
-    
-% 30 days per month    
-elseif (any(basis == [4,5,6,11]))     % 30/XXX             
-        dvec1 = datevec(d1);
-        dvec2 = datevec(d2);
-        days1 = dvec1(:,3);
-        months1 = dvec1(:,2);
-        years1 = dvec1(:,1);
-        days2 = dvec2(:,3);
-        months2 = dvec2(:,2);
-        years2 = dvec2(:,1);
-        % special case 30/360E or 30/360 European: adjust days in month to 30
-        if ( any(basis == [6,11]) )  
-            days1 = min(days1,30);
-            days2 = min(days2,30);
-        end
-        dip = (years2 - years1) .* 360 + ( months2 - months1 ) .* 30 + ( days2 - days1 );
-elseif(basis == 14)                     % business/252
-    % vectorized code not possible because of holiday function
-    if ~( length(d1) == length(d2))
-        if ( length(d1) < length(d2))
-            d1 = repmat(d1,length(d2),1);
-        else
-            d2 = repmat(d2,length(d1),1);
-        end
-    end
-    dip = zeros(length(d2),1);
-    % for each accrual period calculate business days
-    for ii = 1:1:length(d2)
-        dip(ii) = length(busdays(d1(ii),d2(ii)));
-    end
-end
-
-% calculate days in base (dib)
-if (any(basis == [1,2,4,5,6,9,11,13]))  % YYY/360
-    dib = 360;
-elseif (any(basis == [3,7,10]))         % YYY/365
-    dib = 365;
-elseif (basis == 14)                    % business/252
-    dib = 252;
-elseif (basis == 15)                    % YYY/364
-    dib = 364;
-elseif (any(basis == [0,8]))            % YYY/actual
-        dvec1 = datevec(d1);
-        dvec2 = datevec(d2);
-        days1 = dvec1(:,3);
-        months1 = dvec1(:,2);
-        years1 = dvec1(:,1);
-        days2 = dvec2(:,3);
-        months2 = dvec2(:,2);
-        years2 = dvec2(:,1);
-        % if years1 == years2 
-        y1_eq_y2 = years1 == years2;
-            dip_y1_eq_y2 = d2 - d1;
-            dib_y1_eq_y2 = yeardays_actual(years1);
-        % elseif  years2 > years1
-        y2_gt_y1 = years2 > years1;
-            y1_ymonth_day_matrix = repmat([12,31,0,0,0],length(years1),1);
-            y2_ymonth_day_matrix = repmat([01,01,0,0,0],length(years2),1);
-            end_of_year_period1 = horzcat(years1,y1_ymonth_day_matrix);
-            begin_of_year_period2 = horzcat(years2,y2_ymonth_day_matrix);
-            days_period1 = datenum(end_of_year_period1) - d1;
-            days_period2 = d2 - datenum(begin_of_year_period2) + 1;
-            dib_y2_gt_y1 = 1;
-            dip_y2_gt_y1 = (days_period1 ./ yeardays_actual(years1)) + ...
-                (days_period2 ./ yeardays_actual(years2)) + (years2 - years1 - 1);           
-        % else
-        y1_gt_y2 = years1 > years2;
-            dip_y1_gt_y2 = 0;
-            dib_y1_gt_y2 = 1;
-            
-        % concatenate all cases
-        dip = y1_gt_y2 .* dip_y1_gt_y2 + y2_gt_y1 .* dip_y2_gt_y1 + y1_eq_y2 .* dip_y1_eq_y2;
-        dib = y1_gt_y2 .* dib_y1_gt_y2 + y2_gt_y1 .* dib_y2_gt_y1 + y1_eq_y2 .* dib_y1_eq_y2;        
-end
-
-% calculate timefactor
-tf = dip ./ dib;
- 
+% calculate days in period (dip), days in base (dib) and timefactor in
+% compiled function timefactor_cpp (business/252 requires holidays)
+if (basis == 14)
+    [tf dip dib] = timefactor_cpp(d1, d2, basis, holidays(min(d1(:)),max(d2(:))));
+else
+    [tf dip dib] = timefactor_cpp(d1, d2, basis);
 end
  
-% helper function yeardays_actual()
-function days = yeardays_actual(year)
-    days = 365 + (eomday(year, 2) == 29);
 end
 
 
@@ -36,7 +36,16 @@ function_cell= {'pricing_npv','option_bs','option_willowtree', ...
                 'addtodatefinancial','epanechnikov_weight','get_quantile_estimator', ...
                 'get_informclass','get_informscore','get_esg_rating','calc_HHI', ...
                 'get_credit_rating','map_country_isocodes','get_readinessclass', ...
-                'test_oct_files','get_sri_level','get_srri_level'};
+                'test_oct_files','get_sri_level','get_srri_level', ...
+                'get_scenario_subset','instrument_approximation', ...
+                'pricing_grid','compile_stresstests','valuate_scenario_sets', ...
+                'cashflow_cache','calibrate_vola_spread_batch','calibrate_vola_spreads', ...
+                'calibrate_bond_yields','get_curve_weights', ...
+                'correct_correlation_matrix','get_correlation_factors', ...
+                'load_correlation_factors','compress_curve_scenarios','stack_curve_factors', ...
+                'compile_whatif_engine','calc_whatif_var','benchmark_oct_files', ...
+                'get_timestep_days','load_yieldcurves','get_convention_num', ...
+                'rollout_retail_batch','whatif_commit_trade'};
 fprintf('=== Running unit tests for %d functions=== \n',length(function_cell)); 
 % 2) Run tests
 tests_total = 0;
@@ -18,12 +18,31 @@
 %# Calculate reciprocal FX conversion factors for all exchange rate market objects (e.g. FX_USDEUR = 1 ./ FX_USDEUR).
 %# During aggregation and instrument currency conversion the appropriate FX exchange rate is always chosen by FX_BasecurrencyForeigncurrency)
 %# Volatility surfaces and cube MC and stress shocks are generated in script load_volacubes.m
+%# If parameter use_curve_factors of the optional para_object is set, curve MC scenarios are
+%# stored in a factor representation (see compress_curve_scenarios). Risk factor curves in
+%# factor representation are applied to the mean curve and the factor loadings only.
+%# If parameter use_scenario_buffer is set, dense curve MC scenarios are moved into the
+%# shared scenario buffer pool (see scenario_buffer_cpp).
+%# Intermediate MC path steps of index risk factors (see get_path_timesteps) are stored as
+%# additional MC timesteps of the index, named in days (e.g. '90d').
 %# @end deftypefn
 
-function [index_struct curve_struct surface_struct id_failed_cell] = update_mktdata_objects(valuation_date,instrument_struct,mktdata_struct,index_struct,riskfactor_struct,curve_struct,surface_struct,timesteps_mc,mc,no_stresstests,run_mc,stress_struct)
+function [index_struct curve_struct surface_struct id_failed_cell] = update_mktdata_objects(valuation_date,instrument_struct,mktdata_struct,index_struct,riskfactor_struct,curve_struct,surface_struct,timesteps_mc,mc,no_stresstests,run_mc,stress_struct,para_object)
 
 id_failed_cell = {};
+% optional factor representation of curve scenarios
+use_curve_factors = false;
+use_scenario_buffer = false;
+if ( nargin > 12 )
+    use_curve_factors = para_object.use_curve_factors;
+    use_scenario_buffer = para_object.use_scenario_buffer;
+    curve_factor_tolerance = para_object.curve_factor_tolerance;
+    curve_max_factors = para_object.curve_max_factors;
+end
 index_curve_objects = 0;
+% compile stresstests once: sparse shock matrix (objects x stresses)
+stress_engine = compile_stresstests(stress_struct);
+number_stresses = stress_engine.number_stresses;
 % loop through all Index and Curve mktdata objects (except Aggregated Curves -> stacked in next step)
 for ii = 1 : 1 : length(mktdata_struct)
     % get class -> switch between curve, index, surface
@@ -33,21 +52,12 @@ for ii = 1 : 1 : length(mktdata_struct)
         tmp_id = tmp_object.id;
         try
             % a) apply Stress scenario shocks
-                % reserve stress_values matrix
-                stress_values = zeros(length(stress_struct),columns(tmp_object.getValue('base'))) ;
-
-                % iterate via all stress definitions
-                for ii = 1:1:length(stress_struct)
-                    % get struct with all market object shocks
-                    subst = stress_struct(ii).objects;
-                    % get appropriate market object
-                    [mktstruct retcode] = get_sub_struct(subst,tmp_object.id);
-                    if ( retcode == 1)  % market data is contained in stress
-                        stress_values(ii,:) = return_stress_shocks(tmp_object,mktstruct);
-                    else
-                        % apply base value
-                        stress_values(ii,:) = tmp_object.getValue('base');
-                    end
+                % reserve stress_values matrix (all stresses: apply base value)
+                stress_values = repmat(tmp_object.getValue('base'),number_stresses,1);
+                % iterate via all stress definitions of market object
+                [stress_idx shock_defs] = get_stress_shocks(stress_engine,tmp_object.id);
+                for kk = 1:1:length(stress_idx)
+                    stress_values(stress_idx(kk),:) = return_stress_shocks(tmp_object,shock_defs{kk});
                 end
                 % set instrument stress vector
                 tmp_object = tmp_object.set('scenario_stress',stress_values);
@@ -61,12 +71,19 @@ for ii = 1 : 1 : length(mktdata_struct)
                     tmp_model               = tmp_rf_object.get('model');
                     % set mc object values:
                     tmp_scenario_mc_shock   = tmp_rf_object.get('scenario_mc');
+                    tmp_timesteps_mc        = tmp_rf_object.get('timestep_mc');
+                    % intermediate MC path steps as additional MC timesteps
+                    tmp_path_timesteps = tmp_rf_object.get_path_timesteps();
+                    for kk = 1 : 1 : length(tmp_path_timesteps)
+                        tmp_scenario_mc_shock = [tmp_scenario_mc_shock, ...
+                                tmp_rf_object.getValue(tmp_path_timesteps{kk})];
+                    end
+                    tmp_timesteps_mc = [tmp_timesteps_mc, tmp_path_timesteps];
                     if ( sum(strcmp(tmp_model,{'GBM','BKM'})) > 0 ) % Log-normal Motion
                         tmp_scenario_values     =  exp(tmp_scenario_mc_shock) .*  tmp_object.value_base;
                     else        % Normal Model
                         tmp_scenario_values     = tmp_scenario_mc_shock + tmp_object.value_base;
                     end
-                    tmp_timesteps_mc    = tmp_rf_object.get('timestep_mc');
                     tmp_object = tmp_object.set('scenario_mc', tmp_scenario_values );
                     tmp_object = tmp_object.set('timestep_mc', tmp_timesteps_mc );
                 end     % no match found, market object has no attached risk factor
@@ -122,21 +139,12 @@ for ii = 1 : 1 : length(mktdata_struct)
             
             % b) apply stress scenario shocks to market data curve
 
-                % set stressed_values
-                stress_values = zeros(length(stress_struct),columns(tmp_object.getValue('base'))) ;
-                % iterate via all stress definitions
-                for ii = 1:1:length(stress_struct)
-                    % get struct with all market object shocks
-                    subst = stress_struct(ii).objects;
-                    % get approriate market object
-                    [mktstruct retcode] = get_sub_struct(subst,tmp_object.id);
-                    if ( retcode == 1)  % market data is contained in stress
-                        stress_values(ii,:) = return_stress_shocks(tmp_object,mktstruct);
-                    else
-                        % apply base value
-                        stress_values(ii,:) = tmp_object.getValue('base');
-                    end
-                    
+                % set stressed_values (all stresses: apply base value)
+                stress_values = repmat(tmp_object.getValue('base'),number_stresses,1);
+                % iterate via all stress definitions of market object
+                [stress_idx shock_defs] = get_stress_shocks(stress_engine,tmp_object.id);
+                for kk = 1:1:length(stress_idx)
+                    stress_values(stress_idx(kk),:) = return_stress_shocks(tmp_object,shock_defs{kk});
                 end
                 % set instrument stress vector
                 tmp_object = tmp_object.set('rates_stress',stress_values);
@@ -154,6 +162,32 @@ for ii = 1 : 1 : length(mktdata_struct)
                     for kk = 1 : 1 : length(tmp_timestep_mc)
                         tmp_value_type = tmp_timestep_mc{kk};
                         rf_shock_nodes    = tmp_rf_object.get('nodes');
+                        % risk factor shocks in factor representation: linear
+                        % interpolation and shocks are applied to mean curve
+                        % and factor loadings only, scores are shared
+                        if ( isempty(tmp_rf_object.get('rates_mc')) ...
+                                && ~isempty(tmp_rf_object.get('rates_mc_loadings')) ...
+                                && strcmpi(tmp_rf_object.method_interpolation,'linear') ...
+                                && ~strcmpi(tmp_shocktype_mc,'sln_relative'))
+                            rf_loadings = tmp_rf_object.rates_mc_loadings(:,:,kk);
+                            curve_loadings = zeros(rows(rf_loadings),length(curve_nodes));
+                            for nn = 1 : 1 : length(curve_nodes)
+                                curve_loadings(:,nn) = interpolate_curve(rf_shock_nodes, ...
+                                    rf_loadings,curve_nodes(nn),'linear');
+                            end
+                            if ( strcmp(tmp_shocktype_mc,'relative'))
+                                curve_loadings = curve_rates_base .* curve_loadings;
+                            elseif ( strcmp(tmp_shocktype_mc,'absolute'))
+                                curve_loadings(1,:) = curve_rates_base + curve_loadings(1,:);
+                            else
+                                error('No valid shock type defined [relative,absolute]: >>%s<< \n',tmp_shocktype_mc);
+                            end
+                            tmp_object = tmp_object.set('timestep_mc',tmp_value_type);
+                            tmp_object = tmp_object.set('rates_mc',[], ...
+                                    'rates_mc_scores',tmp_rf_object.rates_mc_scores(:,:,kk), ...
+                                    'rates_mc_loadings',curve_loadings);
+                            continue;
+                        end
                         rf_shock_rates    = tmp_rf_object.getValue(tmp_value_type);
                         % 1. loop through all risk factor shock values and calculate
                         % sln values
@@ -196,6 +230,13 @@ for ii = 1 : 1 : length(mktdata_struct)
                         end
                         tmp_object = tmp_object.set('timestep_mc',tmp_value_type);
                         tmp_object = tmp_object.set('rates_mc',curve_rates_mc);
+                        if ( use_curve_factors == true )
+                            tmp_object = tmp_object.compress_rates_mc( ...
+                                    curve_factor_tolerance,curve_max_factors);
+                        end
+                        if ( use_scenario_buffer == true )
+                            tmp_object = tmp_object.store_rates_mc();
+                        end
                         
                     end
                 end
@@ -236,6 +277,13 @@ for ii = 1 : 1 : length(mktdata_struct)
                 [tmp_object curve_struct] = aggregate_curve_ojects(tmp_object,valuation_date, ...
                                 mktdata_struct,index_struct,riskfactor_struct, ...
                                 curve_struct,surface_struct,timesteps_mc,mc,no_stresstests,run_mc);
+                if ( use_curve_factors == true )
+                    tmp_object = tmp_object.compress_rates_mc( ...
+                                    curve_factor_tolerance,curve_max_factors);
+                end
+                if ( use_scenario_buffer == true )
+                    tmp_object = tmp_object.store_rates_mc();
+                end
 
                 aggr_curve_objects = aggr_curve_objects + 1;
                 % store everything in curve struct
@@ -466,31 +514,41 @@ function retval = return_stress_shocks(obj,mktstruct)
         % get base rates and nodes of curve
         rates_base = obj.get('rates_base');
         nodes = obj.get('nodes');
-        rates_stress = zeros(1,length(nodes));
-        
-        % apply interpolated shocks to all base rates
-        for kk = 1:1:length(nodes)
-            tmp_node = nodes(kk);
-            shock_value = interpolate_curve (mktstruct.term, ...
-                                mktstruct.shock_value, tmp_node, ...
+        % interpolate shocks for all nodes at once
+        if ( length(mktstruct.term) == 1 )
+            shock_value = repmat(mktstruct.shock_value(1),1,length(nodes));
+        elseif ( strcmpi(mktstruct.method_interpolation,'linear') ...
+                    && all(round(mktstruct.term) == mktstruct.term) ...
+                    && all(round(nodes) == nodes) )
+            shock_value = interpolate_curve_vectorized(mktstruct.term, ...
+                                mktstruct.shock_value, nodes);
+        else
+            shock_value = zeros(1,length(nodes));
+            for kk = 1:1:length(nodes)
+                shock_value(kk) = interpolate_curve (mktstruct.term, ...
+                                mktstruct.shock_value, nodes(kk), ...
                                 mktstruct.method_interpolation);
-            if (strcmpi(shock_type,'relative'))
-                appliedshock = rates_base(kk) .* (shock_value - 1);
-                if ( ~isempty(minshock))
-                    appliedshock(abs(appliedshock)<minshock) = sign(appliedshock).*minshock;
-                end
-                if ( ~isempty(maxshock))
-                    appliedshock(abs(appliedshock)>maxshock) = sign(appliedshock).*maxshock;
-                end
-                rates_stress(kk)  = rates_base(kk) + appliedshock;
-            elseif (strcmpi(shock_type,'absolute'))
-                rates_stress(kk)  = rates_base(kk) + shock_value;
-            elseif (strcmpi(shock_type,'value'))
-                rates_stress(kk)  = shock_value;
-            else
-                error('return_stress_shocks: unknown stress shock type: >>%s<<\n',any2str(shock_type));
             end
         end
+        % apply interpolated shocks to all base rates
+        if (strcmpi(shock_type,'relative'))
+            appliedshock = rates_base .* (shock_value - 1);
+            if ( ~isempty(minshock))
+                tmp_mask = abs(appliedshock) < minshock;
+                appliedshock(tmp_mask) = sign(appliedshock(tmp_mask)) .* minshock;
+            end
+            if ( ~isempty(maxshock))
+                tmp_mask = abs(appliedshock) > maxshock;
+                appliedshock(tmp_mask) = sign(appliedshock(tmp_mask)) .* maxshock;
+            end
+            rates_stress  = rates_base + appliedshock;
+        elseif (strcmpi(shock_type,'absolute'))
+            rates_stress  = rates_base + shock_value;
+        elseif (strcmpi(shock_type,'value'))
+            rates_stress  = shock_value;
+        else
+            error('return_stress_shocks: unknown stress shock type: >>%s<<\n',any2str(shock_type));
+        end
         % return stressed rates
         retval = rates_stress;
     % other types
@@ -0,0 +1,183 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {[@var{ret_instr_obj} @var{scen_number_total}] =} valuate_scenario_sets (@var{instr_obj}, @var{valuation_date}, @var{scenario_set}, @var{instrument_struct}, @var{surface_struct}, @var{matrix_struct}, @var{curve_struct}, @var{index_struct}, @var{riskfactor_struct}, @var{para_object})
+%#
+%# Valuate an instrument for several scenario sets (e.g. @{'250d','stress'@})
+%# in one call. All scenario set independent calculations (base cash flow
+%# rollout, base value, sensitivities, key rate durations, yield to maturity
+%# and spread calibration) are done in the first evaluation only and are
+%# reused for all further scenario sets.
+%# @*
+%# Fixed cash flow bonds (FRB, SWAP_FIXED, ZCB, CASHFLOW and FAB without
+%# prepayment and without embedded options) have equal cash flows in all
+%# scenarios. For these bonds the discount curve rates of all stress and MC
+%# scenario sets are concatenated into one scenario dimension and all
+%# scenarios are discounted in one pass.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{instr_obj}: instrument object, which has to be valuated
+%# @item @var{valuation_date}: valuation date
+%# @item @var{scenario_set}: cell with scenario sets ['base','stress', MC timesteps]
+%# @item @var{instrument_struct}: structure with all instruments
+%# @item @var{surface_struct}: structure with all surfaces
+%# @item @var{matrix_struct}: structure with all matrizes
+%# @item @var{curve_struct}: structure with all curves
+%# @item @var{index_struct}: structure with all indizes
+%# @item @var{riskfactor_struct}: structure with all risk factors
+%# @item @var{para_object}: Parameter object (required: mc, no_stresstests,
+%# first_eval, path_static)
+%# @item @var{ret_instr_obj}: RETURN: valuated instrument object
+%# @item @var{scen_number_total}: RETURN: total number of valuated scenarios
+%# @end itemize
+%# @seealso{instrument_valuation}
+%# @end deftypefn
+
+function [ret_instr_obj scen_number_total] = valuate_scenario_sets(instr_obj, ...
+                    valuation_date, scenario_set, instrument_struct, ...
+                    surface_struct, matrix_struct, curve_struct, index_struct, ...
+                    riskfactor_struct, para_object)
+
+if ( nargin < 10 )
+    print_usage();
+end
+if ( ischar(scenario_set) )
+    scenario_set = {scenario_set};
+end
+
+% get number of scenarios for all scenario sets
+scen_numbers = zeros(1,length(scenario_set));
+for kk = 1 : 1 : length(scenario_set)
+    if ( strcmpi(scenario_set{kk},'stress') )
+        scen_numbers(kk) = para_object.no_stresstests;
+    elseif ( strcmpi(scenario_set{kk},'base') )
+        scen_numbers(kk) = 1;
+    else
+        scen_numbers(kk) = para_object.mc;
+    end
+end
+scen_number_total = sum(scen_numbers);
+
+ret_instr_obj = instr_obj;
+if ( is_fixed_cf_bond(instr_obj) )
+    % a) base valuation: cash flow rollout, base value and sensitivities
+    para_object.scen_number = 1;
+    ret_instr_obj = ret_instr_obj.valuate(valuation_date, 'base', ...
+                        instrument_struct, surface_struct, ...
+                        matrix_struct, curve_struct, index_struct, ...
+                        riskfactor_struct, para_object);
+    % b) all stress and MC scenarios in one pass
+    scen_idx = ~strcmpi(scenario_set,'base');
+    if ( any(scen_idx) )
+        ret_instr_obj = calc_value_concatenated(ret_instr_obj, valuation_date, ...
+                        scenario_set(scen_idx), scen_numbers(scen_idx), curve_struct);
+    end
+else
+    % valuate all scenario sets, reuse scenario set independent results
+    for kk = 1 : 1 : length(scenario_set)
+        para_object.scen_number = scen_numbers(kk);
+        ret_instr_obj = ret_instr_obj.valuate(valuation_date, scenario_set{kk}, ...
+                        instrument_struct, surface_struct, ...
+                        matrix_struct, curve_struct, index_struct, ...
+                        riskfactor_struct, para_object);
+        para_object.first_eval = 0;
+    end
+end
+
+end
+
+% ------------------------------------------------------------------------------
+% helper functions
+function retval = is_fixed_cf_bond(obj)
+    retval = false;
+    if ~( strcmpi(obj.type,'bond') )
+        return;
+    end
+    if ( obj.embedded_option_flag == true )
+        return;
+    end
+    if ( any(strcmpi(obj.sub_type,{'FRB','SWAP_FIXED','ZCB','CASHFLOW'})) )
+        retval = true;
+    elseif ( strcmpi(obj.sub_type,'FAB') && obj.prepayment_flag == false )
+        retval = true;
+    end
+end
+
+% discount base cash flows with concatenated discount rates of all scenario sets
+function obj = calc_value_concatenated(obj, valuation_date, scenario_set, ...
+                                        scen_numbers, curve_struct)
+    [curve_obj object_ret_code] = get_sub_object(curve_struct, obj.discount_curve);
+    if ( object_ret_code == 0 )
+        error('valuate_scenario_sets: No curve_struct object found for id >>%s<<',obj.discount_curve);
+    end
+    tmp_nodes = curve_obj.nodes;
+    tmp_rates = zeros(sum(scen_numbers),length(tmp_nodes));
+    row_end = cumsum(scen_numbers);
+    row_start = row_end - scen_numbers + 1;
+    for kk = 1 : 1 : length(scenario_set)
+        set_rates = curve_obj.getValue(scenario_set{kk});
+        if ( rows(set_rates) == 1 )
+            set_rates = repmat(set_rates,scen_numbers(kk),1);
+        elseif ( rows(set_rates) ~= scen_numbers(kk) )
+            error('valuate_scenario_sets: curve >>%s<< has %d instead of %d scenarios for scenario set >>%s<<', ...
+                    curve_obj.id,rows(set_rates),scen_numbers(kk),scenario_set{kk});
+        end
+        tmp_rates(row_start(kk):row_end(kk),:) = set_rates;
+    end
+    % cash flow values are equal for base and all scenarios
+    tmp_cf_values = obj.getCF('base');
+    theo_value = pricing_npv(valuation_date, obj.cf_dates, tmp_cf_values, ...
+                            obj.soy, tmp_nodes, tmp_rates, obj.basis, ...
+                            obj.compounding_type, obj.compounding_freq, ...
+                            curve_obj.method_interpolation, ...
+                            curve_obj.compounding_type, curve_obj.basis, ...
+                            curve_obj.compounding_freq);
+    % split values into scenario sets
+    for kk = 1 : 1 : length(scenario_set)
+        tmp_value = theo_value(row_start(kk):row_end(kk));
+        if ( strcmpi(scenario_set{kk},'stress') )
+            obj = obj.set('cf_values_stress',tmp_cf_values);
+            obj = obj.set('value_stress',tmp_value);
+        else
+            obj = obj.set('cf_values_mc',tmp_cf_values,'timestep_mc_cf',scenario_set{kk});
+            obj = obj.set('timestep_mc',scenario_set{kk});
+            obj = obj.set('value_mc',tmp_value);
+        end
+    end
+end
+
+%!test
+%! para_object = Parameter();
+%! para_object.mc = 3;
+%! para_object.no_stresstests = 2;
+%! b = Bond();
+%! b = b.set('Name','Test_ZCB','id','TEST_ZCB','coupon_rate',0.00,'value_base',101.1190,'coupon_generation_method','backward');
+%! b = b.set('maturity_date','21-Apr-2020','notional',100,'compounding_type','disc','issue_date','21-Apr-2015','term',12,'compounding_freq','annual','sub_type','ZCB','discount_curve','IR_EUR');
+%! c = Curve();
+%! c = c.set('id','IR_EUR','nodes',[365,1095,1825],'rates_base',[-0.00519251,-0.00508595,-0.00367762],'method_interpolation','linear');
+%! c = c.set('rates_stress',[-0.005,-0.005,-0.003;0.01,0.01,0.01]);
+%! c = c.set('rates_mc',[-0.004,-0.004,-0.002;0.0,0.0,0.0;0.02,0.02,0.02],'timestep_mc','250d');
+%! curve_struct(1).id = c.id;
+%! curve_struct(1).object = c;
+%! [obj scen_number_total] = valuate_scenario_sets(b,'31-Dec-2015',{'250d','stress'}, ...
+%!                     struct(),struct(),struct(),curve_struct,struct(),struct(),para_object);
+%! assert(scen_number_total,5)
+%! para_object.scen_number = 3;
+%! ref = b.valuate('31-Dec-2015','250d',struct(),struct(),struct(),curve_struct,struct(),struct(),para_object);
+%! para_object.scen_number = 2;
+%! ref = ref.valuate('31-Dec-2015','stress',struct(),struct(),struct(),curve_struct,struct(),struct(),para_object);
+%! assert(obj.getValue('base'),ref.getValue('base'),1e-10)
+%! assert(obj.getValue('250d'),ref.getValue('250d'),1e-10)
+%! assert(obj.getValue('stress'),ref.getValue('stress'),1e-10)
+%! assert(obj.get('mod_duration'),ref.get('mod_duration'),1e-10)
@@ -0,0 +1,94 @@
+%# Copyright (C) 2026 Stefan Schloegl <schinzilord@octarisk.com>
+%#
+%# This program is free software; you can redistribute it and/or modify it under
+%# the terms of the GNU General Public License as published by the Free Software
+%# Foundation; either version 3 of the License, or (at your option) any later
+%# version.
+%#
+%# This program is distributed in the hope that it will be useful, but WITHOUT
+%# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+%# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+%# details.
+
+%# -*- texinfo -*-
+%# @deftypefn {Function File} {@var{whatif_engine} =} whatif_commit_trade (@var{whatif_engine}, @var{pnl_trade})
+%#
+%# Add accepted trades to the portfolio of a what-if engine without compiling
+%# a new engine (see compile_whatif_engine).
+%# The new portfolio P&L is the current P&L plus the sum of all columns of
+%# @var{pnl_trade}. As in calc_whatif_var, only the candidate scenarios below
+%# the threshold pnl_sorted(no_ranks) + 2 * max(abs(trade)) can move to the
+%# required smallest ranks. The candidate prefix and the remaining scenarios
+%# are sorted separately (the remaining scenarios keep their current order
+%# up to shifts by the trade P&L) and both sorted runs are merged.
+%# The quantile estimator weights depend on the number of scenarios only and
+%# are reused, the portfolio VaR and ES figures are updated.
+%# @*
+%# Variables:
+%# @itemize @bullet
+%# @item @var{whatif_engine}: what-if engine (see compile_whatif_engine)
+%# @item @var{pnl_trade}: scenario P&L of accepted trades (scenarios x trades)
+%# @item @var{whatif_engine}: RETURN: what-if engine of new portfolio
+%# @end itemize
+%# @seealso{compile_whatif_engine, calc_whatif_var}
+%# @end deftypefn
+
+function whatif_engine = whatif_commit_trade(whatif_engine, pnl_trade)
+
+if ( nargin ~= 2 )
+    print_usage();
+end
+if ( rows(pnl_trade) ~= length(whatif_engine.pnl) )
+    error('whatif_commit_trade: trade P&L has %d scenarios, portfolio P&L %d', ...
+                            rows(pnl_trade),length(whatif_engine.pnl));
+end
+
+trade = sum(pnl_trade,2);
+no_ranks = whatif_engine.no_ranks;
+confi_scenario = whatif_engine.confi_scenario;
+pnl = whatif_engine.pnl + trade;
+
+% candidate prefix and remaining scenarios of current sorted P&L
+threshold = whatif_engine.pnl_sorted(no_ranks) + 2 * max(abs(trade));
+no_cand = max(lookup(whatif_engine.pnl_sorted,threshold),no_ranks);
+cand = whatif_engine.scen_order(1:no_cand);
+rest = whatif_engine.scen_order(no_cand+1:end);
+[tmp idx] = sort(pnl(cand));
+cand = cand(idx);
+[tmp idx] = sort(pnl(rest));
+rest = rest(idx);
+% merge both sorted runs
+scen_order = [cand;rest];
+[pnl_sorted idx] = sort(pnl(scen_order));
+scen_order = scen_order(idx);
+
+whatif_engine.pnl = pnl;
+whatif_engine.pnl_sorted = pnl_sorted;
+whatif_engine.scen_order = scen_order;
+whatif_engine.varhd_abs = - dot(whatif_engine.hd_vec,pnl_sorted(1:no_ranks));
+whatif_engine.var_abs = - pnl_sorted(confi_scenario);
+whatif_engine.expshortfall_abs = - mean(pnl_sorted(1:confi_scenario-1));
+
+end
+
+%!test
+%! randn('state',7);
+%! pnl = 1000 * randn(5000,1);
+%! para = struct('quantile',0.99,'quantile_estimator','hd','quantile_bandwidth',50);
+%! whatif_engine = compile_whatif_engine(pnl,para);
+%! trades = [50 * randn(5000,1), -0.5 * pnl];
+%! new_engine = whatif_commit_trade(whatif_engine,trades(:,1));
+%! ref_engine = compile_whatif_engine(pnl + trades(:,1),para);
+%! assert(new_engine.pnl_sorted,ref_engine.pnl_sorted)
+%! assert(new_engine.pnl(new_engine.scen_order),ref_engine.pnl_sorted)
+%! assert(new_engine.varhd_abs,ref_engine.varhd_abs,1e-6)
+%! assert(new_engine.var_abs,ref_engine.var_abs)
+%! assert(new_engine.expshortfall_abs,ref_engine.expshortfall_abs,1e-6)
+%! whatif = calc_whatif_var(whatif_engine,trades(:,1));
+%! assert(new_engine.varhd_abs,whatif.varhd_abs,1e-6)
+%! new_engine = whatif_commit_trade(new_engine,trades(:,2));
+%! ref_engine = compile_whatif_engine(pnl + sum(trades,2),para);
+%! assert(new_engine.pnl_sorted,ref_engine.pnl_sorted,1e-9)
+%! assert(new_engine.varhd_abs,ref_engine.varhd_abs,1e-6)
+%! assert(whatif_commit_trade(whatif_engine,trades).pnl_sorted,ref_engine.pnl_sorted)
+%!error whatif_commit_trade(compile_whatif_engine([1;2;3],struct('quantile',0.5,'quantile_estimator','singular','quantile_bandwidth',0)),[1;2])